@@ -31,6 +31,8 @@
 #include "live/viewcontext.h"
 #include "live/workspaceextension.h"
 #include "live/packagegraph.h"
+#include "live/librarypreloader.h"
+#include "live/trace.h"
 
 #include "live/project.h"
 #include "live/documenthandler.h"
@@ -50,6 +52,7 @@
 #include <QQuickWindow>
 #include <QGuiApplication>
 #include <QProcess>
+#include <QRegularExpression>
 
 #ifdef BUILD_ELEMENTS
 #include "live/elements/engine.h"
@@ -72,6 +75,7 @@ Livekeys::Livekeys(QObject *parent)
     , m_log(nullptr)
     , m_vlog(new VisualLogQmlObject) // js ownership
     , m_packageGraph(nullptr)
+    , m_libraryPreloader(nullptr)
 
     , m_layers(new QQmlPropertyMap)
     , m_lastLayer(nullptr)
@@ -82,6 +86,10 @@ Livekeys::Livekeys(QObject *parent)
     solveImportPaths();
     m_log = new VisualLogModel(m_viewEngine->engine());
 
+#ifdef BUILD_ELEMENTS
+    m_engine->setCompileCache(el::CompileCache::Ptr(new el::CompileCache(el::CompileCache::defaultCachePath())));
+#endif
+
     connect(m_project, SIGNAL(pathChanged(QString)), SLOT(projectChanged(QString)));
     connect(m_viewEngine, &ViewEngine::applicationError, this, &Livekeys::engineError);
 
@@ -99,6 +107,23 @@ Livekeys::~Livekeys(){
 
     Memory::clear();
 
+    if ( m_packageGraph && m_packageGraph->manifestCache() && m_packageGraph->manifestCache()->isModified() ){
+        try{
+            m_packageGraph->manifestCache()->save(ManifestCache::defaultCacheFilePath());
+        } catch ( lv::Exception& e ){
+            vlog().w() << "Failed to save manifest cache: " << e.message();
+        }
+    }
+
+    if ( !m_arguments->traceFile().empty() ){
+        try{
+            Trace::save(m_arguments->traceFile());
+        } catch ( lv::Exception& e ){
+            vlog().w() << "Failed to save trace: " << e.message();
+        }
+    }
+
+    delete m_libraryPreloader;
     delete m_layers;
     delete m_settings;
     delete m_viewEngine;
@@ -119,6 +144,9 @@ Livekeys::Ptr Livekeys::create(int argc, const char * const argv[], QObject *par
     Livekeys::Ptr livekeys = Livekeys::Ptr(new Livekeys(parent));
     livekeys->m_arguments->initialize(argc, argv);
 
+    if ( !livekeys->m_arguments->traceFile().empty() )
+        Trace::enable();
+
     qInstallMessageHandler(&visualLogMessageHandler);
 
     MLNode logconfig = livekeys->m_arguments->getLogConfiguration();
@@ -173,6 +201,10 @@ void Livekeys::solveImportPaths(){
 }
 
 void Livekeys::loadProject(){
+    vtrace("main", "Livekeys::loadProject");
+
+    finishPreloadingLibraries();
+
     m_project->setRunSpace(layerPlaceholder());
 
     if ( m_arguments->script() != "" ){
@@ -207,6 +239,8 @@ void Livekeys::addLayer(const QString &name, const QString &layer){
 }
 
 void Livekeys::loadLayer(const QString &name, std::function<void (Layer*)> onReady){
+    vtrace("main", "Livekeys::loadLayer", name.toStdString());
+
     auto it = m_storedLayers.find(name);
     if ( it == m_storedLayers.end() )
         THROW_EXCEPTION(Exception, "Layer not found: " + name.toStdString(), Exception::toCode("~Layer"));
@@ -311,6 +345,9 @@ void Livekeys::loadDefaultLayers(){
         layersToLoad.removeAll("base");
     }
 
+    if ( m_arguments->preloadLibrariesFlag() )
+        preloadLibraries(layersToLoad);
+
     if ( !layersToLoad.isEmpty() ){
         loadLayers(layersToLoad, [this](Layer*){
             loadProject();
@@ -320,7 +357,74 @@ void Livekeys::loadDefaultLayers(){
     }
 }
 
+/**
+ * \brief Starts loading the plugin libraries imported by the given \p layers and the project script in the background
+ *
+ * Imports are read from the top of each file, and resolved through the package graph together with their plugin
+ * dependencies. The libraries are then loaded concurrently, while the layers are being created.
+ */
+void Livekeys::preloadLibraries(const QStringList &layers){
+    if ( m_libraryPreloader )
+        return;
+
+    QStringList files;
+    for ( auto it = layers.begin(); it != layers.end(); ++it ){
+        auto layerIt = m_storedLayers.find(*it);
+        if ( layerIt != m_storedLayers.end() )
+            files.append(layerIt.value());
+    }
+
+    if ( m_arguments->script() != "" ){
+        QString scriptPath = QString::fromStdString(m_arguments->script());
+        if ( m_arguments->globalFlag() && !QFileInfo(scriptPath).isAbsolute() )
+            scriptPath = QString::fromStdString(ApplicationContext::instance().pluginPath()) + "/" + scriptPath + ".qml";
+        if ( QFileInfo(scriptPath).isDir() )
+            scriptPath += "/main.qml";
+        files.append(scriptPath);
+    }
+
+    m_libraryPreloader = new LibraryPreloader;
+
+    QRegularExpression importExpression("^\\s*import\\s+([A-Za-z_][\\w\\.]*)", QRegularExpression::MultilineOption);
+    for ( auto it = files.begin(); it != files.end(); ++it ){
+        QFile file(*it);
+        if ( !file.open(QFile::ReadOnly) )
+            continue;
+
+        QString content = QString::fromUtf8(file.readAll());
+        QRegularExpressionMatchIterator matchIt = importExpression.globalMatch(content);
+        while ( matchIt.hasNext() ){
+            m_libraryPreloader->addImport(m_packageGraph, matchIt.next().captured(1).toStdString());
+        }
+    }
+
+    vlog("main").v() << "Preloading " << m_libraryPreloader->libraries().size() << " libraries.";
+    m_libraryPreloader->start();
+}
+
+/**
+ * \brief Waits for the preloaded libraries and logs the time spent on each of them
+ */
+void Livekeys::finishPreloadingLibraries(){
+    if ( !m_libraryPreloader || !m_libraryPreloader->isRunning() )
+        return;
+
+    m_libraryPreloader->wait();
+
+    const std::vector<LibraryPreloader::Result>& results = m_libraryPreloader->results();
+    for ( auto it = results.begin(); it != results.end(); ++it ){
+        if ( it->error.empty() ){
+            vlog("main").v() << "Preloaded library \'" << it->path << "\' in " << (it->elapsed / 1000.0) << "ms";
+        } else {
+            vlog("main").w() << "Failed to preload library \'" << it->path << "\': " << it->error;
+        }
+    }
+    vlog("main").v() << "Preloaded " << results.size() << " libraries in " << (m_libraryPreloader->elapsed() / 1000.0) << "ms";
+}
+
 void Livekeys::loadInternals(){
+    vtrace("main", "Livekeys::loadInternals");
+
     loadInternalPackages();
     loadInternalPlugins();
     addDefaultLayers();
@@ -328,6 +432,8 @@ void Livekeys::loadInternals(){
 }
 
 void Livekeys::loadInternalPlugins(){
+    vtrace("main", "Livekeys::loadInternalPlugins");
+
 //    qmlRegisterUncreatableType<lv::Livekeys>(
 //        "base", 1, 0, "LiveKeys",        ViewEngine::typeAsPropertyMessage("LiveKeys", "lk"));
 
@@ -346,9 +452,15 @@ void Livekeys::loadInternalPackages(){
     if ( m_packageGraph )
         return;
 
+    vtrace("main", "Livekeys::loadInternalPackages");
+
     m_packageGraph = new PackageGraph;
     PackageGraph::internalsContextOwner() = m_packageGraph;
 
+    ManifestCache::Ptr manifestCache(new ManifestCache);
+    manifestCache->load(ManifestCache::defaultCacheFilePath());
+    m_packageGraph->setManifestCache(manifestCache);
+
     m_viewEngine->setPackageGraph(m_packageGraph);
 
     const MLNode& defaults = ApplicationContext::instance().startupConfiguration();
@@ -360,7 +472,7 @@ void Livekeys::loadInternalPackages(){
             std::string packagePath = ApplicationContext::instance().pluginPath() + "/" + it->asString();
 
             if ( Package::existsIn(packagePath) ){
-                PackageGraph::addInternalPackage(Package::createFromPath(packagePath));
+                PackageGraph::addInternalPackage(Package::createFromPath(packagePath, manifestCache.get()));
             }
         }
     }
@@ -515,7 +627,9 @@ void Livekeys::projectChanged(const QString &path){
     std::string packagePath = path.toStdString();
     if ( Package::existsIn(packagePath) ){
         std::list<Package::Reference> missing;
-        m_packageGraph->loadPackageWithDependencies(Package::createFromPath(packagePath), missing);
+        m_packageGraph->loadPackageWithDependencies(
+            Package::createFromPath(packagePath, m_packageGraph->manifestCache().get()), missing
+        );
         if ( missing.size() > 0 ){
             emit missingPackages();
         }
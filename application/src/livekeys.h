@@ -54,6 +54,7 @@ class Project;
 class DocumentHandler;
 class CodeQmlHandler;
 class PackageGraph;
+class LibraryPreloader;
 class Layer;
 
 namespace el{ class Engine; }
@@ -127,6 +128,8 @@ private:
     Livekeys& operator = (const Livekeys&);
 
     void loadDefaultLayers();
+    void preloadLibraries(const QStringList& layers);
+    void finishPreloadingLibraries();
     int execElements(const QGuiApplication& app);
     void parseArguments(const QStringList& arguments);
     void solveImportPaths();
@@ -144,6 +147,7 @@ private:
     lv::VisualLogModel*    m_log;
     lv::VisualLogQmlObject*m_vlog;
     lv::PackageGraph*      m_packageGraph;
+    lv::LibraryPreloader*  m_libraryPreloader;
 
     QQmlPropertyMap*       m_layers;
     QMap<QString, QString> m_storedLayers;
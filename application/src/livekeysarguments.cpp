@@ -24,6 +24,7 @@ namespace lv{
 LivekeysArguments::LivekeysArguments(const std::string& header)
     : m_parser(new CommandLineParser(header))
     , m_globalScript(false)
+    , m_preloadLibraries(false)
 {
 }
 
@@ -73,6 +74,10 @@ void LivekeysArguments::initialize(int argc, const char* const argv[]){
         "Run project in window mode, do not load any workspace. This is equivalent to --layers window");
     CommandLineParser::Option* globalScript = m_parser->addFlag({"--global"},
         "Run project by looking its path up in the global packages folder.");
+    CommandLineParser::Option* preloadLibraries = m_parser->addFlag({"--preload-libraries"},
+        "Load the plugin libraries imported by the project and layers on background threads during startup.");
+    CommandLineParser::Option* traceOption = m_parser->addOption({"--trace"},
+        "Record startup timings and save them to a Chrome trace file (viewable in chrome://tracing).", "path");
 
     m_parser->parse(argc, argv);
 
@@ -93,6 +98,12 @@ void LivekeysArguments::initialize(int argc, const char* const argv[]){
     if ( m_parser->isSet(globalScript) ){
         m_globalScript = true;
     }
+    if ( m_parser->isSet(preloadLibraries) ){
+        m_preloadLibraries = true;
+    }
+    if ( m_parser->isSet(traceOption) ){
+        m_traceFile = m_parser->value(traceOption);
+    }
 
     if ( m_parser->isSet(logConfigFileOption) ){
         m_logConfiguration = MLNode(MLNode::Type::Object);
@@ -191,6 +202,14 @@ bool LivekeysArguments::globalFlag() const{
     return m_globalScript;
 }
 
+bool LivekeysArguments::preloadLibrariesFlag() const{
+    return m_preloadLibraries;
+}
+
+const std::string &LivekeysArguments::traceFile() const{
+    return m_traceFile;
+}
+
 std::string LivekeysArguments::helpString() const{
     return m_parser->helpString();
 }
@@ -35,6 +35,8 @@ public:
     bool helpFlag() const;
     bool versionFlag() const;
     bool globalFlag() const;
+    bool preloadLibrariesFlag() const;
+    const std::string& traceFile() const;
     std::string helpString() const;
 
     const QStringList& layers() const;
@@ -56,6 +58,8 @@ private:
     MLNode m_logConfiguration;
 
     bool        m_globalScript;
+    bool        m_preloadLibraries;
+    std::string m_traceFile;
 
     QStringList m_monitoredFiles;
     QStringList m_layers;
@@ -15,8 +15,6 @@ QmlEngineInterceptor::UrlInterceptor::UrlInterceptor(ViewEngine* engine, Package
 }
 
 QUrl QmlEngineInterceptor::UrlInterceptor::intercept(const QUrl &path, QQmlAbstractUrlInterceptor::DataType dataType){
-    QStringList importPaths = m_engine->engine()->importPathList();
-
     if ( dataType == QQmlAbstractUrlInterceptor::QmldirFile && path.isLocalFile() ){
         try{
             QString localPath = path.toLocalFile();
@@ -24,33 +22,20 @@ QUrl QmlEngineInterceptor::UrlInterceptor::intercept(const QUrl &path, QQmlAbstr
                 localPath = localPath.mid(0, localPath.length() - 6);
             }
 
-            QString importSegment;
-
-            for ( auto it = importPaths.begin(); it != importPaths.end(); ++it ){
-                if ( localPath.startsWith(*it) ){
-                    importSegment = localPath.mid(it->length());
-                    if ( importSegment.startsWith('/') )
-                        importSegment = importSegment.mid(1);
-                    if ( importSegment.endsWith('/') )
-                        importSegment = importSegment.mid(0, importSegment.length() - 1);
-                    break;
-                }
+            // import ids are cached per path, and reset whenever the engine import paths change
+            QStringList importPaths = m_engine->engine()->importPathList();
+            if ( importPaths != m_importPaths ){
+                m_importPaths = importPaths;
+                m_importIds.clear();
             }
 
-            if ( !importSegment.isEmpty() ){
-                QStringList importSegmentParts = importSegment.split('/');
-                std::vector<std::string> partsConverted;
-                for ( auto it = importSegmentParts.begin(); it != importSegmentParts.end(); ++it ){
-                    int dotIndex = it->indexOf('.');
-                    if ( dotIndex != -1 ){
-                        partsConverted.push_back(it->mid(0, dotIndex).toStdString());
-                    } else {
-                        partsConverted.push_back(it->toStdString());
-                    }
-                }
+            auto importIdIt = m_importIds.find(localPath);
+            if ( importIdIt == m_importIds.end() )
+                importIdIt = m_importIds.insert(localPath, importIdFromPath(localPath, importPaths));
 
+            if ( !importIdIt.value().empty() ){
                 try{
-                    Plugin::Ptr plugin = m_packageGraph->loadPlugin(partsConverted);
+                    Plugin::Ptr plugin = m_packageGraph->loadPlugin(importIdIt.value());
                     if ( plugin != nullptr ){
                         return QUrl::fromLocalFile(QString::fromStdString(plugin->path() + "/qmldir"));
                     }
@@ -71,6 +56,43 @@ QUrl QmlEngineInterceptor::UrlInterceptor::intercept(const QUrl &path, QQmlAbstr
     return path;
 }
 
+std::string QmlEngineInterceptor::UrlInterceptor::importIdFromPath(
+        const QString &localPath, const QStringList &importPaths) const
+{
+    QString importSegment;
+
+    for ( auto it = importPaths.begin(); it != importPaths.end(); ++it ){
+        if ( localPath.startsWith(*it) ){
+            importSegment = localPath.mid(it->length());
+            if ( importSegment.startsWith('/') )
+                importSegment = importSegment.mid(1);
+            if ( importSegment.endsWith('/') )
+                importSegment = importSegment.mid(0, importSegment.length() - 1);
+            break;
+        }
+    }
+
+    if ( importSegment.isEmpty() )
+        return std::string();
+
+    std::string importId;
+
+    QStringList importSegmentParts = importSegment.split('/');
+    for ( auto it = importSegmentParts.begin(); it != importSegmentParts.end(); ++it ){
+        if ( it != importSegmentParts.begin() )
+            importId += '.';
+
+        int dotIndex = it->indexOf('.');
+        if ( dotIndex != -1 ){
+            importId += it->mid(0, dotIndex).toStdString();
+        } else {
+            importId += it->toStdString();
+        }
+    }
+
+    return importId;
+}
+
 QNetworkAccessManager *QmlEngineInterceptor::Factory::create(QObject *parent){
     return new QmlEngineInterceptor(parent);
 }
@@ -11,6 +11,7 @@
 #include <QQmlAbstractUrlInterceptor>
 #include <QQmlNetworkAccessManagerFactory>
 #include <QNetworkReply>
+#include <QHash>
 
 namespace lv{
 
@@ -47,9 +48,14 @@ public:
         QUrl intercept(const QUrl &path, DataType type);
 
     private:
+        std::string importIdFromPath(const QString& localPath, const QStringList& importPaths) const;
+
         Project*      m_project;
         ViewEngine*   m_engine;
         PackageGraph* m_packageGraph;
+
+        QStringList                  m_importPaths;
+        QHash<QString, std::string>  m_importIds;
     };
 
     class Factory : public QQmlNetworkAccessManagerFactory{
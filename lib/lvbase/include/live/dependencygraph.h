@@ -0,0 +1 @@
+#include "../../src/dependencygraph.h"
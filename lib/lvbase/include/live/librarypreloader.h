@@ -0,0 +1 @@
+#include "../../src/librarypreloader.h"
@@ -0,0 +1 @@
+#include "../../src/manifestcache.h"
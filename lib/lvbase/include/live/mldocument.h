@@ -0,0 +1 @@
+#include "../../src/mldocument.h"
@@ -0,0 +1 @@
+#include "../../src/mljsonview.h"
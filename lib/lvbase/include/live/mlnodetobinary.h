@@ -0,0 +1 @@
+#include "../../src/mlnodetobinary.h"
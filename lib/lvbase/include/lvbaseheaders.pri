@@ -12,6 +12,13 @@ HEADERS += \
     $$PWD/live/applicationcontext.h \
     $$PWD/live/mlnode.h \
     $$PWD/live/mlnodetojson.h \
+    $$PWD/live/mldocument.h \
+    $$PWD/live/mlnodetobinary.h \
+    $$PWD/live/mljsonview.h \
+    $$PWD/live/manifestcache.h \
+    $$PWD/live/librarypreloader.h \
+    $$PWD/live/trace.h \
+    $$PWD/live/dependencygraph.h \
     $$PWD/live/typename.h \
     $$PWD/live/visuallog.h \
     $$PWD/live/meta/indextuple.h \
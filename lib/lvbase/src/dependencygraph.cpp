@@ -0,0 +1,334 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "dependencygraph.h"
+
+#include <algorithm>
+#include <deque>
+
+namespace lv{
+
+/**
+ * \class lv::DependencyGraph
+ * \brief Directed graph of dependencies between indexed nodes
+ *
+ * An edge from \p a to \p b means that \p a depends on \p b. Edges are stored as adjacency lists, together with
+ * a hash set for constant time edge lookups.
+ *
+ * The set of nodes reachable from each node (its transitive closure) is computed on first request and cached.
+ * Adding or removing an edge from \p a only invalidates the cached closures of \p a and of the nodes that
+ * reach \p a, so repeated dependency and cycle queries on a stable graph don't traverse it again.
+ *
+ * Strongly connected components are found with Tarjan's algorithm, and are returned with dependencies first,
+ * which also gives the order in which nodes can be loaded.
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Default constructor
+ */
+DependencyGraph::DependencyGraph(){
+}
+
+/**
+ * \brief Destructor
+ */
+DependencyGraph::~DependencyGraph(){
+}
+
+/**
+ * \brief Adds a new node without any edges, and returns its index
+ */
+DependencyGraph::Node DependencyGraph::addNode(){
+    m_edges.push_back(std::vector<Node>());
+    m_closure.push_back(std::vector<Node>());
+    m_closureValid.push_back(true);
+    return m_edges.size() - 1;
+}
+
+/**
+ * \brief Adds an edge stating that \p from depends on \p to
+ *
+ * Returns false if the edge already exists.
+ */
+bool DependencyGraph::addEdge(DependencyGraph::Node from, DependencyGraph::Node to){
+    if ( !m_edgeSet.insert(edgeKey(from, to)).second )
+        return false;
+
+    m_edges[from].push_back(to);
+    invalidateReaching(from);
+    return true;
+}
+
+/**
+ * \brief Removes the edge between \p from and \p to
+ *
+ * Returns false if the edge does not exist.
+ */
+bool DependencyGraph::removeEdge(DependencyGraph::Node from, DependencyGraph::Node to){
+    if ( m_edgeSet.erase(edgeKey(from, to)) == 0 )
+        return false;
+
+    std::vector<Node>& fromEdges = m_edges[from];
+    fromEdges.erase(std::find(fromEdges.begin(), fromEdges.end(), to));
+    invalidateReaching(from);
+    return true;
+}
+
+/**
+ * \brief Checks wether \p from depends directly on \p to
+ */
+bool DependencyGraph::hasEdge(DependencyGraph::Node from, DependencyGraph::Node to) const{
+    return m_edgeSet.find(edgeKey(from, to)) != m_edgeSet.end();
+}
+
+/**
+ * \brief Checks wether \p from depends on \p to, either directly or through other nodes
+ *
+ * A node only reaches itself if it's part of a cycle.
+ */
+bool DependencyGraph::reaches(DependencyGraph::Node from, DependencyGraph::Node to) const{
+    const std::vector<Node>& r = reachable(from);
+    return std::binary_search(r.begin(), r.end(), to);
+}
+
+/**
+ * \brief Returns the sorted list of nodes \p from depends on, either directly or through other nodes
+ */
+const std::vector<DependencyGraph::Node> &DependencyGraph::reachable(DependencyGraph::Node from) const{
+    if ( m_closureValid[from] )
+        return m_closure[from];
+
+    std::vector<Node> result;
+    std::vector<bool> visited(m_edges.size(), false);
+    std::vector<Node> stack(m_edges[from].begin(), m_edges[from].end());
+
+    while ( !stack.empty() ){
+        Node current = stack.back();
+        stack.pop_back();
+        if ( visited[current] )
+            continue;
+
+        visited[current] = true;
+        result.push_back(current);
+
+        // reuse closures computed previously, without traversing them again
+        if ( m_closureValid[current] && current != from ){
+            for ( Node n : m_closure[current] ){
+                if ( !visited[n] ){
+                    visited[n] = true;
+                    result.push_back(n);
+                }
+            }
+        } else {
+            for ( Node n : m_edges[current] ){
+                if ( !visited[n] )
+                    stack.push_back(n);
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    m_closure[from] = std::move(result);
+    m_closureValid[from] = true;
+    return m_closure[from];
+}
+
+/**
+ * \brief Returns the shortest path of nodes starting with \p from and ending with \p to
+ *
+ * Returns an empty list if \p to is not reachable from \p from.
+ */
+std::vector<DependencyGraph::Node> DependencyGraph::path(DependencyGraph::Node from, DependencyGraph::Node to) const{
+    const size_t none = static_cast<size_t>(-1);
+    std::vector<size_t> parent(m_edges.size(), none);
+    std::deque<Node> queue;
+
+    queue.push_back(from);
+    while ( !queue.empty() ){
+        Node current = queue.front();
+        queue.pop_front();
+
+        for ( Node n : m_edges[current] ){
+            if ( parent[n] != none )
+                continue;
+
+            parent[n] = current;
+            if ( n == to ){
+                std::vector<Node> result;
+                result.push_back(to);
+                Node step = current;
+                while ( step != from ){
+                    result.push_back(step);
+                    step = parent[step];
+                }
+                result.push_back(from);
+                std::reverse(result.begin(), result.end());
+                return result;
+            }
+            queue.push_back(n);
+        }
+    }
+
+    return std::vector<Node>();
+}
+
+/**
+ * \brief Returns the strongly connected components of the graph
+ *
+ * Each component is returned after all the components it depends on. Components with more than one node, or a
+ * single node depending on itself, are cycles.
+ */
+std::vector<std::vector<DependencyGraph::Node> > DependencyGraph::stronglyConnectedComponents() const{
+    const size_t none = static_cast<size_t>(-1);
+    size_t total = m_edges.size();
+
+    std::vector<std::vector<Node> > result;
+    std::vector<size_t> index(total, none);
+    std::vector<size_t> lowLink(total, 0);
+    std::vector<bool>   onStack(total, false);
+    std::vector<Node>   componentStack;
+
+    // iterative depth first search, each frame holds the node and the next edge to visit
+    std::vector<std::pair<Node, size_t> > callStack;
+    size_t nextIndex = 0;
+
+    for ( Node root = 0; root < total; ++root ){
+        if ( index[root] != none )
+            continue;
+
+        callStack.push_back(std::make_pair(root, 0));
+        while ( !callStack.empty() ){
+            Node node = callStack.back().first;
+            size_t& edgeIndex = callStack.back().second;
+
+            if ( edgeIndex == 0 && index[node] == none ){
+                index[node] = lowLink[node] = nextIndex++;
+                componentStack.push_back(node);
+                onStack[node] = true;
+            }
+
+            if ( edgeIndex < m_edges[node].size() ){
+                Node next = m_edges[node][edgeIndex++];
+                if ( index[next] == none ){
+                    callStack.push_back(std::make_pair(next, 0));
+                } else if ( onStack[next] ){
+                    lowLink[node] = std::min(lowLink[node], index[next]);
+                }
+                continue;
+            }
+
+            if ( lowLink[node] == index[node] ){
+                std::vector<Node> component;
+                Node member;
+                do{
+                    member = componentStack.back();
+                    componentStack.pop_back();
+                    onStack[member] = false;
+                    component.push_back(member);
+                } while ( member != node );
+                result.push_back(std::move(component));
+            }
+
+            callStack.pop_back();
+            if ( !callStack.empty() ){
+                Node parent = callStack.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * \brief Returns all nodes ordered so that each node comes after its dependencies
+ *
+ * Nodes within a cycle are returned next to each other, in no particular order.
+ */
+std::vector<DependencyGraph::Node> DependencyGraph::topologicalOrder() const{
+    std::vector<Node> result;
+    result.reserve(m_edges.size());
+
+    std::vector<std::vector<Node> > components = stronglyConnectedComponents();
+    for ( auto it = components.begin(); it != components.end(); ++it )
+        result.insert(result.end(), it->begin(), it->end());
+
+    return result;
+}
+
+/**
+ * \brief Groups nodes into levels, where each node depends only on nodes from previous levels
+ *
+ * Nodes within the same level don't depend on each other, and can be initialized in parallel once all previous
+ * levels are done. Nodes within a cycle are placed on the same level.
+ */
+std::vector<std::vector<DependencyGraph::Node> > DependencyGraph::levels() const{
+    std::vector<std::vector<Node> > components = stronglyConnectedComponents();
+
+    std::vector<size_t> componentOf(m_edges.size(), 0);
+    for ( size_t i = 0; i < components.size(); ++i )
+        for ( Node n : components[i] )
+            componentOf[n] = i;
+
+    // components are ordered with dependencies first, so their levels are known when reached
+    std::vector<size_t> componentLevel(components.size(), 0);
+    std::vector<std::vector<Node> > result;
+
+    for ( size_t i = 0; i < components.size(); ++i ){
+        size_t level = 0;
+        for ( Node n : components[i] ){
+            for ( Node dependency : m_edges[n] ){
+                size_t dependencyComponent = componentOf[dependency];
+                if ( dependencyComponent != i )
+                    level = std::max(level, componentLevel[dependencyComponent] + 1);
+            }
+        }
+        componentLevel[i] = level;
+
+        if ( result.size() <= level )
+            result.resize(level + 1);
+        result[level].insert(result[level].end(), components[i].begin(), components[i].end());
+    }
+
+    return result;
+}
+
+/**
+ * \brief Removes all nodes and edges
+ */
+void DependencyGraph::clear(){
+    m_edges.clear();
+    m_edgeSet.clear();
+    m_closure.clear();
+    m_closureValid.clear();
+}
+
+unsigned long long DependencyGraph::edgeKey(DependencyGraph::Node from, DependencyGraph::Node to){
+    return (static_cast<unsigned long long>(from) << 32) | static_cast<unsigned long long>(to);
+}
+
+void DependencyGraph::invalidateReaching(DependencyGraph::Node node){
+    for ( size_t i = 0; i < m_closureValid.size(); ++i ){
+        if ( m_closureValid[i] && (i == node || std::binary_search(m_closure[i].begin(), m_closure[i].end(), node)) ){
+            m_closureValid[i] = false;
+            m_closure[i].clear();
+        }
+    }
+}
+
+}// namespace
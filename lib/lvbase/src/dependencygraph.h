@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LVDEPENDENCYGRAPH_H
+#define LVDEPENDENCYGRAPH_H
+
+#include "live/lvbaseglobal.h"
+
+#include <cstddef>
+#include <vector>
+#include <unordered_set>
+
+namespace lv{
+
+class LV_BASE_EXPORT DependencyGraph{
+
+public:
+    /** Index of a node within the graph */
+    typedef size_t Node;
+
+public:
+    DependencyGraph();
+    ~DependencyGraph();
+
+    Node addNode();
+    size_t nodeCount() const;
+
+    bool addEdge(Node from, Node to);
+    bool removeEdge(Node from, Node to);
+    bool hasEdge(Node from, Node to) const;
+    const std::vector<Node>& edges(Node node) const;
+
+    bool reaches(Node from, Node to) const;
+    const std::vector<Node>& reachable(Node from) const;
+    std::vector<Node> path(Node from, Node to) const;
+
+    std::vector<std::vector<Node> > stronglyConnectedComponents() const;
+    std::vector<Node> topologicalOrder() const;
+    std::vector<std::vector<Node> > levels() const;
+
+    void clear();
+
+private:
+    static unsigned long long edgeKey(Node from, Node to);
+    void invalidateReaching(Node node);
+
+    std::vector<std::vector<Node> >       m_edges;
+    std::unordered_set<unsigned long long> m_edgeSet;
+
+    mutable std::vector<std::vector<Node> > m_closure;
+    mutable std::vector<bool>               m_closureValid;
+};
+
+/**
+ * \brief Returns the number of nodes in the graph
+ */
+inline size_t DependencyGraph::nodeCount() const{
+    return m_edges.size();
+}
+
+/**
+ * \brief Returns the direct dependencies of \p node, in the order they were added
+ */
+inline const std::vector<DependencyGraph::Node> &DependencyGraph::edges(DependencyGraph::Node node) const{
+    return m_edges[node];
+}
+
+}// namespace
+
+#endif // LVDEPENDENCYGRAPH_H
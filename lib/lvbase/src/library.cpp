@@ -46,4 +46,9 @@ Library::Library(const std::string &path)
 {
 }
 
+/** Destructor. The library is not unloaded, since symbols from it might still be in use. */
+Library::~Library(){
+    delete m_d;
+}
+
 }// namespace
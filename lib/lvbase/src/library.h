@@ -17,6 +17,8 @@ public:
     typedef std::shared_ptr<const Library> ConstPtr;
 
 public:
+    ~Library();
+
     static Ptr load(const std::string& path);
     void* symbol(const std::string& name);
     void* symbol(const char* name);
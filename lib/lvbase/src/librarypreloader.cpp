@@ -0,0 +1,220 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "librarypreloader.h"
+#include "live/packagegraph.h"
+#include "live/exception.h"
+#include "live/visuallog.h"
+#include "live/trace.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace lv{
+
+/**
+ * \class lv::LibraryPreloader
+ * \brief Loads a set of libraries concurrently on background threads
+ *
+ * Plugin libraries are normally loaded by the QML engine one by one, as each import is reached. The preloader
+ * loads them ahead of time, so when the engine requests them they are already mapped into the process, and
+ * loading them again only increments their reference count.
+ *
+ * Libraries are collected on the calling thread, either directly, from plugins, or by walking the import graph
+ * of a PackageGraph. Only the actual loading happens in the background:
+ *
+ * \code
+ * LibraryPreloader preloader;
+ * preloader.addImport(packageGraph, "lcvcore");
+ * preloader.start();
+ * // ...
+ * preloader.wait();
+ * \endcode
+ *
+ * Libraries stay loaded for the lifetime of the process, even after the preloader is destroyed.
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Constructor
+ *
+ * If \p threadCount is 0, the number of threads is chosen based on the available cores.
+ */
+LibraryPreloader::LibraryPreloader(size_t threadCount)
+    : m_next(0)
+    , m_threadCount(threadCount)
+    , m_elapsed(0)
+{
+    if ( m_threadCount == 0 ){
+        m_threadCount = std::thread::hardware_concurrency();
+        if ( m_threadCount == 0 )
+            m_threadCount = 2;
+        if ( m_threadCount > 4 )
+            m_threadCount = 4;
+    }
+}
+
+/**
+ * \brief Destructor, waits for the loading threads to finish
+ */
+LibraryPreloader::~LibraryPreloader(){
+    wait();
+}
+
+/**
+ * \brief Adds the library at \p path. Libraries that were already added are skipped.
+ *
+ * Throws an lv::Exception if the preloader is running.
+ */
+void LibraryPreloader::addLibrary(const std::string &path){
+    if ( isRunning() )
+        THROW_EXCEPTION(lv::Exception, "Cannot add libraries while the preloader is running.", Exception::toCode("~State"));
+
+    if ( m_visited.insert("lib:" + path).second )
+        m_libraries.push_back(path);
+}
+
+/**
+ * \brief Adds the libraries declared in the \p plugin qmldir file
+ */
+void LibraryPreloader::addPlugin(const Plugin::Ptr &plugin){
+    if ( !plugin || !m_visited.insert("plugin:" + plugin->path()).second )
+        return;
+
+    std::vector<std::string> libraries = librariesFromQmldir(plugin->path());
+    for ( auto it = libraries.begin(); it != libraries.end(); ++it )
+        addLibrary(*it);
+}
+
+/**
+ * \brief Resolves \p importId through the \p graph, and adds the libraries of the resulting plugin and of all the
+ * plugins it depends on
+ *
+ * Imports that cannot be resolved are skipped, since the engine will report them when the import is reached.
+ */
+void LibraryPreloader::addImport(PackageGraph *graph, const std::string &importId){
+    if ( !m_visited.insert("import:" + importId).second )
+        return;
+
+    Plugin::Ptr plugin(nullptr);
+    try{
+        plugin = graph->loadPlugin(importId);
+    } catch ( lv::Exception& e ){
+        vlog("lvbase-librarypreloader").v() << "Skipping import \'" << importId << "\': " << e.message();
+        return;
+    }
+
+    if ( !plugin )
+        return;
+
+    addPlugin(plugin);
+    for ( auto it = plugin->dependencies().begin(); it != plugin->dependencies().end(); ++it )
+        addImport(graph, *it);
+}
+
+/**
+ * \brief Starts loading the added libraries on background threads
+ */
+void LibraryPreloader::start(){
+    if ( isRunning() )
+        return;
+
+    m_results.clear();
+    m_results.resize(m_libraries.size());
+    for ( size_t i = 0; i < m_libraries.size(); ++i )
+        m_results[i].path = m_libraries[i];
+
+    m_next = 0;
+    m_startStamp = std::chrono::steady_clock::now();
+
+    size_t threadCount = m_threadCount < m_libraries.size() ? m_threadCount : m_libraries.size();
+    for ( size_t i = 0; i < threadCount; ++i )
+        m_threads.push_back(std::thread(&LibraryPreloader::work, this));
+}
+
+/**
+ * \brief Blocks until all libraries have been loaded
+ */
+void LibraryPreloader::wait(){
+    if ( !isRunning() )
+        return;
+
+    for ( auto it = m_threads.begin(); it != m_threads.end(); ++it )
+        it->join();
+    m_threads.clear();
+
+    m_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_startStamp
+    ).count();
+}
+
+/**
+ * \brief Returns the library paths declared by the \p plugin lines in the qmldir file from \p pluginPath
+ *
+ * Paths are returned without platform specific prefixes or suffixes, which are added by Library::load.
+ */
+std::vector<std::string> LibraryPreloader::librariesFromQmldir(const std::string &pluginPath){
+    std::vector<std::string> result;
+
+    std::ifstream instream(pluginPath + "/qmldir", std::ifstream::in);
+    if ( !instream.is_open() )
+        return result;
+
+    std::string line;
+    while ( std::getline(instream, line) ){
+        std::istringstream linestream(line);
+
+        std::string command, name, path;
+        linestream >> command >> name >> path;
+        if ( command != "plugin" || name.empty() )
+            continue;
+
+        if ( path.empty() ){
+            result.push_back(pluginPath + "/" + name);
+        } else if ( path[0] == '/' || (path.size() > 1 && path[1] == ':') ){
+            result.push_back(path + "/" + name);
+        } else {
+            result.push_back(pluginPath + "/" + path + "/" + name);
+        }
+    }
+
+    return result;
+}
+
+void LibraryPreloader::work(){
+    while ( true ){
+        size_t index = m_next++;
+        if ( index >= m_libraries.size() )
+            return;
+
+        Result& result = m_results[index];
+
+        vtrace("lvbase", "LibraryPreloader::load", result.path);
+
+        auto stamp = std::chrono::steady_clock::now();
+        try{
+            result.library = Library::load(result.path);
+        } catch ( lv::Exception& e ){
+            result.error = e.message();
+        }
+        result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - stamp
+        ).count();
+    }
+}
+
+}// namespace
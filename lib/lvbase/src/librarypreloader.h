@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LVLIBRARYPRELOADER_H
+#define LVLIBRARYPRELOADER_H
+
+#include "live/lvbaseglobal.h"
+#include "live/library.h"
+#include "live/plugin.h"
+
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace lv{
+
+class PackageGraph;
+
+class LV_BASE_EXPORT LibraryPreloader{
+
+    DISABLE_COPY(LibraryPreloader);
+
+public:
+    /**
+     * \class lv::LibraryPreloader::Result
+     * \brief Outcome of loading a single library
+     */
+    class Result{
+    public:
+        /** Path of the library, as given to Library::load */
+        std::string  path;
+        /** Loaded library, null if loading failed */
+        Library::Ptr library;
+        /** Time spent loading, in microseconds */
+        long long    elapsed;
+        /** Error message, empty on success */
+        std::string  error;
+    };
+
+public:
+    explicit LibraryPreloader(size_t threadCount = 0);
+    ~LibraryPreloader();
+
+    void addLibrary(const std::string& path);
+    void addPlugin(const Plugin::Ptr& plugin);
+    void addImport(PackageGraph* graph, const std::string& importId);
+
+    void start();
+    void wait();
+
+    bool isRunning() const;
+    const std::vector<Result>& results() const;
+    const std::vector<std::string>& libraries() const;
+    long long elapsed() const;
+
+    static std::vector<std::string> librariesFromQmldir(const std::string& pluginPath);
+
+private:
+    void work();
+
+    std::vector<std::string> m_libraries;
+    std::set<std::string>    m_visited;
+    std::vector<Result>      m_results;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t>      m_next;
+    size_t                   m_threadCount;
+    long long                m_elapsed;
+
+    std::chrono::steady_clock::time_point m_startStamp;
+};
+
+/**
+ * \brief Checks wether the preloader was started and not waited for yet
+ */
+inline bool LibraryPreloader::isRunning() const{
+    return !m_threads.empty();
+}
+
+/**
+ * \brief Returns the results for each library, in the order they were added
+ *
+ * Results are only available after wait() returns.
+ */
+inline const std::vector<LibraryPreloader::Result> &LibraryPreloader::results() const{
+    return m_results;
+}
+
+/**
+ * \brief Returns the paths of all added libraries
+ */
+inline const std::vector<std::string> &LibraryPreloader::libraries() const{
+    return m_libraries;
+}
+
+/**
+ * \brief Returns the total time between start() and wait(), in microseconds
+ */
+inline long long LibraryPreloader::elapsed() const{
+    return m_elapsed;
+}
+
+}// namespace
+
+#endif // LVLIBRARYPRELOADER_H
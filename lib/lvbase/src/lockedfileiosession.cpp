@@ -18,10 +18,17 @@
 #include <fstream>
 #include <istream>
 #include <unordered_map>
+#include <list>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QTextStream>
 #include <QMutex>
+#include <QMutexLocker>
 #include <QReadWriteLock>
 #include <QHash>
 #include <QString>
@@ -35,6 +42,14 @@
   Each file (given by its path) gets a unique file lock (the acquisition and release of locks themselves is
   guaranteed to be in critical sections as well), and depending on the context, we get either read or write access.
   There can be multiple readers, but only one writer, at a time.
+
+  Content read through the session is cached as shared, immutable buffers, so files scanned repeatedly by
+  different threads are only read once. Each entry is validated against the modification time and size of the
+  file before it's returned, and entries are dropped when the file is written through the session, or in least
+  recently used order once the cacheLimit() is exceeded.
+
+  Files are read through a memory map, copied once into the cached buffer. The mapping is released right after,
+  so cached content doesn't keep files open or locked while editors or the session write to them.
  */
 
 namespace lv{
@@ -51,6 +66,93 @@ public:
     int refcount;
 };
 
+// Class FileContentCache
+// --------------------------------------------------
+
+/// \private
+class FileContentCache{
+
+public:
+    /// \private
+    class Entry{
+    public:
+        LockedFileIOSession::ContentPtr content;
+        long long modified;
+        long long size;
+        std::list<std::string>::iterator usage;
+    };
+
+    FileContentCache() : limit(LockedFileIOSession::DefaultCacheLimit), totalSize(0){}
+
+    LockedFileIOSession::ContentPtr find(const std::string& path, long long modified, long long size);
+    void insert(const std::string& path, const LockedFileIOSession::ContentPtr& content, long long modified, long long size);
+    void remove(const std::string& path);
+    void clear();
+    void shrink();
+
+    QMutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> usage;
+    size_t limit;
+    size_t totalSize;
+};
+
+LockedFileIOSession::ContentPtr FileContentCache::find(const std::string &path, long long modified, long long size){
+    auto it = entries.find(path);
+    if ( it == entries.end() )
+        return nullptr;
+
+    if ( it->second.modified != modified || it->second.size != size ){
+        remove(path);
+        return nullptr;
+    }
+
+    usage.splice(usage.begin(), usage, it->second.usage);
+    return it->second.content;
+}
+
+void FileContentCache::insert(
+        const std::string &path, const LockedFileIOSession::ContentPtr &content, long long modified, long long size)
+{
+    remove(path);
+    if ( limit == 0 || content->size() > limit )
+        return;
+
+    usage.push_front(path);
+
+    Entry entry;
+    entry.content  = content;
+    entry.modified = modified;
+    entry.size     = size;
+    entry.usage    = usage.begin();
+    entries[path]  = entry;
+
+    totalSize += content->size();
+    shrink();
+}
+
+void FileContentCache::remove(const std::string &path){
+    auto it = entries.find(path);
+    if ( it == entries.end() )
+        return;
+
+    totalSize -= it->second.content->size();
+    usage.erase(it->second.usage);
+    entries.erase(it);
+}
+
+void FileContentCache::clear(){
+    entries.clear();
+    usage.clear();
+    totalSize = 0;
+}
+
+void FileContentCache::shrink(){
+    while ( totalSize > limit && !usage.empty() ){
+        remove(usage.back());
+    }
+}
+
 // Class LockedFileIOSessionPrivate
 // --------------------------------------------------
 
@@ -61,8 +163,12 @@ public:
     QReadWriteLock* getLock(const std::string& path);
     void releaseLock(const std::string& path);
 
+    LockedFileIOSession::ContentPtr readContent(const std::string& path);
+
     std::unordered_map<std::string, FileLock*> m_locks;
     QMutex* m_locksMutex;
+
+    FileContentCache m_cache;
 };
 
 QReadWriteLock *LockedFileIOSessionPrivate::getLock(const std::string &path){
@@ -99,6 +205,24 @@ void LockedFileIOSessionPrivate::releaseLock(const std::string &path){
     m_locksMutex->unlock();
 }
 
+LockedFileIOSession::ContentPtr LockedFileIOSessionPrivate::readContent(const std::string &path){
+    QFile file(QString::fromStdString(path));
+    if ( !file.open(QIODevice::ReadOnly) )
+        return nullptr;
+
+    qint64 size = file.size();
+    if ( size <= 0 )
+        return LockedFileIOSession::ContentPtr(new std::string(file.readAll().toStdString()));
+
+    uchar* mapped = file.map(0, size);
+    if ( !mapped )
+        return LockedFileIOSession::ContentPtr(new std::string(file.readAll().toStdString()));
+
+    LockedFileIOSession::ContentPtr content(new std::string(reinterpret_cast<const char*>(mapped), static_cast<size_t>(size)));
+    file.unmap(mapped);
+    return content;
+}
+
 // Class LockedFileIOSession
 // --------------------------------------------------
 
@@ -137,23 +261,81 @@ LockedFileIOSession::Ptr LockedFileIOSession::createInstance(){
  * If not, an empty string is returned.
  */
 std::string LockedFileIOSession::readFromFile(const std::string &path){
+    ContentPtr content = readSharedFromFile(path);
+    return content ? *content : std::string();
+}
+
+/**
+ * \brief Returns the content of the file at \p path, shared with the session's cache
+ *
+ * The content is returned from the cache if the file didn't change since it was read. Otherwise the file is
+ * read under a read lock and cached. Returns null if the file cannot be opened.
+ */
+LockedFileIOSession::ContentPtr LockedFileIOSession::readSharedFromFile(const std::string &path){
+    QFileInfo finfo(QString::fromStdString(path));
+    long long modified = finfo.lastModified().toMSecsSinceEpoch();
+    long long size     = finfo.size();
+
+    {
+        QMutexLocker cacheLock(&m_d->m_cache.mutex);
+        ContentPtr content = m_d->m_cache.find(path, modified, size);
+        if ( content )
+            return content;
+    }
+
     m_d->getLock(path)->lockForRead();
+    ContentPtr content = m_d->readContent(path);
+    m_d->releaseLock(path);
 
-    std::ifstream instream(path, std::ifstream::in | std::ifstream::binary);
-    if ( !instream.is_open() ){
+    if ( !content ){
         qCritical("Cannot open file: %s", path.c_str());
-        m_d->releaseLock(path);
-        return "";
+        return nullptr;
     }
 
-    instream.seekg(0, std::ios::end);
-    size_t size = static_cast<size_t>(instream.tellg());
-    std::string buffer(size, ' ');
-    instream.seekg(0);
-    instream.read(&buffer[0], size);
+    // only cache content if the file was unchanged while reading
+    if ( static_cast<long long>(content->size()) == size ){
+        QMutexLocker cacheLock(&m_d->m_cache.mutex);
+        m_d->m_cache.insert(path, content, modified, size);
+    }
 
-    m_d->releaseLock(path);
-    return buffer;
+    return content;
+}
+
+/**
+ * \brief Reads the files at \p paths in parallel, and returns their contents in the same order
+ *
+ * Files that cannot be opened have null contents. Contents are cached, so this can also be used to prefetch
+ * files that are later read one by one.
+ */
+std::vector<LockedFileIOSession::ContentPtr> LockedFileIOSession::readFromFiles(const std::vector<std::string> &paths){
+    std::vector<ContentPtr> result(paths.size());
+
+    size_t threadCount = std::min<size_t>(std::max<unsigned int>(std::thread::hardware_concurrency(), 1), 4);
+    threadCount = std::min(threadCount, paths.size());
+
+    if ( threadCount <= 1 ){
+        for ( size_t i = 0; i < paths.size(); ++i )
+            result[i] = readSharedFromFile(paths[i]);
+        return result;
+    }
+
+    std::atomic<size_t> next(0);
+    auto work = [this, &paths, &result, &next](){
+        size_t index;
+        while ( (index = next++) < paths.size() ){
+            result[index] = readSharedFromFile(paths[index]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for ( size_t i = 1; i < threadCount; ++i )
+        threads.push_back(std::thread(work));
+    work();
+
+    for ( auto it = threads.begin(); it != threads.end(); ++it )
+        it->join();
+
+    return result;
 }
 
 /**
@@ -180,8 +362,49 @@ bool LockedFileIOSession::writeToFile(const std::string &path, const char *data,
     fileInput.write(data, static_cast<int>(length));
     fileInput.close();
 
+    {
+        QMutexLocker cacheLock(&m_d->m_cache.mutex);
+        m_d->m_cache.remove(path);
+    }
+
     m_d->releaseLock(path);
     return true;
 }
 
+/**
+ * \brief Returns the maximum number of bytes kept in the content cache
+ */
+size_t LockedFileIOSession::cacheLimit() const{
+    QMutexLocker cacheLock(&m_d->m_cache.mutex);
+    return m_d->m_cache.limit;
+}
+
+/**
+ * \brief Sets the maximum number of bytes kept in the content cache, removing the least recently used entries
+ * if required
+ *
+ * A limit of 0 disables caching.
+ */
+void LockedFileIOSession::setCacheLimit(size_t limit){
+    QMutexLocker cacheLock(&m_d->m_cache.mutex);
+    m_d->m_cache.limit = limit;
+    m_d->m_cache.shrink();
+}
+
+/**
+ * \brief Returns the number of bytes currently cached
+ */
+size_t LockedFileIOSession::cacheSize() const{
+    QMutexLocker cacheLock(&m_d->m_cache.mutex);
+    return m_d->m_cache.totalSize;
+}
+
+/**
+ * \brief Removes all cached content
+ */
+void LockedFileIOSession::clearCache(){
+    QMutexLocker cacheLock(&m_d->m_cache.mutex);
+    m_d->m_cache.clear();
+}
+
 }// namespace
@@ -20,6 +20,7 @@
 #include "live/lvbaseglobal.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace lv{
 
@@ -33,6 +34,11 @@ class LV_BASE_EXPORT LockedFileIOSession{
 public:
     /** Shared pointer to this class */
     typedef std::shared_ptr<LockedFileIOSession> Ptr;
+    /** Shared, immutable file content */
+    typedef std::shared_ptr<const std::string> ContentPtr;
+
+    /** Default size limit of cached content, in bytes */
+    static const size_t DefaultCacheLimit = 64 * 1024 * 1024;
 
 public:
     ~LockedFileIOSession();
@@ -40,9 +46,17 @@ public:
     static LockedFileIOSession::Ptr createInstance();
 
     std::string readFromFile(const std::string& path);
+    ContentPtr readSharedFromFile(const std::string& path);
+    std::vector<ContentPtr> readFromFiles(const std::vector<std::string>& paths);
+
     bool writeToFile(const std::string& path, const std::string& data);
     bool writeToFile(const std::string& path, const char* data, size_t length);
 
+    size_t cacheLimit() const;
+    void setCacheLimit(size_t limit);
+    size_t cacheSize() const;
+    void clearCache();
+
 private:
     LockedFileIOSession();
 
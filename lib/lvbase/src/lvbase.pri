@@ -12,6 +12,13 @@ HEADERS += \
     $$PWD/applicationcontext.h \
     $$PWD/mlnode.h \
     $$PWD/mlnodetojson.h \
+    $$PWD/mldocument.h \
+    $$PWD/mlnodetobinary.h \
+    $$PWD/mljsonview.h \
+    $$PWD/manifestcache.h \
+    $$PWD/librarypreloader.h \
+    $$PWD/trace.h \
+    $$PWD/dependencygraph.h \
     $$PWD/typename.h \
     $$PWD/visuallog.h \
     $$PWD/indextuple.h \
@@ -34,6 +41,13 @@ SOURCES += \
     $$PWD/applicationcontext.cpp \
     $$PWD/mlnode.cpp \
     $$PWD/mlnodetojson.cpp \
+    $$PWD/mldocument.cpp \
+    $$PWD/mlnodetobinary.cpp \
+    $$PWD/mljsonview.cpp \
+    $$PWD/manifestcache.cpp \
+    $$PWD/librarypreloader.cpp \
+    $$PWD/trace.cpp \
+    $$PWD/dependencygraph.cpp \
     $$PWD/libraryloadpath.cpp \
     $$PWD/typename.cpp \
     $$PWD/visuallog.cpp \
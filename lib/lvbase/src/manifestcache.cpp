@@ -0,0 +1,200 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "manifestcache.h"
+#include "live/mlnodetobinary.h"
+#include "live/applicationcontext.h"
+#include "live/exception.h"
+#include "live/visuallog.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+
+namespace lv{
+
+/**
+ * \class lv::ManifestCache
+ * \brief Cache of parsed package and plugin manifests, keyed by file path
+ *
+ * Each entry stores the modification time and size of the manifest file at the time it was parsed. Lookups stat
+ * the file and discard the entry if either changed, so only a stat is required for each unchanged manifest.
+ *
+ * The cache can be persisted between runs in binary format (see ml::toBinary). Cache files that are missing,
+ * corrupt or written with a different FormatVersion are ignored.
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Default constructor
+ */
+ManifestCache::ManifestCache()
+    : m_isModified(false)
+{
+}
+
+/**
+ * \brief Destructor
+ */
+ManifestCache::~ManifestCache(){
+}
+
+/**
+ * \brief Retrieves the cached \p manifest for \p filePath
+ *
+ * Returns false if the manifest was not cached, or if the file was changed or removed since.
+ */
+bool ManifestCache::lookup(const std::string &filePath, MLNode &manifest){
+    auto it = m_entries.find(filePath);
+    if ( it == m_entries.end() )
+        return false;
+
+    long long modified = 0, size = 0;
+    if ( !fileStamp(filePath, modified, size) || it->second.modified != modified || it->second.size != size ){
+        m_entries.erase(it);
+        m_isModified = true;
+        return false;
+    }
+
+    manifest = it->second.manifest;
+    return true;
+}
+
+/**
+ * \brief Stores the parsed \p manifest of \p filePath, together with the current file stamp
+ */
+void ManifestCache::store(const std::string &filePath, const MLNode &manifest){
+    Entry entry;
+    if ( !fileStamp(filePath, entry.modified, entry.size) )
+        return;
+
+    entry.manifest = manifest;
+    m_entries[filePath] = entry;
+    m_isModified = true;
+}
+
+/**
+ * \brief Removes the entry for \p filePath
+ */
+void ManifestCache::remove(const std::string &filePath){
+    if ( m_entries.erase(filePath) )
+        m_isModified = true;
+}
+
+/**
+ * \brief Removes all entries
+ */
+void ManifestCache::clear(){
+    if ( !m_entries.empty() )
+        m_isModified = true;
+    m_entries.clear();
+}
+
+/**
+ * \brief Loads entries from \p cacheFilePath, replacing the current ones
+ *
+ * Returns false and leaves the cache empty if the file cannot be used.
+ */
+bool ManifestCache::load(const std::string &cacheFilePath){
+    m_entries.clear();
+    m_isModified = false;
+
+    QFile file(QString::fromStdString(cacheFilePath));
+    if ( !file.open(QIODevice::ReadOnly) )
+        return false;
+
+    QByteArray content = file.readAll();
+    if ( !ml::isBinary(content.constData(), static_cast<size_t>(content.size())) )
+        return false;
+
+    try{
+        MLNode root;
+        ml::fromBinary(content.constData(), static_cast<size_t>(content.size()), root);
+
+        if ( root.type() != MLNode::Object || !root.hasKey("version") || root["version"].asInt() != FormatVersion )
+            return false;
+
+        const MLNode::ObjectType& entries = root["entries"].asObject();
+        for ( auto it = entries.begin(); it != entries.end(); ++it ){
+            Entry entry;
+            entry.modified = it->second["modified"].asLongInt();
+            entry.size     = it->second["size"].asLongInt();
+            entry.manifest = it->second["manifest"];
+            m_entries[it->first] = entry;
+        }
+    } catch ( lv::Exception& e ){
+        vlog("lvbase-manifestcache").w() << "Ignoring manifest cache \'" << cacheFilePath << "\': " << e.message();
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Writes all entries to \p cacheFilePath, creating its directory if required
+ *
+ * Throws an lv::Exception if the file cannot be written.
+ */
+void ManifestCache::save(const std::string &cacheFilePath){
+    MLNode entries(MLNode::Object);
+    for ( auto it = m_entries.begin(); it != m_entries.end(); ++it ){
+        entries[it->first] = {
+            {"modified", static_cast<MLNode::IntType>(it->second.modified)},
+            {"size", static_cast<MLNode::IntType>(it->second.size)},
+            {"manifest", it->second.manifest}
+        };
+    }
+
+    MLNode root = {
+        {"version", FormatVersion},
+        {"entries", entries}
+    };
+
+    std::string serialized;
+    ml::toBinary(root, serialized);
+
+    QFileInfo finfo(QString::fromStdString(cacheFilePath));
+    QDir().mkpath(finfo.path());
+
+    QFile file(finfo.filePath());
+    if ( !file.open(QIODevice::WriteOnly) )
+        THROW_EXCEPTION(lv::Exception, "Failed to write manifest cache: " + cacheFilePath, Exception::toCode("~File"));
+
+    file.write(serialized.data(), static_cast<qint64>(serialized.size()));
+    m_isModified = false;
+}
+
+/**
+ * \brief Returns the default location of the cache file, within the user's application data directory
+ */
+std::string ManifestCache::defaultCacheFilePath(){
+    return ApplicationContext::instance().appDataPath() + "/manifests.cache";
+}
+
+bool ManifestCache::fileStamp(const std::string &filePath, long long &modified, long long &size){
+    QFileInfo finfo(QString::fromStdString(filePath));
+    if ( !finfo.isFile() )
+        return false;
+
+    modified = finfo.lastModified().toMSecsSinceEpoch();
+    size     = finfo.size();
+    return true;
+}
+
+}// namespace
@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LVMANIFESTCACHE_H
+#define LVMANIFESTCACHE_H
+
+#include "live/lvbaseglobal.h"
+#include "live/mlnode.h"
+
+#include <memory>
+#include <string>
+#include <map>
+
+namespace lv{
+
+class LV_BASE_EXPORT ManifestCache{
+
+    DISABLE_COPY(ManifestCache);
+
+public:
+    /** Shared pointer to this class */
+    typedef std::shared_ptr<ManifestCache> Ptr;
+
+    /** Version of the cache file format */
+    static const int FormatVersion = 1;
+
+public:
+    ManifestCache();
+    ~ManifestCache();
+
+    bool lookup(const std::string& filePath, MLNode& manifest);
+    void store(const std::string& filePath, const MLNode& manifest);
+    void remove(const std::string& filePath);
+    void clear();
+
+    bool load(const std::string& cacheFilePath);
+    void save(const std::string& cacheFilePath);
+
+    size_t size() const;
+    bool isModified() const;
+
+    static std::string defaultCacheFilePath();
+
+private:
+    /// \private
+    class Entry{
+    public:
+        long long modified;
+        long long size;
+        MLNode    manifest;
+    };
+
+    static bool fileStamp(const std::string& filePath, long long& modified, long long& size);
+
+    std::map<std::string, Entry> m_entries;
+    bool                         m_isModified;
+};
+
+/**
+ * \brief Returns the number of cached manifests
+ */
+inline size_t ManifestCache::size() const{
+    return m_entries.size();
+}
+
+/**
+ * \brief Checks wether the cache has changed since it was loaded or saved
+ */
+inline bool ManifestCache::isModified() const{
+    return m_isModified;
+}
+
+}// namespace
+
+#endif // LVMANIFESTCACHE_H
@@ -0,0 +1,807 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "live/mldocument.h"
+#include "live/exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace lv{
+
+namespace{
+
+int compareKeys(const MLStringTable::Entry* a, const char* bData, size_t bSize){
+    size_t minSize = std::min(a->size(), bSize);
+    int result = minSize > 0 ? std::memcmp(a->data(), bData, minSize) : 0;
+    if ( result != 0 )
+        return result;
+    return a->size() < bSize ? -1 : (a->size() > bSize ? 1 : 0);
+}
+
+} // namespace
+
+// MLArena
+// ----------------------------------------------------------------------------
+
+/**
+ * \class lv::MLArena
+ * \brief Bump allocator used by lv::MLDocument to store its nodes
+ *
+ * Memory is handed out linearly from large blocks, and is released all at once when the arena is cleared or
+ * destroyed. Destructors of allocated objects are never called, so only trivially destructible types can be stored.
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Constructor with the size of each allocated block
+ */
+MLArena::MLArena(size_t blockSize)
+    : m_blockSize(blockSize)
+{
+}
+
+/**
+ * \brief Move constructor. The \p other arena is left empty.
+ */
+MLArena::MLArena(MLArena &&other)
+    : m_blocks(std::move(other.m_blocks))
+    , m_blockSize(other.m_blockSize)
+{
+    other.m_blocks.clear();
+}
+
+/**
+ * \brief Destructor, releases all blocks
+ */
+MLArena::~MLArena(){
+    clear();
+}
+
+/**
+ * \brief Move assignment operator. The \p other arena is left empty.
+ */
+MLArena &MLArena::operator=(MLArena &&other){
+    if ( this != &other ){
+        clear();
+        m_blocks    = std::move(other.m_blocks);
+        m_blockSize = other.m_blockSize;
+        other.m_blocks.clear();
+    }
+    return *this;
+}
+
+/**
+ * \brief Allocates \p size bytes aligned to \p alignment
+ *
+ * The \p alignment has to be a power of 2.
+ */
+void *MLArena::allocate(size_t size, size_t alignment){
+    if ( !m_blocks.empty() ){
+        Block& b = m_blocks.back();
+        size_t offset = (b.used + alignment - 1) & ~(alignment - 1);
+        if ( offset + size <= b.size ){
+            b.used = offset + size;
+            return b.data + offset;
+        }
+    }
+
+    appendBlock(size + alignment);
+
+    Block& b = m_blocks.back();
+    size_t offset = (reinterpret_cast<size_t>(b.data) + alignment - 1) & ~(alignment - 1);
+    offset -= reinterpret_cast<size_t>(b.data);
+    b.used = offset + size;
+    return b.data + offset;
+}
+
+/**
+ * \brief Makes sure at least \p size bytes can be allocated without creating a new block
+ */
+void MLArena::reserve(size_t size){
+    if ( !m_blocks.empty() && m_blocks.back().size - m_blocks.back().used >= size )
+        return;
+    appendBlock(size);
+}
+
+/**
+ * \brief Releases all allocated memory
+ */
+void MLArena::clear(){
+    for ( auto it = m_blocks.begin(); it != m_blocks.end(); ++it )
+        delete[] it->data;
+    m_blocks.clear();
+}
+
+/**
+ * \brief Returns the total number of bytes reserved by this arena
+ */
+size_t MLArena::totalAllocated() const{
+    size_t result = 0;
+    for ( auto it = m_blocks.begin(); it != m_blocks.end(); ++it )
+        result += it->size;
+    return result;
+}
+
+/**
+ * \brief Returns the total number of bytes handed out by this arena
+ */
+size_t MLArena::totalUsed() const{
+    size_t result = 0;
+    for ( auto it = m_blocks.begin(); it != m_blocks.end(); ++it )
+        result += it->used;
+    return result;
+}
+
+void MLArena::appendBlock(size_t minimumSize){
+    Block b;
+    b.size = std::max(minimumSize, m_blockSize);
+    b.data = new char[b.size];
+    b.used = 0;
+    m_blocks.push_back(b);
+}
+
+// MLStringTable
+// ----------------------------------------------------------------------------
+
+/**
+ * \class lv::MLStringTable
+ * \brief Table of interned strings, used by lv::MLDocument to store object keys once
+ *
+ * A table can be shared between multiple documents that use the same set of keys.
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Default constructor
+ */
+MLStringTable::MLStringTable(){
+}
+
+/**
+ * \brief Destructor
+ */
+MLStringTable::~MLStringTable(){
+}
+
+/**
+ * \brief Returns the interned entry for the given string, adding it to the table if required
+ *
+ * Returned entries stay valid for the lifetime of the table.
+ */
+const MLStringTable::Entry *MLStringTable::intern(const char *data, size_t size){
+    return intern(std::string(data, size));
+}
+
+/**
+ * \brief Overload of lv::MLStringTable::intern for std::string
+ */
+const MLStringTable::Entry *MLStringTable::intern(const std::string &str){
+    auto it = m_entries.find(str);
+    if ( it != m_entries.end() )
+        return &it->second;
+
+    auto result = m_entries.emplace(str, Entry());
+    result.first->second.m_data = result.first->first.c_str();
+    result.first->second.m_size = result.first->first.size();
+    return &result.first->second;
+}
+
+/**
+ * \brief Returns the entry for the given string, or nullptr if the string was not interned
+ */
+const MLStringTable::Entry *MLStringTable::find(const std::string &str) const{
+    auto it = m_entries.find(str);
+    if ( it == m_entries.end() )
+        return nullptr;
+    return &it->second;
+}
+
+/**
+ * \brief Returns the number of interned strings
+ */
+size_t MLStringTable::size() const{
+    return m_entries.size();
+}
+
+// MLDocument::Node
+// ----------------------------------------------------------------------------
+
+/**
+ * \class lv::MLDocument::Node
+ * \brief Compact, read-only node stored within an lv::MLDocument
+ *
+ * Provides the same accessors as lv::MLNode for reading. Nodes are only valid while the document that created
+ * them is alive.
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Default constructor, creates a Null node
+ */
+MLDocument::Node::Node()
+    : m_type(MLNode::Null)
+    , m_flags(0)
+    , m_size(0)
+{
+    m_value.asInt = 0;
+}
+
+/**
+ * \brief Indicates if the node is of Null type.
+ */
+bool MLDocument::Node::isNull() const{
+    return m_type == MLNode::Null;
+}
+
+/**
+ * \brief Returns the node value as int.
+ *
+ * If not the appropriate type, an exception is thrown.
+ */
+int MLDocument::Node::asInt() const{
+    return static_cast<int>(asLongInt());
+}
+
+/**
+ * \brief Returns the node value as a MLNode::IntType
+ *
+ * If not the appropriate type, an exception is thrown.
+ */
+MLNode::IntType MLDocument::Node::asLongInt() const{
+    if ( m_type != MLNode::Integer )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of integer type.", 0);
+    return m_value.asInt;
+}
+
+/**
+ * \brief Returns the node value as bool.
+ *
+ * Throws exception if node is not of bool type.
+ */
+bool MLDocument::Node::asBool() const{
+    if ( m_type != MLNode::Boolean )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of boolean type.", 0);
+    return m_value.asBool;
+}
+
+/**
+ * \brief Returns the node value as float.
+ *
+ * Throws exception if node is not of float type.
+ */
+MLNode::FloatType MLDocument::Node::asFloat() const{
+    if ( m_type != MLNode::Float )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of float type.", 0);
+    return m_value.asFloat;
+}
+
+/**
+ * \brief Returns a copy of the node value as string.
+ *
+ * Throws exception if node is not of string type. Use stringData() and stringSize() to avoid the copy.
+ */
+std::string MLDocument::Node::asString() const{
+    if ( m_type != MLNode::String )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of string type.", 0);
+    return std::string(stringData(), m_size);
+}
+
+/**
+ * \brief Returns a copy of the node value as bytes.
+ *
+ * Similar to lv::MLNode::asBytes, string nodes are decoded from base64.
+ */
+MLNode::BytesType MLDocument::Node::asBytes() const{
+    if ( m_type == MLNode::Bytes ){
+        return MLNode::BytesType(const_cast<MLNode::ByteType*>(m_value.asBytes), m_size);
+    } else if ( m_type == MLNode::String ){
+        return MLNode::BytesType::fromBase64(asString());
+    } else
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of bytes type.", 0);
+}
+
+/**
+ * \brief Returns the size of the string stored in this node
+ */
+size_t MLDocument::Node::stringSize() const{
+    if ( m_type != MLNode::String )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of string type.", 0);
+    return m_size;
+}
+
+/**
+ * \brief Returns the bytes stored in this node without copying them
+ */
+const MLNode::ByteType *MLDocument::Node::bytesData() const{
+    if ( m_type != MLNode::Bytes )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of bytes type.", 0);
+    return m_value.asBytes;
+}
+
+/**
+ * \brief Returns the number of bytes stored in this node
+ */
+size_t MLDocument::Node::bytesSize() const{
+    if ( m_type != MLNode::Bytes )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of bytes type.", 0);
+    return m_size;
+}
+
+/**
+ * \brief Returns the number of elements in an Array node, or the number of members in an Object node.
+ *
+ * Zero is returned for other types.
+ */
+int MLDocument::Node::size() const{
+    if ( m_type == MLNode::Array || m_type == MLNode::Object )
+        return static_cast<int>(m_size);
+    return 0;
+}
+
+/**
+ * \brief Returns an indicator that the given key is found in this Object node.
+ *
+ * If the node is not an Object, an exception is thrown.
+ */
+bool MLDocument::Node::hasKey(const std::string &key) const{
+    return find(key.c_str(), key.size()) != nullptr;
+}
+
+/**
+ * \brief Returns the value stored under \p key, or nullptr if there's no such key.
+ *
+ * Members are sorted by key, so the lookup is a binary search. If the node is not an Object, an exception is thrown.
+ */
+const MLDocument::Node *MLDocument::Node::find(const char *key, size_t keySize) const{
+    if ( m_type != MLNode::Object )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of object type.", 0);
+
+    const Member* first = m_value.asObject;
+    size_t count = m_size;
+    while ( count > 0 ){
+        size_t step = count / 2;
+        const Member* mid = first + step;
+        int cmp = compareKeys(mid->m_key, key, keySize);
+        if ( cmp == 0 )
+            return &mid->m_value;
+        if ( cmp < 0 ){
+            first = mid + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * \brief Index operator of Object nodes. Returns a Null node if the key is not found.
+ *
+ * If used on a non-Object type, throws an exception.
+ */
+const MLDocument::Node &MLDocument::Node::operator[](const std::string &key) const{
+    static const Node nullNode;
+    if ( m_type != MLNode::Object )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of object type. Requested key: " + key, 0);
+
+    const Node* result = find(key.c_str(), key.size());
+    return result ? *result : nullNode;
+}
+
+/**
+ * \brief Index operator of Array nodes.
+ *
+ * Throws an exception if the node is not an Array, or if the index is out of range.
+ */
+const MLDocument::Node &MLDocument::Node::operator[](int index) const{
+    if ( m_type != MLNode::Array )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of array type. Requested index: " + std::to_string(index), 0);
+    if ( index < 0 || static_cast<unsigned int>(index) >= m_size )
+        THROW_EXCEPTION(MLOutOfRanceException, "Index out of range: " + std::to_string(index), 0);
+
+    return m_value.asArray[index];
+}
+
+/**
+ * \brief Returns the member at \p index of an Object node. Members are ordered by key.
+ *
+ * Throws an exception if the node is not an Object, or if the index is out of range.
+ */
+const MLDocument::Member &MLDocument::Node::memberAt(int index) const{
+    if ( m_type != MLNode::Object )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of object type. Requested index: " + std::to_string(index), 0);
+    if ( index < 0 || static_cast<unsigned int>(index) >= m_size )
+        THROW_EXCEPTION(MLOutOfRanceException, "Index out of range: " + std::to_string(index), 0);
+
+    return m_value.asObject[index];
+}
+
+/**
+ * \brief Returns a string representation of the node type.
+ */
+std::string MLDocument::Node::typeString() const{
+    return MLNode(type()).typeString();
+}
+
+/**
+ * \brief Returns a string representation of this node. See lv::MLNode::toString.
+ */
+std::string MLDocument::Node::toString(int indent, int indentStep) const{
+    return toMLNode().toString(indent, indentStep);
+}
+
+/**
+ * \brief Creates a heap-allocated lv::MLNode copy of this node.
+ */
+MLNode MLDocument::Node::toMLNode() const{
+    switch(m_type){
+    case MLNode::Null:    return MLNode();
+    case MLNode::Boolean: return MLNode(m_value.asBool);
+    case MLNode::Integer: return MLNode(m_value.asInt);
+    case MLNode::Float:   return MLNode(m_value.asFloat);
+    case MLNode::String:  return MLNode(std::string(stringData(), m_size));
+    case MLNode::Bytes:   return MLNode(const_cast<MLNode::ByteType*>(m_value.asBytes), m_size);
+    case MLNode::Array: {
+        MLNode result(MLNode::Array);
+        MLNode::ArrayType& arr = result.asArray();
+        arr.reserve(m_size);
+        for ( unsigned int i = 0; i < m_size; ++i )
+            arr.push_back(m_value.asArray[i].toMLNode());
+        return result;
+    }
+    case MLNode::Object: {
+        MLNode result(MLNode::Object);
+        for ( unsigned int i = 0; i < m_size; ++i ){
+            const Member& m = m_value.asObject[i];
+            result[m.m_key->toString()] = m.m_value.toMLNode();
+        }
+        return result;
+    }
+    }
+    return MLNode();
+}
+
+// MLDocument::Member
+// ----------------------------------------------------------------------------
+
+/**
+ * \class lv::MLDocument::Member
+ * \brief Key-value pair stored within an Object lv::MLDocument::Node
+ *
+ * \ingroup lvbase
+ */
+
+// MLDocument
+// ----------------------------------------------------------------------------
+
+/**
+ * \class lv::MLDocument
+ * \brief Arena-backed, compact alternative to an lv::MLNode tree
+ *
+ * An lv::MLNode allocates each object map, array and string separately on the heap. An MLDocument stores
+ * all of its nodes in a single lv::MLArena instead:
+ *
+ *  - Nodes are 16 bytes, and strings of up to 8 bytes are stored inline within the node.
+ *  - Arrays are stored as contiguous vectors of nodes.
+ *  - Objects are stored as contiguous vectors of members sorted by key, so lookups are binary searches.
+ *  - Keys are interned in an lv::MLStringTable, which can be shared between documents.
+ *
+ * Documents are built once (from an lv::MLNode, from json, or through the create functions), then read through
+ * the same accessors as lv::MLNode. Releasing a document releases all of its nodes at once.
+ *
+ * ```
+ * MLDocument doc;
+ * ml::fromJson(data, doc);
+ * int width = doc.root()["size"][0].asInt();
+ * ```
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Constructor with its own key table
+ */
+MLDocument::MLDocument(size_t blockSize)
+    : m_arena(blockSize)
+    , m_keys(new MLStringTable)
+{
+}
+
+/**
+ * \brief Constructor with a shared key table
+ */
+MLDocument::MLDocument(const MLStringTable::Ptr &keys, size_t blockSize)
+    : m_arena(blockSize)
+    , m_keys(keys ? keys : MLStringTable::Ptr(new MLStringTable))
+{
+}
+
+/**
+ * \brief Move constructor. The \p other document is left empty.
+ */
+MLDocument::MLDocument(MLDocument &&other)
+    : m_arena(std::move(other.m_arena))
+    , m_keys(other.m_keys)
+    , m_root(other.m_root)
+{
+    other.m_root = Node();
+}
+
+/**
+ * \brief Destructor
+ */
+MLDocument::~MLDocument(){
+}
+
+/**
+ * \brief Move assignment. The \p other document is left empty.
+ */
+MLDocument &MLDocument::operator=(MLDocument &&other){
+    if ( this != &other ){
+        m_arena = std::move(other.m_arena);
+        m_keys  = other.m_keys;
+        m_root  = other.m_root;
+        other.m_root = Node();
+    }
+    return *this;
+}
+
+/**
+ * \brief Replaces the contents of this document with a copy of \p node
+ */
+void MLDocument::assign(const MLNode &node){
+    clear();
+    m_root = convert(node);
+}
+
+/**
+ * \brief Creates a heap-allocated lv::MLNode copy of this document.
+ */
+MLNode MLDocument::toMLNode() const{
+    return m_root.toMLNode();
+}
+
+/**
+ * \brief Releases all nodes in this document. Interned keys are kept.
+ */
+void MLDocument::clear(){
+    m_root = Node();
+    m_arena.clear();
+}
+
+/**
+ * \brief Creates a Null node
+ */
+MLDocument::Node MLDocument::createNull(){
+    return Node();
+}
+
+/**
+ * \brief Creates an Integer node
+ */
+MLDocument::Node MLDocument::createInt(MLNode::IntType value){
+    Node n;
+    n.m_type = MLNode::Integer;
+    n.m_value.asInt = value;
+    return n;
+}
+
+/**
+ * \brief Creates a Float node
+ */
+MLDocument::Node MLDocument::createFloat(MLNode::FloatType value){
+    Node n;
+    n.m_type = MLNode::Float;
+    n.m_value.asFloat = value;
+    return n;
+}
+
+/**
+ * \brief Creates a Boolean node
+ */
+MLDocument::Node MLDocument::createBool(MLNode::BoolType value){
+    Node n;
+    n.m_type = MLNode::Boolean;
+    n.m_value.asBool = value;
+    return n;
+}
+
+/**
+ * \brief Creates a String node. Small strings are stored inline, the others are copied to the arena.
+ */
+MLDocument::Node MLDocument::createString(const char *data, size_t size){
+    Node n;
+    n.m_type = MLNode::String;
+    n.m_size = static_cast<unsigned int>(size);
+    if ( size <= Node::InlineCapacity ){
+        n.m_flags |= Node::InlineString;
+        if ( size > 0 )
+            std::memcpy(n.m_value.asInline, data, size);
+    } else {
+        char* str = m_arena.allocateArray<char>(size + 1);
+        std::memcpy(str, data, size);
+        str[size] = '\0';
+        n.m_value.asString = str;
+    }
+    return n;
+}
+
+/**
+ * \brief Creates a String node pointing to \p data without copying it.
+ *
+ * The \p data has to stay valid for the lifetime of the document, e.g. by being allocated within the
+ * document's arena.
+ */
+MLDocument::Node MLDocument::createStringReference(const char *data, size_t size){
+    Node n;
+    n.m_type = MLNode::String;
+    n.m_size = static_cast<unsigned int>(size);
+    n.m_value.asString = data;
+    return n;
+}
+
+/**
+ * \brief Creates a Bytes node by copying \p data to the arena
+ */
+MLDocument::Node MLDocument::createBytes(const MLNode::ByteType *data, size_t size){
+    Node n;
+    n.m_type = MLNode::Bytes;
+    n.m_size = static_cast<unsigned int>(size);
+    MLNode::ByteType* bytes = m_arena.allocateArray<MLNode::ByteType>(size);
+    if ( size > 0 )
+        std::memcpy(bytes, data, size);
+    n.m_value.asBytes = bytes;
+    return n;
+}
+
+/**
+ * \brief Creates a Bytes node pointing to \p data without copying it.
+ *
+ * The \p data has to stay valid for the lifetime of the document.
+ */
+MLDocument::Node MLDocument::createBytesReference(const MLNode::ByteType *data, size_t size){
+    Node n;
+    n.m_type = MLNode::Bytes;
+    n.m_size = static_cast<unsigned int>(size);
+    n.m_value.asBytes = data;
+    return n;
+}
+
+/**
+ * \brief Creates an Array node by copying \p count \p elements to the arena
+ */
+MLDocument::Node MLDocument::createArray(const MLDocument::Node *elements, size_t count){
+    Node n;
+    n.m_type = MLNode::Array;
+    n.m_size = static_cast<unsigned int>(count);
+    Node* arr = m_arena.allocateArray<Node>(count);
+    if ( count > 0 )
+        std::memcpy(static_cast<void*>(arr), elements, sizeof(Node) * count);
+    n.m_value.asArray = arr;
+    return n;
+}
+
+/**
+ * \brief Creates an Object node by copying \p count \p members to the arena
+ *
+ * Members are sorted by key. For duplicate keys, the last member is kept, same as assigning them in order
+ * to an lv::MLNode.
+ */
+MLDocument::Node MLDocument::createObject(const MLDocument::Member *members, size_t count){
+    Member* obj = m_arena.allocateArray<Member>(count);
+    if ( count > 0 )
+        std::memcpy(static_cast<void*>(obj), members, sizeof(Member) * count);
+
+    bool isSorted = true;
+    for ( size_t i = 1; i < count; ++i ){
+        if ( compareKeys(obj[i - 1].m_key, obj[i].m_key->data(), obj[i].m_key->size()) >= 0 ){
+            isSorted = false;
+            break;
+        }
+    }
+
+    if ( !isSorted ){
+        std::stable_sort(obj, obj + count, [](const Member& a, const Member& b){
+            return compareKeys(a.m_key, b.m_key->data(), b.m_key->size()) < 0;
+        });
+
+        size_t last = 0;
+        for ( size_t i = 1; i < count; ++i ){
+            if ( obj[i].m_key == obj[last].m_key ){
+                obj[last] = obj[i];
+            } else {
+                obj[++last] = obj[i];
+            }
+        }
+        count = last + 1;
+    }
+
+    Node n;
+    n.m_type = MLNode::Object;
+    n.m_size = static_cast<unsigned int>(count);
+    n.m_value.asObject = obj;
+    return n;
+}
+
+/**
+ * \brief Creates a member with an interned \p key, to be passed to createObject()
+ */
+MLDocument::Member MLDocument::createMember(const char *key, size_t keySize, const MLDocument::Node &value){
+    Member m;
+    m.m_key   = m_keys->intern(key, keySize);
+    m.m_value = value;
+    return m;
+}
+
+/**
+ * \brief Creates a member with an already interned \p key
+ *
+ * The key has to be interned in this document's key table.
+ */
+MLDocument::Member MLDocument::createMember(const MLStringTable::Entry *key, const MLDocument::Node &value){
+    Member m;
+    m.m_key   = key;
+    m.m_value = value;
+    return m;
+}
+
+MLDocument::Node MLDocument::convert(const MLNode &node){
+    switch(node.type()){
+    case MLNode::Null:    return createNull();
+    case MLNode::Boolean: return createBool(node.asBool());
+    case MLNode::Integer: return createInt(node.m_value.asInt);
+    case MLNode::Float:   return createFloat(node.asFloat());
+    case MLNode::String:  return createString(node.asString().c_str(), node.asString().size());
+    case MLNode::Bytes: {
+        MLNode::BytesType b = node.asBytes();
+        return createBytes(b.data(), b.size());
+    }
+    case MLNode::Array: {
+        const MLNode::ArrayType& arr = node.asArray();
+        Node n;
+        n.m_type = MLNode::Array;
+        n.m_size = static_cast<unsigned int>(arr.size());
+        Node* elements = m_arena.allocateArray<Node>(arr.size());
+        for ( size_t i = 0; i < arr.size(); ++i )
+            new (elements + i) Node(convert(arr[i]));
+        n.m_value.asArray = elements;
+        return n;
+    }
+    case MLNode::Object: {
+        // std::map keeps keys sorted and unique, so members can be written directly
+        const MLNode::ObjectType& obj = node.asObject();
+        Node n;
+        n.m_type = MLNode::Object;
+        n.m_size = static_cast<unsigned int>(obj.size());
+        Member* members = m_arena.allocateArray<Member>(obj.size());
+        Member* current = members;
+        for ( auto it = obj.begin(); it != obj.end(); ++it ){
+            new (current) Member(createMember(it->first.c_str(), it->first.size(), convert(it->second)));
+            ++current;
+        }
+        n.m_value.asObject = members;
+        return n;
+    }
+    }
+    return Node();
+}
+
+}// namespace
@@ -0,0 +1,300 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LVMLDOCUMENT_H
+#define LVMLDOCUMENT_H
+
+#include "live/lvbaseglobal.h"
+#include "live/mlnode.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace lv{
+
+// MLArena
+// -------
+
+class LV_BASE_EXPORT MLArena{
+
+    DISABLE_COPY(MLArena);
+
+public:
+    /** Default size of a newly allocated block */
+    static const size_t DefaultBlockSize = 16 * 1024;
+
+public:
+    explicit MLArena(size_t blockSize = DefaultBlockSize);
+    MLArena(MLArena&& other);
+    ~MLArena();
+
+    MLArena& operator=(MLArena&& other);
+
+    void* allocate(size_t size, size_t alignment = sizeof(void*));
+    template<typename T> T* allocateArray(size_t count);
+
+    void reserve(size_t size);
+    void clear();
+
+    size_t totalAllocated() const;
+    size_t totalUsed() const;
+
+private:
+    struct Block{
+        char*  data;
+        size_t size;
+        size_t used;
+    };
+
+    void appendBlock(size_t minimumSize);
+
+    std::vector<Block> m_blocks;
+    size_t             m_blockSize;
+};
+
+/**
+ * \brief Allocates an uninitialized array of \p count elements of type T
+ *
+ * T is required to be trivially destructible, since the arena never runs destructors.
+ */
+template<typename T> T *MLArena::allocateArray(size_t count){
+    return reinterpret_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+}
+
+// MLStringTable
+// -------------
+
+class LV_BASE_EXPORT MLStringTable{
+
+    DISABLE_COPY(MLStringTable);
+
+public:
+    /** Shared pointer to this class */
+    typedef std::shared_ptr<MLStringTable> Ptr;
+
+    /**
+     * \class lv::MLStringTable::Entry
+     * \brief Interned string. Entries from the same table can be compared by pointer.
+     */
+    class Entry{
+
+        friend class MLStringTable;
+
+    public:
+        /** Returns the string data (null-terminated) */
+        const char* data() const{ return m_data; }
+        /** Returns the string size */
+        size_t size() const{ return m_size; }
+        /** Returns a copy of the string */
+        std::string toString() const{ return std::string(m_data, m_size); }
+
+    private:
+        const char* m_data;
+        size_t      m_size;
+    };
+
+public:
+    MLStringTable();
+    ~MLStringTable();
+
+    const Entry* intern(const char* data, size_t size);
+    const Entry* intern(const std::string& str);
+    const Entry* find(const std::string& str) const;
+
+    size_t size() const;
+
+private:
+    std::unordered_map<std::string, Entry> m_entries;
+};
+
+// MLDocument
+// ----------
+
+class LV_BASE_EXPORT MLDocument{
+
+    DISABLE_COPY(MLDocument);
+
+public:
+    class Member;
+
+    // MLDocument::Node
+    // ----------------
+
+    class LV_BASE_EXPORT Node{
+
+        friend class MLDocument;
+
+    public:
+        Node();
+
+        MLNode::Type type() const;
+
+        bool isNull() const;
+        int asInt() const;
+        MLNode::IntType asLongInt() const;
+        bool asBool() const;
+        MLNode::FloatType asFloat() const;
+        std::string asString() const;
+        MLNode::BytesType asBytes() const;
+
+        const char* stringData() const;
+        size_t stringSize() const;
+        const MLNode::ByteType* bytesData() const;
+        size_t bytesSize() const;
+
+        int size() const;
+        bool hasKey(const std::string& key) const;
+        const Node* find(const char* key, size_t keySize) const;
+
+        const Node& operator[](const std::string& key) const;
+        const Node& operator[](int index) const;
+        const Member& memberAt(int index) const;
+
+        std::string typeString() const;
+        std::string toString(int indent = -1, int indentStep = 4) const;
+        MLNode toMLNode() const;
+
+    private:
+        enum Flags{
+            InlineString = 1
+        };
+
+        /** Largest string stored inside the node itself */
+        static const size_t InlineCapacity = sizeof(void*) > 8 ? sizeof(void*) : 8;
+
+        unsigned char m_type;
+        unsigned char m_flags;
+        unsigned int  m_size;
+        union{
+            MLNode::IntType         asInt;
+            MLNode::FloatType       asFloat;
+            MLNode::BoolType        asBool;
+            const char*             asString;
+            const MLNode::ByteType* asBytes;
+            const Node*             asArray;
+            const Member*           asObject;
+            char                    asInline[InlineCapacity];
+        } m_value;
+    };
+
+    // MLDocument::Member
+    // ------------------
+
+    class LV_BASE_EXPORT Member{
+
+        friend class MLDocument;
+
+    public:
+        /** Returns the key of this member as a string */
+        std::string key() const{ return m_key->toString(); }
+        /** Returns the interned key of this member */
+        const MLStringTable::Entry* keyEntry() const{ return m_key; }
+        /** Returns the value of this member */
+        const Node& value() const{ return m_value; }
+
+    private:
+        const MLStringTable::Entry* m_key;
+        Node                        m_value;
+    };
+
+public:
+    explicit MLDocument(size_t blockSize = MLArena::DefaultBlockSize);
+    explicit MLDocument(const MLStringTable::Ptr& keys, size_t blockSize = MLArena::DefaultBlockSize);
+    MLDocument(MLDocument&& other);
+    ~MLDocument();
+
+    MLDocument& operator=(MLDocument&& other);
+
+    const Node& root() const;
+    void setRoot(const Node& node);
+
+    void assign(const MLNode& node);
+    MLNode toMLNode() const;
+    void clear();
+
+    static Node createNull();
+    static Node createInt(MLNode::IntType value);
+    static Node createFloat(MLNode::FloatType value);
+    static Node createBool(MLNode::BoolType value);
+    Node createString(const char* data, size_t size);
+    Node createStringReference(const char* data, size_t size);
+    Node createBytes(const MLNode::ByteType* data, size_t size);
+    Node createBytesReference(const MLNode::ByteType* data, size_t size);
+    Node createArray(const Node* elements, size_t count);
+    Node createObject(const Member* members, size_t count);
+    Member createMember(const char* key, size_t keySize, const Node& value);
+    Member createMember(const MLStringTable::Entry* key, const Node& value);
+
+    MLArena& arena();
+    const MLStringTable::Ptr& keys() const;
+
+private:
+    Node convert(const MLNode& node);
+
+    MLArena            m_arena;
+    MLStringTable::Ptr m_keys;
+    Node               m_root;
+};
+
+/**
+ * \brief Returns the root node of this document
+ */
+inline const MLDocument::Node &MLDocument::root() const{
+    return m_root;
+}
+
+/**
+ * \brief Sets the root node of this document
+ *
+ * The node has to be created by this document.
+ */
+inline void MLDocument::setRoot(const MLDocument::Node &node){
+    m_root = node;
+}
+
+/**
+ * \brief Returns the arena allocator of this document
+ */
+inline MLArena &MLDocument::arena(){
+    return m_arena;
+}
+
+/**
+ * \brief Returns the table used to intern object keys
+ */
+inline const MLStringTable::Ptr &MLDocument::keys() const{
+    return m_keys;
+}
+
+/**
+ * \brief Returns the type of this node
+ */
+inline MLNode::Type MLDocument::Node::type() const{
+    return static_cast<MLNode::Type>(m_type);
+}
+
+/**
+ * \brief Returns a pointer to the string contents of this node, which is not null-terminated
+ */
+inline const char *MLDocument::Node::stringData() const{
+    return (m_flags & InlineString) ? m_value.asInline : m_value.asString;
+}
+
+}// namespace
+
+#endif // LVMLDOCUMENT_H
@@ -0,0 +1,526 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "mljsonview.h"
+#include "live/mlnodetojson.h"
+#include "live/exception.h"
+
+#include <cstring>
+
+#include <QFile>
+
+/*
+ * Indexing is done in a single pass over the buffer, without unescaping strings or converting numbers. Each value
+ * gets one token, and each closing bracket gets its own token. For containers, the token stores the index of its
+ * closing bracket, so siblings can be skipped in constant time:
+ *
+ *   {"a":[1,2],"b":"x"}
+ *   ^ ^  ^ ^ ^ ^   ^   ^
+ *   0 1  2 3 4 5 6 7   8      tokens: { "a" [ 1 2 ] "b" "x" }
+ *
+ * Values are only decoded when they are accessed.
+ */
+
+namespace lv{
+
+// MLJsonViewPrivate
+// -----------------
+
+class MLJsonViewPrivate{
+
+public:
+    MLJsonViewPrivate() : mapped(nullptr){}
+
+    std::string            owned;
+    std::unique_ptr<QFile> file;
+    uchar*                 mapped;
+};
+
+namespace{
+
+inline bool isWhitespace(char c){
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isDelimiter(char c){
+    return c == ',' || c == ']' || c == '}' || c == ':' || isWhitespace(c);
+}
+
+/** Returns the position after the closing quote of the string starting at \p position. */
+size_t skipString(const char* data, size_t size, size_t position){
+    size_t current = position + 1;
+    while ( current < size ){
+        const char* quote = static_cast<const char*>(std::memchr(data + current, '"', size - current));
+        if ( !quote )
+            break;
+
+        size_t quotePosition = static_cast<size_t>(quote - data);
+        size_t backslashes = 0;
+        while ( quotePosition - backslashes > position + 1 && data[quotePosition - backslashes - 1] == '\\' )
+            ++backslashes;
+
+        if ( backslashes % 2 == 0 )
+            return quotePosition + 1;
+
+        current = quotePosition + 1;
+    }
+
+    THROW_EXCEPTION(lv::Exception,
+        "Failed to index json: Missing closing quote at " + std::to_string(position), Exception::toCode("Json"));
+}
+
+}// namespace
+
+// MLJsonView
+// ----------
+
+/**
+ * \class lv::MLJsonView
+ * \brief Read-only view over a json buffer, decoding values only when they are accessed
+ *
+ * Creating the view runs a single structural pass over the buffer, which records where each value starts and ends.
+ * Lookups then skip over unrelated subtrees, and only the accessed values are decoded. This makes it suitable for
+ * large files from which only a few fields are read, like package and plugin manifests during a scan.
+ *
+ * \code
+ * MLJsonView::Ptr view = MLJsonView::createFromFile("live.package.json");
+ * std::string name = view->root()["name"].asString();
+ * MLNode dependencies = view->root()["dependencies"].toMLNode();
+ * \endcode
+ *
+ * The indexing pass checks bracket nesting and string termination, but not full json syntax, so malformed scalars
+ * are only reported when they are decoded.
+ *
+ * \ingroup lvbase
+ */
+
+MLJsonView::MLJsonView()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_d(new MLJsonViewPrivate)
+{
+}
+
+/**
+ * \brief Destructor, unmaps the file if the view was created from one
+ */
+MLJsonView::~MLJsonView(){
+    if ( m_d->mapped )
+        m_d->file->unmap(m_d->mapped);
+    delete m_d;
+}
+
+/**
+ * \brief Creates a view over \p data, which is not copied and needs to outlive the view
+ *
+ * Throws an lv::Exception if the buffer is not correctly structured.
+ */
+MLJsonView::Ptr MLJsonView::create(const char *data, size_t size){
+    MLJsonView::Ptr view(new MLJsonView);
+    view->m_data = data;
+    view->m_size = size;
+    view->index();
+    return view;
+}
+
+/**
+ * \brief Creates a view over a copy of \p data
+ *
+ * Throws an lv::Exception if the buffer is not correctly structured.
+ */
+MLJsonView::Ptr MLJsonView::create(const std::string &data){
+    MLJsonView::Ptr view(new MLJsonView);
+    view->m_d->owned = data;
+    view->m_data = view->m_d->owned.data();
+    view->m_size = view->m_d->owned.size();
+    view->index();
+    return view;
+}
+
+/**
+ * \brief Creates a view over the memory-mapped contents of the file at \p path
+ *
+ * Falls back to reading the file if it cannot be mapped. Throws an lv::Exception if the file cannot be opened or
+ * is not correctly structured.
+ */
+MLJsonView::Ptr MLJsonView::createFromFile(const std::string &path){
+    MLJsonView::Ptr view(new MLJsonView);
+
+    view->m_d->file.reset(new QFile(QString::fromStdString(path)));
+    QFile* file = view->m_d->file.get();
+    if ( !file->open(QIODevice::ReadOnly) ){
+        THROW_EXCEPTION(lv::Exception, std::string("Cannot open file: ") + path, 1);
+    }
+
+    qint64 size = file->size();
+    if ( size > 0 ){
+        view->m_d->mapped = file->map(0, size);
+        if ( view->m_d->mapped ){
+            view->m_data = reinterpret_cast<const char*>(view->m_d->mapped);
+            view->m_size = static_cast<size_t>(size);
+        } else {
+            view->m_d->owned = file->readAll().toStdString();
+            view->m_data = view->m_d->owned.data();
+            view->m_size = view->m_d->owned.size();
+            file->close();
+        }
+    }
+
+    view->index();
+    return view;
+}
+
+/**
+ * \brief Returns the root value of this view
+ */
+MLJsonView::Value MLJsonView::root() const{
+    if ( m_tokens.empty() )
+        return Value();
+    return Value(this, 0);
+}
+
+void MLJsonView::index(){
+    m_tokens.clear();
+    m_tokens.reserve(m_size / 8 + 1);
+
+    std::vector<size_t> openContainers;
+    bool hasRoot = false;
+
+    size_t position = 0;
+    while ( position < m_size ){
+        char c = m_data[position];
+        if ( isWhitespace(c) || c == ',' || c == ':' ){
+            ++position;
+            continue;
+        }
+
+        if ( hasRoot && openContainers.empty() ){
+            THROW_EXCEPTION(lv::Exception,
+                "Failed to index json: Unexpected data after root value at " + std::to_string(position),
+                Exception::toCode("Json"));
+        }
+
+        if ( c == '{' || c == '[' ){
+            openContainers.push_back(m_tokens.size());
+            m_tokens.push_back({position, 0});
+            ++position;
+        } else if ( c == '}' || c == ']' ){
+            char expected = c == '}' ? '{' : '[';
+            if ( openContainers.empty() || m_data[m_tokens[openContainers.back()].offset] != expected ){
+                THROW_EXCEPTION(lv::Exception,
+                    "Failed to index json: Unexpected '" + std::string(1, c) + "' at " + std::to_string(position),
+                    Exception::toCode("Json"));
+            }
+            m_tokens[openContainers.back()].end = m_tokens.size();
+            openContainers.pop_back();
+            m_tokens.push_back({position, position + 1});
+            ++position;
+        } else if ( c == '"' ){
+            size_t end = skipString(m_data, m_size, position);
+            m_tokens.push_back({position, end});
+            position = end;
+        } else {
+            size_t end = position + 1;
+            while ( end < m_size && !isDelimiter(m_data[end]) && m_data[end] != '"' )
+                ++end;
+            m_tokens.push_back({position, end});
+            position = end;
+        }
+
+        hasRoot = true;
+    }
+
+    if ( !openContainers.empty() ){
+        THROW_EXCEPTION(lv::Exception,
+            "Failed to index json: Unterminated container at " + std::to_string(m_tokens[openContainers.back()].offset),
+            Exception::toCode("Json"));
+    }
+}
+
+// MLJsonView::Value
+// -----------------
+
+/**
+ * \brief Creates an invalid value, which behaves like null
+ */
+MLJsonView::Value::Value()
+    : m_view(nullptr)
+    , m_token(0)
+{
+}
+
+MLJsonView::Value::Value(const MLJsonView *view, size_t token)
+    : m_view(view)
+    , m_token(token)
+{
+}
+
+/**
+ * \brief Returns the type of this value, determined from its first character
+ */
+MLNode::Type MLJsonView::Value::type() const{
+    if ( !m_view )
+        return MLNode::Null;
+
+    const MLJsonView::Token& t = m_view->m_tokens[m_token];
+    switch( m_view->m_data[t.offset] ){
+    case '{': return MLNode::Object;
+    case '[': return MLNode::Array;
+    case '"': return MLNode::String;
+    case 't':
+    case 'f': return MLNode::Boolean;
+    case 'n': return MLNode::Null;
+    default:
+        for ( size_t i = t.offset; i < t.end; ++i ){
+            char c = m_view->m_data[i];
+            if ( c == '.' || c == 'e' || c == 'E' )
+                return MLNode::Float;
+        }
+        return MLNode::Integer;
+    }
+}
+
+/**
+ * \brief Checks wether this value is null or invalid
+ */
+bool MLJsonView::Value::isNull() const{
+    return type() == MLNode::Null;
+}
+
+/**
+ * \brief Returns the value as an int. Throws InvalidMLTypeException if the value is not an integer.
+ */
+int MLJsonView::Value::asInt() const{
+    return toMLNode().asInt();
+}
+
+/**
+ * \brief Returns the value as a long int. Throws InvalidMLTypeException if the value is not an integer.
+ */
+MLNode::IntType MLJsonView::Value::asLongInt() const{
+    return toMLNode().asLongInt();
+}
+
+/**
+ * \brief Returns the value as a float. Throws InvalidMLTypeException if the value is not a number.
+ */
+MLNode::FloatType MLJsonView::Value::asFloat() const{
+    return toMLNode().asFloat();
+}
+
+/**
+ * \brief Returns the value as a bool. Throws InvalidMLTypeException if the value is not a boolean.
+ */
+bool MLJsonView::Value::asBool() const{
+    return toMLNode().asBool();
+}
+
+/**
+ * \brief Returns the value as a string. Throws InvalidMLTypeException if the value is not a string.
+ *
+ * Strings without escape sequences are copied directly from the buffer.
+ */
+std::string MLJsonView::Value::asString() const{
+    if ( type() == MLNode::String ){
+        const MLJsonView::Token& t = m_view->m_tokens[m_token];
+        const char* begin = m_view->m_data + t.offset + 1;
+        size_t length = t.end - t.offset - 2;
+        if ( !std::memchr(begin, '\\', length) )
+            return std::string(begin, length);
+    }
+    return toMLNode().asString();
+}
+
+/**
+ * \brief Returns the number of elements of an array or members of an object, 0 for other types
+ *
+ * Object members with duplicated keys are counted separately.
+ */
+int MLJsonView::Value::size() const{
+    if ( !isContainer() )
+        return 0;
+
+    const std::vector<MLJsonView::Token>& tokens = m_view->m_tokens;
+    bool isObject = m_view->m_data[tokens[m_token].offset] == '{';
+
+    int count = 0;
+    size_t closing = tokens[m_token].end;
+    size_t current = m_token + 1;
+    while ( current < closing ){
+        if ( isObject )
+            ++current;
+        Value v(m_view, current);
+        current = v.isContainer() ? tokens[current].end + 1 : current + 1;
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * \brief Checks wether this value is an object containing \p key
+ */
+bool MLJsonView::Value::hasKey(const std::string &key) const{
+    return (*this)[key].isValid();
+}
+
+/**
+ * \brief Returns the member at \p key, or an invalid value if this is not an object or the key is missing
+ *
+ * If the key is duplicated, the last occurrence is returned, same as when parsing to an MLNode.
+ */
+MLJsonView::Value MLJsonView::Value::operator[](const std::string &key) const{
+    if ( !isContainer() || m_view->m_data[m_view->m_tokens[m_token].offset] != '{' )
+        return Value();
+
+    const std::vector<MLJsonView::Token>& tokens = m_view->m_tokens;
+
+    Value result;
+    size_t closing = tokens[m_token].end;
+    size_t current = m_token + 1;
+    while ( current < closing ){
+        size_t valueToken = current + 1;
+        Value v(m_view, valueToken);
+        if ( keyEquals(current, key) )
+            result = v;
+        current = v.isContainer() ? tokens[valueToken].end + 1 : valueToken + 1;
+    }
+    return result;
+}
+
+/**
+ * \brief Returns the element at \p index, or an invalid value if this is not an array or the index is out of range
+ */
+MLJsonView::Value MLJsonView::Value::operator[](int index) const{
+    if ( !isContainer() || m_view->m_data[m_view->m_tokens[m_token].offset] != '[' || index < 0 )
+        return Value();
+
+    const std::vector<MLJsonView::Token>& tokens = m_view->m_tokens;
+
+    size_t closing = tokens[m_token].end;
+    size_t current = m_token + 1;
+    while ( current < closing ){
+        Value v(m_view, current);
+        if ( index == 0 )
+            return v;
+        current = v.isContainer() ? tokens[current].end + 1 : current + 1;
+        --index;
+    }
+    return Value();
+}
+
+/**
+ * \brief Returns the keys of this object in document order
+ */
+std::vector<std::string> MLJsonView::Value::keys() const{
+    std::vector<std::string> result;
+    std::vector<std::pair<std::string, Value> > m = members();
+    result.reserve(m.size());
+    for ( auto it = m.begin(); it != m.end(); ++it )
+        result.push_back(it->first);
+    return result;
+}
+
+/**
+ * \brief Returns the key-value pairs of this object in document order
+ */
+std::vector<std::pair<std::string, MLJsonView::Value> > MLJsonView::Value::members() const{
+    std::vector<std::pair<std::string, Value> > result;
+    if ( !isContainer() || m_view->m_data[m_view->m_tokens[m_token].offset] != '{' )
+        return result;
+
+    const std::vector<MLJsonView::Token>& tokens = m_view->m_tokens;
+
+    size_t closing = tokens[m_token].end;
+    size_t current = m_token + 1;
+    while ( current < closing ){
+        size_t valueToken = current + 1;
+        Value v(m_view, valueToken);
+        result.push_back(std::make_pair(Value(m_view, current).asString(), v));
+        current = v.isContainer() ? tokens[valueToken].end + 1 : valueToken + 1;
+    }
+    return result;
+}
+
+/**
+ * \brief Returns the json text of this value, as found in the buffer
+ */
+std::string MLJsonView::Value::rawJson() const{
+    if ( !m_view )
+        return "null";
+    size_t begin = m_view->m_tokens[m_token].offset;
+    return std::string(m_view->m_data + begin, end() - begin);
+}
+
+/**
+ * \brief Decodes this value and all of its children into an MLNode
+ *
+ * Throws an lv::Exception if the value is not valid json.
+ */
+MLNode MLJsonView::Value::toMLNode() const{
+    MLNode result;
+    if ( !m_view )
+        return result;
+    std::string raw = rawJson();
+    ml::fromJson(raw.c_str(), result);
+    return result;
+}
+
+/**
+ * \brief Decodes only the members of this object found in \p keys, skipping the rest
+ *
+ * Returns a null node if this value is not an object.
+ */
+MLNode MLJsonView::Value::toMLNode(const std::vector<std::string> &keys) const{
+    if ( type() != MLNode::Object )
+        return MLNode();
+
+    MLNode result(MLNode::Object);
+    for ( auto it = keys.begin(); it != keys.end(); ++it ){
+        Value v = (*this)[*it];
+        if ( v.isValid() )
+            result[*it] = v.toMLNode();
+    }
+    return result;
+}
+
+size_t MLJsonView::Value::end() const{
+    const std::vector<MLJsonView::Token>& tokens = m_view->m_tokens;
+    if ( isContainer() )
+        return tokens[tokens[m_token].end].offset + 1;
+    return tokens[m_token].end;
+}
+
+bool MLJsonView::Value::isContainer() const{
+    if ( !m_view )
+        return false;
+    char c = m_view->m_data[m_view->m_tokens[m_token].offset];
+    return c == '{' || c == '[';
+}
+
+bool MLJsonView::Value::keyEquals(size_t token, const std::string &key) const{
+    const MLJsonView::Token& t = m_view->m_tokens[token];
+    if ( m_view->m_data[t.offset] != '"' )
+        return false;
+
+    const char* begin = m_view->m_data + t.offset + 1;
+    size_t length = t.end - t.offset - 2;
+    if ( !std::memchr(begin, '\\', length) )
+        return length == key.size() && std::memcmp(begin, key.data(), length) == 0;
+
+    return Value(m_view, token).asString() == key;
+}
+
+}// namespace
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LVMLJSONVIEW_H
+#define LVMLJSONVIEW_H
+
+#include "live/lvbaseglobal.h"
+#include "live/mlnode.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lv{
+
+class MLJsonViewPrivate;
+
+// MLJsonView
+// ----------
+
+class LV_BASE_EXPORT MLJsonView{
+
+    DISABLE_COPY(MLJsonView);
+
+public:
+    /** Shared pointer to this class */
+    typedef std::shared_ptr<MLJsonView> Ptr;
+
+    /**
+     * \class lv::MLJsonView::Value
+     * \brief Lightweight handle to a value inside the view
+     *
+     * Values are only valid during the lifetime of the view that created them.
+     */
+    class LV_BASE_EXPORT Value{
+
+        friend class MLJsonView;
+
+    public:
+        Value();
+
+        MLNode::Type type() const;
+        bool isValid() const;
+        bool isNull() const;
+
+        int asInt() const;
+        MLNode::IntType asLongInt() const;
+        MLNode::FloatType asFloat() const;
+        bool asBool() const;
+        std::string asString() const;
+
+        int size() const;
+        bool hasKey(const std::string& key) const;
+        Value operator[](const std::string& key) const;
+        Value operator[](int index) const;
+
+        std::vector<std::string> keys() const;
+        std::vector<std::pair<std::string, Value> > members() const;
+
+        std::string rawJson() const;
+        MLNode toMLNode() const;
+        MLNode toMLNode(const std::vector<std::string>& keys) const;
+
+    private:
+        Value(const MLJsonView* view, size_t token);
+
+        size_t end() const;
+        bool isContainer() const;
+        bool keyEquals(size_t token, const std::string& key) const;
+
+        const MLJsonView* m_view;
+        size_t            m_token;
+    };
+
+public:
+    ~MLJsonView();
+
+    static Ptr create(const char* data, size_t size);
+    static Ptr create(const std::string& data);
+    static Ptr createFromFile(const std::string& path);
+
+    Value root() const;
+
+    const char* data() const;
+    size_t size() const;
+    size_t tokenCount() const;
+
+private:
+    MLJsonView();
+
+    void index();
+
+    /** Position of a value or closing bracket in the buffer */
+    struct Token{
+        size_t offset;
+        size_t end;
+    };
+
+    std::vector<Token> m_tokens;
+    const char*        m_data;
+    size_t             m_size;
+    MLJsonViewPrivate* m_d;
+};
+
+/**
+ * \brief Returns the buffer this view indexes
+ */
+inline const char *MLJsonView::data() const{
+    return m_data;
+}
+
+/**
+ * \brief Returns the size of the indexed buffer
+ */
+inline size_t MLJsonView::size() const{
+    return m_size;
+}
+
+/**
+ * \brief Returns the number of structural tokens found while indexing
+ */
+inline size_t MLJsonView::tokenCount() const{
+    return m_tokens.size();
+}
+
+/**
+ * \brief Checks wether this value points to an existing location in the view
+ */
+inline bool MLJsonView::Value::isValid() const{
+    return m_view != nullptr;
+}
+
+}// namespace
+
+#endif // LVMLJSONVIEW_H
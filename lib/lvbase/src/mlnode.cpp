@@ -102,11 +102,14 @@ namespace lv{
   * We provide several functions to convert our MLNode representation to JSON.
   * ```
   * void toJson(const MLNode& n, std::string& result);
+  * size_t toJson(const MLNode& n, char* buffer, size_t capacity);
   * void fromJson(const std::string& data, MLNode& n);
   * void fromJson(const char* data, MLNode& n);
+  * void fromJsonInsitu(char* data, MLNode& n);
   * ```
   * We are able to convert in both directions, from an MLNode to a JSON string, and vice versa (noting that the JSON string
-  * can be either a standard string or a char array.
+  * can be either a standard string or a char array. The in-situ version parses a writable buffer in place, modifying
+  * its contents, while the buffer version of toJson writes into a caller-provided buffer, returning the required size.
   *
   * Converting the following object
   * ```
@@ -159,7 +162,7 @@ namespace lv{
 MLNode::BytesType::BytesType(unsigned char *data, size_t size)
     : m_data(new unsigned char[size])
     , m_size(size)
-    , m_ref(new int)
+    , m_ref(new int(0))
 {
     ++(*m_ref);
     memcpy((void*)m_data, (void*)data, size);
@@ -186,7 +189,7 @@ MLNode::BytesType::BytesType(const MLNode::BytesType &other)
 MLNode::BytesType::BytesType()
     : m_data(0)
     , m_size(0)
-    , m_ref(new int)
+    , m_ref(new int(0))
 {
     ++(*m_ref);
 }
@@ -1445,6 +1448,18 @@ int MLNode::asInt() const{
     return static_cast<int>(m_value.asInt);
 }
 
+/**
+ * \brief Returns the MLNode value as IntType, without narrowing it to int.
+ *
+ * If not the appropriate type, an exception is thrown.
+ */
+MLNode::IntType MLNode::asLongInt() const{
+    if ( m_type != Type::Integer )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of integer type.", 0);
+
+    return m_value.asInt;
+}
+
 /**
  * \brief Returns the MLNode value as bool.
  *
@@ -1533,6 +1548,18 @@ const MLNode::ObjectType &MLNode::asObject() const{
     return *m_value.asObject;
 }
 
+/**
+ * \brief Returns the MLNode value as an object.
+ *
+ * If not the appropriate type, an exception is thrown.
+ */
+MLNode::ObjectType &MLNode::asObject(){
+    if ( m_type != Type::Object )
+        THROW_EXCEPTION(InvalidMLTypeException, "Node is not of object type.", 0);
+
+    return *m_value.asObject;
+}
+
 /**
  * \brief Returns the size of MLNode, if it's an Object or Array.
  *
@@ -331,6 +331,7 @@ public:
     };
 
     friend class ConstIterator;
+    friend class MLDocument;
 
 public:
     /**
@@ -411,6 +412,7 @@ public:
 
     bool isNull() const;
     int asInt() const;
+    IntType asLongInt() const;
     bool asBool() const;
     FloatType asFloat() const;
     const StringType& asString() const;
@@ -419,6 +421,7 @@ public:
     const ArrayType& asArray() const;
     ArrayType& asArray();
     const ObjectType& asObject() const;
+    ObjectType& asObject();
 
     int size() const;
     bool hasKey(const StringType& key) const;
@@ -0,0 +1,532 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "mlnodetobinary.h"
+#include "live/exception.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+/*
+ * The binary format is a subset of CBOR (RFC 7049), so it can be read by any CBOR decoder:
+ *
+ *  - integers are encoded as major types 0 and 1
+ *  - bytes are stored raw as major type 2, strings as major type 3
+ *  - arrays and objects are definite-length major types 4 and 5, with string keys
+ *  - floats are always written as doubles, booleans and null as simple values
+ *
+ * Encoded data starts with the CBOR self-describe tag (0xd9d9f7), which is used to distinguish it from json.
+ */
+
+namespace lv{
+namespace ml{
+
+namespace{
+
+enum MajorType{
+    UnsignedInt = 0,
+    NegativeInt = 1,
+    ByteString  = 2,
+    TextString  = 3,
+    ArrayItems  = 4,
+    MapItems    = 5,
+    Tag         = 6,
+    SimpleValue = 7
+};
+
+const unsigned char SelfDescribeTag[] = {0xd9, 0xd9, 0xf7};
+
+const unsigned char FalseValue     = 0xf4;
+const unsigned char TrueValue      = 0xf5;
+const unsigned char NullValue      = 0xf6;
+const unsigned char UndefinedValue = 0xf7;
+const unsigned char HalfFloatValue = 0xf9;
+const unsigned char FloatValue     = 0xfa;
+const unsigned char DoubleValue    = 0xfb;
+
+// Encoder
+// -------
+
+class BinaryWriter{
+
+public:
+    BinaryWriter(std::string& out) : m_out(out){}
+
+    void writeHeader(MajorType type, unsigned long long value){
+        unsigned char major = static_cast<unsigned char>(type << 5);
+        if ( value < 24 ){
+            m_out.push_back(static_cast<char>(major | value));
+        } else if ( value <= 0xff ){
+            m_out.push_back(static_cast<char>(major | 24));
+            writeBigEndian(value, 1);
+        } else if ( value <= 0xffff ){
+            m_out.push_back(static_cast<char>(major | 25));
+            writeBigEndian(value, 2);
+        } else if ( value <= 0xffffffffULL ){
+            m_out.push_back(static_cast<char>(major | 26));
+            writeBigEndian(value, 4);
+        } else {
+            m_out.push_back(static_cast<char>(major | 27));
+            writeBigEndian(value, 8);
+        }
+    }
+
+    void writeInt(MLNode::IntType value){
+        if ( value >= 0 )
+            writeHeader(UnsignedInt, static_cast<unsigned long long>(value));
+        else
+            writeHeader(NegativeInt, static_cast<unsigned long long>(-1 - value));
+    }
+
+    void writeFloat(MLNode::FloatType value){
+        unsigned long long bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        m_out.push_back(static_cast<char>(DoubleValue));
+        writeBigEndian(bits, 8);
+    }
+
+    void writeBool(bool value){
+        m_out.push_back(static_cast<char>(value ? TrueValue : FalseValue));
+    }
+
+    void writeNull(){
+        m_out.push_back(static_cast<char>(NullValue));
+    }
+
+    void writeString(const char* data, size_t size){
+        writeHeader(TextString, size);
+        m_out.append(data, size);
+    }
+
+    void writeBytes(const MLNode::ByteType* data, size_t size){
+        writeHeader(ByteString, size);
+        m_out.append(reinterpret_cast<const char*>(data), size);
+    }
+
+    void writeSelfDescribeTag(){
+        m_out.append(reinterpret_cast<const char*>(SelfDescribeTag), sizeof(SelfDescribeTag));
+    }
+
+private:
+    void writeBigEndian(unsigned long long value, int bytes){
+        for ( int i = bytes - 1; i >= 0; --i )
+            m_out.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+
+    std::string& m_out;
+};
+
+void recurseSerialize(const MLNode& n, BinaryWriter& writer){
+    switch( n.type() ){
+    case MLNode::Null:
+        writer.writeNull();
+        break;
+    case MLNode::Object:{
+        const MLNode::ObjectType& o = n.asObject();
+        writer.writeHeader(MapItems, o.size());
+        for ( auto it = o.begin(); it != o.end(); ++it ){
+            writer.writeString(it->first.c_str(), it->first.size());
+            recurseSerialize(it->second, writer);
+        }
+        break;
+    }
+    case MLNode::Array:{
+        const MLNode::ArrayType& a = n.asArray();
+        writer.writeHeader(ArrayItems, a.size());
+        for ( auto it = a.begin(); it != a.end(); ++it ){
+            recurseSerialize(*it, writer);
+        }
+        break;
+    }
+    case MLNode::Bytes:{
+        MLNode::BytesType b = n.asBytes();
+        writer.writeBytes(b.data(), b.size());
+        break;
+    }
+    case MLNode::String:{
+        const std::string& s = n.asString();
+        writer.writeString(s.c_str(), s.size());
+        break;
+    }
+    case MLNode::Boolean:
+        writer.writeBool(n.asBool());
+        break;
+    case MLNode::Integer:
+        writer.writeInt(n.asLongInt());
+        break;
+    case MLNode::Float:
+        writer.writeFloat(n.asFloat());
+        break;
+    }
+}
+
+void recurseSerialize(const MLDocument::Node& n, BinaryWriter& writer){
+    switch( n.type() ){
+    case MLNode::Null:
+        writer.writeNull();
+        break;
+    case MLNode::Object:{
+        writer.writeHeader(MapItems, static_cast<unsigned long long>(n.size()));
+        for ( int i = 0; i < n.size(); ++i ){
+            const MLDocument::Member& m = n.memberAt(i);
+            writer.writeString(m.keyEntry()->data(), m.keyEntry()->size());
+            recurseSerialize(m.value(), writer);
+        }
+        break;
+    }
+    case MLNode::Array:{
+        writer.writeHeader(ArrayItems, static_cast<unsigned long long>(n.size()));
+        for ( int i = 0; i < n.size(); ++i ){
+            recurseSerialize(n[i], writer);
+        }
+        break;
+    }
+    case MLNode::Bytes:
+        writer.writeBytes(n.bytesData(), n.bytesSize());
+        break;
+    case MLNode::String:
+        writer.writeString(n.stringData(), n.stringSize());
+        break;
+    case MLNode::Boolean:
+        writer.writeBool(n.asBool());
+        break;
+    case MLNode::Integer:
+        writer.writeInt(n.asLongInt());
+        break;
+    case MLNode::Float:
+        writer.writeFloat(n.asFloat());
+        break;
+    }
+}
+
+// Decoder
+// -------
+
+class BinaryReader{
+
+public:
+    BinaryReader(const char* data, size_t size)
+        : m_data(reinterpret_cast<const unsigned char*>(data))
+        , m_size(size)
+        , m_position(0)
+    {
+        if ( isBinary(data, size) )
+            m_position = sizeof(SelfDescribeTag);
+    }
+
+    bool atEnd() const{ return m_position >= m_size; }
+    size_t position() const{ return m_position; }
+
+    unsigned char readByte(){
+        require(1);
+        return m_data[m_position++];
+    }
+
+    unsigned long long readBigEndian(int bytes){
+        require(static_cast<size_t>(bytes));
+        unsigned long long result = 0;
+        for ( int i = 0; i < bytes; ++i )
+            result = (result << 8) | m_data[m_position++];
+        return result;
+    }
+
+    unsigned long long readArgument(unsigned char info){
+        if ( info < 24 )
+            return info;
+        switch( info ){
+        case 24: return readBigEndian(1);
+        case 25: return readBigEndian(2);
+        case 26: return readBigEndian(4);
+        case 27: return readBigEndian(8);
+        default:
+            fail("Unsupported indefinite length or reserved value");
+        }
+        return 0;
+    }
+
+    const char* readSpan(unsigned long long size){
+        require(size);
+        const char* result = reinterpret_cast<const char*>(m_data + m_position);
+        m_position += static_cast<size_t>(size);
+        return result;
+    }
+
+    MLNode::FloatType readHalfFloat(){
+        unsigned long long half = readBigEndian(2);
+        int exponent = (half >> 10) & 0x1f;
+        int mantissa = half & 0x3ff;
+        double value;
+        if ( exponent == 0 )
+            value = std::ldexp(mantissa, -24);
+        else if ( exponent != 31 )
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+        else
+            value = mantissa == 0 ? INFINITY : NAN;
+        return (half & 0x8000) ? -value : value;
+    }
+
+    MLNode::FloatType readFloat(){
+        unsigned int bits = static_cast<unsigned int>(readBigEndian(4));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    MLNode::FloatType readDouble(){
+        unsigned long long bits = readBigEndian(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void require(unsigned long long size){
+        if ( size > m_size - m_position )
+            fail("Unexpected end of data");
+    }
+
+    void fail(const std::string& message){
+        THROW_EXCEPTION(lv::Exception,
+            "Failed to parse binary: " + message + " at " + std::to_string(m_position), Exception::toCode("Binary"));
+    }
+
+private:
+    const unsigned char* m_data;
+    size_t               m_size;
+    size_t               m_position;
+};
+
+/*
+ * Reads values from the binary reader and constructs them through the given builder. The builder provides the
+ * node type and the functions to create each value, so both MLNode and MLDocument share the same decoding.
+ */
+template<typename Builder> typename Builder::NodeType readValue(BinaryReader& reader, Builder& builder, int depth){
+    if ( depth > 512 )
+        reader.fail("Maximum nesting depth exceeded");
+
+    unsigned char initial = reader.readByte();
+    unsigned char major   = initial >> 5;
+    unsigned char info    = initial & 0x1f;
+
+    switch( major ){
+    case UnsignedInt: {
+        unsigned long long value = reader.readArgument(info);
+        return builder.createInt(static_cast<MLNode::IntType>(value));
+    }
+    case NegativeInt: {
+        unsigned long long value = reader.readArgument(info);
+        return builder.createInt(-1 - static_cast<MLNode::IntType>(value));
+    }
+    case ByteString: {
+        unsigned long long size = reader.readArgument(info);
+        const char* data = reader.readSpan(size);
+        return builder.createBytes(reinterpret_cast<const MLNode::ByteType*>(data), static_cast<size_t>(size));
+    }
+    case TextString: {
+        unsigned long long size = reader.readArgument(info);
+        const char* data = reader.readSpan(size);
+        return builder.createString(data, static_cast<size_t>(size));
+    }
+    case ArrayItems: {
+        unsigned long long size = reader.readArgument(info);
+        reader.require(size); // each element takes at least one byte
+        auto frame = builder.beginArray(static_cast<size_t>(size));
+        for ( unsigned long long i = 0; i < size; ++i )
+            builder.appendElement(frame, readValue(reader, builder, depth + 1));
+        return builder.endArray(frame);
+    }
+    case MapItems: {
+        unsigned long long size = reader.readArgument(info);
+        reader.require(size * 2);
+        auto frame = builder.beginObject(static_cast<size_t>(size));
+        for ( unsigned long long i = 0; i < size; ++i ){
+            unsigned char keyInitial = reader.readByte();
+            if ( (keyInitial >> 5) != TextString )
+                reader.fail("Object keys are required to be strings");
+            unsigned long long keySize = reader.readArgument(keyInitial & 0x1f);
+            const char* key = reader.readSpan(keySize);
+            builder.appendMember(frame, key, static_cast<size_t>(keySize), readValue(reader, builder, depth + 1));
+        }
+        return builder.endObject(frame);
+    }
+    case Tag: {
+        reader.readArgument(info); // tags carry no information for MLNode, only the tagged value is read
+        return readValue(reader, builder, depth + 1);
+    }
+    case SimpleValue: {
+        switch( initial ){
+        case FalseValue:     return builder.createBool(false);
+        case TrueValue:      return builder.createBool(true);
+        case NullValue:      return builder.createNull();
+        case UndefinedValue: return builder.createNull();
+        case HalfFloatValue: return builder.createFloat(reader.readHalfFloat());
+        case FloatValue:     return builder.createFloat(reader.readFloat());
+        case DoubleValue:    return builder.createFloat(reader.readDouble());
+        default:
+            reader.fail("Unsupported simple value");
+        }
+    }
+    }
+
+    return builder.createNull();
+}
+
+class MLNodeBinaryBuilder{
+
+public:
+    typedef MLNode NodeType;
+
+    MLNode createNull(){ return MLNode(); }
+    MLNode createInt(MLNode::IntType value){ return MLNode(value); }
+    MLNode createFloat(MLNode::FloatType value){ return MLNode(value); }
+    MLNode createBool(bool value){ return MLNode(value); }
+    MLNode createString(const char* data, size_t size){ return MLNode(std::string(data, size)); }
+    MLNode createBytes(const MLNode::ByteType* data, size_t size){
+        return MLNode(const_cast<MLNode::ByteType*>(data), size);
+    }
+
+    MLNode beginArray(size_t size){
+        MLNode result(MLNode::Array);
+        result.asArray().reserve(size);
+        return result;
+    }
+    void appendElement(MLNode& arr, MLNode&& value){ arr.asArray().push_back(std::move(value)); }
+    MLNode endArray(MLNode& arr){ return std::move(arr); }
+
+    MLNode beginObject(size_t){ return MLNode(MLNode::Object); }
+    void appendMember(MLNode& obj, const char* key, size_t keySize, MLNode&& value){
+        obj.asObject()[std::string(key, keySize)] = std::move(value);
+    }
+    MLNode endObject(MLNode& obj){ return std::move(obj); }
+};
+
+class MLDocumentBinaryBuilder{
+
+public:
+    typedef MLDocument::Node NodeType;
+
+    MLDocumentBinaryBuilder(MLDocument* d, bool reference) : doc(d), isReference(reference){}
+
+    NodeType createNull(){ return MLDocument::createNull(); }
+    NodeType createInt(MLNode::IntType value){ return MLDocument::createInt(value); }
+    NodeType createFloat(MLNode::FloatType value){ return MLDocument::createFloat(value); }
+    NodeType createBool(bool value){ return MLDocument::createBool(value); }
+    NodeType createString(const char* data, size_t size){
+        return isReference ? doc->createStringReference(data, size) : doc->createString(data, size);
+    }
+    NodeType createBytes(const MLNode::ByteType* data, size_t size){
+        return isReference ? doc->createBytesReference(data, size) : doc->createBytes(data, size);
+    }
+
+    size_t beginArray(size_t){ return values.size(); }
+    void appendElement(size_t, const NodeType& value){ values.push_back(value); }
+    NodeType endArray(size_t start){
+        NodeType result = doc->createArray(values.data() + start, values.size() - start);
+        values.resize(start);
+        return result;
+    }
+
+    size_t beginObject(size_t){ return members.size(); }
+    void appendMember(size_t, const char* key, size_t keySize, const NodeType& value){
+        members.push_back(doc->createMember(key, keySize, value));
+    }
+    NodeType endObject(size_t start){
+        NodeType result = doc->createObject(members.data() + start, members.size() - start);
+        members.resize(start);
+        return result;
+    }
+
+private:
+    MLDocument* doc;
+    bool isReference;
+    std::vector<MLDocument::Node>   values;
+    std::vector<MLDocument::Member> members;
+};
+
+void readDocument(const char *data, size_t size, MLDocument &doc, bool isReference){
+    doc.clear();
+    BinaryReader reader(data, size);
+    MLDocumentBinaryBuilder builder(&doc, isReference);
+    doc.setRoot(readValue(reader, builder, 0));
+}
+
+} // namespace
+
+/**
+ * \brief Serializes \p n to its binary (CBOR) representation
+ *
+ * Unlike json, bytes are stored raw and numbers are stored natively.
+ */
+void toBinary(const MLNode &n, std::string &result){
+    result.clear();
+    BinaryWriter writer(result);
+    writer.writeSelfDescribeTag();
+    recurseSerialize(n, writer);
+}
+
+/**
+ * \brief Deserializes \p data from its binary (CBOR) representation into \p n
+ */
+void fromBinary(const std::string &data, MLNode &n){
+    fromBinary(data.c_str(), data.size(), n);
+}
+
+/**
+ * \brief Deserializes \p size bytes of \p data from its binary (CBOR) representation into \p n
+ */
+void fromBinary(const char *data, size_t size, MLNode &n){
+    BinaryReader reader(data, size);
+    MLNodeBinaryBuilder builder;
+    n = readValue(reader, builder, 0);
+}
+
+/**
+ * \brief Serializes \p doc to its binary (CBOR) representation
+ */
+void toBinary(const MLDocument &doc, std::string &result){
+    result.clear();
+    BinaryWriter writer(result);
+    writer.writeSelfDescribeTag();
+    recurseSerialize(doc.root(), writer);
+}
+
+/**
+ * \brief Deserializes \p data into \p doc, copying strings and bytes into the document's arena
+ */
+void fromBinary(const char *data, size_t size, MLDocument &doc){
+    readDocument(data, size, doc, false);
+}
+
+/**
+ * \brief Deserializes \p data into \p doc without copying strings or byte blobs.
+ *
+ * String and Bytes nodes point directly into \p data, so \p data has to outlive the document. This is meant
+ * for reading from memory-mapped files or shared memory segments, where large byte blobs can be accessed
+ * without being copied.
+ */
+void fromBinaryReference(const char *data, size_t size, MLDocument &doc){
+    readDocument(data, size, doc, true);
+}
+
+/**
+ * \brief Checks whether \p data starts with the binary format marker
+ */
+bool isBinary(const char *data, size_t size){
+    return size >= sizeof(SelfDescribeTag) && std::memcmp(data, SelfDescribeTag, sizeof(SelfDescribeTag)) == 0;
+}
+
+}// namespace ml
+}// namespace
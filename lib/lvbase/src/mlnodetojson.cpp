@@ -16,7 +16,8 @@
 
 #include "mlnodetojson.h"
 #include "live/exception.h"
-#include <list>
+#include <vector>
+#include <cstring>
 #include <QByteArray>
 
 #include "rapidjson/reader.h"
@@ -30,75 +31,241 @@ namespace ml{
 
 namespace{
 
-class MLNodeTrace{
+/*
+ * Builds the MLNode tree directly from the reader events. Values are kept on a stack and moved into their
+ * parent container once the container ends, so there's no path tracing and no per-value key lookup.
+ */
+class MLNodeBuilder{
 
 private:
-    std::list<MLNode*> path;
-    std::string lastKey;
+    std::vector<MLNode> values;
+    std::vector<std::string> keys;
+
+    void push(MLNode&& node){
+        values.push_back(std::move(node));
+    }
 
 public:
-    MLNodeTrace(MLNode* r){
-        path.push_back(r);
-    }
-
-    template<typename T> MLNode* insert(const T& value){
-        if ( path.back()->type() == MLNode::Object ){
-            (*path.back())[lastKey] = value;
-            return &(*path.back())[lastKey];
-        } else if ( path.back()->type() == MLNode::Array ){
-            MLNode* br = path.back();
-            br->append(value);
-
-            MLNode* ret = &((*br)[br->size() - 1]);
-            return ret;
-        } else {
-            (*path.back()) = value;
-            return &(*path.back());
-        }
+    MLNodeBuilder(){
+        values.reserve(32);
+        keys.reserve(32);
+    }
+
+    MLNode& result(){ return values.back(); }
+
+    bool Null() { push(MLNode()); return true; }
+    bool Bool(bool b) { push(MLNode(b)); return true; }
+    bool Int(int i) { push(MLNode(i)); return true; }
+    bool Uint(unsigned u) { push(MLNode(static_cast<MLNode::IntType>(u))); return true; }
+    bool Int64(int64_t i) { push(MLNode(static_cast<MLNode::IntType>(i))); return true; }
+    bool Uint64(uint64_t u) { push(MLNode(static_cast<MLNode::IntType>(u))); return true; }
+    bool Double(double d) { push(MLNode(d)); return true; }
+    bool RawNumber(const char* str, SizeType length, bool) {
+        push(MLNode(std::string(str, length)));
+        return true;
+    }
+    bool String(const char* str, SizeType length, bool) {
+        push(MLNode(std::string(str, length)));
+        return true;
     }
 
-    bool Null() { insert(MLNode::Null); return true; }
-    bool Bool(bool b) { insert(b); return true; }
-    bool Int(int i) { insert(i); return true; }
-    bool Uint(unsigned u) { insert(static_cast<MLNode::IntType>(u)); return true; }
-    bool Int64(int64_t i) { insert(static_cast<MLNode::IntType>(i)); return true; }
-    bool Uint64(uint64_t u) { insert(static_cast<MLNode::IntType>(u)); return true; }
-    bool Double(double d) { insert(d); return true; }
-    bool RawNumber(const char* str, SizeType, bool) {
-        insert(str);
+    bool StartObject() { return true; }
+    bool Key(const char* str, SizeType length, bool) {
+        keys.push_back(std::string(str, length));
         return true;
     }
-    bool String(const char* str, SizeType, bool) {
-        insert(str);
+    bool EndObject(SizeType memberCount){
+        size_t valueStart = values.size() - memberCount;
+        size_t keyStart   = keys.size() - memberCount;
+
+        MLNode obj(MLNode::Object);
+        MLNode::ObjectType& o = obj.asObject();
+        for ( size_t i = 0; i < memberCount; ++i ){
+            std::string& key = keys[keyStart + i];
+            auto it = o.lower_bound(key);
+            if ( it != o.end() && it->first == key ){ // duplicate keys, last one is kept
+                it->second = std::move(values[valueStart + i]);
+            } else {
+                o.emplace_hint(it, std::move(key), std::move(values[valueStart + i]));
+            }
+        }
+
+        values.resize(valueStart);
+        keys.resize(keyStart);
+        push(std::move(obj));
         return true;
     }
 
-    bool StartObject() {
-        path.push_back(insert(MLNode(MLNode::Object)));
+    bool StartArray() { return true; }
+    bool EndArray(SizeType elementCount){
+        size_t valueStart = values.size() - elementCount;
+
+        MLNode arr(MLNode::Array);
+        MLNode::ArrayType& a = arr.asArray();
+        a.reserve(elementCount);
+        for ( size_t i = valueStart; i < values.size(); ++i )
+            a.push_back(std::move(values[i]));
+
+        values.resize(valueStart);
+        push(std::move(arr));
         return true;
     }
-    bool Key(const char* str, SizeType, bool) {
-        lastKey = str;
+};
+
+/*
+ * Output stream writing into a caller provided buffer. Characters past the capacity are counted but not written,
+ * so the required size is known after a single pass.
+ */
+class FixedBufferStream{
+
+public:
+    typedef char Ch;
+
+    FixedBufferStream(char* buffer, size_t capacity) : m_buffer(buffer), m_capacity(capacity), m_size(0){}
+
+    void Put(char c){
+        if ( m_size < m_capacity )
+            m_buffer[m_size] = c;
+        ++m_size;
+    }
+    void Flush(){}
+
+    size_t size() const{ return m_size; }
+
+private:
+    char*  m_buffer;
+    size_t m_capacity;
+    size_t m_size;
+};
+
+/*
+ * Output stream appending to a std::string.
+ */
+class StdStringStream{
+
+public:
+    typedef char Ch;
+
+    StdStringStream(std::string& str) : m_str(str){}
+
+    void Put(char c){ m_str.push_back(c); }
+    void Flush(){}
+
+private:
+    std::string& m_str;
+};
+
+class MLDocumentBuilder{
+
+private:
+    MLDocument* doc;
+    bool isInsitu;
+    std::vector<MLDocument::Node> values;
+    std::vector<const MLStringTable::Entry*> keys;
+    std::vector<MLDocument::Member> members;
+
+    void push(const MLDocument::Node& node){
+        values.push_back(node);
+    }
+
+public:
+    MLDocumentBuilder(MLDocument* d, bool insitu = false) : doc(d), isInsitu(insitu){
+        values.reserve(32);
+        keys.reserve(32);
+    }
+
+    const MLDocument::Node& result() const{ return values.back(); }
+
+    bool Null() { push(MLDocument::createNull()); return true; }
+    bool Bool(bool b) { push(MLDocument::createBool(b)); return true; }
+    bool Int(int i) { push(MLDocument::createInt(i)); return true; }
+    bool Uint(unsigned u) { push(MLDocument::createInt(static_cast<MLNode::IntType>(u))); return true; }
+    bool Int64(int64_t i) { push(MLDocument::createInt(static_cast<MLNode::IntType>(i))); return true; }
+    bool Uint64(uint64_t u) { push(MLDocument::createInt(static_cast<MLNode::IntType>(u))); return true; }
+    bool Double(double d) { push(MLDocument::createFloat(d)); return true; }
+    bool RawNumber(const char* str, SizeType length, bool copy) {
+        return String(str, length, copy);
+    }
+    bool String(const char* str, SizeType length, bool) {
+        // in-situ strings are already stored within the document's arena
+        push(isInsitu ? doc->createStringReference(str, length) : doc->createString(str, length));
         return true;
     }
-    bool EndObject(SizeType){
-        if (path.size() > 1)
-            path.pop_back();
+
+    bool StartObject() { return true; }
+    bool Key(const char* str, SizeType length, bool) {
+        keys.push_back(doc->keys()->intern(str, length));
         return true;
     }
+    bool EndObject(SizeType memberCount){
+        size_t valueStart = values.size() - memberCount;
+        size_t keyStart   = keys.size() - memberCount;
+
+        members.clear();
+        for ( size_t i = 0; i < memberCount; ++i )
+            members.push_back(doc->createMember(keys[keyStart + i], values[valueStart + i]));
 
-    bool StartArray() {
-        path.push_back(insert(MLNode(MLNode::Array)));
+        MLDocument::Node obj = doc->createObject(members.data(), members.size());
+        values.resize(valueStart);
+        keys.resize(keyStart);
+        push(obj);
         return true;
     }
-    bool EndArray(SizeType){
-        if (path.size() > 1)
-            path.pop_back();
+
+    bool StartArray() { return true; }
+    bool EndArray(SizeType elementCount){
+        size_t valueStart = values.size() - elementCount;
+        MLDocument::Node arr = doc->createArray(values.data() + valueStart, elementCount);
+        values.resize(valueStart);
+        push(arr);
         return true;
     }
 };
 
-void recurseSerialize(const MLNode& n, rapidjson::Writer<rapidjson::StringBuffer>& writer){
+template<typename W> void recurseSerialize(const MLDocument::Node& n, W& writer){
+    switch( n.type() ){
+    case MLNode::Null:
+        writer.Null();
+        break;
+    case MLNode::Object:{
+        writer.StartObject();
+        for ( int i = 0; i < n.size(); ++i ){
+            const MLDocument::Member& m = n.memberAt(i);
+            writer.Key(m.keyEntry()->data(), static_cast<rapidjson::SizeType>(m.keyEntry()->size()));
+            recurseSerialize(m.value(), writer);
+        }
+        writer.EndObject();
+        break;
+    }
+    case MLNode::Array:{
+        writer.StartArray();
+        for ( int i = 0; i < n.size(); ++i ){
+            recurseSerialize(n[i], writer);
+        }
+        writer.EndArray();
+        break;
+    }
+    case MLNode::Bytes:{
+        std::string bs = n.asBytes().toBase64String();
+        writer.String(bs.c_str(), static_cast<rapidjson::SizeType>(bs.length()));
+        break;
+    }
+    case MLNode::String:
+        writer.String(n.stringData(), static_cast<rapidjson::SizeType>(n.stringSize()));
+        break;
+    case MLNode::Boolean:
+        writer.Bool(n.asBool());
+        break;
+    case MLNode::Integer:
+        writer.Int64(n.asLongInt());
+        break;
+    case MLNode::Float:
+        writer.Double(n.asFloat());
+        break;
+    }
+}
+
+template<typename W> void recurseSerialize(const MLNode& n, W& writer){
     switch( n.type() ){
     case MLNode::Null:
         writer.Null();
@@ -145,39 +312,147 @@ void recurseSerialize(const MLNode& n, rapidjson::Writer<rapidjson::StringBuffer
     }
 }
 
-} // namespace
+template<typename N> size_t serializeToBuffer(const N& n, char* buffer, size_t capacity){
+    FixedBufferStream s(buffer, capacity);
+    Writer<FixedBufferStream> writer(s);
 
-void toJson(const MLNode &n, std::string &result){
-    StringBuffer s;
-    Writer<StringBuffer> writer(s);
+    recurseSerialize(n, writer);
+
+    if ( s.size() < capacity )
+        buffer[s.size()] = '\0';
+    return s.size();
+}
+
+template<typename N> void serializeToString(const N& n, std::string& result){
+    result.clear();
+    StdStringStream s(result);
+    Writer<StdStringStream> writer(s);
 
     recurseSerialize(n, writer);
+}
+
+} // namespace
+
+/**
+ * \brief Serializes \p n to json into \p result
+ */
+void toJson(const MLNode &n, std::string &result){
+    serializeToString(n, result);
+}
 
-    result = s.GetString();
+/**
+ * \brief Serializes \p n to json into the caller provided \p buffer of \p capacity bytes
+ *
+ * Returns the size of the serialized json, excluding the null terminator. If the returned size is larger or equal
+ * to the capacity, the output was truncated and the call can be repeated with a buffer of at least the returned
+ * size + 1. This allows reusing the same buffer across calls without any allocations.
+ */
+size_t toJson(const MLNode &n, char *buffer, size_t capacity){
+    return serializeToBuffer(n, buffer, capacity);
 }
 
 void fromJson(const std::string &data, MLNode &n){
-    MLNodeTrace handler(&n);
+    MLNodeBuilder handler;
 
     Reader reader;
     StringStream ss(data.c_str());
-    reader.Parse(ss, handler);
+    if ( reader.Parse(ss, handler) )
+        n = std::move(handler.result());
 }
 
 void fromJson(const char *data, MLNode &n){
-    MLNodeTrace handler(&n);
+    MLNodeBuilder handler;
 
     Reader reader;
     StringStream ss(data);
 
+    ParseResult pr = reader.Parse(ss, handler);
+    if ( !pr ){
+        THROW_EXCEPTION(lv::Exception,
+            "Failed to parse json: " + std::string(GetParseError_En(pr.Code())) + " at " + std::to_string(pr.Offset()), Exception::toCode("Json"));
+    }
+    n = std::move(handler.result());
+}
+
+/**
+ * \brief Parses the null-terminated \p data in-situ into \p n
+ *
+ * The contents of \p data are modified during parsing (strings are unescaped in place), so the buffer cannot be
+ * reused afterwards. This avoids copying the input and measuring each token.
+ */
+void fromJsonInsitu(char *data, MLNode &n){
+    MLNodeBuilder handler;
+
+    Reader reader;
+    InsituStringStream ss(data);
+
+    ParseResult pr = reader.Parse<kParseInsituFlag>(ss, handler);
+    if ( !pr ){
+        THROW_EXCEPTION(lv::Exception,
+            "Failed to parse json: " + std::string(GetParseError_En(pr.Code())) + " at " + std::to_string(pr.Offset()), Exception::toCode("Json"));
+    }
+    n = std::move(handler.result());
+}
+
+/**
+ * \brief Serializes \p doc to json into \p result
+ */
+void toJson(const MLDocument &doc, std::string &result){
+    serializeToString(doc.root(), result);
+}
+
+/**
+ * \brief Serializes \p doc to json into the caller provided \p buffer. See lv::ml::toJson(const MLNode&, char*, size_t)
+ */
+size_t toJson(const MLDocument &doc, char *buffer, size_t capacity){
+    return serializeToBuffer(doc.root(), buffer, capacity);
+}
+
+void fromJson(const std::string &data, MLDocument &doc){
+    fromJson(data.c_str(), doc);
+}
+
+void fromJson(const char *data, MLDocument &doc){
+    doc.clear();
+    MLDocumentBuilder handler(&doc);
+
+    Reader reader;
+    StringStream ss(data);
 
     ParseResult pr = reader.Parse(ss, handler);
     if ( !pr ){
         THROW_EXCEPTION(lv::Exception,
             "Failed to parse json: " + std::string(GetParseError_En(pr.Code())) + " at " + std::to_string(pr.Offset()), Exception::toCode("Json"));
     }
+    doc.setRoot(handler.result());
+}
+
+/**
+ * \brief Parses \p data in-situ within the arena of \p doc
+ *
+ * The input is copied once into a pre-reserved arena block and parsed in place. String values reference the
+ * copied buffer instead of being allocated separately.
+ */
+void fromJsonInsitu(const std::string &data, MLDocument &doc){
+    doc.clear();
+    // input buffer, plus an estimate for the nodes
+    doc.arena().reserve(data.size() * 2 + 1);
+
+    char* buffer = doc.arena().allocateArray<char>(data.size() + 1);
+    memcpy(buffer, data.c_str(), data.size() + 1);
+
+    MLDocumentBuilder handler(&doc, true);
+
+    Reader reader;
+    InsituStringStream ss(buffer);
+
+    ParseResult pr = reader.Parse<kParseInsituFlag>(ss, handler);
+    if ( !pr ){
+        THROW_EXCEPTION(lv::Exception,
+            "Failed to parse json: " + std::string(GetParseError_En(pr.Code())) + " at " + std::to_string(pr.Offset()), Exception::toCode("Json"));
+    }
+    doc.setRoot(handler.result());
 }
 
 }// namespace ml
 }// namespace
-
@@ -18,6 +18,7 @@
 #define LVMLNODETOJSON_H
 
 #include "live/mlnode.h"
+#include "live/mldocument.h"
 
 class QJsonValue;
 
@@ -26,8 +27,16 @@ namespace lv{
 namespace ml{
 
 void LV_BASE_EXPORT toJson(const MLNode& n, std::string& result);
+size_t LV_BASE_EXPORT toJson(const MLNode& n, char* buffer, size_t capacity);
 void LV_BASE_EXPORT fromJson(const std::string& data, MLNode& n);
 void LV_BASE_EXPORT fromJson(const char* data, MLNode& n);
+void LV_BASE_EXPORT fromJsonInsitu(char* data, MLNode& n);
+
+void LV_BASE_EXPORT toJson(const MLDocument& doc, std::string& result);
+size_t LV_BASE_EXPORT toJson(const MLDocument& doc, char* buffer, size_t capacity);
+void LV_BASE_EXPORT fromJson(const std::string& data, MLDocument& doc);
+void LV_BASE_EXPORT fromJson(const char* data, MLDocument& doc);
+void LV_BASE_EXPORT fromJsonInsitu(const std::string& data, MLDocument& doc);
 
 //void LV_BASE_EXPORT toJson(const MLNode& n, QJsonValue& result);
 //void LV_BASE_EXPORT toJson(const MLNode& n, QByteArray& result);
@@ -3,6 +3,8 @@
 
 #include "lockedfileiosession.h"
 #include "live/mlnodetojson.h"
+#include "live/mljsonview.h"
+#include "live/manifestcache.h"
 #include "live/exception.h"
 #include "live/visuallog.h"
 #include "live/library.h"
@@ -24,6 +26,45 @@
 
 namespace lv{
 
+namespace{
+
+// Fields read by createFromNode, which are the only ones decoded from the manifest file
+enum PackageField{
+    NameField,
+    VersionField,
+    DependenciesField,
+    LibrariesField,
+    InternalLibrariesField,
+    DocumentationField,
+    WorkspaceField,
+    TotalPackageFields
+};
+
+const char* packageFieldNames[] = {
+    "name",
+    "version",
+    "dependencies",
+    "libraries",
+    "internalLibraries",
+    "documentation",
+    "workspace"
+};
+
+static_assert(
+    sizeof(packageFieldNames) / sizeof(packageFieldNames[0]) == TotalPackageFields, "Each manifest field needs a name"
+);
+
+const char* field(PackageField f){
+    return packageFieldNames[f];
+}
+
+const std::vector<std::string>& manifestKeys(){
+    static const std::vector<std::string> keys(packageFieldNames, packageFieldNames + TotalPackageFields);
+    return keys;
+}
+
+} // namespace
+
 const char* Package::fileName = "live.package.json";
 
 /// \private
@@ -67,8 +108,12 @@ bool Package::existsIn(const std::string &path){
     return finfo.exists();
 }
 
-/** Creates a package pointer from that path, considering that path has a package */
-Package::Ptr Package::createFromPath(const std::string &path){
+/**
+ * \brief Creates a package pointer from that path, considering that path has a package
+ *
+ * If a \p cache is given, the manifest is only parsed if it's not cached or has changed since.
+ */
+Package::Ptr Package::createFromPath(const std::string &path, ManifestCache *cache){
     QString packagePath = QString::fromStdString(path);
     QString packageDirPath;
 
@@ -80,41 +125,39 @@ Package::Ptr Package::createFromPath(const std::string &path){
         packageDirPath = finfo.path();
     }
 
-    std::ifstream instream(packagePath.toStdString(), std::ifstream::in | std::ifstream::binary);
-    if ( !instream.is_open() ){
-        THROW_EXCEPTION(lv::Exception, std::string("Cannot open file: ") + path, 1);
-    }
-
-    instream.seekg(0, std::ios::end);
-    size_t size = static_cast<size_t>(instream.tellg());
-    std::string buffer(size, ' ');
-    instream.seekg(0);
-    instream.read(&buffer[0], size);
+    std::string filePath = packagePath.toStdString();
 
     MLNode m;
-    ml::fromJson(buffer, m);
+    if ( !cache || !cache->lookup(filePath, m) ){
+        MLJsonView::Ptr view = MLJsonView::createFromFile(filePath);
+        m = view->root().toMLNode(manifestKeys());
+        if ( cache )
+            cache->store(filePath, m);
+    }
 
     return createFromNode(packageDirPath.toStdString(), packagePath.toStdString(), m);
 }
 
 /** This function actually creates the path pointer that is returned to the above function */
 Package::Ptr Package::createFromNode(const std::string& path, const std::string &filePath, const MLNode &m){
-    if ( !m.hasKey("name") || !m.hasKey("version") )
+    if ( !m.hasKey(field(NameField)) || !m.hasKey(field(VersionField)) )
         return Package::Ptr(nullptr);
 
 
-    Package::Ptr pt(new Package(path, filePath, m["name"].asString(), Version(m["version"].asString())));
+    Package::Ptr pt(new Package(
+        path, filePath, m[field(NameField)].asString(), Version(m[field(VersionField)].asString())
+    ));
 
-    if ( m.hasKey("dependencies") ){
-        MLNode::ObjectType dep = m["dependencies"].asObject();
+    if ( m.hasKey(field(DependenciesField)) ){
+        MLNode::ObjectType dep = m[field(DependenciesField)].asObject();
         for ( auto it = dep.begin(); it != dep.end(); ++it ){
             Package::Reference* dep = new Package::Reference(it->first, Version(it->second.asString()));
             pt->m_d->dependencies[dep->name.data()] = dep;
         }
     }
 
-    if ( m.hasKey("libraries") ){
-        MLNode::ObjectType libs = m["libraries"].asObject();
+    if ( m.hasKey(field(LibrariesField)) ){
+        MLNode::ObjectType libs = m[field(LibrariesField)].asObject();
         for ( auto it = libs.begin(); it != libs.end(); ++it ){
             MLNode libValue = it->second;
 
@@ -127,19 +170,19 @@ Package::Ptr Package::createFromNode(const std::string& path, const std::string
             }
         }
     }
-    if ( m.hasKey("internalLibraries") ){
-        MLNode::ArrayType libs = m["internalLibraries"].asArray();
+    if ( m.hasKey(field(InternalLibrariesField)) ){
+        MLNode::ArrayType libs = m[field(InternalLibrariesField)].asArray();
         for ( auto it = libs.begin(); it != libs.end(); ++it ){
             pt->m_d->internalLibraries.push_back(it->asString());
         }
     }
 
-    if ( m.hasKey("documentation" ) ){
-        pt->m_d->documentation = m["documentation"].asString();
+    if ( m.hasKey(field(DocumentationField)) ){
+        pt->m_d->documentation = m[field(DocumentationField)].asString();
     }
 
-    if ( m.hasKey("workspace") ){
-        const MLNode& workspace = m["workspace"];
+    if ( m.hasKey(field(WorkspaceField)) ){
+        const MLNode& workspace = m[field(WorkspaceField)];
         if ( workspace.hasKey("label") )
             pt->m_d->workspaceLabel = workspace["label"].asString();
 
@@ -12,6 +12,7 @@
 namespace lv{
 
 class MLNode;
+class ManifestCache;
 class PackageGraph;
 
 class PackagePrivate;
@@ -117,7 +118,7 @@ public:
     ~Package();
 
     static bool existsIn(const std::string& path);
-    static Package::Ptr createFromPath(const std::string& path);
+    static Package::Ptr createFromPath(const std::string& path, ManifestCache* cache = nullptr);
     static Package::Ptr createFromNode(const std::string &path, const std::string& filePath, const MLNode& m);
 
     const std::string& name() const;
@@ -1,6 +1,8 @@
 #include "packagegraph.h"
 #include "live/packagecontext.h"
 #include "live/plugincontext.h"
+#include "live/trace.h"
+#include "live/dependencygraph.h"
 #include "live/exception.h"
 #include "live/applicationcontext.h"
 #include "live/libraryloadpath.h"
@@ -10,6 +12,8 @@
 #include <list>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace lv{
 
@@ -25,6 +29,29 @@ namespace{
         tokens.push_back(text.substr(start));
         return tokens;
     }
+
+    void loadPackageWithDependencies(
+        PackageGraph* graph,
+        const Package::Ptr& package,
+        std::list<Package::Reference>& missing,
+        bool addLibraries,
+        std::unordered_set<std::string>& visited)
+    {
+        if ( !visited.insert(package->path()).second )
+            return;
+
+        graph->loadPackage(package, addLibraries);
+
+        for ( auto it = package->dependencies().begin(); it != package->dependencies().end(); ++it ){
+            Package::Reference* ref = it->second;
+            Package::Ptr p = graph->findPackage(*ref);
+            if ( p != nullptr ){
+                loadPackageWithDependencies(graph, p, missing, addLibraries, visited);
+            } else {
+                missing.push_back(*ref);
+            }
+        }
+    }
 }
 
 /// \private
@@ -34,6 +61,109 @@ public:
     std::vector<std::string> packageImportPaths;
     std::map<std::string, Package::Ptr> packages;
     std::map<std::string, PackageGraph::LibraryNode*> libraries;
+    std::unordered_map<std::string, Plugin::Ptr> importCache;
+    ManifestCache::Ptr manifestCache;
+
+    DependencyGraph packageDependencies;
+    std::vector<Package::Ptr> packageNodes;
+    std::unordered_map<const Package*, DependencyGraph::Node> packageIndex;
+    DependencyGraph pluginDependencies;
+    std::vector<Plugin::Ptr> pluginNodes;
+    std::unordered_map<const Plugin*, DependencyGraph::Node> pluginIndex;
+
+    DependencyGraph::Node packageNode(const Package::Ptr& package){
+        auto it = packageIndex.find(package.get());
+        if ( it != packageIndex.end() )
+            return it->second;
+
+        DependencyGraph::Node node = packageDependencies.addNode();
+        packageNodes.push_back(package);
+        packageIndex[package.get()] = node;
+        return node;
+    }
+
+    DependencyGraph::Node pluginNode(const Plugin::Ptr& plugin){
+        auto it = pluginIndex.find(plugin.get());
+        if ( it != pluginIndex.end() )
+            return it->second;
+
+        DependencyGraph::Node node = pluginDependencies.addNode();
+        pluginNodes.push_back(plugin);
+        pluginIndex[plugin.get()] = node;
+        return node;
+    }
+
+    bool findPackageNode(const Package::Ptr& package, DependencyGraph::Node& node) const{
+        auto it = packageIndex.find(package.get());
+        if ( it == packageIndex.end() )
+            return false;
+        node = it->second;
+        return true;
+    }
+
+    bool findPluginNode(const Plugin::Ptr& plugin, DependencyGraph::Node& node) const{
+        auto it = pluginIndex.find(plugin.get());
+        if ( it == pluginIndex.end() )
+            return false;
+        node = it->second;
+        return true;
+    }
+
+    bool isCurrentPackageNode(DependencyGraph::Node node) const{
+        // skip packages that were replaced by a newer version
+        const Package::Ptr& package = packageNodes[node];
+        auto it = packages.find(package->name());
+        return it == packages.end() || it->second == package;
+    }
+
+    void clearDependencies(){
+        packageNodes.clear();
+        packageIndex.clear();
+        pluginNodes.clear();
+        pluginIndex.clear();
+        packageDependencies.clear();
+        pluginDependencies.clear();
+    }
+
+    void rebuildDependencies(const std::vector<Package::Ptr>& remaining){
+        clearDependencies();
+
+        std::unordered_set<const Package*> remainingSet;
+        for ( auto it = remaining.begin(); it != remaining.end(); ++it )
+            remainingSet.insert(it->get());
+
+        for ( auto it = remaining.begin(); it != remaining.end(); ++it )
+            packageNode(*it);
+
+        for ( auto it = remaining.begin(); it != remaining.end(); ++it ){
+            Package::Context* context = (*it)->context();
+
+            // drop links to packages that are no longer part of the graph
+            for ( auto depIt = context->dependencies.begin(); depIt != context->dependencies.end(); ){
+                if ( remainingSet.find(depIt->get()) == remainingSet.end() ){
+                    depIt = context->dependencies.erase(depIt);
+                } else {
+                    packageDependencies.addEdge(packageNode(*it), packageNode(*depIt));
+                    ++depIt;
+                }
+            }
+            for ( auto depIt = context->dependents.begin(); depIt != context->dependents.end(); ){
+                if ( remainingSet.find(depIt->get()) == remainingSet.end() )
+                    depIt = context->dependents.erase(depIt);
+                else
+                    ++depIt;
+            }
+
+            for ( auto plIt = context->plugins.begin(); plIt != context->plugins.end(); ++plIt ){
+                const Plugin::Ptr& plugin = plIt->second;
+                if ( !plugin->context() )
+                    continue;
+                auto& localDependencies = plugin->context()->localDependencies;
+                for ( auto depIt = localDependencies.begin(); depIt != localDependencies.end(); ++depIt )
+                    pluginDependencies.addEdge(pluginNode(plugin), pluginNode(*depIt));
+            }
+        }
+    }
 };
 
 /**
@@ -42,6 +172,10 @@ public:
  *
  * It also stores all the libraries, stores in the LibraryNode structure.
  * We also check for dependency cycles on multiple levels: plugins, packages, Elements files
+ *
+ * Dependencies between packages and between plugins of the same package are mirrored in an indexed
+ * lv::DependencyGraph, which answers direct and transitive dependency queries from cached results, and provides
+ * the order in which packages can be initialized.
  * \ingroup lvbase
  */
 
@@ -73,6 +207,7 @@ void PackageGraph::loadPackage(const Package::Ptr &p, bool addLibraries){
         }
 
         m_d->packages[p->name()] = p;
+        m_d->packageNode(p);
 
         vlog("lvbase-packagegraph").v() << "Loaded package \'" + p->name() << "\' [" + p->version().toString() + "]";
 
@@ -95,6 +230,7 @@ void PackageGraph::loadPackage(const Package::Ptr &p, bool addLibraries){
 
             p->assignContext(this);
             m_d->packages[p->name()] = p;
+            m_d->packageNode(p);
 
             if ( addLibraries ){
                 for ( auto it = p->libraries().begin(); it != p->libraries().end(); ++it ){
@@ -106,21 +242,12 @@ void PackageGraph::loadPackage(const Package::Ptr &p, bool addLibraries){
     }
 }
 
-/** Recursive loader that also loads the necessarys dependencies */
+/** Recursive loader that also loads the necessarys dependencies. Each package is visited once. */
 void PackageGraph::loadPackageWithDependencies(
     const Package::Ptr &package, std::list<Package::Reference> &missing, bool addLibraries)
 {
-    loadPackage(package, addLibraries);
-
-    for ( auto it = package->dependencies().begin(); it != package->dependencies().end(); ++it ){
-        Package::Reference* ref = it->second;
-        Package::Ptr p = findPackage(*ref);
-        if ( p != nullptr ){
-            loadPackageWithDependencies(p, missing, addLibraries);
-        } else {
-            missing.push_back(*ref);
-        }
-    }
+    std::unordered_set<std::string> visited;
+    lv::loadPackageWithDependencies(this, package, missing, addLibraries, visited);
 }
 
 /** */
@@ -139,44 +266,38 @@ void PackageGraph::addDependency(const Package::Ptr &package, const Package::Ptr
         if ( internalsIt == internals().end() ){
             THROW_EXCEPTION(lv::Exception, "Failed to find package: " + dependsOn->name(), 2);
         } else {
-            if ( !hasDependency(package, dependsOn) )
+            if ( !hasDependency(package, dependsOn) ){
                 package->context()->dependencies.push_back(dependsOn);
+                m_d->packageDependencies.addEdge(m_d->packageNode(package), m_d->packageNode(dependsOn));
+            }
             return;
         }
     }
     if ( !hasDependency(package, dependsOn ) ){
-        package->context()->dependencies.push_back(dependsOn);
-        dependsOn->context()->dependents.push_back(package);
+        DependencyGraph::Node packageNode   = m_d->packageNode(package);
+        DependencyGraph::Node dependsOnNode = m_d->packageNode(dependsOn);
 
-        PackageGraph::CyclesResult<Package::Ptr> cr = checkCycles(package);
-        if ( cr.found() ){
-            std::stringstream ss;
-
-            for ( auto it = cr.path().begin(); it != cr.path().end(); ++it ){
-                Package::Ptr n = *it;
+        // the new edge closes a cycle if the dependency already reaches the package
+        if ( packageNode == dependsOnNode || m_d->packageDependencies.reaches(dependsOnNode, packageNode) ){
+            std::vector<DependencyGraph::Node> path;
+            if ( packageNode == dependsOnNode )
+                path.push_back(dependsOnNode);
+            else
+                path = m_d->packageDependencies.path(dependsOnNode, packageNode);
 
-                if ( it != cr.path().begin() ){
-                    ss << " -> ";
-                }
-
-                ss << n->name() << "[" << n->version().toString() << "]";
-            }
-
-            for ( auto it = package->context()->dependencies.begin(); it != package->context()->dependencies.end(); ++it ){
-                if ( *it == dependsOn ){
-                    package->context()->dependencies.erase(it);
-                    break;
-                }
-            }
-            for ( auto it = dependsOn->context()->dependents.begin(); it != dependsOn->context()->dependents.end(); ++it ){
-                if ( *it == package ){
-                    dependsOn->context()->dependents.erase(it);
-                    break;
-                }
+            std::stringstream ss;
+            ss << package->name() << "[" << package->version().toString() << "]";
+            for ( auto it = path.begin(); it != path.end(); ++it ){
+                Package::Ptr n = m_d->packageNodes[*it];
+                ss << " -> " << n->name() << "[" << n->version().toString() << "]";
             }
 
             THROW_EXCEPTION(lv::Exception, "Package dependency cycle found: "  + ss.str(), 4);
         }
+
+        package->context()->dependencies.push_back(dependsOn);
+        dependsOn->context()->dependents.push_back(package);
+        m_d->packageDependencies.addEdge(packageNode, dependsOnNode);
     }
 
 }
@@ -184,18 +305,19 @@ void PackageGraph::addDependency(const Package::Ptr &package, const Package::Ptr
 /** Check if there are cycles between packages, starting from the given packages */
 PackageGraph::CyclesResult<Package::Ptr> PackageGraph::checkCycles(const Package::Ptr &p){
     auto it = m_d->packages.find(p->name());
-    if ( it == m_d->packages.end() && p->name() != ".")
+    if ( (it == m_d->packages.end() && p->name() != ".") || p->contextOwner() != this )
         THROW_EXCEPTION(lv::Exception, "Failed to find package for cycles: " + p->name(), 2);
 
+    DependencyGraph::Node node;
+    if ( !m_d->findPackageNode(p, node) || !m_d->packageDependencies.reaches(node, node) )
+        return PackageGraph::CyclesResult<Package::Ptr>(PackageGraph::CyclesResult<Package::Ptr>::NotFound);
+
     std::list<Package::Ptr> path;
-    path.push_back(p);
+    std::vector<DependencyGraph::Node> nodePath = m_d->packageDependencies.path(node, node);
+    for ( auto it = nodePath.begin(); it != nodePath.end(); ++it )
+        path.push_back(m_d->packageNodes[*it]);
 
-    for ( auto it = p->context()->dependencies.begin(); it != p->context()->dependencies.end(); ++it ){
-        PackageGraph::CyclesResult<Package::Ptr> cr = checkCycles(p, *it, path);
-        if ( cr.found() )
-            return cr;
-    }
-    return PackageGraph::CyclesResult<Package::Ptr>(PackageGraph::CyclesResult<Package::Ptr>::NotFound);
+    return PackageGraph::CyclesResult<Package::Ptr>(PackageGraph::CyclesResult<Package::Ptr>::Found, path);
 }
 
 /** Check if there are cycles between plugins, starting from the given plugin */
@@ -203,45 +325,83 @@ PackageGraph::CyclesResult<Plugin::Ptr> PackageGraph::checkCycles(const Plugin::
     if ( p->context() == nullptr || p->context()->packageGraph != this )
         THROW_EXCEPTION(lv::Exception, "Failed to find loaded plugin for cycles: " + p->name(), 2);
 
+    DependencyGraph::Node node;
+    if ( !m_d->findPluginNode(p, node) || !m_d->pluginDependencies.reaches(node, node) )
+        return PackageGraph::CyclesResult<Plugin::Ptr>(PackageGraph::CyclesResult<Plugin::Ptr>::NotFound);
+
     std::list<Plugin::Ptr> path;
-    path.push_back(p);
+    std::vector<DependencyGraph::Node> nodePath = m_d->pluginDependencies.path(node, node);
+    for ( auto it = nodePath.begin(); it != nodePath.end(); ++it )
+        path.push_back(m_d->pluginNodes[*it]);
 
-    for ( auto it = p->context()->localDependencies.begin(); it != p->context()->localDependencies.end(); ++it ){
-        PackageGraph::CyclesResult<Plugin::Ptr> cr = checkCycles(p, *it, path);
-        if ( cr.found() )
-            return cr;
-    }
-    return PackageGraph::CyclesResult<Plugin::Ptr>(PackageGraph::CyclesResult<Plugin::Ptr>::NotFound);
+    return PackageGraph::CyclesResult<Plugin::Ptr>(PackageGraph::CyclesResult<Plugin::Ptr>::Found, path);
 }
 
-PackageGraph::CyclesResult<Package::Ptr> PackageGraph::checkCycles(
-        const Package::Ptr &p, Package::Ptr current, std::list<Package::Ptr> path)
-{
-    path.push_back(current);
-    if ( current.get() == p.get() )
-        return PackageGraph::CyclesResult<Package::Ptr>(PackageGraph::CyclesResult<Package::Ptr>::Found, path);
+/**
+ * \brief Checks wether \p package depends on \p dependency, either directly or through other packages
+ */
+bool PackageGraph::dependsOn(const Package::Ptr &package, const Package::Ptr &dependency) const{
+    if ( package->contextOwner() != this || dependency->contextOwner() != this )
+        return false;
 
-    for ( auto it = current->context()->dependencies.begin(); it != current->context()->dependencies.end(); ++it ){
-        PackageGraph::CyclesResult<Package::Ptr> cr = checkCycles(p, *it, path);
-        if ( cr.found() )
-            return cr;
-    }
-    return PackageGraph::CyclesResult<Package::Ptr>(PackageGraph::CyclesResult<Package::Ptr>::NotFound);
+    DependencyGraph::Node packageNode, dependencyNode;
+    if ( !m_d->findPackageNode(package, packageNode) || !m_d->findPackageNode(dependency, dependencyNode) )
+        return false;
+    return m_d->packageDependencies.reaches(packageNode, dependencyNode);
 }
 
-PackageGraph::CyclesResult<Plugin::Ptr> PackageGraph::checkCycles(
-        const Plugin::Ptr &p, Plugin::Ptr current, std::list<Plugin::Ptr> path)
-{
-    path.push_back(current);
-    if ( current.get() == p.get() )
-        return PackageGraph::CyclesResult<Plugin::Ptr>(PackageGraph::CyclesResult<Plugin::Ptr>::Found, path);
+/**
+ * \brief Checks wether \p plugin depends on \p dependency within the same package, either directly or through
+ * other plugins
+ */
+bool PackageGraph::dependsOn(const Plugin::Ptr &plugin, const Plugin::Ptr &dependency) const{
+    if ( !plugin->context() || plugin->context()->packageGraph != this )
+        return false;
+    if ( !dependency->context() || dependency->context()->packageGraph != this )
+        return false;
+
+    DependencyGraph::Node pluginNode, dependencyNode;
+    if ( !m_d->findPluginNode(plugin, pluginNode) || !m_d->findPluginNode(dependency, dependencyNode) )
+        return false;
+    return m_d->pluginDependencies.reaches(pluginNode, dependencyNode);
+}
+
+/**
+ * \brief Returns the packages in this graph, each one after all the packages it depends on
+ */
+std::vector<Package::Ptr> PackageGraph::packageLoadOrder() const{
+    std::vector<Package::Ptr> result;
+
+    std::vector<DependencyGraph::Node> order = m_d->packageDependencies.topologicalOrder();
+    for ( auto it = order.begin(); it != order.end(); ++it ){
+        if ( m_d->isCurrentPackageNode(*it) )
+            result.push_back(m_d->packageNodes[*it]);
+    }
+
+    return result;
+}
 
-    for ( auto it = current->context()->localDependencies.begin(); it != current->context()->localDependencies.end(); ++it ){
-        PackageGraph::CyclesResult<Plugin::Ptr> cr = checkCycles(p, *it, path);
-        if ( cr.found() )
-            return cr;
+/**
+ * \brief Groups the packages in this graph into levels, where each package depends only on packages from previous
+ * levels
+ *
+ * Packages within the same level can be initialized in parallel, once all previous levels are initialized.
+ */
+std::vector<std::vector<Package::Ptr> > PackageGraph::packageLoadLevels() const{
+    std::vector<std::vector<Package::Ptr> > result;
+
+    std::vector<std::vector<DependencyGraph::Node> > levels = m_d->packageDependencies.levels();
+    for ( auto levelIt = levels.begin(); levelIt != levels.end(); ++levelIt ){
+        std::vector<Package::Ptr> level;
+        for ( auto it = levelIt->begin(); it != levelIt->end(); ++it ){
+            if ( m_d->isCurrentPackageNode(*it) )
+                level.push_back(m_d->packageNodes[*it]);
+        }
+        if ( !level.empty() )
+            result.push_back(level);
     }
-    return PackageGraph::CyclesResult<Plugin::Ptr>(PackageGraph::CyclesResult<Plugin::Ptr>::NotFound);
+
+    return result;
 }
 
 /**
@@ -339,9 +499,20 @@ void PackageGraph::loadLibraries(){
 
 /**
  * \brief Clears all packages from the graph
+ *
+ * Internal packages owned by this graph remain available, so the dependency index is rebuilt from them, and their
+ * links to the cleared packages are dropped.
  */
 void PackageGraph::clearPackages(){
     m_d->packages.clear();
+    m_d->importCache.clear();
+
+    std::vector<Package::Ptr> remaining;
+    for ( auto it = internals().begin(); it != internals().end(); ++it ){
+        if ( it->second->contextOwner() == this )
+            remaining.push_back(it->second);
+    }
+    m_d->rebuildDependencies(remaining);
 }
 
 /**
@@ -394,7 +565,7 @@ Package::Ptr PackageGraph::findPackage(Package::Reference ref) const{
     for ( auto it = paths.begin(); it != paths.end(); ++it ){
         std::string path = *it + "/" + ref.name.data();
         if ( Package::existsIn(path) ){
-            Package::Ptr p = Package::createFromPath(path);
+            Package::Ptr p = Package::createFromPath(path, m_d->manifestCache.get());
             if ( p->version().majorNumber() == ref.version.majorNumber() && p->version() > ref.version ){
                 return p;
             }
@@ -402,7 +573,7 @@ Package::Ptr PackageGraph::findPackage(Package::Reference ref) const{
 
         std::string pathMajor = path + "." + std::to_string(ref.version.majorNumber());
         if ( Package::existsIn(pathMajor) ){
-            Package::Ptr p = Package::createFromPath(path);
+            Package::Ptr p = Package::createFromPath(path, m_d->manifestCache.get());
             if ( p->version().majorNumber() == ref.version.majorNumber() && p->version() > ref.version ){
                 return p;
             }
@@ -410,7 +581,7 @@ Package::Ptr PackageGraph::findPackage(Package::Reference ref) const{
 
         std::string pathMajorMinor = pathMajor + "." + std::to_string(ref.version.minorNumber());
         if ( Package::existsIn(pathMajorMinor) ){
-            Package::Ptr p = Package::createFromPath(path);
+            Package::Ptr p = Package::createFromPath(path, m_d->manifestCache.get());
             if ( p->version().majorNumber() == ref.version.majorNumber() && p->version() > ref.version ){
                 return p;
             }
@@ -430,7 +601,7 @@ Package::Ptr PackageGraph::findPackage(const std::string &packageName) const{
     for ( auto it = paths.begin(); it != paths.end(); ++it ){
         std::string path = *it + "/" + packageName;
         if ( Package::existsIn(path) ){
-            Package::Ptr p = Package::createFromPath(path);
+            Package::Ptr p = Package::createFromPath(path, m_d->manifestCache.get());
 
             if ( foundPackage == nullptr ){
                 foundPackage = p;
@@ -494,6 +665,20 @@ void PackageGraph::setPackageImportPaths(const std::vector<std::string> &paths){
     m_d->packageImportPaths = paths;
 }
 
+/** Returns the cache used when reading package and plugin manifests, or null if there isn't one */
+const ManifestCache::Ptr &PackageGraph::manifestCache() const{
+    return m_d->manifestCache;
+}
+
+/**
+ * \brief Sets the \p cache used when reading package and plugin manifests
+ *
+ * The cache can be shared between multiple graphs.
+ */
+void PackageGraph::setManifestCache(const ManifestCache::Ptr &cache){
+    m_d->manifestCache = cache;
+}
+
 /**
  * \brief Adds internal package
  */
@@ -559,11 +744,18 @@ void PackageGraph::loadRunningPackageAndPlugin(const Package::Ptr &package, cons
  * \brief Load plugin given the import segment
  */
 Plugin::Ptr PackageGraph::loadPlugin(const std::string &importSegment, Plugin::Ptr requestingPlugin){
+    if ( !requestingPlugin ){
+        auto it = m_d->importCache.find(importSegment);
+        if ( it != m_d->importCache.end() )
+            return it->second;
+    }
     return loadPlugin(splitString(importSegment, '.'), requestingPlugin);
 }
 
 /**
  * \brief Loads plugin given split-up import segments
+ *
+ * Plugins resolved without a \p requestingPlugin are cached by their import id until the packages are cleared.
  */
 Plugin::Ptr PackageGraph::loadPlugin(const std::vector<std::string> &importSegments, Plugin::Ptr requestingPlugin){
     PackageGraphPrivate* d = m_d;
@@ -571,6 +763,18 @@ Plugin::Ptr PackageGraph::loadPlugin(const std::vector<std::string> &importSegme
     if ( importSegments.empty() )
         THROW_EXCEPTION(lv::Exception, "Given import path is empty.", 5);
 
+    vtrace("lvbase", "PackageGraph::loadPlugin", importSegments[0]);
+
+    if ( !requestingPlugin && !d->importCache.empty() ){
+        std::string importId = importSegments[0];
+        for ( size_t i = 1; i < importSegments.size(); ++i )
+            importId += "." + importSegments[i];
+
+        auto it = d->importCache.find(importId);
+        if ( it != d->importCache.end() )
+            return it->second;
+    }
+
     std::string packageName = importSegments[0];
 
     Package::Ptr foundPackage = nullptr;
@@ -618,13 +822,15 @@ Plugin::Ptr PackageGraph::loadPlugin(const std::vector<std::string> &importSegme
 
         auto pluginIt = foundPackage->context()->plugins.find(importId);
         if ( pluginIt != foundPackage->context()->plugins.end() ){
+            if ( !requestingPlugin )
+                d->importCache[importId] = pluginIt->second;
             return pluginIt->second;
         }
 
         if ( !Plugin::existsIn(pluginPath) )
             THROW_EXCEPTION(lv::Exception, "No \'live.plugin.json\' file has been found in " + pluginPath, 7);
 
-        Plugin::Ptr plugin = Plugin::createFromPath(pluginPath);
+        Plugin::Ptr plugin = Plugin::createFromPath(pluginPath, d->manifestCache.get());
         plugin->assignContext(this);
         plugin->context()->package  = foundPackage;
         plugin->context()->importId = importId;
@@ -635,6 +841,8 @@ Plugin::Ptr PackageGraph::loadPlugin(const std::vector<std::string> &importSegme
         vlog("lvbase-packagegraph").v() << "Loaded plugin: " << importId;
 
         foundPackage->context()->plugins[importId] = plugin;
+        if ( !requestingPlugin )
+            d->importCache[importId] = plugin;
 
         return plugin;
     }
@@ -666,35 +874,23 @@ void PackageGraph::addDependency(const Plugin::Ptr& plugin, const Plugin::Ptr& d
     if ( plugin->context()->package.get() == dependsOn->context()->package.get() ){ // within the same package
 
         if ( !hasDependency(plugin, dependsOn) ){
-            plugin->context()->localDependencies.push_back(dependsOn);
-            dependsOn->context()->localDependents.push_back(plugin);
+            DependencyGraph::Node pluginNode    = m_d->pluginNode(plugin);
+            DependencyGraph::Node dependsOnNode = m_d->pluginNode(dependsOn);
 
-            PackageGraph::CyclesResult<Plugin::Ptr> cr = checkCycles(plugin);
-            if ( cr.found() ){
-                std::stringstream ss;
-
-                for ( auto it = cr.path().begin(); it != cr.path().end(); ++it ){
-                    Plugin::Ptr n = *it;
-                    if ( it != cr.path().begin() )
-                        ss << " -> ";
-                    ss << n->name();
-                }
+            if ( m_d->pluginDependencies.reaches(dependsOnNode, pluginNode) ){
+                std::vector<DependencyGraph::Node> path = m_d->pluginDependencies.path(dependsOnNode, pluginNode);
 
-                for ( auto it = plugin->context()->localDependencies.begin(); it != plugin->context()->localDependencies.end(); ++it ){
-                    if ( *it == dependsOn ){
-                        plugin->context()->localDependencies.erase(it);
-                        break;
-                    }
-                }
-                for ( auto it = dependsOn->context()->localDependents.begin(); it != dependsOn->context()->localDependents.end(); ++it ){
-                    if ( *it == plugin ){
-                        dependsOn->context()->localDependents.erase(it);
-                        break;
-                    }
-                }
+                std::stringstream ss;
+                ss << plugin->name();
+                for ( auto it = path.begin(); it != path.end(); ++it )
+                    ss << " -> " << m_d->pluginNodes[*it]->name();
 
                 THROW_EXCEPTION(lv::Exception, "Plugin dependency cycle found: "  + ss.str(), 4);
             }
+
+            plugin->context()->localDependencies.push_back(dependsOn);
+            dependsOn->context()->localDependents.push_back(plugin);
+            m_d->pluginDependencies.addEdge(pluginNode, dependsOnNode);
         }
 
     } else { // add package dependency instead
@@ -703,19 +899,25 @@ void PackageGraph::addDependency(const Plugin::Ptr& plugin, const Plugin::Ptr& d
 }
 
 bool PackageGraph::hasDependency(const Package::Ptr &package, const Package::Ptr &dependency){
-    for ( auto it = package->context()->dependencies.begin(); it != package->context()->dependencies.end(); ++it ){
-        if ( *it == dependency )
-            return true;
-    }
-    return false;
+    if ( package->contextOwner() != this || dependency->contextOwner() != this )
+        return false;
+
+    DependencyGraph::Node packageNode, dependencyNode;
+    if ( !m_d->findPackageNode(package, packageNode) || !m_d->findPackageNode(dependency, dependencyNode) )
+        return false;
+    return m_d->packageDependencies.hasEdge(packageNode, dependencyNode);
 }
 
 bool PackageGraph::hasDependency(const Plugin::Ptr &plugin, const Plugin::Ptr &dependency){
-    for ( auto it = plugin->context()->localDependencies.begin(); it != plugin->context()->localDependencies.end(); ++it ){
-        if ( *it == dependency )
-            return true;
-    }
-    return false;
+    if ( !plugin->context() || plugin->context()->packageGraph != this )
+        return false;
+    if ( !dependency->context() || dependency->context()->packageGraph != this )
+        return false;
+
+    DependencyGraph::Node pluginNode, dependencyNode;
+    if ( !m_d->findPluginNode(plugin, pluginNode) || !m_d->findPluginNode(dependency, dependencyNode) )
+        return false;
+    return m_d->pluginDependencies.hasEdge(pluginNode, dependencyNode);
 }
 
 std::string PackageGraph::toString(Package::Ptr package, const std::string &indent) const{
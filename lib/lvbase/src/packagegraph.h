@@ -4,6 +4,7 @@
 #include "live/lvbaseglobal.h"
 #include "live/package.h"
 #include "live/plugin.h"
+#include "live/manifestcache.h"
 #include <vector>
 
 #include <vector>
@@ -68,6 +69,11 @@ public:
     CyclesResult<Package::Ptr> checkCycles(const Package::Ptr& p);
     CyclesResult<Plugin::Ptr> checkCycles(const Plugin::Ptr& p);
 
+    bool dependsOn(const Package::Ptr& package, const Package::Ptr& dependency) const;
+    bool dependsOn(const Plugin::Ptr& plugin, const Plugin::Ptr& dependency) const;
+    std::vector<Package::Ptr> packageLoadOrder() const;
+    std::vector<std::vector<Package::Ptr> > packageLoadLevels() const;
+
     void clearPackages();
     void clearLibraries();
 
@@ -87,6 +93,9 @@ public:
     const std::vector<std::string>& packageImportPaths() const;
     void setPackageImportPaths(const std::vector<std::string>& paths);
 
+    const ManifestCache::Ptr& manifestCache() const;
+    void setManifestCache(const ManifestCache::Ptr& cache);
+
     static void addInternalPackage(const Package::Ptr& package);
     static std::map<std::string, Package::Ptr>& internals();
 
@@ -105,9 +114,6 @@ private:
     bool hasDependency(const Package::Ptr& package, const Package::Ptr& dependency);
     bool hasDependency(const Plugin::Ptr& plugin, const Plugin::Ptr& dependency);
 
-    PackageGraph::CyclesResult<Package::Ptr> checkCycles(const Package::Ptr &p, Package::Ptr current, std::list<Package::Ptr> path);
-    PackageGraph::CyclesResult<Plugin::Ptr> checkCycles(const Plugin::Ptr &p, Plugin::Ptr current, std::list<Plugin::Ptr> path);
-
     std::string toString(Package::Ptr package, const std::string& indent) const;
     std::string toStringRecurse(Package::Ptr package, const std::string& indent) const;
 
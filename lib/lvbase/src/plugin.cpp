@@ -3,6 +3,8 @@
 
 #include "lockedfileiosession.h"
 #include "live/mlnodetojson.h"
+#include "live/mljsonview.h"
+#include "live/manifestcache.h"
 #include "live/exception.h"
 #include "live/package.h"
 #include <list>
@@ -24,6 +26,43 @@
 
 namespace lv{
 
+namespace{
+
+// Fields read by createFromNode, which are the only ones decoded from the manifest file
+enum PluginField{
+    NameField,
+    PackageField,
+    PalettesField,
+    DependenciesField,
+    ModulesField,
+    LibraryModulesField,
+    TotalPluginFields
+};
+
+const char* pluginFieldNames[] = {
+    "name",
+    "package",
+    "palettes",
+    "dependencies",
+    "modules",
+    "libraryModules"
+};
+
+static_assert(
+    sizeof(pluginFieldNames) / sizeof(pluginFieldNames[0]) == TotalPluginFields, "Each manifest field needs a name"
+);
+
+const char* field(PluginField f){
+    return pluginFieldNames[f];
+}
+
+const std::vector<std::string>& manifestKeys(){
+    static const std::vector<std::string> keys(pluginFieldNames, pluginFieldNames + TotalPluginFields);
+    return keys;
+}
+
+} // namespace
+
 const char* Plugin::fileName = "live.plugin.json";
 
 /// \private
@@ -56,8 +95,12 @@ bool Plugin::existsIn(const std::string &path){
     return finfo.exists();
 }
 
-/** Creates plugin from a given path */
-Plugin::Ptr Plugin::createFromPath(const std::string &path){
+/**
+ * \brief Creates plugin from a given path
+ *
+ * If a \p cache is given, the manifest is only parsed if it's not cached or has changed since.
+ */
+Plugin::Ptr Plugin::createFromPath(const std::string &path, ManifestCache *cache){
     QString pluginPath = QString::fromStdString(path);
     QString pluginDirPath;
 
@@ -69,29 +112,25 @@ Plugin::Ptr Plugin::createFromPath(const std::string &path){
         pluginDirPath = finfo.path();
     }
 
-    std::ifstream instream(pluginPath.toStdString(), std::ifstream::in | std::ifstream::binary);
-    if ( !instream.is_open() ){
-        THROW_EXCEPTION(lv::Exception, std::string("Cannot open file: ") + path, 1);
-    }
-
-    instream.seekg(0, std::ios::end);
-    size_t size = static_cast<size_t>(instream.tellg());
-    std::string buffer(size, ' ');
-    instream.seekg(0);
-    instream.read(&buffer[0], static_cast<std::streamsize>(size));
+    std::string filePath = pluginPath.toStdString();
 
     MLNode m;
-    ml::fromJson(buffer, m);
+    if ( !cache || !cache->lookup(filePath, m) ){
+        MLJsonView::Ptr view = MLJsonView::createFromFile(filePath);
+        m = view->root().toMLNode(manifestKeys());
+        if ( cache )
+            cache->store(filePath, m);
+    }
 
     return createFromNode(pluginDirPath.toStdString(), pluginPath.toStdString(), m);
 }
 
 /** Creates plugin from a given MLNode*/
 Plugin::Ptr Plugin::createFromNode(const std::string &path, const std::string &filePath, const MLNode &m){
-    if ( !m.hasKey("name") || !m.hasKey("package") )
+    if ( !m.hasKey(field(NameField)) || !m.hasKey(field(PackageField)) )
         return Plugin::Ptr(nullptr);
 
-    QString package = QString::fromStdString(m["package"].asString());
+    QString package = QString::fromStdString(m[field(PackageField)].asString());
 
     QFileInfo finfo(package);
     if ( finfo.isRelative() ){
@@ -104,10 +143,10 @@ Plugin::Ptr Plugin::createFromNode(const std::string &path, const std::string &f
     }
 
 
-    Plugin::Ptr pt(new Plugin(path, filePath, m["name"].asString(), package.toStdString()));
+    Plugin::Ptr pt(new Plugin(path, filePath, m[field(NameField)].asString(), package.toStdString()));
 
-    if ( m.hasKey("palettes") ){
-        MLNode::ObjectType pal = m["palettes"].asObject();
+    if ( m.hasKey(field(PalettesField)) ){
+        MLNode::ObjectType pal = m[field(PalettesField)].asObject();
         for ( auto it = pal.begin(); it != pal.end(); ++it ){
             if ( it->second.type() == MLNode::Array ){
                 const MLNode::ArrayType& itArray = it->second.asArray();
@@ -120,22 +159,22 @@ Plugin::Ptr Plugin::createFromNode(const std::string &path, const std::string &f
         }
     }
 
-    if ( m.hasKey("dependencies") ){
-        MLNode::ArrayType dep = m["dependencies"].asArray();
+    if ( m.hasKey(field(DependenciesField)) ){
+        MLNode::ArrayType dep = m[field(DependenciesField)].asArray();
         for ( auto it = dep.begin(); it != dep.end(); ++it ){
             pt->m_d->dependencies.push_back(it->asString());
         }
     }
 
-    if ( m.hasKey("modules") ){
-        MLNode::ArrayType mod = m["modules"].asArray();
+    if ( m.hasKey(field(ModulesField)) ){
+        MLNode::ArrayType mod = m[field(ModulesField)].asArray();
         for ( auto it = mod.begin(); it != mod.end(); ++it ){
             pt->m_d->modules.push_back(it->asString());
         }
     }
 
-    if ( m.hasKey("libraryModules") ){
-        MLNode::ArrayType libmod = m["libraryModules"].asArray();
+    if ( m.hasKey(field(LibraryModulesField)) ){
+        MLNode::ArrayType libmod = m[field(LibraryModulesField)].asArray();
         for ( auto it = libmod.begin(); it != libmod.end(); ++it ){
             pt->m_d->libraryModules.push_back(it->asString());
         }
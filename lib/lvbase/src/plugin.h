@@ -11,6 +11,7 @@
 namespace lv{
 
 class MLNode;
+class ManifestCache;
 class PackageGraph;
 
 class PluginPrivate;
@@ -32,7 +33,7 @@ public:
     ~Plugin();
 
     static bool existsIn(const std::string& path);
-    static Plugin::Ptr createFromPath(const std::string& path);
+    static Plugin::Ptr createFromPath(const std::string& path, ManifestCache* cache = nullptr);
     static Plugin::Ptr createFromNode(const std::string &path, const std::string& filePath, const MLNode& m);
     static Plugin::Ptr createEmpty(const std::string& name);
 
@@ -0,0 +1,245 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "trace.h"
+#include "live/mlnode.h"
+#include "live/mlnodetojson.h"
+#include "live/exception.h"
+
+#include <chrono>
+#include <mutex>
+#include <fstream>
+
+namespace lv{
+
+namespace{
+
+/// \private
+class TraceRecorder{
+
+public:
+    TraceRecorder() : epoch(std::chrono::steady_clock::now()), threadCount(0){}
+
+    std::chrono::steady_clock::time_point epoch;
+    std::atomic<int>                      threadCount;
+    std::mutex                            eventsMutex;
+    std::vector<Trace::Event>             events;
+};
+
+TraceRecorder& recorder(){
+    static TraceRecorder tr;
+    return tr;
+}
+
+int currentThreadIndex(){
+    static thread_local int index = recorder().threadCount++;
+    return index;
+}
+
+void record(
+    char phase,
+    const char* category,
+    const char* name,
+    long long begin,
+    long long duration,
+    const std::string& detail)
+{
+    Trace::Event ev;
+    ev.phase     = phase;
+    ev.category  = category;
+    ev.name      = name;
+    ev.detail    = detail;
+    ev.timestamp = begin;
+    ev.duration  = duration;
+    ev.thread    = currentThreadIndex();
+
+    TraceRecorder& tr = recorder();
+    std::lock_guard<std::mutex> guard(tr.eventsMutex);
+    tr.events.push_back(ev);
+}
+
+}// namespace
+
+std::atomic<bool> Trace::m_enabled(false);
+
+/**
+ * \class lv::Trace
+ * \brief Low overhead recorder for timing events, exported in the Chrome trace event format
+ *
+ * Blocks of code are timed with the vtrace macro, which records a complete event when the block exits:
+ *
+ * \code
+ * void PackageGraph::loadPlugin(...){
+ *     vtrace("lvbase", "loadPlugin", importId);
+ *     ...
+ * }
+ * \endcode
+ *
+ * While tracing is disabled, a scope only checks a flag, and its detail is not evaluated. Recording is thread safe,
+ * and events from each thread are shown on a separate track. The result of toChromeJson() or save() can be opened
+ * in chrome://tracing or in the Perfetto UI.
+ *
+ * \ingroup lvbase
+ */
+
+/**
+ * \brief Starts recording events
+ */
+void Trace::enable(){
+    recorder();
+    m_enabled = true;
+}
+
+/**
+ * \brief Stops recording events. Events recorded so far are kept.
+ */
+void Trace::disable(){
+    m_enabled = false;
+}
+
+/**
+ * \brief Returns the number of microseconds since the trace epoch
+ */
+long long Trace::now(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - recorder().epoch
+    ).count();
+}
+
+/**
+ * \brief Records an instant event
+ */
+void Trace::instant(const char *category, const char *name, const std::string &detail){
+    if ( !isEnabled() )
+        return;
+    record('i', category, name, now(), 0, detail);
+}
+
+/**
+ * \brief Records an event that started at \p begin and lasted for \p duration microseconds
+ */
+void Trace::complete(
+        const char *category, const char *name, long long begin, long long duration, const std::string &detail)
+{
+    if ( !isEnabled() )
+        return;
+    record('X', category, name, begin, duration, detail);
+}
+
+/**
+ * \brief Returns a copy of the recorded events
+ */
+std::vector<Trace::Event> Trace::events(){
+    TraceRecorder& tr = recorder();
+    std::lock_guard<std::mutex> guard(tr.eventsMutex);
+    return tr.events;
+}
+
+/**
+ * \brief Removes all recorded events
+ */
+void Trace::clear(){
+    TraceRecorder& tr = recorder();
+    std::lock_guard<std::mutex> guard(tr.eventsMutex);
+    tr.events.clear();
+}
+
+/**
+ * \brief Serializes the recorded events in the Chrome trace event format
+ */
+void Trace::toChromeJson(std::string &result){
+    std::vector<Trace::Event> evs = events();
+
+    MLNode traceEvents(MLNode::Array);
+    for ( auto it = evs.begin(); it != evs.end(); ++it ){
+        MLNode ev = {
+            {"name", it->name},
+            {"cat", it->category},
+            {"ph", std::string(1, it->phase)},
+            {"ts", static_cast<MLNode::IntType>(it->timestamp)},
+            {"pid", 1},
+            {"tid", it->thread}
+        };
+        if ( it->phase == 'X' )
+            ev["dur"] = static_cast<MLNode::IntType>(it->duration);
+        else
+            ev["s"] = "t";
+        if ( !it->detail.empty() )
+            ev["args"] = {{"detail", it->detail}};
+
+        traceEvents.append(ev);
+    }
+
+    MLNode root = {
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"}
+    };
+    ml::toJson(root, result);
+}
+
+/**
+ * \brief Writes the recorded events to \p path in the Chrome trace event format
+ *
+ * Throws an lv::Exception if the file cannot be written.
+ */
+void Trace::save(const std::string &path){
+    std::string result;
+    toChromeJson(result);
+
+    std::ofstream outstream(path, std::ofstream::out | std::ofstream::binary);
+    if ( !outstream.is_open() )
+        THROW_EXCEPTION(lv::Exception, "Failed to write trace file: " + path, Exception::toCode("~File"));
+    outstream.write(result.data(), static_cast<std::streamsize>(result.size()));
+}
+
+// Trace::Scope
+// ------------
+
+/**
+ * \brief Starts timing the \p name scope
+ */
+Trace::Scope::Scope(const char *category, const char *name)
+    : m_category(category)
+    , m_name(name)
+    , m_begin(-1)
+{
+    if ( Trace::isEnabled() )
+        m_begin = Trace::now();
+}
+
+/**
+ * \brief Starts timing the \p name scope, attaching \p detail to the event
+ */
+Trace::Scope::Scope(const char *category, const char *name, const std::string &detail)
+    : m_category(category)
+    , m_name(name)
+    , m_begin(-1)
+{
+    if ( Trace::isEnabled() ){
+        m_detail = detail;
+        m_begin  = Trace::now();
+    }
+}
+
+/**
+ * \brief Records the event, if tracing was enabled when the scope started
+ */
+Trace::Scope::~Scope(){
+    if ( m_begin >= 0 )
+        Trace::complete(m_category, m_name, m_begin, Trace::now() - m_begin, m_detail);
+}
+
+}// namespace
@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LVTRACE_H
+#define LVTRACE_H
+
+#include "live/lvbaseglobal.h"
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+namespace lv{
+
+class LV_BASE_EXPORT Trace{
+
+public:
+    /**
+     * \class lv::Trace::Event
+     * \brief Recorded trace event
+     */
+    class Event{
+    public:
+        /** Event phase, 'X' for complete events and 'i' for instant events */
+        char        phase;
+        /** Category, used to filter events in the viewer */
+        const char* category;
+        /** Event name */
+        const char* name;
+        /** Optional detail, shown as an argument of the event */
+        std::string detail;
+        /** Start time, in microseconds since tracing was enabled */
+        long long   timestamp;
+        /** Duration in microseconds, 0 for instant events */
+        long long   duration;
+        /** Index of the recording thread, in the order threads first recorded an event */
+        int         thread;
+    };
+
+    /**
+     * \class lv::Trace::Scope
+     * \brief Records a complete event covering its lifetime, if tracing is enabled
+     *
+     * The \p category and \p name need to be string literals, or outlive the trace.
+     */
+    class LV_BASE_EXPORT Scope{
+
+        DISABLE_COPY(Scope);
+
+    public:
+        Scope(const char* category, const char* name);
+        Scope(const char* category, const char* name, const std::string& detail);
+        ~Scope();
+
+    private:
+        const char* m_category;
+        const char* m_name;
+        std::string m_detail;
+        long long   m_begin;
+    };
+
+public:
+    static void enable();
+    static void disable();
+    static bool isEnabled();
+
+    static long long now();
+    static void instant(const char* category, const char* name, const std::string& detail = std::string());
+    static void complete(
+        const char* category, const char* name, long long begin, long long duration,
+        const std::string& detail = std::string()
+    );
+
+    static std::vector<Event> events();
+    static void clear();
+
+    static void toChromeJson(std::string& result);
+    static void save(const std::string& path);
+
+private:
+    Trace();
+
+    static std::atomic<bool> m_enabled;
+};
+
+/**
+ * \brief Checks wether events are currently being recorded
+ */
+inline bool Trace::isEnabled(){
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+}// namespace
+
+#define LV_TRACE_CONCAT_IMPL(_a, _b) _a ## _b
+#define LV_TRACE_CONCAT(_a, _b) LV_TRACE_CONCAT_IMPL(_a, _b)
+#define LV_TRACE_EXPAND(_x) _x
+#define LV_TRACE_SELECT(_1, _2, _3, _macro, ...) _macro
+
+#define LV_TRACE_SCOPE(_category, _name) \
+    lv::Trace::Scope LV_TRACE_CONCAT(vtraceScope, __LINE__)(_category, _name)
+#define LV_TRACE_SCOPE_DETAIL(_category, _name, _detail) \
+    lv::Trace::Scope LV_TRACE_CONCAT(vtraceScope, __LINE__)( \
+        _category, _name, lv::Trace::isEnabled() ? std::string(_detail) : std::string() \
+    )
+
+/**
+ * \brief Records the remainder of the enclosing block as a trace event
+ *
+ * The optional detail is only evaluated while tracing is enabled, so it can be built inline.
+ *
+ * \code
+ * vtrace("lvbase", "loadPlugin", importId);
+ * \endcode
+ */
+#define vtrace(...) \
+    LV_TRACE_EXPAND(LV_TRACE_SELECT(__VA_ARGS__, LV_TRACE_SCOPE_DETAIL, LV_TRACE_SCOPE, )(__VA_ARGS__))
+
+#endif // LVTRACE_H
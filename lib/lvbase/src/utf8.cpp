@@ -1,16 +1,187 @@
 #include "utf8.h"
 #include "utf8proc.h"
 
-#include <locale>
-#include <functional>
 #include <algorithm>
-#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LV_UTF8_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace lv{
 
+namespace{
+
+inline int bitCount(unsigned int v){
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(v);
+#else
+    int count = 0;
+    for ( ; v; v &= v - 1 )
+        ++count;
+    return count;
+#endif
+}
+
+inline int highestBit(unsigned int v){
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(v);
+#else
+    int bit = 0;
+    while ( v >>= 1 )
+        ++bit;
+    return bit;
+#endif
+}
+
+/// Returns the number of leading bytes in \p data that are ascii
+size_t asciiPrefix(const char* data, size_t size){
+    size_t i = 0;
+#ifdef LV_UTF8_SSE2
+    for ( ; i + 16 <= size; i += 16 ){
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if ( _mm_movemask_epi8(chunk) )
+            break;
+    }
+#else
+    for ( ; i + 8 <= size; i += 8 ){
+        unsigned long long word;
+        std::memcpy(&word, data + i, 8);
+        if ( word & 0x8080808080808080ULL )
+            break;
+    }
+#endif
+    while ( i < size && !(static_cast<unsigned char>(data[i]) & 0x80) )
+        ++i;
+    return i;
+}
+
+/// Counts the bytes in \p data that start a code point, i.e. are not continuation bytes
+size_t countLeadBytes(const char* data, size_t size){
+    size_t count = 0;
+    size_t i = 0;
+#ifdef LV_UTF8_SSE2
+    // as signed values, continuation bytes (0x80-0xBF) are the ones below -64
+    const __m128i continuationLimit = _mm_set1_epi8(static_cast<char>(0xBF));
+    for ( ; i + 16 <= size; i += 16 ){
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        count += static_cast<size_t>(bitCount(static_cast<unsigned int>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(chunk, continuationLimit))
+        )));
+    }
+#endif
+    for ( ; i < size; ++i ){
+        if ( (static_cast<unsigned char>(data[i]) & 0xC0) != 0x80 )
+            ++count;
+    }
+    return count;
+}
+
+/// Returns the position of the last \p ch in the first \p size bytes of \p data, or npos
+size_t findLastByte(const char* data, size_t size, char ch){
+    size_t i = size;
+#ifdef LV_UTF8_SSE2
+    const __m128i needle = _mm_set1_epi8(ch);
+    while ( i >= 16 ){
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 16));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if ( mask )
+            return i - 16 + static_cast<size_t>(highestBit(mask));
+        i -= 16;
+    }
+#endif
+    while ( i > 0 ){
+        --i;
+        if ( data[i] == ch )
+            return i;
+    }
+    return std::string::npos;
+}
+
+/// Copies \p str, switching the case of ascii letters between \p from and \p to
+std::string* asciiCase(const std::string& str, char from, char to){
+    std::string* result = new std::string(str);
+    for ( auto it = result->begin(); it != result->end(); ++it ){
+        if ( *it >= from && *it <= to )
+            *it = static_cast<char>(*it ^ 0x20);
+    }
+    return result;
+}
+
+std::string* mapCodePoints(const std::string& str, utf8proc_int32_t (*map)(utf8proc_int32_t)){
+    std::string* result = new std::string;
+    result->reserve(str.size());
+
+    const utf8proc_uint8_t* strdata = reinterpret_cast<const utf8proc_uint8_t*>(str.data());
+    utf8proc_ssize_t strlength = static_cast<utf8proc_ssize_t>(str.size());
+
+    utf8proc_uint8_t encoded[4];
+    utf8proc_int32_t nextcodepoint;
+
+    while ( strlength > 0 ){
+        utf8proc_ssize_t charsize = utf8proc_iterate(strdata, strlength, &nextcodepoint);
+        if ( charsize <= 0 ){
+            result->clear();
+            return result;
+        }
+
+        strlength -= charsize;
+        strdata   += charsize;
+
+        utf8proc_ssize_t encodecharsize = utf8proc_encode_char(map(nextcodepoint), encoded);
+        if ( encodecharsize == 0 ){
+            encodecharsize = utf8proc_encode_char(nextcodepoint, encoded);
+            if ( encodecharsize == 0 ){
+                result->clear();
+                return result;
+            }
+        }
+        result->append(reinterpret_cast<const char*>(encoded), static_cast<size_t>(encodecharsize));
+    }
+
+    return result;
+}
+
+/// \private
+class Utf8InternTable{
+
+public:
+    class Hash{
+    public:
+        size_t operator()(const std::string* str) const{ return std::hash<std::string>()(*str); }
+    };
+    class Equal{
+    public:
+        bool operator()(const std::string* a, const std::string* b) const{ return *a == *b; }
+    };
+
+    std::mutex mutex;
+    std::unordered_map<const std::string*, std::shared_ptr<std::string>, Hash, Equal> entries;
+};
+
+Utf8InternTable& internTable(){
+    // not destroyed on exit, since interned strings can still be released by other static objects
+    static Utf8InternTable* table = new Utf8InternTable;
+    return *table;
+}
+
+}// namespace
+
 /**
  * \class lv::Utf8
  * \brief Encapsulates an Utf8 string
+ *
+ * The string data is immutable and shared between copies, so copying a Utf8 object is cheap, and copies
+ * compare equal by pointer.
+ *
+ * Validation, code point counting and reverse searches process 16 bytes at a time with SSE2 where available,
+ * and fall back to scalar code otherwise. Forward searches use std::string, which relies on the vectorized
+ * memchr of the C library.
+ *
  * \private
  */
 
@@ -62,7 +233,8 @@ size_t Utf8::find(const Utf8 &str, size_t offset) const{
 }
 
 size_t Utf8::findLast(char ch, size_t offset) const{
-    return m_data->rfind(ch, offset);
+    size_t searchSize = offset < m_data->size() ? offset + 1 : m_data->size();
+    return findLastByte(m_data->data(), searchSize, ch);
 }
 
 size_t Utf8::findLast(const char *str, size_t offset) const{
@@ -86,6 +258,8 @@ char Utf8::operator[](size_t index) const{
 }
 
 int Utf8::compare(const Utf8 &other) const{
+    if ( m_data == other.m_data )
+        return 0;
     return m_data->compare(other.data());
 }
 
@@ -138,80 +312,112 @@ bool Utf8::endsWith(char ch) const{
 }
 
 Utf8 Utf8::toLower() const{
-    utf8proc_int32_t nextcodepoint;
-
-    const char* strdata = m_data->c_str();
-    size_t strlength = length();
-
-    utf8proc_uint8_t* lowerCharDst = new utf8proc_uint8_t[4];
-
-    std::string* lowerStr = new std::string;
-    lowerStr->reserve(strlength);
-
-    while ( strlength > 0 ){
-        utf8proc_ssize_t charsize = utf8proc_iterate(reinterpret_cast<const utf8proc_uint8_t*>(strdata), -1, &nextcodepoint);
-        if ( charsize <= 0 ){
-            delete[] lowerCharDst;
-            return "";
-        }
+    if ( isAscii() )
+        return Utf8(asciiCase(*m_data, 'A', 'Z'));
+    return Utf8(mapCodePoints(*m_data, &utf8proc_tolower));
+}
 
-        strlength -= charsize;
-        strdata   += charsize;
+Utf8 Utf8::toUpper() const{
+    if ( isAscii() )
+        return Utf8(asciiCase(*m_data, 'a', 'z'));
+    return Utf8(mapCodePoints(*m_data, &utf8proc_toupper));
+}
 
-        utf8proc_int32_t lowercodepoint = utf8proc_tolower(nextcodepoint);
-        utf8proc_ssize_t encodecharsize = utf8proc_encode_char(lowercodepoint, lowerCharDst);
-        if ( encodecharsize == 0 ){
-            encodecharsize = utf8proc_encode_char(nextcodepoint, lowerCharDst);
-            if ( encodecharsize == 0 ){
-                delete[] lowerCharDst;
-                return "";
-            }
-        }
-        for ( int i = 0; i < encodecharsize; ++i )
-            lowerStr += static_cast<char>(lowerCharDst[i]);
+/**
+ * \brief Returns this string converted to the given normalization \p form
+ *
+ * Ascii strings are the same in all forms, and are returned without being processed. Returns an empty
+ * string if this string is not valid utf8.
+ */
+Utf8 Utf8::normalize(Utf8::NormalizationForm form) const{
+    if ( isAscii() )
+        return *this;
+
+    int options = UTF8PROC_STABLE;
+    switch( form ){
+    case NFC:  options |= UTF8PROC_COMPOSE; break;
+    case NFD:  options |= UTF8PROC_DECOMPOSE; break;
+    case NFKC: options |= UTF8PROC_COMPOSE | UTF8PROC_COMPAT; break;
+    case NFKD: options |= UTF8PROC_DECOMPOSE | UTF8PROC_COMPAT; break;
     }
 
-    delete[] lowerCharDst;
-    return Utf8(lowerStr);
+    utf8proc_uint8_t* normalized = nullptr;
+    utf8proc_ssize_t normalizedSize = utf8proc_map(
+        reinterpret_cast<const utf8proc_uint8_t*>(m_data->data()),
+        static_cast<utf8proc_ssize_t>(m_data->size()),
+        &normalized,
+        static_cast<utf8proc_option_t>(options)
+    );
+    if ( normalizedSize < 0 )
+        return Utf8();
+
+    Utf8 result(reinterpret_cast<const char*>(normalized), static_cast<size_t>(normalizedSize));
+    std::free(normalized);
+    return result;
 }
 
-Utf8 Utf8::toUpper() const{
-    utf8proc_int32_t nextcodepoint;
+/**
+ * \brief Returns the shared instance of this string from the global intern table
+ *
+ * Equal interned strings share the same data, so they compare equal by pointer. Interned strings are kept
+ * until the application exits, so this is meant for identifiers like type and module names.
+ */
+Utf8 Utf8::intern() const{
+    Utf8InternTable& table = internTable();
+    std::lock_guard<std::mutex> guard(table.mutex);
 
-    const char* strdata = m_data->c_str();
-    size_t strlength = length();
+    auto it = table.entries.find(m_data.get());
+    if ( it != table.entries.end() )
+        return Utf8(it->second);
 
-    utf8proc_uint8_t* upperCharDst = new utf8proc_uint8_t[4];
+    // the data is immutable, so it can be shared with the table directly
+    table.entries[m_data.get()] = m_data;
+    return *this;
+}
 
-    std::string* upperStr = new std::string;
-    upperStr->reserve(strlength);
+/**
+ * \brief Splits this string by \p sep
+ *
+ * Empty segments are kept. An empty separator returns the whole string.
+ */
+std::vector<Utf8> Utf8::split(const char *sep) const{
+    size_t sepLength = std::strlen(sep);
+    if ( sepLength == 1 )
+        return split(sep[0]);
+
+    std::vector<Utf8> result;
+    if ( sepLength == 0 ){
+        result.push_back(*this);
+        return result;
+    }
 
-    while ( strlength > 0 ){
-        utf8proc_ssize_t charsize = utf8proc_iterate(reinterpret_cast<const utf8proc_uint8_t*>(strdata), -1, &nextcodepoint);
-        if ( charsize <= 0 ){
-            delete[] upperCharDst;
-            return "";
-        }
+    size_t start = 0, end = 0;
+    while ( (end = m_data->find(sep, start, sepLength)) != std::string::npos ){
+        result.push_back(Utf8(m_data->data() + start, end - start));
+        start = end + sepLength;
+    }
+    result.push_back(Utf8(m_data->data() + start, m_data->size() - start));
+    return result;
+}
 
-        strlength -= charsize;
-        strdata   += charsize;
+/**
+ * \brief Splits this string by the \p sep byte
+ *
+ * Empty segments are kept.
+ */
+std::vector<Utf8> Utf8::split(char sep) const{
+    std::vector<Utf8> result;
 
-        utf8proc_int32_t uppercodepoint = utf8proc_toupper(nextcodepoint);
-        utf8proc_ssize_t encodecharsize = utf8proc_encode_char(uppercodepoint, upperCharDst);
-        if ( encodecharsize == 0 ){
-            encodecharsize = utf8proc_encode_char(nextcodepoint, upperCharDst);
-            if ( encodecharsize == 0 ){
-                delete[] upperCharDst;
-                return "";
-            }
-        }
-        for ( int i = 0; i < encodecharsize; ++i )
-            upperStr += static_cast<char>(upperCharDst[i]);
+    const char* begin = m_data->data();
+    const char* end   = begin + m_data->size();
+    const char* current = begin;
 
+    while ( const char* found = static_cast<const char*>(std::memchr(current, sep, static_cast<size_t>(end - current))) ){
+        result.push_back(Utf8(current, static_cast<size_t>(found - current)));
+        current = found + 1;
     }
-
-    delete[] upperCharDst;
-    return Utf8(upperStr);
+    result.push_back(Utf8(current, static_cast<size_t>(end - current)));
+    return result;
 }
 
 size_t Utf8::size() const{
@@ -222,25 +428,81 @@ size_t Utf8::length() const{
     return size();
 }
 
+/**
+ * \brief Returns the number of code points in this string, assuming it's valid utf8
+ */
 size_t Utf8::utfLength() const{
-    utf8proc_int32_t nextcodepoint;
+    return countLeadBytes(m_data->data(), m_data->size());
+}
 
-    const char* strdata = m_data->c_str();
-    size_t strlength = m_data->length();
-    size_t utflength = 0;
+/**
+ * \brief Checks wether this string is valid utf8
+ */
+bool Utf8::isValid() const{
+    return isValid(m_data->data(), m_data->size());
+}
 
-    while ( strlength > 0 ){
-        utf8proc_ssize_t size =
-            utf8proc_iterate(reinterpret_cast<const utf8proc_uint8_t*>(strdata), -1, &nextcodepoint);
-        if ( size <= 0 )
-            return 0;
+/**
+ * \brief Checks wether this string contains only ascii characters
+ */
+bool Utf8::isAscii() const{
+    return isAscii(m_data->data(), m_data->size());
+}
 
-        utflength += size;
-        strlength -= size;
-        strdata   += size;
+/**
+ * \brief Checks wether the \p size bytes at \p data are valid utf8
+ *
+ * Overlong encodings, surrogates and code points above U+10FFFF are rejected. Ascii runs are skipped 16 bytes
+ * at a time.
+ */
+bool Utf8::isValid(const char *data, size_t size){
+    size_t i = 0;
+    while ( i < size ){
+        i += asciiPrefix(data + i, size - i);
+        if ( i >= size )
+            break;
+
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        size_t continuationBytes = 0;
+        uint32_t codepoint = 0;
+        if ( c >= 0xC2 && c <= 0xDF ){
+            continuationBytes = 1;
+            codepoint = c & 0x1F;
+        } else if ( c >= 0xE0 && c <= 0xEF ){
+            continuationBytes = 2;
+            codepoint = c & 0x0F;
+        } else if ( c >= 0xF0 && c <= 0xF4 ){
+            continuationBytes = 3;
+            codepoint = c & 0x07;
+        } else {
+            return false;
+        }
+
+        if ( size - i - 1 < continuationBytes )
+            return false;
+
+        for ( size_t j = 1; j <= continuationBytes; ++j ){
+            unsigned char cc = static_cast<unsigned char>(data[i + j]);
+            if ( (cc & 0xC0) != 0x80 )
+                return false;
+            codepoint = (codepoint << 6) | (cc & 0x3F);
+        }
 
+        if ( continuationBytes == 2 && (codepoint < 0x800 || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) )
+            return false;
+        if ( continuationBytes == 3 && (codepoint < 0x10000 || codepoint > 0x10FFFF) )
+            return false;
+
+        i += continuationBytes + 1;
     }
-    return utflength;
+    return true;
+}
+
+/**
+ * \brief Checks wether the \p size bytes at \p data are all ascii characters
+ */
+bool Utf8::isAscii(const char *data, size_t size){
+    return asciiPrefix(data, size) == size;
 }
 
 bool Utf8::isSpace(uint32_t c){
@@ -248,13 +510,17 @@ bool Utf8::isSpace(uint32_t c){
 }
 
 void Utf8::trimLeft(std::string &s){
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(),
-            std::not1(std::ptr_fun<int, int>(std::isspace))));
+    size_t start = 0;
+    while ( start < s.size() && isSpace(static_cast<unsigned char>(s[start])) )
+        ++start;
+    s.erase(0, start);
 }
 
 void Utf8::trimRight(std::string &s){
-    s.erase(std::find_if(s.rbegin(), s.rend(),
-            std::not1(std::ptr_fun<int, int>(std::isspace))).base(), s.end());
+    size_t end = s.size();
+    while ( end > 0 && isSpace(static_cast<unsigned char>(s[end - 1])) )
+        --end;
+    s.erase(end);
 }
 
 void Utf8::trim(std::string &s){
@@ -285,4 +551,9 @@ Utf8::Utf8(std::string *strPtr)
 {
 }
 
+Utf8::Utf8(const std::shared_ptr<std::string> &strPtr)
+    : m_data(strPtr)
+{
+}
+
 }// namespace
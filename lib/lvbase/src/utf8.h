@@ -16,6 +16,19 @@ namespace lv{
 
 class LV_BASE_EXPORT Utf8{
 
+public:
+    /** Unicode normalization form */
+    enum NormalizationForm{
+        /** Canonical decomposition, followed by canonical composition */
+        NFC,
+        /** Canonical decomposition */
+        NFD,
+        /** Compatibility decomposition, followed by canonical composition */
+        NFKC,
+        /** Compatibility decomposition */
+        NFKD
+    };
+
 public:
     Utf8();
     Utf8(const std::string& str);
@@ -75,13 +88,22 @@ public:
 
     Utf8 toLower() const;
     Utf8 toUpper() const;
+    Utf8 normalize(NormalizationForm form = NFC) const;
 
-    std::vector<Utf8> split(const char* sep);
+    Utf8 intern() const;
+
+    std::vector<Utf8> split(const char* sep) const;
+    std::vector<Utf8> split(char sep) const;
 
     size_t size() const;
     size_t length() const;
 
     size_t utfLength() const;
+    bool isValid() const;
+    bool isAscii() const;
+
+    static bool isValid(const char* data, size_t size);
+    static bool isAscii(const char* data, size_t size);
 
     static bool isSpace(uint32_t c);
 
@@ -95,6 +117,7 @@ public:
 
 private:
     Utf8(std::string* strPtr);
+    Utf8(const std::shared_ptr<std::string>& strPtr);
 
     std::shared_ptr<std::string> m_data;
 };
@@ -116,7 +139,7 @@ inline Utf8 Utf8::operator+(char c) const{
 }
 
 inline bool Utf8::operator ==(const Utf8 &other) const{
-    return compare(other) == 0;
+    return m_data == other.m_data || *m_data == *other.m_data;
 }
 
 inline bool Utf8::operator ==(const char *str) const{
@@ -124,7 +147,7 @@ inline bool Utf8::operator ==(const char *str) const{
 }
 
 inline bool Utf8::operator !=(const Utf8 &other) const{
-    return compare(other) != 0;
+    return !(*this == other);
 }
 
 inline bool Utf8::operator !=(const char *str) const{
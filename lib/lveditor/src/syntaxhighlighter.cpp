@@ -616,6 +616,27 @@ void SyntaxHighlighter::rehighlightBlock(const QTextBlock &block)
         d->rehighlightPending = rehighlightPending;
 }
 
+void SyntaxHighlighter::rehighlightBlocks(const QTextBlock &first, const QTextBlock &last)
+{
+    Q_D(SyntaxHighlighter);
+    if (!d->doc || !first.isValid() || !last.isValid() || first.document() != d->doc || last.document() != d->doc)
+        return;
+    if (last.blockNumber() < first.blockNumber())
+        return;
+
+    const bool rehighlightPending = d->rehighlightPending;
+
+    QTextCursor cursor(first);
+    d->inReformatBlocks = true;
+    cursor.beginEditBlock();
+    d->reformatBlocks(first.position(), 0, last.position() + last.length() - 1 - first.position());
+    cursor.endEditBlock();
+    d->inReformatBlocks = false;
+
+    if (rehighlightPending)
+        d->rehighlightPending = rehighlightPending;
+}
+
 void SyntaxHighlighter::_q_reformatBlocks(int from, int charsRemoved, int charsAdded){
     Q_D(SyntaxHighlighter);
     documentChanged(from, charsRemoved, charsAdded);
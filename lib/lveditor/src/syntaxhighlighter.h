@@ -86,6 +86,7 @@ public:
 public slots:
     void rehighlight();
     void rehighlightBlock(const QTextBlock &block);
+    void rehighlightBlocks(const QTextBlock &first, const QTextBlock &last);
 
     void _q_reformatBlocks(int from, int charsRemoved, int charsAdded);
     void _q_delayedRehighlight();
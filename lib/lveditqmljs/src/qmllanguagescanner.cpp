@@ -2,6 +2,7 @@
 #include "live/visuallogqt.h"
 #include "live/lockedfileiosession.h"
 #include "live/applicationcontext.h"
+#include "live/trace.h"
 
 #include "qmljs/qmljsdocument.h"
 #include "qmljs/qmljsinterpreter.h"
@@ -68,6 +69,8 @@ QmlLanguageScanner::~QmlLanguageScanner(){
        * Declared types through cpp
   */
 void QmlLanguageScanner::processQueue(){
+    vtrace("lveditqmljs", "QmlLanguageScanner::processQueue");
+
     m_isProcessing = true;
 
     QLinkedList<QmlLibraryInfo::Ptr> queue;
@@ -164,6 +167,8 @@ void QmlLanguageScanner::processQueue(){
 }
 
 void QmlLanguageScanner::scanDocument(const QString &path, const QString &content, CodeQmlHandler *handler){
+    vtrace("lveditqmljs", "QmlLanguageScanner::scanDocument", path.toStdString());
+
     DocumentQmlInfo::Ptr docinfo = DocumentQmlInfo::create(path);
     docinfo->parse(content);
     docinfo->createRanges();
@@ -234,6 +239,8 @@ int QmlLanguageScanner::plannedQueueSize(){
 /// parent modules cover their types. In case we find some of those types, we will
 /// have to populate those libraries as well.
 QList<QmlTypeInfo::Ptr> QmlLanguageScanner::scanLibrary(const QmlLibraryInfo::Ptr &lib){
+    vtrace("lveditqmljs", "QmlLanguageScanner::scanLibrary", lib->uri().toStdString());
+
     QList<QmlTypeInfo::Ptr> result;
 
     vlog_debug("editqmljs-scanner", "Updating library: " + lib->path());
@@ -442,13 +449,25 @@ QmlTypeInfo::Ptr QmlLanguageScanner::scanObjectFile(
 void QmlLanguageScanner::scanQmlDirForExports(const QmlDirParser &dirParser, const QmlLibraryInfo::Ptr &lib){
     QHash<QString, QmlDirParser::Component> components = dirParser.components();
 
+    // read all component files in parallel, they are retrieved from the session cache below
+    std::vector<std::string> componentPaths;
+    for ( auto it = components.begin(); it != components.end(); ++it ){
+        if ( it.key() == "classname" )
+            continue;
+        QString filePath = QDir::cleanPath(lib->path() + QDir::separator() + it->fileName);
+        if ( QFile::exists(filePath) )
+            componentPaths.push_back(filePath.toStdString());
+    }
+    m_ioSession->readFromFiles(componentPaths);
+
     for ( auto it = components.begin(); it != components.end(); ++it ){
         if ( it.key() == "classname" )
             continue;
 
         QString filePath = QDir::cleanPath(lib->path() + QDir::separator() + it->fileName);
         if ( QFile::exists(filePath) ){
-            QString fileContent = QString::fromStdString(m_ioSession->readFromFile(filePath.toStdString()));
+            LockedFileIOSession::ContentPtr content = m_ioSession->readSharedFromFile(filePath.toStdString());
+            QString fileContent = content ? QString::fromUtf8(content->data(), static_cast<int>(content->size())) : QString();
             QmlTypeInfo::Ptr fileType = scanObjectFile(lib, filePath, it->typeName, fileContent);
             if ( fileType ){
                 lib->addType(fileType);
@@ -464,6 +483,9 @@ void QmlLanguageScanner::scanQmlDirForExports(const QmlDirParser &dirParser, con
 void QmlLanguageScanner::scanPathForExports(const QString &path, const QmlLibraryInfo::Ptr &lib){
     vlog_debug("editqmljs-scanner", "Scannig path: " + path);
 
+    QList<QFileInfo> files;
+    std::vector<std::string> filePaths;
+
     QDirIterator dit(path);
     while( dit.hasNext() ){
         dit.next();
@@ -475,7 +497,17 @@ void QmlLanguageScanner::scanPathForExports(const QString &path, const QmlLibrar
         if ( !info.fileName().at(0).isUpper() )
             continue;
 
-        QString fileContent = QString::fromStdString(m_ioSession->readFromFile(info.filePath().toStdString()));
+        files.append(info);
+        filePaths.push_back(info.filePath().toStdString());
+    }
+
+    std::vector<LockedFileIOSession::ContentPtr> contents = m_ioSession->readFromFiles(filePaths);
+
+    for ( int i = 0; i < files.size(); ++i ){
+        const QFileInfo& info = files[i];
+        const LockedFileIOSession::ContentPtr& content = contents[static_cast<size_t>(i)];
+
+        QString fileContent = content ? QString::fromUtf8(content->data(), static_cast<int>(content->size())) : QString();
         QmlTypeInfo::Ptr fileType = scanObjectFile(lib, info.filePath(), info.baseName(), fileContent);
         if ( fileType ){
             lib->addType(fileType);
@@ -0,0 +1 @@
+#include "../../../src/bufferpool.h"
@@ -0,0 +1 @@
+#include "../../../src/compilecache.h"
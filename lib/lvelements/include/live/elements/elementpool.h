@@ -0,0 +1 @@
+#include "../../../src/elementpool.h"
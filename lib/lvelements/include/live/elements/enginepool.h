@@ -0,0 +1 @@
+#include "../../../src/enginepool.h"
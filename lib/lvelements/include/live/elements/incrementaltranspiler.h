@@ -0,0 +1 @@
+#include "../../../src/incrementaltranspiler.h"
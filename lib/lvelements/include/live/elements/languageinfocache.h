@@ -0,0 +1 @@
+#include "../../../src/languageinfocache.h"
@@ -0,0 +1 @@
+#include "../../../src/moduleprefetcher.h"
@@ -6,6 +6,7 @@ HEADERS += \
     $$PWD/live/elements/function.h \
     $$PWD/live/elements/engine.h \
     $$PWD/live/elements/languageinfo.h \
+    $$PWD/live/elements/languageinfocache.h \
     $$PWD/live/elements/languageparser.h \
     $$PWD/live/elements/languagequery.h \
     $$PWD/live/elements/languagescanner.h \
@@ -16,6 +17,7 @@ HEADERS += \
     $$PWD/live/elements/treesitterapi.h \
     $$PWD/live/elements/value.h \
     $$PWD/live/elements/element.h \
+    $$PWD/live/elements/elementpool.h \
     $$PWD/live/elements/event.h \
     $$PWD/live/elements/property.h \
     $$PWD/live/elements/eventfunction.h \
@@ -27,8 +29,13 @@ HEADERS += \
     $$PWD/live/elements/callable.h \
     $$PWD/live/elements/object.h \
     $$PWD/live/elements/buffer.h \
+    $$PWD/live/elements/bufferpool.h \
     $$PWD/live/elements/list.h \
     $$PWD/live/elements/container.h \
     $$PWD/live/elements/mlnodetojs.h \
     $$PWD/live/elements/modulelibrary.h \
-    $$PWD/live/elements/elementsplugin.h
+    $$PWD/live/elements/elementsplugin.h \
+    $$PWD/live/elements/compilecache.h \
+    $$PWD/live/elements/moduleprefetcher.h \
+    $$PWD/live/elements/incrementaltranspiler.h \
+    $$PWD/live/elements/enginepool.h
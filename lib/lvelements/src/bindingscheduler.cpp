@@ -0,0 +1,242 @@
+#include "bindingscheduler_p.h"
+#include "element_p.h"
+#include "live/visuallog.h"
+
+#include <algorithm>
+#include <set>
+
+namespace lv{ namespace el{
+
+/**
+ * \class lv::el::BindingScheduler
+ * \brief Propagates property bindings in transactions
+ *
+ * When a property that an expression is bound to changes, the expression is only marked as dirty. Dirty expressions
+ * are evaluated when the outermost transaction ends, ordered by their rank, so an expression runs after all the
+ * bound expressions it depends on. Ranks are computed when the flush starts, and the dirty expressions are kept in
+ * a queue ordered by rank, so a flush of n expressions takes O(n log n). This way each expression is evaluated once per transaction, and never sees
+ * intermediate values of its dependencies.
+ *
+ * Each event dispatch runs in its own transaction, and Engine::batch() groups several changes into a single one.
+ *
+ * An expression that's marked dirty again after it was evaluated, e.g. by a listener that writes one of its
+ * dependencies, is evaluated again in the same transaction. Expressions that depend on themselves through their
+ * bindings are evaluated only once per transaction, which stops cyclic bindings. Cycles the bindings don't show,
+ * like the ones closed by listeners, are stopped after MaxRunsPerTransaction evaluations.
+ */
+
+BindingScheduler::BindingScheduler()
+    : m_depth(0)
+    , m_isFlushing(false)
+    , m_transaction(0)
+    , m_queueOrder(0)
+{
+}
+
+BindingScheduler::~BindingScheduler(){
+    clear();
+}
+
+/**
+ * \brief Starts a transaction, transactions can be nested
+ */
+void BindingScheduler::begin(){
+    ++m_depth;
+}
+
+/**
+ * \brief Ends a transaction, evaluating all dirty expressions if this was the outermost one
+ */
+void BindingScheduler::end(){
+    if ( m_depth > 0 )
+        --m_depth;
+    if ( m_depth == 0 && !m_isFlushing )
+        flush();
+}
+
+/**
+ * \brief Ends a transaction after an error, discarding all dirty expressions if this was the outermost one
+ */
+void BindingScheduler::cancel(){
+    if ( m_depth > 0 )
+        --m_depth;
+    if ( m_depth == 0 && !m_isFlushing )
+        clear();
+}
+
+/**
+ * \brief Marks \p be as dirty
+ *
+ * Expressions that were already evaluated during the current flush are scheduled again, unless they are part of a
+ * binding cycle, or reached MaxRunsPerTransaction evaluations.
+ */
+void BindingScheduler::schedule(Element::BindableExpression *be){
+    if ( be->isScheduled )
+        return;
+
+    if ( m_isFlushing && be->transaction == m_transaction ){
+        if ( isCyclic(be) )
+            return;
+        if ( be->runs >= MaxRunsPerTransaction ){
+            vlog("lvelements-bindings").w() <<
+                "Binding for '" << be->propertyName << "' was evaluated " << be->runs << " times in the same "
+                "transaction, and is likely part of a cycle. Skipping evaluation.";
+            return;
+        }
+    }
+
+    be->isScheduled = true;
+    if ( m_isFlushing )
+        enqueue(be);
+    else
+        m_dirty.push_back(be);
+
+    if ( !isActive() )
+        flush();
+}
+
+/**
+ * \brief Removes \p be from the dirty expressions, called when the expression is deleted
+ */
+void BindingScheduler::remove(Element::BindableExpression *be){
+    m_ranks.clear();
+    m_cyclic.clear();
+    if ( !be->isScheduled )
+        return;
+
+    if ( m_queue.erase(QueueEntry(be->queueRank, be->queueOrder, be)) > 0 )
+        return;
+
+    for ( auto it = m_dirty.begin(); it != m_dirty.end(); ++it ){
+        if ( *it == be ){
+            m_dirty.erase(it);
+            return;
+        }
+    }
+}
+
+/**
+ * Adds \p be to the flush queue, after the expressions of the same rank that are already queued.
+ */
+void BindingScheduler::enqueue(Element::BindableExpression *be){
+    be->queueRank  = rank(be);
+    be->queueOrder = m_queueOrder++;
+    m_queue.insert(QueueEntry(be->queueRank, be->queueOrder, be));
+}
+
+void BindingScheduler::flush(){
+    if ( m_dirty.empty() )
+        return;
+
+    m_isFlushing = true;
+    ++m_transaction;
+
+    try{
+        // bindings can be reassigned during a transaction, so ranks are only computed once it ends
+        for ( Element::BindableExpression* be : m_dirty )
+            enqueue(be);
+        m_dirty.clear();
+
+        while ( !m_queue.empty() ){
+            Element::BindableExpression* be = std::get<2>(*m_queue.begin());
+            m_queue.erase(m_queue.begin());
+            be->isScheduled = false;
+            if ( be->transaction != m_transaction ){
+                be->transaction = m_transaction;
+                be->runs = 0;
+            }
+            ++be->runs;
+            be->run();
+        }
+    } catch ( ... ){
+        m_isFlushing = false;
+        clear();
+        throw;
+    }
+
+    m_isFlushing = false;
+    m_ranks.clear();
+    m_cyclic.clear();
+}
+
+void BindingScheduler::clear(){
+    for ( Element::BindableExpression* be : m_dirty )
+        be->isScheduled = false;
+    for ( const QueueEntry& entry : m_queue )
+        std::get<2>(entry)->isScheduled = false;
+    m_dirty.clear();
+    m_queue.clear();
+    m_ranks.clear();
+    m_cyclic.clear();
+}
+
+/**
+ * Appends the bound expressions that write the properties \p be listens to.
+ */
+void BindingScheduler::dependencies(Element::BindableExpression *be, std::vector<Element::BindableExpression *> &result){
+    for ( size_t i = 0; i < be->bindables.size(); ++i ){
+        Element* emitter = be->bindables[i]->emitter();
+        const std::string& eventName = be->bindableEvents[i];
+
+        ElementPrivate* ed = emitter->m_d;
+        for ( auto beIt = ed->boundPropertyExpressions.begin(); beIt != ed->boundPropertyExpressions.end(); ++beIt ){
+            Element::BindableExpression* dependency = beIt->second;
+            if ( dependency->property->changedEvent() == eventName )
+                result.push_back(dependency);
+        }
+    }
+}
+
+/**
+ * Checks whether \p be depends on itself through its bindings. Computed once per flush, and only for expressions
+ * that are marked dirty again.
+ */
+bool BindingScheduler::isCyclic(Element::BindableExpression *be){
+    auto it = m_cyclic.find(be);
+    if ( it != m_cyclic.end() )
+        return it->second;
+
+    bool result = false;
+    std::set<Element::BindableExpression*> visited;
+    std::vector<Element::BindableExpression*> toVisit;
+    dependencies(be, toVisit);
+
+    while ( !toVisit.empty() ){
+        Element::BindableExpression* current = toVisit.back();
+        toVisit.pop_back();
+        if ( current == be ){
+            result = true;
+            break;
+        }
+        if ( visited.insert(current).second )
+            dependencies(current, toVisit);
+    }
+
+    m_cyclic[be] = result;
+    return result;
+}
+
+/**
+ * The rank of an expression is one more than the highest rank of the bound expressions that write the properties
+ * it listens to. Ranks are computed once per flush, so they follow bindings that were reassigned in the meantime.
+ */
+int BindingScheduler::rank(Element::BindableExpression *be){
+    auto it = m_ranks.find(be);
+    if ( it != m_ranks.end() )
+        return it->second;
+
+    // guards against cyclic bindings
+    m_ranks[be] = 0;
+
+    std::vector<Element::BindableExpression*> beDependencies;
+    dependencies(be, beDependencies);
+
+    int result = 0;
+    for ( Element::BindableExpression* dependency : beDependencies )
+        result = std::max(result, rank(dependency) + 1);
+
+    m_ranks[be] = result;
+    return result;
+}
+
+}} // namespace lv, el
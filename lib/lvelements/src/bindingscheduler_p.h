@@ -0,0 +1,63 @@
+#ifndef LVBINDINGSCHEDULER_H
+#define LVBINDINGSCHEDULER_H
+
+#include "live/elements/lvelementsglobal.h"
+#include "live/elements/element.h"
+
+#include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+
+namespace lv{ namespace el{
+
+class BindingScheduler{
+
+    DISABLE_COPY(BindingScheduler);
+
+public:
+    /** Evaluations of the same expression within a transaction, after which it's considered part of a cycle */
+    static const int MaxRunsPerTransaction = 100;
+
+public:
+    BindingScheduler();
+    ~BindingScheduler();
+
+    void begin();
+    void end();
+    void cancel();
+
+    bool isActive() const;
+
+    void schedule(Element::BindableExpression* be);
+    void remove(Element::BindableExpression* be);
+
+private:
+    /// Dirty expression in the flush queue, ordered by rank, then by the order it was scheduled in
+    typedef std::tuple<int, unsigned long long, Element::BindableExpression*> QueueEntry;
+
+    void enqueue(Element::BindableExpression* be);
+    void flush();
+    void clear();
+    int rank(Element::BindableExpression* be);
+    bool isCyclic(Element::BindableExpression* be);
+    static void dependencies(Element::BindableExpression* be, std::vector<Element::BindableExpression*>& result);
+
+    int                m_depth;
+    bool               m_isFlushing;
+    unsigned long long m_transaction;
+    unsigned long long m_queueOrder;
+
+    std::vector<Element::BindableExpression*>  m_dirty;
+    std::set<QueueEntry>                        m_queue;
+    std::map<Element::BindableExpression*, int> m_ranks;
+    std::map<Element::BindableExpression*, bool> m_cyclic;
+};
+
+inline bool BindingScheduler::isActive() const{
+    return m_depth > 0 || m_isFlushing;
+}
+
+}} // namespace lv, el
+
+#endif // LVBINDINGSCHEDULER_H
@@ -1,8 +1,149 @@
 #include "buffer.h"
+#include "buffer_p.h"
+#include "live/elements/engine.h"
 #include "v8nowarnings.h"
 
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace lv{ namespace el{
 
+namespace{
+
+// Maps the data of storages exposed to js back to their storage, so array buffers passed
+// back from js share it. Also tracks the live handles of each isolate, since their weak
+// callbacks don't run when the isolate is disposed.
+class BufferRegistry{
+public:
+    std::mutex mutex;
+    std::unordered_map<void*, std::weak_ptr<BufferStorage> > storages;
+    std::unordered_map<v8::Isolate*, std::unordered_set<BufferHandle*> > handles;
+
+    static BufferRegistry& instance(){
+        static BufferRegistry registry;
+        return registry;
+    }
+};
+
+} // namespace
+
+// BufferStorage
+// -------------
+
+BufferStorage::~BufferStorage(){
+    if ( data ){
+        BufferRegistry& registry = BufferRegistry::instance();
+        {
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            registry.storages.erase(data);
+        }
+        BufferPool::instance().release(data, size);
+    }
+}
+
+// BufferHandle
+// ------------
+
+BufferHandle::BufferHandle(v8::Isolate *iso, const v8::Local<v8::ArrayBuffer> &value, const std::shared_ptr<BufferStorage> &st)
+    : isolate(iso)
+    , object(iso, value)
+    , storage(st)
+{
+    object.SetWeak(this, &BufferHandle::weakBufferDestructor, v8::WeakCallbackType::kParameter);
+
+    BufferRegistry& registry = BufferRegistry::instance();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    if ( !storage->handle )
+        storage->handle = this;
+    if ( storage->data )
+        registry.storages[storage->data] = storage;
+    registry.handles[isolate].insert(this);
+}
+
+void BufferHandle::weakBufferDestructor(const v8::WeakCallbackInfo<BufferHandle> &data){
+    BufferHandle* h = data.GetParameter();
+    h->object.Reset();
+    {
+        BufferRegistry& registry = BufferRegistry::instance();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        if ( h->storage->handle == h )
+            h->storage->handle = nullptr;
+
+        auto it = registry.handles.find(h->isolate);
+        if ( it != registry.handles.end() ){
+            it->second.erase(h);
+            if ( it->second.empty() )
+                registry.handles.erase(it);
+        }
+    }
+    delete h;
+}
+
+/**
+ * Releases the handles still alive in \p isolate, together with their reference to the storage. Called before
+ * the isolate is disposed, since weak callbacks are not run on disposal.
+ */
+void BufferHandle::releaseAll(v8::Isolate *isolate){
+    std::unordered_set<BufferHandle*> handles;
+    {
+        BufferRegistry& registry = BufferRegistry::instance();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        auto it = registry.handles.find(isolate);
+        if ( it == registry.handles.end() )
+            return;
+
+        handles.swap(it->second);
+        registry.handles.erase(it);
+
+        for ( BufferHandle* h : handles ){
+            if ( h->storage->handle == h )
+                h->storage->handle = nullptr;
+        }
+    }
+
+    // storages released here lock the registry on destruction
+    for ( BufferHandle* h : handles ){
+        h->object.Reset();
+        delete h;
+    }
+}
+
+// ArrayBufferAllocator
+// --------------------
+
+void *ArrayBufferAllocator::Allocate(size_t length){
+    try{
+        return BufferPool::instance().allocate(length > 0 ? length : 1, true);
+    } catch ( std::bad_alloc& ){
+        return nullptr;
+    }
+}
+
+void *ArrayBufferAllocator::AllocateUninitialized(size_t length){
+    try{
+        return BufferPool::instance().allocate(length > 0 ? length : 1, false);
+    } catch ( std::bad_alloc& ){
+        return nullptr;
+    }
+}
+
+void ArrayBufferAllocator::Free(void *data, size_t length){
+    BufferPool::instance().release(data, length);
+}
+
+ArrayBufferAllocator *ArrayBufferAllocator::instance(){
+    static ArrayBufferAllocator allocator;
+    return &allocator;
+}
+
+// Buffer
+// ------
+
+/**
+ * \brief Creates a buffer that refers to \p data without owning it
+ */
 Buffer::Buffer(void *data, size_t size)
     : m_data(data)
     , m_size(size)
@@ -10,11 +151,90 @@ Buffer::Buffer(void *data, size_t size)
 {
 }
 
+/**
+ * \brief Creates a buffer from a js \p value
+ *
+ * If \p value exposes an owned buffer, the data is shared with it. If \p value owns its data, the data is
+ * externalized and moved to this buffer, which shares it with the js object from then on.
+ */
 Buffer::Buffer(const v8::Local<v8::ArrayBuffer> &value)
-    : m_data(value->GetContents().Data())
+    : m_data(nullptr)
     , m_size(value->ByteLength())
     , m_externalized(value->IsExternal())
 {
+    if ( m_externalized ){
+        m_data = value->GetContents().Data();
+        if ( m_data ){
+            BufferRegistry& registry = BufferRegistry::instance();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            auto it = registry.storages.find(m_data);
+            if ( it != registry.storages.end() )
+                m_storage = it->second.lock();
+        }
+        return;
+    }
+
+    // Data allocated by other allocators cannot be released through the pool, so it stays with js
+    v8::Isolate* isolate = value->GetIsolate();
+    if ( isolate->GetArrayBufferAllocator() != ArrayBufferAllocator::instance() ){
+        m_data = value->GetContents().Data();
+        return;
+    }
+
+    v8::ArrayBuffer::Contents contents = value->Externalize();
+    m_data         = contents.Data();
+    m_externalized = true;
+    m_storage      = std::make_shared<BufferStorage>(m_data, m_size);
+    new BufferHandle(isolate, value, m_storage);
+}
+
+Buffer::Buffer(const std::shared_ptr<BufferStorage> &storage)
+    : m_data(storage->data)
+    , m_size(storage->size)
+    , m_externalized(true)
+    , m_storage(storage)
+{
+}
+
+/**
+ * \brief Creates an owned buffer of \p size bytes, allocated from the BufferPool and filled with zeros
+ */
+Buffer Buffer::create(size_t size){
+    void* data = BufferPool::instance().allocate(size, true);
+    return Buffer(std::make_shared<BufferStorage>(data, size));
+}
+
+/**
+ * \brief Creates an owned buffer with a copy of \p size bytes from \p data
+ */
+Buffer Buffer::copy(const void *data, size_t size){
+    void* storageData = BufferPool::instance().allocate(size, false);
+    if ( size )
+        std::memcpy(storageData, data, size);
+    return Buffer(std::make_shared<BufferStorage>(storageData, size));
+}
+
+/**
+ * \brief Returns a js ```ArrayBuffer``` over the data of this buffer, without copying it
+ *
+ * For owned buffers, the returned object keeps the data alive, and the same object is returned while it's still
+ * reachable from js.
+ */
+v8::Local<v8::ArrayBuffer> Buffer::toArrayBuffer(Engine *engine) const{
+    v8::Isolate* isolate = engine->isolate();
+    if ( !m_storage )
+        return v8::ArrayBuffer::New(isolate, m_data, m_size);
+
+    {
+        std::lock_guard<std::mutex> guard(BufferRegistry::instance().mutex);
+        BufferHandle* handle = m_storage->handle;
+        if ( handle && handle->isolate == isolate )
+            return v8::Local<v8::ArrayBuffer>::New(isolate, handle->object);
+    }
+
+    v8::Local<v8::ArrayBuffer> value = v8::ArrayBuffer::New(isolate, m_data, m_size);
+    new BufferHandle(isolate, value, m_storage);
+    return value;
 }
 
 }} // namespace lv, el
@@ -12,15 +12,22 @@ template<class T> class Local;
 namespace lv{ namespace el{
 
 class Engine;
+class BufferStorage;
 
 /**
  * @brief The Buffer class
  *
  * The Buffer class handles transfer of raw data between c++ and js. The equivalent
- * in js is the ```ArrayBuffer```. It's important to note that the data is not owned
- * by the buffer, nor by js. It's meant for purely transfer purposes, i.e. function
- * calls and properties. If you want to keep raw data persistance, use an element subclass,
- * and a Buffer property.
+ * in js is the ```ArrayBuffer```.
+ *
+ * Buffers created through Buffer::create or Buffer::copy own their data. The data is
+ * allocated from the BufferPool and reference counted between all copies of the buffer
+ * and the js ```ArrayBuffer``` objects exposing it, so it's released only after both
+ * sides are done with it. Exposing an owned buffer to js doesn't copy its data.
+ *
+ * An ```ArrayBuffer``` created in js is moved to an owned buffer when it's passed to c++
+ * (e.g. as a function argument or property value), so the c++ side can keep it after
+ * the call.
  *
  * @code
  * class BufferHolder : public Element{
@@ -30,7 +37,8 @@ class Engine;
  * };
  * @endcode
  *
- * Then in js, you can hold a reference to BufferHolder while accesing it's raw data.
+ * Buffers created from a raw pointer don't own their data, and are meant for purely
+ * transfer purposes. The data needs to outlive any js reference to it.
  */
 class LV_ELEMENTS_EXPORT Buffer{
 
@@ -39,15 +47,26 @@ public:
     Buffer(const v8::Local<v8::ArrayBuffer>& value);
     ~Buffer(){}
 
+    static Buffer create(size_t size);
+    static Buffer copy(const void* data, size_t size);
+
     void* data() const{ return m_data; }
     template<typename T> T dataAs(){ return reinterpret_cast<T>(m_data); }
     size_t size() const{ return m_size; }
     bool isExternal() const{ return m_externalized; }
+    bool isOwned() const{ return m_storage.get() != nullptr; }
+    long useCount() const{ return m_storage.use_count(); }
+
+    v8::Local<v8::ArrayBuffer> toArrayBuffer(Engine* engine) const;
 
 private:
+    Buffer(const std::shared_ptr<BufferStorage>& storage);
+
     void*  m_data;
     size_t m_size;
     bool   m_externalized;
+
+    std::shared_ptr<BufferStorage> m_storage;
 };
 
 }} // namespace lv, el
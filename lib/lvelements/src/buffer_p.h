@@ -0,0 +1,56 @@
+#ifndef LVBUFFER_P_H
+#define LVBUFFER_P_H
+
+#include "live/elements/buffer.h"
+#include "live/elements/bufferpool.h"
+#include "v8nowarnings.h"
+
+namespace lv{ namespace el{
+
+class BufferHandle;
+
+/// \private
+class BufferStorage{
+
+    DISABLE_COPY(BufferStorage);
+
+public:
+    BufferStorage(void* d, size_t s) : data(d), size(s), handle(nullptr){}
+    ~BufferStorage();
+
+    void*         data;
+    size_t        size;
+    // Script object this storage was last exposed through, while it's still alive
+    BufferHandle* handle;
+};
+
+/// \private
+class BufferHandle{
+
+    DISABLE_COPY(BufferHandle);
+
+public:
+    BufferHandle(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& value, const std::shared_ptr<BufferStorage>& storage);
+
+    static void weakBufferDestructor(const v8::WeakCallbackInfo<BufferHandle>& data);
+    static void releaseAll(v8::Isolate* isolate);
+
+    v8::Isolate*                    isolate;
+    v8::Persistent<v8::ArrayBuffer> object;
+    std::shared_ptr<BufferStorage>  storage;
+};
+
+/// \private
+class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator{
+
+public:
+    void* Allocate(size_t length) override;
+    void* AllocateUninitialized(size_t length) override;
+    void Free(void* data, size_t length) override;
+
+    static ArrayBufferAllocator* instance();
+};
+
+}} // namespace lv, el
+
+#endif // LVBUFFER_P_H
@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "bufferpool.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace lv{ namespace el{
+
+/**
+ * \class lv::el::BufferPool
+ * \brief Thread-safe pool of raw memory blocks used as backing stores for buffers
+ *
+ * Requested sizes are rounded up to a power of two between MinBlockSize and MaxBlockSize, and released blocks are
+ * kept in a free list for their size class, so repeatedly allocating buffers of similar size doesn't reach the
+ * system allocator. Blocks larger than MaxBlockSize are allocated and freed directly. Once the cached blocks reach
+ * maxCachedBytes(), released blocks are freed instead of being cached.
+ *
+ * The pool returned by instance() backs lv::el::Buffer storage, as well as the array buffers allocated by each
+ * engine, so memory can change ownership between the two.
+ *
+ * \ingroup lvelements
+ */
+
+/**
+ * \brief Creates a pool that caches at most \p maxCachedBytes
+ */
+BufferPool::BufferPool(size_t maxCachedBytes)
+    : m_free(sizeClass(MaxBlockSize) + 1)
+    , m_cachedBytes(0)
+    , m_maxCachedBytes(maxCachedBytes)
+{
+}
+
+/**
+ * \brief Destructor, frees all cached blocks
+ */
+BufferPool::~BufferPool(){
+    clear();
+}
+
+/**
+ * \brief Returns the pool shared by buffers and engines
+ */
+BufferPool &BufferPool::instance(){
+    static BufferPool pool;
+    return pool;
+}
+
+/**
+ * \brief Allocates a block of at least \p size bytes, filled with zeros if \p zeroed is set
+ *
+ * Throws std::bad_alloc if the memory cannot be allocated. Release the block using release() with the same \p size.
+ */
+void *BufferPool::allocate(size_t size, bool zeroed){
+    if ( size == 0 )
+        return nullptr;
+
+    void* data = nullptr;
+    size_t capacity = blockSize(size);
+
+    if ( size <= MaxBlockSize ){
+        std::lock_guard<std::mutex> guard(m_mutex);
+        std::vector<void*>& freeList = m_free[sizeClass(size)];
+        if ( !freeList.empty() ){
+            data = freeList.back();
+            freeList.pop_back();
+            m_cachedBytes -= capacity;
+        }
+    }
+
+    if ( !data ){
+        data = std::malloc(capacity);
+        if ( !data )
+            throw std::bad_alloc();
+    }
+
+    if ( zeroed )
+        std::memset(data, 0, size);
+
+    return data;
+}
+
+/**
+ * \brief Returns the block \p data, allocated with \p size bytes, to the pool
+ */
+void BufferPool::release(void *data, size_t size){
+    if ( !data )
+        return;
+
+    if ( size <= MaxBlockSize ){
+        size_t capacity = blockSize(size);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if ( m_cachedBytes + capacity <= m_maxCachedBytes ){
+            m_free[sizeClass(size)].push_back(data);
+            m_cachedBytes += capacity;
+            return;
+        }
+    }
+
+    std::free(data);
+}
+
+/**
+ * \brief Frees all cached blocks
+ */
+void BufferPool::clear(){
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for ( auto it = m_free.begin(); it != m_free.end(); ++it ){
+        for ( void* data : *it )
+            std::free(data);
+        it->clear();
+    }
+    m_cachedBytes = 0;
+}
+
+/**
+ * \brief Returns the total size of the blocks currently cached
+ */
+size_t BufferPool::cachedBytes() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_cachedBytes;
+}
+
+/**
+ * \brief Returns the maximum size of cached blocks
+ */
+size_t BufferPool::maxCachedBytes() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_maxCachedBytes;
+}
+
+/**
+ * \brief Sets the maximum size of cached blocks. Already cached blocks are kept.
+ */
+void BufferPool::setMaxCachedBytes(size_t maxCachedBytes){
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_maxCachedBytes = maxCachedBytes;
+}
+
+/**
+ * \brief Returns the capacity of the block allocated for \p size bytes
+ */
+size_t BufferPool::blockSize(size_t size){
+    if ( size > MaxBlockSize )
+        return size;
+    size_t capacity = MinBlockSize;
+    while ( capacity < size )
+        capacity <<= 1;
+    return capacity;
+}
+
+size_t BufferPool::sizeClass(size_t size){
+    size_t index = 0;
+    size_t capacity = MinBlockSize;
+    while ( capacity < size ){
+        capacity <<= 1;
+        ++index;
+    }
+    return index;
+}
+
+}} // namespace lv, el
@@ -0,0 +1,65 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVBUFFERPOOL_H
+#define LVBUFFERPOOL_H
+
+#include "live/elements/lvelementsglobal.h"
+
+#include <mutex>
+#include <vector>
+
+namespace lv{ namespace el{
+
+class LV_ELEMENTS_EXPORT BufferPool{
+
+    DISABLE_COPY(BufferPool);
+
+public:
+    /** Smallest size class, in bytes */
+    static const size_t MinBlockSize = 64;
+    /** Largest size class, in bytes. Larger blocks are not pooled. */
+    static const size_t MaxBlockSize = 16 * 1024 * 1024;
+
+public:
+    BufferPool(size_t maxCachedBytes = 64 * 1024 * 1024);
+    ~BufferPool();
+
+    static BufferPool& instance();
+
+    void* allocate(size_t size, bool zeroed = true);
+    void release(void* data, size_t size);
+    void clear();
+
+    size_t cachedBytes() const;
+    size_t maxCachedBytes() const;
+    void setMaxCachedBytes(size_t maxCachedBytes);
+
+    static size_t blockSize(size_t size);
+
+private:
+    static size_t sizeClass(size_t size);
+
+    std::vector<std::vector<void*> > m_free;
+    size_t                           m_cachedBytes;
+    size_t                           m_maxCachedBytes;
+    mutable std::mutex               m_mutex;
+};
+
+}} // namespace lv, el
+
+#endif // LVBUFFERPOOL_H
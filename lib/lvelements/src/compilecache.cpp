@@ -0,0 +1,252 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "compilecache.h"
+#include "languageparser.h"
+#include "live/applicationcontext.h"
+#include "live/visuallog.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDir>
+#include <QCryptographicHash>
+#include <QDataStream>
+
+namespace lv{ namespace el{
+
+namespace{
+
+const char*   compileCacheMagic = "LVCC";
+const quint32 compileCacheMaxSectionSize = 256 * 1024 * 1024;
+
+}// namespace
+
+/**
+ * \class lv::el::CompileCache
+ * \brief Persistent cache of transpiled modules and their engine code cache
+ *
+ * Each entry is stored in its own file within the cache path, named after the entry key. Keys are created with
+ * createKey() from the module source, the module name, the transpiler version and the engine version, so a changed
+ * source, transpiler or engine will simply miss the cache. Entries that are corrupt or written with a different FormatVersion are ignored.
+ *
+ * Entries are written atomically, so multiple processes can share the same cache path.
+ *
+ * The size of all entries is limited to maxSize(). Once a store exceeds it, the least recently written entries are
+ * removed until the cache fits within three quarters of maxSize(), so entries left behind by older sources,
+ * transpilers or engines are pruned over time.
+ *
+ * \ingroup lvelements
+ */
+
+/**
+ * \brief Creates a cache that stores its entries in \p cachePath
+ *
+ * The directory is created when the first entry is stored.
+ */
+CompileCache::CompileCache(const std::string &cachePath)
+    : m_cachePath(cachePath)
+    , m_maxSize(DefaultMaxSize)
+    , m_size(-1)
+{
+}
+
+/**
+ * \brief Destructor
+ */
+CompileCache::~CompileCache(){
+}
+
+/**
+ * \brief Retrieves the \p entry stored under \p key
+ *
+ * Returns false if there is no entry, or the entry cannot be read.
+ */
+bool CompileCache::lookup(const std::string &key, CompileCache::Entry &entry) const{
+    QFile file(QString::fromStdString(entryPath(key)));
+    if ( !file.open(QIODevice::ReadOnly) )
+        return false;
+
+    QDataStream stream(&file);
+
+    char magic[4];
+    if ( stream.readRawData(magic, 4) != 4 || std::string(magic, 4) != compileCacheMagic )
+        return false;
+
+    qint32 version = 0;
+    quint32 jsSize = 0, codeCacheSize = 0;
+    stream >> version >> jsSize >> codeCacheSize;
+    if ( stream.status() != QDataStream::Ok || version != FormatVersion )
+        return false;
+    if ( jsSize > compileCacheMaxSectionSize || codeCacheSize > compileCacheMaxSectionSize )
+        return false;
+
+    entry.js.resize(jsSize);
+    entry.codeCache.resize(codeCacheSize);
+    if ( stream.readRawData(&entry.js[0], static_cast<int>(jsSize)) != static_cast<int>(jsSize) ||
+         stream.readRawData(&entry.codeCache[0], static_cast<int>(codeCacheSize)) != static_cast<int>(codeCacheSize) )
+    {
+        vlog("lvelements-compilecache").w() << "Ignoring corrupt compile cache entry: " << key;
+        entry.js.clear();
+        entry.codeCache.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Checks wether an entry is stored under \p key, without reading it
+ */
+bool CompileCache::contains(const std::string &key) const{
+    return QFileInfo(QString::fromStdString(entryPath(key))).isFile();
+}
+
+/**
+ * \brief Stores \p entry under \p key, replacing any previous entry
+ *
+ * Returns false if the entry could not be written.
+ */
+bool CompileCache::store(const std::string &key, const CompileCache::Entry &entry){
+    if ( !QDir().mkpath(QString::fromStdString(m_cachePath)) )
+        return false;
+
+    QSaveFile file(QString::fromStdString(entryPath(key)));
+    if ( !file.open(QIODevice::WriteOnly) )
+        return false;
+
+    QDataStream stream(&file);
+    stream.writeRawData(compileCacheMagic, 4);
+    stream << static_cast<qint32>(FormatVersion)
+           << static_cast<quint32>(entry.js.size())
+           << static_cast<quint32>(entry.codeCache.size());
+    stream.writeRawData(entry.js.data(), static_cast<int>(entry.js.size()));
+    stream.writeRawData(entry.codeCache.data(), static_cast<int>(entry.codeCache.size()));
+
+    if ( stream.status() != QDataStream::Ok ){
+        file.cancelWriting();
+        return false;
+    }
+
+    qint64 entrySize = file.size();
+    if ( !file.commit() )
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if ( m_size < 0 ){
+        pruneTo(m_maxSize);
+    } else {
+        m_size += entrySize;
+        if ( m_size > static_cast<long long>(m_maxSize) )
+            pruneTo(m_maxSize / 4 * 3);
+    }
+
+    return true;
+}
+
+/**
+ * \brief Removes the entry stored under \p key
+ */
+void CompileCache::remove(const std::string &key){
+    QFile::remove(QString::fromStdString(entryPath(key)));
+}
+
+/**
+ * \brief Removes all entries from the cache path
+ */
+void CompileCache::clear(){
+    QDir dir(QString::fromStdString(m_cachePath));
+    QStringList entries = dir.entryList(QStringList() << "*.lvc", QDir::Files);
+    for ( const QString& entry : entries )
+        dir.remove(entry);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_size = 0;
+}
+
+/**
+ * \brief Returns the maximum size of all entries, in bytes
+ */
+size_t CompileCache::maxSize() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_maxSize;
+}
+
+/**
+ * \brief Sets the maximum size of all entries to \p bytes, pruning the cache if it's larger
+ */
+void CompileCache::setMaxSize(size_t bytes){
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_maxSize = bytes;
+    pruneTo(m_maxSize);
+}
+
+/**
+ * \brief Removes the least recently written entries until the cache fits within maxSize()
+ */
+void CompileCache::prune(){
+    std::lock_guard<std::mutex> guard(m_mutex);
+    pruneTo(m_maxSize);
+}
+
+/**
+ * \brief Creates the key for the module \p name with the given \p source
+ *
+ * The \p engineVersion is part of the key, since both generated code and the code cache depend on it. So is
+ * LanguageParser::TranspilerVersion, since the entry stores the generated javascript.
+ */
+std::string CompileCache::createKey(const std::string &name, const std::string &source, const std::string &engineVersion){
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    std::string header =
+        std::to_string(FormatVersion) + ":" + std::to_string(LanguageParser::TranspilerVersion) + ":" +
+        engineVersion + ":" + name + ":";
+    hash.addData(header.data(), static_cast<int>(header.size()));
+    hash.addData(source.data(), static_cast<int>(source.size()));
+
+    return hash.result().toHex().toStdString();
+}
+
+/**
+ * \brief Returns the default cache path, within the user's application data directory
+ */
+std::string CompileCache::defaultCachePath(){
+    return ApplicationContext::instance().appDataPath() + "/elements/compiled";
+}
+
+std::string CompileCache::entryPath(const std::string &key) const{
+    return m_cachePath + "/" + key + ".lvc";
+}
+
+void CompileCache::pruneTo(size_t bytes){
+    QDir dir(QString::fromStdString(m_cachePath));
+    QFileInfoList entries = dir.entryInfoList(QStringList() << "*.lvc", QDir::Files, QDir::Time); // newest first
+
+    long long size = 0;
+    bool isFull = false;
+    for ( const QFileInfo& entry : entries ){
+        if ( !isFull && size + entry.size() > static_cast<long long>(bytes) )
+            isFull = true;
+        if ( isFull && QFile::remove(entry.filePath()) )
+            continue;
+        size += entry.size();
+    }
+
+    m_size = size;
+}
+
+}} // namespace lv, el
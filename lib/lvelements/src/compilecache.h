@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVCOMPILECACHE_H
+#define LVCOMPILECACHE_H
+
+#include "live/elements/lvelementsglobal.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace lv{ namespace el{
+
+class LV_ELEMENTS_EXPORT CompileCache{
+
+    DISABLE_COPY(CompileCache);
+
+public:
+    /** Shared pointer to this class */
+    typedef std::shared_ptr<CompileCache> Ptr;
+
+    /** Version of the cache entry format */
+    static const int FormatVersion = 1;
+    /** Default maximum size of all entries, in bytes */
+    static const size_t DefaultMaxSize = 256 * 1024 * 1024;
+
+    /**
+     * \class lv::el::CompileCache::Entry
+     * \brief Compiled output stored for a single module source
+     */
+    class Entry{
+    public:
+        /** Generated javascript, ready to be compiled */
+        std::string js;
+        /** Code cache produced by the engine for the generated javascript, may be empty */
+        std::string codeCache;
+    };
+
+public:
+    explicit CompileCache(const std::string& cachePath);
+    ~CompileCache();
+
+    bool lookup(const std::string& key, Entry& entry) const;
+    bool contains(const std::string& key) const;
+    bool store(const std::string& key, const Entry& entry);
+    void remove(const std::string& key);
+    void clear();
+
+    const std::string& cachePath() const;
+
+    size_t maxSize() const;
+    void setMaxSize(size_t bytes);
+    void prune();
+
+    static std::string createKey(const std::string& name, const std::string& source, const std::string& engineVersion);
+    static std::string defaultCachePath();
+
+private:
+    std::string entryPath(const std::string& key) const;
+    void pruneTo(size_t bytes);
+
+    std::string        m_cachePath;
+    size_t             m_maxSize;
+    long long          m_size;
+    mutable std::mutex m_mutex;
+};
+
+/**
+ * \brief Returns the directory where entries are stored
+ */
+inline const std::string &CompileCache::cachePath() const{
+    return m_cachePath;
+}
+
+}} // namespace lv, el
+
+#endif // LVCOMPILECACHE_H
@@ -7,6 +7,7 @@
 namespace lv{ namespace el{
 
 template<typename C, typename ...Args> class ConcreteConstructor;
+class ElementPool;
 
 // Constructor
 // -----------
@@ -78,6 +79,9 @@ public:
     }
 
     static Element* createNative(Engine* engine, Args ...args){
+        ElementPool* pool = C::metaObject().pool();
+        if ( pool )
+            return new (pool) C(engine, args...);
         return new C(engine, args...);
     }
 };
@@ -1,5 +1,6 @@
 #include "element.h"
 #include "element_p.h"
+#include "bindingscheduler_p.h"
 #include "context_p.h"
 #include "live/exception.h"
 #include "v8nowarnings.h"
@@ -25,8 +26,10 @@ Element::~Element(){
         (*it)->m_d->parent = nullptr;
         (*it)->unref();
     }
-    if ( !m_d->persistent.IsEmpty() )
+    if ( !m_d->persistent.IsEmpty() ){
         m_d->persistent.ClearWeak();
+        m_d->persistent.Reset();
+    }
     delete m_d;
 }
 
@@ -82,7 +85,7 @@ void Element::setLifeTimeWithObject(const v8::Local<v8::Object> &obj){
         if ( p->isWritable() ){
             obj->SetAccessor(
                 context,
-                v8::Local<v8::Name>::Cast(v8::String::NewFromUtf8(engine()->isolate(), p->name().c_str())),
+                v8::Local<v8::Name>::Cast(v8::String::NewFromUtf8(engine()->isolate(), p->name().c_str(), v8::String::kInternalizedString)),
                 &Property::ptrGetImplementation,
                 &Property::ptrSetImplementation,
                 pdata
@@ -90,7 +93,7 @@ void Element::setLifeTimeWithObject(const v8::Local<v8::Object> &obj){
         } else {
             obj->SetAccessor(
                 context,
-                v8::Local<v8::Name>::Cast(v8::String::NewFromUtf8(engine()->isolate(), p->name().c_str())),
+                v8::Local<v8::Name>::Cast(v8::String::NewFromUtf8(engine()->isolate(), p->name().c_str(), v8::String::kInternalizedString)),
                 &Property::ptrGetImplementation,
                 0,
                 pdata
@@ -142,6 +145,30 @@ void Element::destroy(Element *e){
     delete e;
 }
 
+/**
+ * \brief Allocates an element outside of any pool
+ */
+void *Element::operator new(size_t size){
+    return ElementPool::allocate(size);
+}
+
+/**
+ * \brief Allocates an element from \p pool
+ *
+ * Elements are returned to their pool when deleted.
+ */
+void *Element::operator new(size_t size, ElementPool *pool){
+    return pool->acquire(size);
+}
+
+void Element::operator delete(void *ptr){
+    ElementPool::deallocate(ptr);
+}
+
+void Element::operator delete(void *ptr, ElementPool *){
+    ElementPool::deallocate(ptr);
+}
+
 EventConnection* Element::on(const std::string &key, std::function<void (const Function::Parameters &)> f){
     EventFunction* fnc = typeMetaObject().getEvent(key);
     if ( fnc ){
@@ -236,7 +263,14 @@ void Element::trigger(const std::string &eventKey, const Function::Parameters &p
     auto delegateIt = m_listeningConnections.find(eventId);
     if ( delegateIt != m_listeningConnections.end() ){
         container = delegateIt->second;
-        container->trigger(params);
+        BindingScheduler* bs = beginBindingTransaction();
+        try{
+            container->trigger(params);
+        } catch ( ... ){
+            cancelBindingTransaction(bs);
+            throw;
+        }
+        endBindingTransaction(bs);
     }
 }
 
@@ -356,6 +390,11 @@ void Element::addProperty(Element *e, ScopedValue propertyName, ScopedValue prop
     }
 }
 
+Element::BindableExpression::~BindableExpression(){
+    if ( element && element->engine() )
+        element->engine()->bindingScheduler()->remove(this);
+}
+
 void Element::assignPropertyExpression(
         Element *e,
         ScopedValue propertyName,
@@ -420,9 +459,10 @@ void Element::assignPropertyExpression(
 
             try {
                 EventConnection* bec = bindingElement->on(bindingEvent, [be](const Function::Parameters&){
-                    be->run();
+                    be->element->engine()->bindingScheduler()->schedule(be);
                 });
                 be->bindables.push_back(bec);
+                be->bindableEvents.push_back(bindingEvent);
             } catch (lv::Exception exc) {
                 e->engine()->throwError(&exc, e);
                 return;
@@ -431,6 +471,24 @@ void Element::assignPropertyExpression(
     }
 }
 
+/**
+ * \brief Runs the function given as the first argument in a single binding transaction
+ *
+ * Available in script as Element.batch(function(){ ... }). See Engine::batch().
+ */
+void Element::batch(const Function::CallInfo &info){
+    Engine* engine = info.engine();
+    if ( info.length() < 1 ){
+        info.throwError(engine, "Element.batch requires a function argument.");
+        return;
+    }
+
+    Callable f = info.at(0).toCallable(engine);
+    engine->batch([engine, &f](){
+        f.call(engine, Function::Parameters(0));
+    });
+}
+
 void Element::assignDefaultProperty(Element *e, ScopedValue value){
     if ( !value.isNull() ){
         if ( e->defaultProperty().empty() )
@@ -557,10 +615,38 @@ Property *Element::property(const std::string &name) const{
     return p;
 }
 
+/**
+ * \brief Returns the property for \p key, or null if there's no such property
+ *
+ * Type properties are resolved through the inline cache of \p key, so repeated lookups on elements of the same
+ * type don't require a search.
+ */
+Property *Element::property(const PropertyKey &key) const{
+    const MetaObject* mo = &typeMetaObject();
+    Property* p = key.cachedProperty(mo);
+    if ( p )
+        return p;
+
+    p = mo->getProperty(key);
+    if ( p ){
+        key.cacheProperty(mo, p);
+        return p;
+    }
+
+    auto it = m_d->instanceProperties.find(key.name());
+    if ( it != m_d->instanceProperties.end() )
+        return it->second;
+    return nullptr;
+}
+
 bool Element::hasProperty(const std::string &name) const{
     return property(name) != 0;
 }
 
+bool Element::hasProperty(const PropertyKey &key) const{
+    return property(key) != nullptr;
+}
+
 ScopedValue Element::get(const std::string &name){
     Property* p = property(name);
     if ( !p )
@@ -573,6 +659,18 @@ ScopedValue Element::get(const std::string &name){
     return p->read(this);
 }
 
+ScopedValue Element::get(const PropertyKey &key){
+    Property* p = property(key);
+    if ( !p )
+    {
+        auto exc = CREATE_EXCEPTION(lv::Exception, "Property with the given name doesn't exist", lv::Exception::toCode("~Element"));
+        engine()->throwError(&exc, this);
+        return ScopedValue(engine());
+    }
+
+    return p->read(this);
+}
+
 void Element::set(const std::string &name, const ScopedValue &value){
     Property* p = property(name);
     if ( !p )
@@ -585,6 +683,18 @@ void Element::set(const std::string &name, const ScopedValue &value){
     p->write(this, value.data());
 }
 
+void Element::set(const PropertyKey &key, const ScopedValue &value){
+    Property* p = property(key);
+    if ( !p )
+    {
+        auto exc = CREATE_EXCEPTION(lv::Exception, "Property with the given name doesn't exist", lv::Exception::toCode("~Element"));
+        engine()->throwError(&exc, this);
+        return;
+    }
+
+    p->write(this, value.data());
+}
+
 void Element::removeListeningConnection(EventConnection *conn){
     // If there's a listener, remove the connection from it's emission
     if ( conn->listener() ){
@@ -640,6 +750,24 @@ void Element::removeBoundPropertyExpressions(){
     m_d->boundPropertyExpressions.clear();
 }
 
+BindingScheduler *Element::beginBindingTransaction(){
+    if ( !m_d->engine )
+        return nullptr;
+    BindingScheduler* scheduler = m_d->engine->bindingScheduler();
+    scheduler->begin();
+    return scheduler;
+}
+
+void Element::endBindingTransaction(BindingScheduler *scheduler){
+    if ( scheduler )
+        scheduler->end();
+}
+
+void Element::cancelBindingTransaction(BindingScheduler *scheduler){
+    if ( scheduler )
+        scheduler->cancel();
+}
+
 void Element::removeListenerConnectionDontNotify(EventConnection *conn){
     m_listeningConnections[conn->eventId()]->removeConnection(conn);
 }
@@ -687,4 +815,18 @@ Element *ElementPrivate::elementFromObject(const v8::Local<v8::Object> &object){
     return reinterpret_cast<Element*>(ptr);
 }
 
+void *ElementPrivate::operator new(size_t size){
+    return pool().acquire(size);
+}
+
+void ElementPrivate::operator delete(void *ptr){
+    ElementPool::deallocate(ptr);
+}
+
+ElementPool &ElementPrivate::pool(){
+    // Never freed, since elements can be destroyed during static destruction
+    static ElementPool* pool = new ElementPool(sizeof(ElementPrivate), 1024);
+    return *pool;
+}
+
 }}// namespace lv, el
@@ -10,6 +10,7 @@
 namespace lv{ namespace el{
 
 class ElementPrivate;
+class BindingScheduler;
 
 /**
  * @brief The Element class
@@ -56,12 +57,21 @@ class ElementPrivate;
  *
  * The GC is triggered only if there is a reference of 'e' within the JS,
  * i.e. 'e' has passed throught he JS engine.
+ *
+ * @section2 Pooled Allocation
+ *
+ * Types described with MetaObject::Builder::pooled() recycle the memory of
+ * deleted elements through an ElementPool. Elements created from script, or
+ * through Element::create(), are allocated from the pool of their type, and
+ * returned to it once deleted, either manually or by the GC. Element itself
+ * is pooled, so components declared in .lv files are recycled as well.
  */
 class LV_ELEMENTS_EXPORT Element{
 
     BASE_META_OBJECT{
         META_OBJECT_DESCRIBE(Element)
             .constructor()
+            .pooled()
             .scriptMethod<void, ScopedValue, Callable>("on", &Element::on)
             .scriptMethod("setParent", &Element::setParent)
             .scriptProperty<Element*>("parent", &Element::parent)
@@ -70,6 +80,7 @@ class LV_ELEMENTS_EXPORT Element{
             .scriptFunction("addProperty", &Element::addProperty)
             .scriptFunction("assignPropertyExpression", &Element::assignPropertyExpression)
             .scriptFunction("assignId", &Element::assignId)
+            .scriptFunction("batch", &Element::batch)
         META_OBJECT_CLOSE
     }
 
@@ -77,6 +88,7 @@ class LV_ELEMENTS_EXPORT Element{
     friend class ScopedValue;
     friend class ElementPrivate;
     friend class InstanceEvent;
+    friend class BindingScheduler;
 
     class BindableExpression;
 
@@ -108,6 +120,13 @@ public:
     bool hasScriptReference() const;
     static void destroy(Element* e);
 
+    template<typename T, typename ...Args> static T* create(Engine* engine, Args... args);
+
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, ElementPool* pool);
+    static void operator delete(void* ptr);
+    static void operator delete(void* ptr, ElementPool* pool);
+
     // Events
     // ------
 
@@ -133,6 +152,7 @@ public:
         ScopedValue bindings);
     static void assignDefaultProperty(Element* e, ScopedValue value);
     static void assignId(Element* e, const std::string& id);
+    static void batch(const Function::CallInfo& info);
 
     void clearPropertyBoundExpression(const std::string& propertyName);
 
@@ -159,9 +179,13 @@ public:
     const std::string& defaultProperty() const;
     Property* property(const std::string& name);
     Property* property(const std::string& name) const;
+    Property* property(const PropertyKey& key) const;
     bool hasProperty(const std::string& name) const;
+    bool hasProperty(const PropertyKey& key) const;
     ScopedValue get(const std::string& name);
+    ScopedValue get(const PropertyKey& key);
     void set(const std::string& name, const ScopedValue& value);
+    void set(const PropertyKey& key, const ScopedValue& value);
 
     // Ready
     // -----
@@ -178,6 +202,10 @@ private:
     Event notifyFromInstance(Event::Id eventId, const Function::Parameters& params);
     void removeInstanceProperties();
     void removeBoundPropertyExpressions();
+    BindingScheduler* beginBindingTransaction();
+    static void endBindingTransaction(BindingScheduler* scheduler);
+    static void cancelBindingTransaction(BindingScheduler* scheduler);
+
     void removeListenerConnectionDontNotify(EventConnection* conn);
     void removeEmitterConnectionDontNotify(EventConnection* conn);
 
@@ -185,15 +213,26 @@ private:
     void removeEmitterDontNotify(Element* e);
 
     // Connections that listen to this object
-    std::map<Event::Id, EventListenerContainerBase*> m_listeningConnections;
+    EventListenerTable          m_listeningConnections;
     // Connections that this objects listens to
-    std::list<EventConnection*>                      m_emittingConnections;
+    std::list<EventConnection*> m_emittingConnections;
 
     // Private data
     ElementPrivate* m_d;
 
 };
 
+/**
+ * \brief Creates an element of type \p T, allocated from the pool of its meta object if it has one
+ */
+template<typename T, typename ...Args>
+T *Element::create(Engine *engine, Args... args){
+    ElementPool* pool = T::metaObject().pool();
+    if ( pool )
+        return new (pool) T(engine, args...);
+    return new T(engine, args...);
+}
+
 template<typename T, typename ...Args>
 Event::Id Element::eventId(Event(T::*e)(Args...)){
     return EventIdGenerator::eventId(e);
@@ -247,7 +286,14 @@ Event Element::notify(Event::Id eventId, Args... args){
     auto delegateIt = m_listeningConnections.find(eventId);
     if ( delegateIt != m_listeningConnections.end() ){
         EventListenerContainer<Args...>* ed = static_cast<EventListenerContainer<Args...>*>(delegateIt->second);
-        ed->call(args...);
+        BindingScheduler* bs = beginBindingTransaction();
+        try{
+            ed->call(args...);
+        } catch ( ... ){
+            cancelBindingTransaction(bs);
+            throw;
+        }
+        endBindingTransaction(bs);
     }
     return Event();
 }
@@ -256,7 +302,14 @@ inline Event Element::notifyFromInstance(Event::Id eventId, const Function::Para
     auto delegateIt = m_listeningConnections.find(eventId);
     if ( delegateIt != m_listeningConnections.end() ){
         EventListenerContainer<const Function::Parameters&>* ed = static_cast<EventListenerContainer<const Function::Parameters&>*>(delegateIt->second);
-        ed->trigger(params);
+        BindingScheduler* bs = beginBindingTransaction();
+        try{
+            ed->trigger(params);
+        } catch ( ... ){
+            cancelBindingTransaction(bs);
+            throw;
+        }
+        endBindingTransaction(bs);
     }
     return Event();
 }
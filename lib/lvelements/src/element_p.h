@@ -16,9 +16,27 @@ public:
     Property*        property;
     EventConnection* monitoringConnection;
     std::vector<EventConnection*> bindables;
+    std::vector<std::string>      bindableEvents;
     bool             isActive;
-
-    BindableExpression(const Callable& exp) : expression(exp){}
+    bool             isScheduled;
+    unsigned long long transaction;
+    int              runs;
+    int              queueRank;
+    unsigned long long queueOrder;
+
+    BindableExpression(const Callable& exp)
+        : expression(exp)
+        , element(nullptr)
+        , property(nullptr)
+        , monitoringConnection(nullptr)
+        , isActive(false)
+        , isScheduled(false)
+        , transaction(0)
+        , runs(0)
+        , queueRank(0)
+        , queueOrder(0)
+    {}
+    ~BindableExpression();
 
     void run(){
         isActive = true;
@@ -34,6 +52,10 @@ public:
     static v8::Local<v8::Object> localObject(Element* element);
     static Element* elementFromObject(const v8::Local<v8::Object>& object);
 
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+    static ElementPool& pool();
+
     // Instance events
     std::map<std::string, InstanceEvent*>               instanceEvents;
 
@@ -0,0 +1,332 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "elementpool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <set>
+
+namespace lv{ namespace el{
+
+/// \private
+class ElementPool::Header{
+public:
+    ElementPool* pool;
+};
+
+namespace{
+
+// Keep the object aligned after the header
+const size_t headerSize =
+    ((sizeof(void*) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t)) * alignof(std::max_align_t);
+
+class ElementPoolRegistry{
+public:
+    ElementPoolRegistry() : freeBytes(0), totalCapacity(ElementPool::DefaultTotalCapacity){}
+
+    std::mutex              mutex;
+    std::set<ElementPool*>  pools;
+    std::atomic<size_t>     freeBytes;
+    std::atomic<size_t>     totalCapacity;
+
+    bool reserve(size_t bytes){
+        size_t current = freeBytes.load();
+        do{
+            if ( current + bytes > totalCapacity.load() )
+                return false;
+        } while ( !freeBytes.compare_exchange_weak(current, current + bytes) );
+        return true;
+    }
+
+    // Pools can be used by elements destroyed during static destruction, so they are never freed
+    static ElementPoolRegistry& instance(){
+        static ElementPoolRegistry* registry = new ElementPoolRegistry;
+        return *registry;
+    }
+};
+
+} // namespace
+
+/**
+ * \class lv::el::ElementPool
+ * \brief Recycles memory blocks of a fixed size for objects of the same type
+ *
+ * Element types described with MetaObject::Builder::pooled() are allocated from a pool owned by their meta object.
+ * When such an element is deleted, whether manually or through the V8 weak callback once script references are gone,
+ * its destructor releases its properties, listeners and bindings, and the block is returned to the pool instead of
+ * being freed, to be reused by the next element of the same type.
+ *
+ * Every allocated block is preceded by a small header pointing to its pool, so deallocate() can return any block to
+ * the pool it came from, or free it if it wasn't pooled.
+ *
+ * Pools are trimmed in generations: nextGeneration() frees the free blocks that were not needed since the previous
+ * generation, keeping only as many as were reused. Engines advance the generation of all pools after each full
+ * garbage collection. Each pool keeps at most capacity() free blocks, and all pools together keep at most
+ * totalCapacity() bytes, so blocks released beyond either limit are freed right away.
+ *
+ * Only the memory of the element is recycled. A reused block is constructed from scratch, so its private data,
+ * properties and script object are created again for each element.
+ *
+ * \ingroup lvelements
+ */
+
+/**
+ * \brief Creates a pool of blocks of \p blockSize bytes, keeping at most \p capacity free blocks
+ */
+ElementPool::ElementPool(size_t blockSize, size_t capacity)
+    : m_blockSize(blockSize)
+    , m_capacity(capacity)
+    , m_lowWater(0)
+    , m_generation(0)
+    , m_totalAcquired(0)
+    , m_totalReused(0)
+{
+    ElementPoolRegistry& registry = ElementPoolRegistry::instance();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.pools.insert(this);
+}
+
+/**
+ * \brief Destructor, frees all free blocks
+ *
+ * The pool needs to outlive all the blocks acquired from it.
+ */
+ElementPool::~ElementPool(){
+    {
+        ElementPoolRegistry& registry = ElementPoolRegistry::instance();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        registry.pools.erase(this);
+    }
+    clear();
+}
+
+/**
+ * \brief Returns a block for an object of \p size bytes, reusing a free block if available
+ *
+ * Objects larger than blockSize() are allocated outside the pool.
+ */
+void *ElementPool::acquire(size_t size){
+    if ( size > m_blockSize )
+        return allocate(size);
+
+    Header* header = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        ++m_totalAcquired;
+        if ( !m_free.empty() ){
+            header = m_free.back();
+            m_free.pop_back();
+            ElementPoolRegistry::instance().freeBytes -= headerSize + m_blockSize;
+            if ( m_free.size() < m_lowWater )
+                m_lowWater = m_free.size();
+            ++m_totalReused;
+        }
+    }
+
+    if ( !header ){
+        header = reinterpret_cast<Header*>(std::malloc(headerSize + m_blockSize));
+        if ( !header )
+            throw std::bad_alloc();
+        header->pool = this;
+    }
+
+    return reinterpret_cast<char*>(header) + headerSize;
+}
+
+/**
+ * \brief Allocates a block of \p size bytes that doesn't belong to any pool
+ */
+void *ElementPool::allocate(size_t size){
+    Header* header = reinterpret_cast<Header*>(std::malloc(headerSize + size));
+    if ( !header )
+        throw std::bad_alloc();
+    header->pool = nullptr;
+    return reinterpret_cast<char*>(header) + headerSize;
+}
+
+/**
+ * \brief Returns \p data to the pool it was acquired from, or frees it if it wasn't pooled
+ *
+ * \p data needs to be returned by either acquire() or allocate().
+ */
+void ElementPool::deallocate(void *data){
+    if ( !data )
+        return;
+
+    Header* header = reinterpret_cast<Header*>(reinterpret_cast<char*>(data) - headerSize);
+    if ( header->pool )
+        header->pool->recycle(header);
+    else
+        std::free(header);
+}
+
+/**
+ * \brief Returns the size of the objects this pool allocates
+ */
+size_t ElementPool::blockSize() const{
+    return m_blockSize;
+}
+
+/**
+ * \brief Returns the maximum number of free blocks this pool keeps
+ */
+size_t ElementPool::capacity() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_capacity;
+}
+
+/**
+ * \brief Sets the maximum number of free blocks. Blocks released above \p capacity are freed.
+ */
+void ElementPool::setCapacity(size_t capacity){
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_capacity = capacity;
+    while ( m_free.size() > m_capacity ){
+        release(m_free.back());
+        m_free.pop_back();
+    }
+    if ( m_lowWater > m_free.size() )
+        m_lowWater = m_free.size();
+}
+
+/**
+ * \brief Returns the number of free blocks ready to be reused
+ */
+size_t ElementPool::available() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_free.size();
+}
+
+/**
+ * \brief Returns the number of blocks acquired from this pool
+ */
+size_t ElementPool::totalAcquired() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_totalAcquired;
+}
+
+/**
+ * \brief Returns the number of acquired blocks that were reused instead of allocated
+ */
+size_t ElementPool::totalReused() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_totalReused;
+}
+
+/**
+ * \brief Returns the current generation of this pool
+ */
+size_t ElementPool::generation() const{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_generation;
+}
+
+/**
+ * \brief Starts a new generation, freeing the blocks that stayed unused throughout the previous one
+ */
+void ElementPool::nextGeneration(){
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    // Blocks at the bottom of the free list are the least recently released
+    size_t unused = m_lowWater < m_free.size() ? m_lowWater : m_free.size();
+    for ( size_t i = 0; i < unused; ++i )
+        release(m_free[i]);
+    m_free.erase(m_free.begin(), m_free.begin() + static_cast<std::ptrdiff_t>(unused));
+
+    m_lowWater = m_free.size();
+    ++m_generation;
+}
+
+/**
+ * \brief Frees all free blocks
+ */
+void ElementPool::clear(){
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for ( Header* header : m_free )
+        release(header);
+    m_free.clear();
+    m_lowWater = 0;
+}
+
+/**
+ * \brief Starts a new generation in all existing pools
+ */
+void ElementPool::nextGenerationForAll(){
+    ElementPoolRegistry& registry = ElementPoolRegistry::instance();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    for ( ElementPool* pool : registry.pools )
+        pool->nextGeneration();
+}
+
+/**
+ * \brief Returns the maximum number of bytes kept in free blocks across all pools
+ */
+size_t ElementPool::totalCapacity(){
+    return ElementPoolRegistry::instance().totalCapacity.load();
+}
+
+/**
+ * \brief Sets the maximum number of bytes kept in free blocks across all pools
+ *
+ * If the pools keep more than \p bytes, their least recently released blocks are freed.
+ */
+void ElementPool::setTotalCapacity(size_t bytes){
+    ElementPoolRegistry& registry = ElementPoolRegistry::instance();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    registry.totalCapacity = bytes;
+
+    for ( ElementPool* pool : registry.pools ){
+        std::lock_guard<std::mutex> poolGuard(pool->m_mutex);
+
+        size_t total = 0;
+        while ( total < pool->m_free.size() && registry.freeBytes.load() > bytes ){
+            pool->release(pool->m_free[total]);
+            ++total;
+        }
+        pool->m_free.erase(pool->m_free.begin(), pool->m_free.begin() + static_cast<std::ptrdiff_t>(total));
+        if ( pool->m_lowWater > pool->m_free.size() )
+            pool->m_lowWater = pool->m_free.size();
+    }
+}
+
+/**
+ * \brief Returns the number of bytes kept in free blocks across all pools
+ */
+size_t ElementPool::totalAvailable(){
+    return ElementPoolRegistry::instance().freeBytes.load();
+}
+
+void ElementPool::recycle(ElementPool::Header *header){
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if ( m_free.size() < m_capacity && ElementPoolRegistry::instance().reserve(headerSize + m_blockSize) ){
+            m_free.push_back(header);
+            return;
+        }
+    }
+    std::free(header);
+}
+
+void ElementPool::release(ElementPool::Header *header){
+    ElementPoolRegistry::instance().freeBytes -= headerSize + m_blockSize;
+    std::free(header);
+}
+
+}} // namespace lv, el
@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVELEMENTPOOL_H
+#define LVELEMENTPOOL_H
+
+#include "live/elements/lvelementsglobal.h"
+
+#include <mutex>
+#include <vector>
+
+namespace lv{ namespace el{
+
+class LV_ELEMENTS_EXPORT ElementPool{
+
+    DISABLE_COPY(ElementPool);
+
+public:
+    /** Default number of free blocks kept by a pool */
+    static const size_t DefaultCapacity = 256;
+    /** Default number of bytes kept in free blocks across all pools */
+    static const size_t DefaultTotalCapacity = 16 * 1024 * 1024;
+
+public:
+    ElementPool(size_t blockSize, size_t capacity = DefaultCapacity);
+    ~ElementPool();
+
+    void* acquire(size_t size);
+
+    static void* allocate(size_t size);
+    static void deallocate(void* data);
+
+    size_t blockSize() const;
+    size_t capacity() const;
+    void setCapacity(size_t capacity);
+
+    size_t available() const;
+    size_t totalAcquired() const;
+    size_t totalReused() const;
+    size_t generation() const;
+
+    void nextGeneration();
+    void clear();
+
+    static void nextGenerationForAll();
+    static size_t totalCapacity();
+    static void setTotalCapacity(size_t bytes);
+    static size_t totalAvailable();
+
+private:
+    class Header;
+
+    void recycle(Header* header);
+    void release(Header* header);
+
+    size_t               m_blockSize;
+    size_t               m_capacity;
+    std::vector<Header*> m_free;
+    size_t               m_lowWater;
+    size_t               m_generation;
+    size_t               m_totalAcquired;
+    size_t               m_totalReused;
+    mutable std::mutex   m_mutex;
+};
+
+}} // namespace lv, el
+
+#endif // LVELEMENTPOOL_H
@@ -10,13 +10,27 @@
 #include "errorhandler.h"
 #include "imports_p.h"
 #include "tuple.h"
+#include "moduleprefetcher.h"
+#include "incrementaltranspiler.h"
+#include "bindingscheduler_p.h"
+#include "buffer_p.h"
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <set>
 #include <QFileInfo>
 #include "v8nowarnings.h"
 #include <QDateTime>
 
+#if V8_MAJOR_VERSION > 6 || (V8_MAJOR_VERSION == 6 && V8_MINOR_VERSION >= 7)
+#define LV_ELEMENTS_CREATE_CODE_CACHE
+#endif
+
+#if V8_MAJOR_VERSION > 6 || (V8_MAJOR_VERSION == 6 && V8_MINOR_VERSION >= 6)
+#define LV_ELEMENTS_SNAPSHOT
+#endif
+
 namespace lv{ namespace el{
 
 class ComponentTemplate{
@@ -64,6 +78,8 @@ public:
         , hasGlobalErrorHandler(false)
         , moduleFileType(Engine::Lv)
         , parser(LanguageParser::createForElements())
+        , snapshotCreator(nullptr)
+        , modulePrefetcher(nullptr)
     {}
 
     Context*                   context;
@@ -90,9 +106,23 @@ public:
 
     PackageGraph* packageGraph;
     Engine::FileInterceptor* fileInterceptor;
+    CompileCache::Ptr compileCache;
     std::map<std::string, ElementsPlugin::Ptr> loadedPlugins;
 
+    Engine::Snapshot::Ptr snapshot;
+    v8::StartupData       snapshotBlob;
+    v8::SnapshotCreator*  snapshotCreator;
+
+    ModulePrefetcher* modulePrefetcher;
+
+    std::set<std::string> transpiledModules;
+    std::map<std::string, IncrementalTranspiler*> transpilers;
+
+    BindingScheduler bindingScheduler;
+
 public: // helpers
+    std::string transpile(const std::string& path, const std::string& name, const std::string& source);
+
     bool isElementConstructor(
         Engine *engine,
         const v8::Local<v8::Function>& fnc,
@@ -100,9 +130,46 @@ public: // helpers
     );
 
     static void messageListener(v8::Local<v8::Message> message, v8::Local<v8::Value> data);
+    static void gcEpilogue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags);
+
+    static v8::MaybeLocal<v8::Script> compileCached(
+        const v8::Local<v8::Context>& context,
+        const v8::Local<v8::String>& source,
+        CompileCache::Entry& entry,
+        bool& isEntryModified
+    );
+
+    static std::vector<const MetaObject*> internalTypes();
+    static const intptr_t* externalReferences();
+    static size_t externalReferenceCount();
+
+    std::vector<v8::Local<v8::FunctionTemplate> > snapshotTemplates();
+    void resetTemplates();
 
 };
 
+/**
+ * Modules transpiled a second time are most likely being edited, so from then on they are transpiled through an
+ * IncrementalTranspiler that keeps their tree and converted components between versions.
+ */
+std::string EnginePrivate::transpile(const std::string &path, const std::string &name, const std::string &source){
+    auto it = transpilers.find(path);
+    if ( it != transpilers.end() )
+        return it->second->toJs(source);
+
+    if ( transpiledModules.insert(path).second )
+        return parser->toJs(source, name);
+
+    IncrementalTranspiler* transpiler = new IncrementalTranspiler(parser, name);
+    transpilers[path] = transpiler;
+    return transpiler->toJs(source);
+}
+
+// Elements released by the collection were returned to their pools, so element pools advance their generation here
+void EnginePrivate::gcEpilogue(v8::Isolate *, v8::GCType, v8::GCCallbackFlags){
+    ElementPool::nextGenerationForAll();
+}
+
 void EnginePrivate::messageListener(v8::Local<v8::Message> message, v8::Local<v8::Value> data){
     v8::Local<v8::External> engineData = v8::Local<v8::External>::Cast(data);
     Engine* engine = reinterpret_cast<Engine*>(engineData->Value());
@@ -114,6 +181,174 @@ void EnginePrivate::messageListener(v8::Local<v8::Message> message, v8::Local<v8
     engine->handleError(*msg, "", *file, line);
 }
 
+/**
+ * Compiles \p source, consuming the code cache from \p entry if available. If the code cache is missing or
+ * rejected by the engine, a new one is created and \p isEntryModified is set.
+ */
+v8::MaybeLocal<v8::Script> EnginePrivate::compileCached(
+        const v8::Local<v8::Context> &context,
+        const v8::Local<v8::String> &source,
+        CompileCache::Entry &entry,
+        bool &isEntryModified)
+{
+    v8::ScriptCompiler::CachedData* cachedData = nullptr;
+    if ( !entry.codeCache.empty() ){
+        cachedData = new v8::ScriptCompiler::CachedData(
+            reinterpret_cast<const uint8_t*>(entry.codeCache.data()), static_cast<int>(entry.codeCache.size())
+        );
+    }
+
+    // scriptSource takes ownership of cachedData, the buffer stays owned by the entry
+    v8::ScriptCompiler::Source scriptSource(source, cachedData);
+
+#ifdef LV_ELEMENTS_CREATE_CODE_CACHE
+    v8::ScriptCompiler::CompileOptions options =
+        cachedData ? v8::ScriptCompiler::kConsumeCodeCache : v8::ScriptCompiler::kNoCompileOptions;
+#else
+    v8::ScriptCompiler::CompileOptions options =
+        cachedData ? v8::ScriptCompiler::kConsumeCodeCache : v8::ScriptCompiler::kProduceCodeCache;
+#endif
+
+    v8::MaybeLocal<v8::Script> script = v8::ScriptCompiler::Compile(context, &scriptSource, options);
+    if ( script.IsEmpty() || (cachedData && !cachedData->rejected) )
+        return script;
+
+    isEntryModified = true;
+
+#ifdef LV_ELEMENTS_CREATE_CODE_CACHE
+    std::unique_ptr<v8::ScriptCompiler::CachedData> created(
+        v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()->GetUnboundScript())
+    );
+#else
+    // a rejected cache cannot be reproduced in the same compilation, it will be produced on the next one
+    const v8::ScriptCompiler::CachedData* created = cachedData ? nullptr : scriptSource.GetCachedData();
+#endif
+
+    if ( created && created->length > 0 )
+        entry.codeCache.assign(reinterpret_cast<const char*>(created->data), static_cast<size_t>(created->length));
+    else
+        entry.codeCache.clear();
+
+    return script;
+}
+
+/**
+ * Returns the internal types registered by each engine, with base types before the types deriving them. The order
+ * is the same between runs, since it's used to index templates within the startup snapshot.
+ */
+std::vector<const MetaObject *> EnginePrivate::internalTypes(){
+    const MetaObject* roots[] = {
+        &Element::metaObject(),
+        &List::metaObject(),
+        &Container::metaObject(),
+        &ErrorHandler::metaObject(),
+        &Tuple::metaObject()
+    };
+
+    std::vector<const MetaObject*> result;
+    for ( const MetaObject* root : roots ){
+        std::vector<const MetaObject*> chain;
+        for ( const MetaObject* t = root; t != nullptr; t = t->base() )
+            chain.push_back(t);
+
+        for ( auto it = chain.rbegin(); it != chain.rend(); ++it ){
+            if ( std::find(result.begin(), result.end(), *it) == result.end() )
+                result.push_back(*it);
+        }
+    }
+    return result;
+}
+
+/**
+ * Returns the null terminated list of callbacks and data pointers referenced by the internal templates. V8 requires
+ * these to serialize and deserialize templates within a startup snapshot.
+ */
+const intptr_t *EnginePrivate::externalReferences(){
+    static const std::vector<intptr_t> references = [](){
+        std::vector<intptr_t> refs = {
+            reinterpret_cast<intptr_t>(&Constructor::nullImplementation),
+            reinterpret_cast<intptr_t>(&Property::ptrGetImplementation),
+            reinterpret_cast<intptr_t>(&Property::ptrSetImplementation),
+            reinterpret_cast<intptr_t>(&Property::ptrIndexGetImplementation),
+            reinterpret_cast<intptr_t>(&Property::ptrIndexSetterImplementation),
+            reinterpret_cast<intptr_t>(&Point::constructPoint),
+            reinterpret_cast<intptr_t>(&Size::constructSize),
+            reinterpret_cast<intptr_t>(&Rectangle::constructRectangle),
+            reinterpret_cast<intptr_t>(static_cast<void(*)(const v8::FunctionCallbackInfo<v8::Value>&)>(&Imports::get)),
+            reinterpret_cast<intptr_t>(static_cast<void(*)(const v8::FunctionCallbackInfo<v8::Value>&)>(&Imports::require)),
+            reinterpret_cast<intptr_t>(static_cast<void(*)(const v8::FunctionCallbackInfo<v8::Value>&)>(&Imports::requireAs)),
+            reinterpret_cast<intptr_t>(&Imports::getImport),
+            reinterpret_cast<intptr_t>(&VisualLogJsObject::f),
+            reinterpret_cast<intptr_t>(&VisualLogJsObject::e),
+            reinterpret_cast<intptr_t>(&VisualLogJsObject::w),
+            reinterpret_cast<intptr_t>(&VisualLogJsObject::i),
+            reinterpret_cast<intptr_t>(&VisualLogJsObject::d),
+            reinterpret_cast<intptr_t>(&VisualLogJsObject::v),
+            reinterpret_cast<intptr_t>(&VisualLogJsObject::configure),
+            reinterpret_cast<intptr_t>(&linkError)
+        };
+
+        for ( const MetaObject* t : internalTypes() ){
+            if ( t->constructor() )
+                refs.push_back(reinterpret_cast<intptr_t>(t->constructor()->ptr()));
+            for ( auto it = t->ownPropertiesBegin(); it != t->ownPropertiesEnd(); ++it )
+                refs.push_back(reinterpret_cast<intptr_t>(it->second));
+            for ( auto it = t->ownMethodsBegin(); it != t->ownMethodsEnd(); ++it ){
+                refs.push_back(reinterpret_cast<intptr_t>(it->second));
+                refs.push_back(reinterpret_cast<intptr_t>(it->second->ptr()));
+            }
+            for ( auto it = t->ownEventsBegin(); it != t->ownEventsEnd(); ++it ){
+                refs.push_back(reinterpret_cast<intptr_t>(static_cast<Function*>(it->second)));
+                refs.push_back(reinterpret_cast<intptr_t>(it->second->ptr()));
+            }
+            for ( auto it = t->functionsBegin(); it != t->functionsEnd(); ++it ){
+                refs.push_back(reinterpret_cast<intptr_t>(it->second));
+                refs.push_back(reinterpret_cast<intptr_t>(it->second->ptr()));
+            }
+        }
+
+        refs.push_back(0);
+        return refs;
+    }();
+
+    return references.data();
+}
+
+size_t EnginePrivate::externalReferenceCount(){
+    size_t count = 0;
+    for ( const intptr_t* ref = externalReferences(); *ref != 0; ++ref )
+        ++count;
+    return count;
+}
+
+/**
+ * Returns the templates stored in the startup snapshot, in the order they are restored in
+ * Engine::restoreInternals().
+ */
+std::vector<v8::Local<v8::FunctionTemplate> > EnginePrivate::snapshotTemplates(){
+    std::vector<v8::Local<v8::FunctionTemplate> > result;
+    for ( const MetaObject* t : internalTypes() )
+        result.push_back(registeredTemplates.at(t)->data.Get(isolate));
+
+    result.push_back(pointTemplate.Get(isolate));
+    result.push_back(sizeTemplate.Get(isolate));
+    result.push_back(rectangleTemplate.Get(isolate));
+    result.push_back(importsTemplate.Get(isolate));
+    return result;
+}
+
+void EnginePrivate::resetTemplates(){
+    for ( auto it = registeredTemplates.begin(); it != registeredTemplates.end(); ++it )
+        delete it->second;
+    registeredTemplates.clear();
+    elementTemplate = nullptr;
+
+    pointTemplate.Reset();
+    sizeTemplate.Reset();
+    rectangleTemplate.Reset();
+    importsTemplate.Reset();
+}
+
 // Engine Initialization
 // --------------------------------------------------------------------------------------------
 
@@ -157,6 +392,160 @@ void Engine::disposeAtExit(){
     }
 }
 
+// Engine Snapshot
+// -------------------------------------------------------------------------------------------
+
+/**
+ * \class lv::el::Engine::Snapshot
+ * \brief Startup snapshot containing the internal types and templates of an engine
+ *
+ * Engines booted from a snapshot deserialize their context and templates instead of creating them, which reduces
+ * the time required to create an engine. Snapshots are created with Engine::createSnapshot(), and can be saved
+ * to a file to be reused between runs. Snapshot files created by a different V8 version or a different lvelements
+ * build (see buildId()) are rejected when loaded.
+ */
+
+Engine::Snapshot::Snapshot(const std::string &data)
+    : m_data(data)
+{
+}
+
+/**
+ * \brief Destructor
+ */
+Engine::Snapshot::~Snapshot(){
+}
+
+/**
+ * \brief Creates a snapshot from the raw V8 startup \p data
+ */
+Engine::Snapshot::Ptr Engine::Snapshot::create(const std::string &data){
+    return Engine::Snapshot::Ptr(new Engine::Snapshot(data));
+}
+
+/**
+ * \brief Loads a snapshot saved with save()
+ *
+ * Returns null if the file cannot be read, or if it was created by a different build.
+ */
+Engine::Snapshot::Ptr Engine::Snapshot::createFromFile(const std::string &path){
+    QFile file(QString::fromStdString(path));
+    if ( !file.open(QIODevice::ReadOnly) )
+        return nullptr;
+
+    QByteArray content = file.readAll();
+    std::string head = header();
+    if ( static_cast<size_t>(content.size()) <= head.size() ||
+         !content.startsWith(QByteArray(head.data(), static_cast<int>(head.size()))) )
+    {
+        vlog("lvelements-engine").w() << "Ignoring incompatible snapshot: " << path;
+        return nullptr;
+    }
+
+    return Engine::Snapshot::Ptr(new Engine::Snapshot(
+        std::string(content.constData() + head.size(), static_cast<size_t>(content.size()) - head.size())
+    ));
+}
+
+/**
+ * \brief Saves this snapshot to \p path
+ *
+ * Throws an lv::Exception if the file cannot be written.
+ */
+void Engine::Snapshot::save(const std::string &path) const{
+    QFile file(QString::fromStdString(path));
+    if ( !file.open(QIODevice::WriteOnly) )
+        THROW_EXCEPTION(lv::Exception, "Failed to write snapshot: " + path, Exception::toCode("~File"));
+
+    std::string head = header();
+    file.write(head.data(), static_cast<qint64>(head.size()));
+    file.write(m_data.data(), static_cast<qint64>(m_data.size()));
+}
+
+/**
+ * \brief Returns the raw V8 startup data
+ */
+const std::string &Engine::Snapshot::data() const{
+    return m_data;
+}
+
+/**
+ * \brief Returns the identifier of this lvelements build, stored in the header of saved snapshots
+ *
+ * Snapshots serialize internal objects by their layout and their external references by index, so a snapshot can
+ * only be used by the build that created it. The identifier contains the compiler, the architecture and the build
+ * type, together with LV_ELEMENTS_BUILD_ID if defined (e.g. a revision), or the time the engine was compiled
+ * otherwise.
+ */
+std::string Engine::Snapshot::buildId(){
+#if defined(__clang__)
+    std::string compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    std::string compiler = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    std::string compiler = "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+    std::string compiler = "unknown";
+#endif
+
+#ifdef NDEBUG
+    std::string buildType = "release";
+#else
+    std::string buildType = "debug";
+#endif
+
+#ifdef LV_ELEMENTS_BUILD_ID
+    std::string build = LV_ELEMENTS_BUILD_ID;
+#else
+    std::string build = std::string(__DATE__) + " " + __TIME__;
+#endif
+
+    return compiler + "/" + std::to_string(sizeof(void*) * 8) + "/" + buildType + "/" + build;
+}
+
+std::string Engine::Snapshot::header(){
+    return "lvsnapshot:" + std::to_string(FormatVersion) + ":" + v8::V8::GetVersion() + ":" +
+           std::to_string(EnginePrivate::externalReferenceCount()) + ":" + buildId() + "\n";
+}
+
+/**
+ * \brief Creates a startup snapshot containing the internal types and templates
+ *
+ * The engine needs to be initialized before calling this function. Throws an lv::Exception if the snapshot
+ * cannot be created.
+ */
+Engine::Snapshot::Ptr Engine::createSnapshot(){
+#ifdef LV_ELEMENTS_SNAPSHOT
+    if ( !isInitialized() )
+        THROW_EXCEPTION(lv::Exception, "Call Engine::Initialize() before creating a snapshot.", 0);
+
+    v8::SnapshotCreator creator(EnginePrivate::externalReferences());
+    {
+        Engine* engine = new Engine(&creator);
+        {
+            v8::HandleScope handle(creator.GetIsolate());
+            creator.SetDefaultContext(engine->m_d->context->asLocal());
+            for ( const v8::Local<v8::FunctionTemplate>& tpl : engine->m_d->snapshotTemplates() )
+                creator.AddData(tpl);
+        }
+        // no persistent handles may be left when creating the blob
+        engine->m_d->resetTemplates();
+        delete engine;
+    }
+
+    v8::StartupData blob = creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+    if ( blob.data == nullptr )
+        THROW_EXCEPTION(lv::Exception, "Failed to create engine snapshot.", Exception::toCode("~Snapshot"));
+
+    std::string data(blob.data, static_cast<size_t>(blob.raw_size));
+    delete[] blob.data;
+
+    return Snapshot::create(data);
+#else
+    THROW_EXCEPTION(lv::Exception, "Engine snapshots are not supported by this V8 version.", Exception::toCode("~Snapshot"));
+#endif
+}
+
 // Engine Input
 // -------------------------------------------------------------------------------------------
 
@@ -181,7 +570,13 @@ const LockedFileIOSession::Ptr &Engine::FileInterceptor::fileInput() const{
 // Engine Implementation
 // --------------------------------------------------------------------------------------------
 
-Engine::Engine(PackageGraph *pg)
+/**
+ * \brief Creates a new engine
+ *
+ * If a \p snapshot is given, the engine context and internal templates are deserialized from it instead of being
+ * created.
+ */
+Engine::Engine(PackageGraph *pg, const Snapshot::Ptr &snapshot)
     : m_d(new EnginePrivate)
 {
     if ( !isInitialized() )
@@ -190,13 +585,44 @@ Engine::Engine(PackageGraph *pg)
     // Create a new Isolate and make it the current one.
 
     m_d->createParams = new v8::Isolate::CreateParams;
-    m_d->createParams->array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    m_d->createParams->array_buffer_allocator = ArrayBufferAllocator::instance();
+
+    if ( snapshot ){
+#ifdef LV_ELEMENTS_SNAPSHOT
+        m_d->snapshot = snapshot;
+        m_d->snapshotBlob.data = snapshot->data().data();
+        m_d->snapshotBlob.raw_size = static_cast<int>(snapshot->data().size());
+        m_d->createParams->snapshot_blob = &m_d->snapshotBlob;
+        m_d->createParams->external_references = EnginePrivate::externalReferences();
+#else
+        delete m_d->createParams;
+        THROW_EXCEPTION(lv::Exception, "Engine snapshots are not supported by this V8 version.", Exception::toCode("~Snapshot"));
+#endif
+    }
 
     m_d->isolate = v8::Isolate::New(*m_d->createParams);
     if ( m_d->isolate->GetNumberOfDataSlots() == 1 ){
         delete m_d->createParams;
         THROW_EXCEPTION(lv::Exception, "Not enough data slots allocated in the isolate.", 1);
     }
+
+    initializeContext(pg);
+}
+
+/**
+ * Creates an engine within the isolate of \p snapshotCreator. The isolate is owned by the creator.
+ */
+Engine::Engine(v8::SnapshotCreator *snapshotCreator)
+    : m_d(new EnginePrivate)
+{
+    m_d->createParams    = nullptr;
+    m_d->snapshotCreator = snapshotCreator;
+    m_d->isolate         = snapshotCreator->GetIsolate();
+
+    initializeContext(nullptr);
+}
+
+void Engine::initializeContext(PackageGraph *pg){
     m_d->isolate->SetData(0, this);
     m_d->mainIsolateScope = new v8::Isolate::Scope(m_d->isolate);
 
@@ -206,17 +632,26 @@ Engine::Engine(PackageGraph *pg)
 
     v8::Local<v8::External> listenerData = v8::External::New(isolate(), this);
     m_d->isolate->AddMessageListener(&EnginePrivate::messageListener, listenerData);
+    m_d->isolate->AddGCEpilogueCallback(&EnginePrivate::gcEpilogue, v8::kGCTypeMarkSweepCompact);
 
     m_d->packageGraph    = (pg == nullptr) ? new PackageGraph : pg;
     m_d->fileInterceptor = new Engine::FileInterceptor;
 
-    importInternals();
+    if ( m_d->snapshot )
+        restoreInternals();
+    else
+        importInternals();
 }
 
 Engine::~Engine(){
+    delete m_d->modulePrefetcher;
+    for ( auto it = m_d->transpilers.begin(); it != m_d->transpilers.end(); ++it )
+        delete it->second;
     delete m_d->context;
+    BufferHandle::releaseAll(m_d->isolate);
     delete m_d->mainIsolateScope;
-    m_d->isolate->Dispose();
+    if ( !m_d->snapshotCreator )
+        m_d->isolate->Dispose();
 }
 
 v8::Isolate *Engine::isolate(){
@@ -352,8 +787,22 @@ Script::Ptr Engine::compileModuleFile(const std::string &path){
 }
 
 Script::Ptr Engine::compileModuleSource(const std::string &path, const std::string &source){
-    m_d->parser->setEngine(this);
-    std::string jssource = m_d->parser->toJs(source, QFileInfo(QString::fromStdString(path)).baseName().toStdString());
+    std::string name = QFileInfo(QString::fromStdString(path)).baseName().toStdString();
+
+    std::string cacheKey;
+    CompileCache::Entry cacheEntry;
+    bool isCached = false;
+    if ( m_d->compileCache ){
+        cacheKey = CompileCache::createKey(name, source, v8::V8::GetVersion());
+        isCached = m_d->compileCache->lookup(cacheKey, cacheEntry);
+    }
+
+    bool isPrefetched = !isCached && m_d->modulePrefetcher && m_d->modulePrefetcher->take(path, source, cacheEntry.js);
+
+    if ( !isCached && !isPrefetched ){
+        m_d->parser->setEngine(this);
+        cacheEntry.js = m_d->transpile(path, name, source);
+    }
 
     v8::HandleScope handle(isolate());
     v8::Local<v8::Context> context = m_d->context->asLocal();
@@ -363,11 +812,20 @@ Script::Ptr Engine::compileModuleSource(const std::string &path, const std::stri
     if ( !file.is_open() )
         THROW_EXCEPTION(Exception, "Failed to open file: " + path, Exception::toCode("~ScriptFile"));
 
-    std::string jssourceEnclosed = Script::moduleEncloseStart + jssource + Script::moduleEncloseEnd;
+    std::string jssourceEnclosed = Script::moduleEncloseStart + cacheEntry.js + Script::moduleEncloseEnd;
 
     v8::Local<v8::String> sourceLocal = v8::String::NewFromUtf8(isolate(), jssourceEnclosed.c_str());
 
-    v8::MaybeLocal<v8::Script> script = v8::Script::Compile(context, sourceLocal);
+    v8::MaybeLocal<v8::Script> script;
+    if ( m_d->compileCache ){
+        bool isEntryModified = !isCached;
+        script = EnginePrivate::compileCached(context, sourceLocal, cacheEntry, isEntryModified);
+        if ( !script.IsEmpty() && isEntryModified && !m_d->compileCache->store(cacheKey, cacheEntry) )
+            vlog("lvelements-engine").w() << "Failed to store compile cache entry for: " << path;
+    } else {
+        script = v8::Script::Compile(context, sourceLocal);
+    }
+
     if ( script.IsEmpty() )
         THROW_EXCEPTION(Exception, "Failed to compile script: " + path, Exception::toCode("~CompileScript"));
 
@@ -416,6 +874,8 @@ Object Engine::loadFile(const std::string &path){
         plugin = m_d->packageGraph->createRunningPlugin(pluginPath);
     }
 
+    prefetchModules(plugin, path);
+
     ElementsPlugin::Ptr epl = ElementsPlugin::create(plugin, this);
     ModuleFile* mf = ElementsPlugin::addModuleFile(epl, fileName);
 
@@ -454,6 +914,28 @@ Object Engine::loadFile(const std::string &path, const std::string &content){
     return lm.get(this, "exports").toObject(this);
 }
 
+/**
+ * \brief Parses and transpiles \p entryPath and all the modules reachable from it on background threads
+ *
+ * Modules compiled afterwards take their javascript from the prefetcher instead of transpiling it on the
+ * calling thread. See lv::el::ModulePrefetcher for details.
+ */
+void Engine::prefetchModules(const Plugin::Ptr &plugin, const std::string &entryPath){
+    if ( m_d->moduleFileType == Engine::JsOnly )
+        return;
+
+    modulePrefetcher()->prefetch(plugin, entryPath);
+}
+
+/**
+ * \brief Returns the prefetcher used by this engine, creating it if required
+ */
+ModulePrefetcher *Engine::modulePrefetcher(){
+    if ( !m_d->modulePrefetcher )
+        m_d->modulePrefetcher = new ModulePrefetcher(this);
+    return m_d->modulePrefetcher;
+}
+
 ComponentTemplate *Engine::registerTemplate(const MetaObject *t){
     auto it = m_d->registeredTemplates.find(t);
     if ( it != m_d->registeredTemplates.end() )
@@ -492,14 +974,14 @@ ComponentTemplate *Engine::registerTemplate(const MetaObject *t){
 
         if ( p->isWritable() ){
             tplInstance->SetAccessor(
-                v8::String::NewFromUtf8(isolate(), propIt->first.c_str()),
+                v8::String::NewFromUtf8(isolate(), propIt->first.c_str(), v8::String::kInternalizedString),
                 &Property::ptrGetImplementation,
                 &Property::ptrSetImplementation,
                 pdata
             );
         } else {
             tplInstance->SetAccessor(
-                v8::String::NewFromUtf8(isolate(), propIt->first.c_str()),
+                v8::String::NewFromUtf8(isolate(), propIt->first.c_str(), v8::String::kInternalizedString),
                 &Property::ptrGetImplementation,
                 nullptr,
                 pdata
@@ -725,6 +1207,10 @@ void Engine::clearPendingException(){
     m_d->pendingExceptionNesting = -1;
 }
 
+PackageGraph *Engine::packageGraph() const{
+    return m_d->packageGraph;
+}
+
 const std::vector<std::string> Engine::packageImportPaths() const{
     return m_d->packageGraph->packageImportPaths();
 }
@@ -759,6 +1245,23 @@ void Engine::setFileInterceptor(Engine::FileInterceptor *fileInterceptor){
     m_d->fileInterceptor = fileInterceptor;
 }
 
+/**
+ * \brief Returns the compile cache used for modules, null if modules are not cached
+ */
+const CompileCache::Ptr &Engine::compileCache() const{
+    return m_d->compileCache;
+}
+
+/**
+ * \brief Sets the cache used to store transpiled modules and their code cache
+ *
+ * Modules compiled through compileModuleSource() will first look up their source in the cache, skipping both
+ * transpiling and parsing on a hit. Pass null to disable caching.
+ */
+void Engine::setCompileCache(const CompileCache::Ptr &compileCache){
+    m_d->compileCache = compileCache;
+}
+
 void Engine::importInternals(){
     v8::HandleScope handle(isolate());
     v8::Local<v8::Context> context = m_d->context->asLocal();
@@ -805,6 +1308,29 @@ void Engine::importInternals(){
         v8::FunctionTemplate::New(isolate(), &linkError)->GetFunction());
 }
 
+/**
+ * Restores the internal templates from the startup snapshot. The context globals are already part of the
+ * deserialized context.
+ */
+void Engine::restoreInternals(){
+#ifdef LV_ELEMENTS_SNAPSHOT
+    v8::HandleScope handle(isolate());
+
+    size_t index = 0;
+    for ( const MetaObject* t : EnginePrivate::internalTypes() ){
+        v8::Local<v8::FunctionTemplate> tpl =
+            isolate()->GetDataFromSnapshotOnce<v8::FunctionTemplate>(index++).ToLocalChecked();
+        m_d->registeredTemplates[t] = new ComponentTemplate(this, tpl);
+    }
+    m_d->elementTemplate = m_d->registeredTemplates[&Element::metaObject()];
+
+    m_d->pointTemplate.Reset(isolate(), isolate()->GetDataFromSnapshotOnce<v8::FunctionTemplate>(index++).ToLocalChecked());
+    m_d->sizeTemplate.Reset(isolate(), isolate()->GetDataFromSnapshotOnce<v8::FunctionTemplate>(index++).ToLocalChecked());
+    m_d->rectangleTemplate.Reset(isolate(), isolate()->GetDataFromSnapshotOnce<v8::FunctionTemplate>(index++).ToLocalChecked());
+    m_d->importsTemplate.Reset(isolate(), isolate()->GetDataFromSnapshotOnce<v8::FunctionTemplate>(index++).ToLocalChecked());
+#endif
+}
+
 void Engine::wrapScriptObject(Element *element){
     ComponentTemplate* ctpl = registerTemplate(&element->typeMetaObject());
     v8::Local<v8::FunctionTemplate> tpl = ctpl->data.Get(isolate());
@@ -867,6 +1393,28 @@ void Engine::scope(const std::function<void()> &f){
     f();
 }
 
+/**
+ * \brief Runs \p f in a single binding transaction
+ *
+ * Property expressions bound to values changed within \p f are evaluated once, after \p f returns, in the order
+ * of their dependencies. Batches can be nested, in which case the expressions are evaluated when the outermost one
+ * ends. If \p f throws, the pending expressions are discarded.
+ */
+void Engine::batch(const std::function<void ()> &f){
+    m_d->bindingScheduler.begin();
+    try{
+        f();
+    } catch ( ... ){
+        m_d->bindingScheduler.cancel();
+        throw;
+    }
+    m_d->bindingScheduler.end();
+}
+
+BindingScheduler *Engine::bindingScheduler(){
+    return &m_d->bindingScheduler;
+}
+
 Engine::InitializeScope::InitializeScope(const std::string &defaultLocation){
     Engine::initialize(defaultLocation);
 }
@@ -7,6 +7,7 @@
 #include "live/elements/script.h"
 #include "live/elements/elementsplugin.h"
 #include "live/elements/languageparser.h"
+#include "live/elements/compilecache.h"
 #include "live/packagegraph.h"
 #include "live/lockedfileiosession.h"
 
@@ -18,6 +19,8 @@ namespace el{
 
 class Context;
 class ComponentTemplate;
+class ModulePrefetcher;
+class BindingScheduler;
 class EnginePrivate;
 class LV_ELEMENTS_EXPORT Engine{
 
@@ -81,6 +84,42 @@ public:
         LockedFileIOSession::Ptr m_fileInput;
     };
 
+    // Startup snapshot
+    // ----------------
+
+    class LV_ELEMENTS_EXPORT Snapshot{
+
+        DISABLE_COPY(Snapshot);
+
+    public:
+        /** Shared pointer to this class */
+        typedef std::shared_ptr<Snapshot> Ptr;
+
+        /** Version of the snapshot file format */
+        static const int FormatVersion = 1;
+
+    public:
+        ~Snapshot();
+
+        static Ptr create(const std::string& data);
+        static Ptr createFromFile(const std::string& path);
+
+        void save(const std::string& path) const;
+
+        const std::string& data() const;
+
+        static std::string buildId();
+
+    private:
+        Snapshot(const std::string& data);
+
+        static std::string header();
+
+        std::string m_data;
+    };
+
+    static Snapshot::Ptr createSnapshot();
+
 private:
     static InitializeData* m_initializeData;
 
@@ -95,13 +134,14 @@ public:
     };
 
 public:
-    Engine(PackageGraph* pg = nullptr);
+    Engine(PackageGraph* pg = nullptr, const Snapshot::Ptr& snapshot = nullptr);
     ~Engine();
 
     Object require(ModuleLibrary* module, const Object& o);
     ElementsPlugin::Ptr require(const std::string& importKey, Plugin::Ptr requestingPlugin = nullptr);
 
     void scope(const std::function<void()> &f);
+    void batch(const std::function<void()>& f);
 
     v8::Isolate* isolate();
 
@@ -118,6 +158,9 @@ public:
     Object loadFile(const std::string& path, const std::string& content);
     Object loadJsFile(const std::string& path);
 
+    void prefetchModules(const Plugin::Ptr& plugin, const std::string& entryPath);
+    ModulePrefetcher* modulePrefetcher();
+
     ComponentTemplate* registerTemplate(const MetaObject* mo);
     v8::Local<v8::FunctionTemplate> pointTemplate();
     v8::Local<v8::FunctionTemplate> sizeTemplate();
@@ -134,6 +177,8 @@ public:
     void decrementTryCatchNesting();
     void clearPendingException();
 
+    PackageGraph* packageGraph() const;
+
     const std::vector<std::string> packageImportPaths() const;
     void setPackageImportPaths(const std::vector<std::string>& paths);
 
@@ -147,13 +192,22 @@ public:
     const FileInterceptor* fileInterceptor() const;
     void setFileInterceptor(FileInterceptor* fileInterceptor);
 
+    const CompileCache::Ptr& compileCache() const;
+    void setCompileCache(const CompileCache::Ptr& compileCache);
+
 private:
+    Engine(v8::SnapshotCreator* snapshotCreator);
+
+    void initializeContext(PackageGraph* pg);
     void importInternals();
+    void restoreInternals();
     void wrapScriptObject(Element* element);
 
     int tryCatchNesting();
     void setGlobalErrorHandler(bool value);
 
+    BindingScheduler* bindingScheduler();
+
 
     EnginePrivate* m_d;
 };
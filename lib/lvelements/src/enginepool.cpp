@@ -0,0 +1,379 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "enginepool.h"
+#include "live/elements/object.h"
+#include "live/elements/callable.h"
+#include "live/elements/mlnodetojs.h"
+#include "live/commandlineparser.h"
+#include "live/mlnodetojson.h"
+#include "live/exception.h"
+#include "live/visuallog.h"
+#include "v8nowarnings.h"
+
+#include <QFile>
+
+#include <iostream>
+
+namespace lv{ namespace el{
+
+/**
+ * \class lv::el::EnginePool
+ * \brief Runs independent scripts on multiple engines in parallel
+ *
+ * Each engine owns its own isolate and runs on its own thread for the lifetime of the pool. Engines are created
+ * on their threads when the first job is run, from the same startup snapshot and with the same compile cache if
+ * given, so modules compiled by one engine are cached for the others.
+ *
+ * run() executes a job once on each engine. map() loads a module in each engine and calls one of its exported
+ * functions for each input, distributing the inputs between engines. Inputs are converted to script values from
+ * MLNode, and results are converted back to MLNode, or to an owned Buffer if the function returned an
+ * ```ArrayBuffer```.
+ *
+ * @code
+ * EnginePool pool(4);
+ * std::vector<EnginePool::Result> results = pool.map("pipeline.lv", "main", inputs);
+ * @endcode
+ *
+ * exec() wraps map() in a command line entry point, reading inputs from and writing results to json files.
+ *
+ * \ingroup lvelements
+ */
+
+/**
+ * \brief Creates a pool of \p engineCount engines, created from \p snapshot if given
+ *
+ * An \p engineCount of 0 creates one engine for each hardware thread.
+ */
+EnginePool::EnginePool(size_t engineCount, const Engine::Snapshot::Ptr &snapshot)
+    : m_engineCount(engineCount)
+    , m_snapshot(snapshot)
+    , m_jobId(0)
+    , m_pending(0)
+    , m_stopped(false)
+{
+    if ( m_engineCount == 0 )
+        m_engineCount = std::thread::hardware_concurrency();
+    if ( m_engineCount == 0 )
+        m_engineCount = 1;
+}
+
+/**
+ * \brief Destructor, destroys the engines on their threads
+ */
+EnginePool::~EnginePool(){
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_stopped = true;
+    }
+    m_wakeCondition.notify_all();
+    for ( auto it = m_threads.begin(); it != m_threads.end(); ++it )
+        it->join();
+}
+
+/**
+ * \brief Assigns a compile cache shared by all engines. Only applies to engines created afterwards.
+ */
+void EnginePool::setCompileCache(const CompileCache::Ptr &compileCache){
+    m_compileCache = compileCache;
+}
+
+/**
+ * \brief Assigns the package import paths for each engine. Only applies to engines created afterwards.
+ */
+void EnginePool::setPackageImportPaths(const std::vector<std::string> &paths){
+    m_packageImportPaths = paths;
+}
+
+/**
+ * \brief Runs \p job once on each engine, and waits for all of them to finish
+ *
+ * The job runs on the engine's thread, and needs to handle its own exceptions. Engines that could not be created
+ * are skipped.
+ */
+void EnginePool::run(const EnginePool::Job &job){
+    std::lock_guard<std::mutex> runGuard(m_runMutex);
+    start();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_job     = job;
+    m_pending = m_threads.size();
+    ++m_jobId;
+    m_wakeCondition.notify_all();
+
+    m_doneCondition.wait(lock, [this](){ return m_pending == 0; });
+    m_job = nullptr;
+}
+
+/**
+ * \brief Calls the function exported as \p functionName from the module at \p modulePath for each of the \p inputs
+ *
+ * Modules with a ```.js``` extension are loaded as javascript, otherwise they are loaded as Elements modules.
+ * Each engine loads its own instance of the module, then takes inputs until all are processed. Results are
+ * returned in the order of the inputs. Errors thrown while loading the module or running the function are
+ * captured in the result of each affected input.
+ */
+std::vector<EnginePool::Result> EnginePool::map(
+        const std::string &modulePath,
+        const std::string &functionName,
+        const std::vector<MLNode> &inputs)
+{
+    std::vector<Result> results(inputs.size());
+    for ( auto it = results.begin(); it != results.end(); ++it )
+        it->error = "Input was not processed.";
+
+    std::atomic<size_t> next(0);
+
+    run([&modulePath, &functionName, &inputs, &results, &next](Engine* engine){
+        engine->scope([&](){
+            Callable function(engine);
+            std::string loadError;
+
+            engine->tryCatch([&](){
+                try{
+                    bool isJs = modulePath.size() > 3 && modulePath.compare(modulePath.size() - 3, 3, ".js") == 0;
+                    Object exports = isJs ? engine->loadJsFile(modulePath) : engine->loadFile(modulePath);
+                    if ( exports.isNull() ){
+                        loadError = "Failed to load module: " + modulePath;
+                        return;
+                    }
+
+                    Object::Accessor exportsAccessor(exports);
+                    ScopedValue exported = exportsAccessor.get(engine, functionName);
+                    if ( !exported.isCallable() ){
+                        loadError = "Module \'" + modulePath + "\' does not export a function named: " + functionName;
+                        return;
+                    }
+                    function = exported.toCallable(engine);
+
+                } catch ( lv::Exception& e ){
+                    loadError = e.message();
+                }
+            }, [&loadError](const Engine::CatchData& cd){
+                loadError = cd.message();
+            });
+
+            size_t index;
+            while ( (index = next++) < inputs.size() ){
+                Result& result = results[index];
+                result.error.clear();
+
+                if ( !loadError.empty() ){
+                    result.error = loadError;
+                    continue;
+                }
+
+                engine->scope([&](){
+                    engine->tryCatch([&](){
+                        try{
+                            ScopedValue input(engine);
+                            ml::toJs(inputs[index], input, engine);
+
+                            Function::Parameters params(1);
+                            params.assign(0, input);
+
+                            // empty if the function threw, in which case the error is captured below
+                            ScopedValue output = function.call(engine, params);
+                            if ( output.data().IsEmpty() )
+                                return;
+
+                            if ( output.isBuffer() ){
+                                result.buffer = output.toBuffer(engine);
+                                if ( !result.buffer.isOwned() )
+                                    result.buffer = Buffer::copy(result.buffer.data(), result.buffer.size());
+                            } else {
+                                ml::fromJs(output, result.value, engine);
+                            }
+                        } catch ( lv::Exception& e ){
+                            result.error = e.message();
+                        }
+                    }, [&result](const Engine::CatchData& cd){
+                        result.error = cd.message();
+                    });
+                });
+            }
+        });
+    });
+
+    return results;
+}
+
+/**
+ * \brief Command line entry point for map()
+ *
+ * Usage: ```[options] <module> <inputs.json>```, where the inputs file contains an array with one entry per
+ * input. Results are written as a json array, with buffers as base64 strings and failed inputs as
+ * ```{"error": message}``` objects. Returns 0 if all inputs were processed successfully.
+ *
+ * Engine::initialize() needs to be called before.
+ */
+int EnginePool::exec(int argc, const char * const argv[]){
+    CommandLineParser parser("Runs a function exported by an Elements module for each input, in parallel.");
+    CommandLineParser::Option* functionOption = parser.addOption({"-f", "--function"},
+        "Name of the exported function to call. Defaults to 'main'.", "string");
+    CommandLineParser::Option* jobsOption = parser.addOption({"-j", "--jobs"},
+        "Number of engines to run in parallel. Defaults to the number of hardware threads.", "int");
+    CommandLineParser::Option* outputOption = parser.addOption({"-o", "--output"},
+        "File to write the results to. Defaults to the standard output.", "string");
+    CommandLineParser::Option* cacheOption = parser.addOption({"--compile-cache"},
+        "Directory of a compile cache shared by all engines.", "string");
+    CommandLineParser::Option* snapshotOption = parser.addOption({"--snapshot"},
+        "Engine snapshot to create engines from.", "string");
+
+    try{
+        parser.parse(argc, argv);
+    } catch ( lv::Exception& e ){
+        std::cerr << e.message() << std::endl << parser.helpString() << std::endl;
+        return 1;
+    }
+
+    if ( parser.isSet(parser.helpOption()) ){
+        std::cout << parser.helpString() << std::endl;
+        return 0;
+    }
+
+    if ( parser.script().empty() || parser.scriptArguments().empty() ){
+        std::cerr << "A module and an inputs file are required." << std::endl << parser.helpString() << std::endl;
+        return 1;
+    }
+
+    if ( !Engine::isInitialized() ){
+        std::cerr << "Engine is not initialized." << std::endl;
+        return 1;
+    }
+
+    try{
+        QFile inputFile(QString::fromStdString(parser.scriptArguments().front()));
+        if ( !inputFile.open(QIODevice::ReadOnly) )
+            THROW_EXCEPTION(lv::Exception, "Failed to read inputs file: " + parser.scriptArguments().front(), Exception::toCode("~File"));
+
+        MLNode inputsNode;
+        ml::fromJson(inputFile.readAll().toStdString(), inputsNode);
+        if ( inputsNode.type() != MLNode::Array )
+            THROW_EXCEPTION(lv::Exception, "Inputs file needs to contain an array.", Exception::toCode("~Format"));
+
+        std::vector<MLNode> inputs;
+        for ( auto it = inputsNode.begin(); it != inputsNode.end(); ++it )
+            inputs.push_back(it.value());
+
+        Engine::Snapshot::Ptr snapshot = parser.isSet(snapshotOption)
+            ? Engine::Snapshot::createFromFile(parser.value(snapshotOption))
+            : nullptr;
+
+        size_t jobs = parser.isSet(jobsOption) ? static_cast<size_t>(std::stoul(parser.value(jobsOption))) : 0;
+
+        EnginePool pool(jobs, snapshot);
+        if ( parser.isSet(cacheOption) )
+            pool.setCompileCache(CompileCache::Ptr(new CompileCache(parser.value(cacheOption))));
+
+        std::string functionName = parser.isSet(functionOption) ? parser.value(functionOption) : "main";
+        std::vector<Result> results = pool.map(parser.script(), functionName, inputs);
+
+        bool hasErrors = false;
+        MLNode output(MLNode::Array);
+        for ( auto it = results.begin(); it != results.end(); ++it ){
+            if ( it->hasError() ){
+                hasErrors = true;
+                MLNode error(MLNode::Object);
+                error["error"] = it->error;
+                output.append(error);
+            } else if ( it->buffer.isOwned() ){
+                output.append(MLNode(MLNode::BytesType(it->buffer.dataAs<MLNode::ByteType*>(), it->buffer.size())));
+            } else {
+                output.append(it->value);
+            }
+        }
+
+        std::string serialized;
+        ml::toJson(output, serialized);
+
+        if ( parser.isSet(outputOption) ){
+            QFile outputFile(QString::fromStdString(parser.value(outputOption)));
+            if ( !outputFile.open(QIODevice::WriteOnly) )
+                THROW_EXCEPTION(lv::Exception, "Failed to write output file: " + parser.value(outputOption), Exception::toCode("~File"));
+            outputFile.write(serialized.data(), static_cast<qint64>(serialized.size()));
+        } else {
+            std::cout << serialized << std::endl;
+        }
+
+        return hasErrors ? 1 : 0;
+
+    } catch ( lv::Exception& e ){
+        std::cerr << e.message() << std::endl;
+        return 1;
+    } catch ( std::exception& e ){
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
+
+void EnginePool::start(){
+    if ( !m_threads.empty() )
+        return;
+
+    for ( size_t i = 0; i < m_engineCount; ++i )
+        m_threads.push_back(std::thread(&EnginePool::work, this));
+}
+
+void EnginePool::work(){
+    // Isolates are used only by the thread that entered them, so each engine lives on its worker thread
+    Engine* engine = nullptr;
+    try{
+        engine = new Engine(nullptr, m_snapshot);
+        if ( m_compileCache )
+            engine->setCompileCache(m_compileCache);
+        if ( !m_packageImportPaths.empty() )
+            engine->setPackageImportPaths(m_packageImportPaths);
+    } catch ( lv::Exception& e ){
+        vlog("lvelements-enginepool").e() << "Failed to create engine: " << e.message();
+        delete engine;
+        engine = nullptr;
+    }
+
+    size_t lastJobId = 0;
+    while ( true ){
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, lastJobId](){ return m_stopped || m_jobId != lastJobId; });
+            if ( m_stopped )
+                break;
+            lastJobId = m_jobId;
+            job = m_job;
+        }
+
+        if ( engine ){
+            try{
+                job(engine);
+            } catch ( lv::Exception& e ){
+                vlog("lvelements-enginepool").e() << "Uncaught exception in engine job: " << e.message();
+            } catch ( std::exception& e ){
+                vlog("lvelements-enginepool").e() << "Uncaught exception in engine job: " << e.what();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            if ( --m_pending == 0 )
+                m_doneCondition.notify_all();
+        }
+    }
+
+    delete engine;
+}
+
+}} // namespace lv, el
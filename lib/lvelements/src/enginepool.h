@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVENGINEPOOL_H
+#define LVENGINEPOOL_H
+
+#include "live/elements/lvelementsglobal.h"
+#include "live/elements/engine.h"
+#include "live/elements/buffer.h"
+#include "live/elements/compilecache.h"
+#include "live/mlnode.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lv{ namespace el{
+
+class LV_ELEMENTS_EXPORT EnginePool{
+
+    DISABLE_COPY(EnginePool);
+
+public:
+    /**
+     * \class lv::el::EnginePool::Result
+     * \brief Outcome of running a module function on a single input
+     */
+    class LV_ELEMENTS_EXPORT Result{
+    public:
+        Result() : buffer(nullptr, 0){}
+
+        /** Checks wether running the function failed */
+        bool hasError() const{ return !error.empty(); }
+
+        /** Value returned by the function, if it's not an ArrayBuffer */
+        MLNode      value;
+        /** Owned buffer returned by the function, if it returned an ArrayBuffer */
+        Buffer      buffer;
+        /** Error message, empty on success */
+        std::string error;
+    };
+
+    /** Job run by each engine, on the engine's thread */
+    typedef std::function<void(Engine*)> Job;
+
+public:
+    explicit EnginePool(size_t engineCount = 0, const Engine::Snapshot::Ptr& snapshot = nullptr);
+    ~EnginePool();
+
+    size_t engineCount() const;
+
+    const CompileCache::Ptr& compileCache() const;
+    void setCompileCache(const CompileCache::Ptr& compileCache);
+
+    const std::vector<std::string>& packageImportPaths() const;
+    void setPackageImportPaths(const std::vector<std::string>& paths);
+
+    void run(const Job& job);
+    std::vector<Result> map(const std::string& modulePath, const std::string& functionName, const std::vector<MLNode>& inputs);
+
+    static int exec(int argc, const char* const argv[]);
+
+private:
+    void start();
+    void work();
+
+    size_t                   m_engineCount;
+    Engine::Snapshot::Ptr    m_snapshot;
+    CompileCache::Ptr        m_compileCache;
+    std::vector<std::string> m_packageImportPaths;
+
+    std::vector<std::thread> m_threads;
+    std::mutex               m_runMutex;
+    std::mutex               m_mutex;
+    std::condition_variable  m_wakeCondition;
+    std::condition_variable  m_doneCondition;
+    Job                      m_job;
+    size_t                   m_jobId;
+    size_t                   m_pending;
+    bool                     m_stopped;
+};
+
+/**
+ * \brief Returns the number of engines in this pool, each running on its own thread
+ */
+inline size_t EnginePool::engineCount() const{
+    return m_engineCount;
+}
+
+/**
+ * \brief Returns the compile cache shared by the engines
+ */
+inline const CompileCache::Ptr &EnginePool::compileCache() const{
+    return m_compileCache;
+}
+
+/**
+ * \brief Returns the package import paths assigned to each engine
+ */
+inline const std::vector<std::string> &EnginePool::packageImportPaths() const{
+    return m_packageImportPaths;
+}
+
+}} // namespace lv, el
+
+#endif // LVENGINEPOOL_H
@@ -6,6 +6,26 @@ namespace lv{ namespace el{
 
 std::map<std::type_index, Event::Id> EventIdGenerator::registeredTypes;
 
+Event::Id EventIdGenerator::registerType(const std::type_index &t){
+    std::lock_guard<std::mutex> guard(registryMutex());
+    auto it = registeredTypes.find(t);
+    if ( it != registeredTypes.end() )
+        return it->second;
+
+    // type id 0 is left for instance events
+    Event::Id tId = static_cast<Event::Id>(registeredTypes.size() + 1);
+    registeredTypes[t] = tId;
+    return tId;
+}
+
+/**
+ * \brief Guards the type and event registries, since engines can run on multiple threads
+ */
+std::mutex &EventIdGenerator::registryMutex(){
+    static std::mutex mutex;
+    return mutex;
+}
+
 Engine *EventListenerContainerBase::elementEngine(Element *element){
     return element->engine();
 }
@@ -9,11 +9,16 @@
 #include "live/meta/functionargs.h"
 #include "live/meta/indextuple.h"
 
+#include <atomic>
 #include <functional>
 #include <list>
+#include <memory>
 #include <set>
 #include <typeindex>
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace lv{ namespace el{
 
@@ -58,8 +63,31 @@ public:
     public:
         typedef void (T::*EventFunction)();
 
-        static std::list<std::pair<EventFunction, Event::Id> >& registeredEvents(){
-            static std::list<std::pair<EventFunction, Event::Id> > internal;
+        /// \private
+        class EventFunctionHash{
+        public:
+            size_t operator()(const EventFunction& f) const{
+                // member function pointers cannot be converted to integers, so their representation is hashed
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&f);
+                size_t result = 14695981039346656037ULL;
+                for ( size_t i = 0; i < sizeof(EventFunction); ++i ){
+                    result ^= bytes[i];
+                    result *= 1099511628211ULL;
+                }
+                return result;
+            }
+        };
+
+        typedef std::unordered_map<EventFunction, Event::Id, EventFunctionHash> EventMap;
+
+        /// Each registration publishes a new copy of the map. Older copies are kept, since readers may still use them.
+        static std::vector<std::unique_ptr<EventMap> >& registeredEventVersions(){
+            static std::vector<std::unique_ptr<EventMap> > internal;
+            return internal;
+        }
+
+        static std::atomic<const EventMap*>& registeredEvents(){
+            static std::atomic<const EventMap*> internal(nullptr);
             return internal;
         }
 
@@ -68,35 +96,42 @@ public:
 
             // This is allowed according to Standard C: ISO/IEC 9899:1999(E) SECTION 6.3.2.3, paragraph 8
             EventFunction ei = reinterpret_cast<EventFunction>(f);
-            Event::Id eId = 0;
 
-            for ( auto it = registeredEvents().begin(); it != registeredEvents().end(); ++it ){
-                if ( it->first == ei ){
+            // registered events are looked up without locking, the mutex only guards new registrations
+            const EventMap* events = registeredEvents().load(std::memory_order_acquire);
+            if ( events ){
+                auto it = events->find(ei);
+                if ( it != events->end() )
                     return it->second;
-                }
             }
 
-            eId = registeredEvents().size();
-            registeredEvents().push_back(std::make_pair(ei, eId));
+            std::lock_guard<std::mutex> guard(registryMutex());
+            std::vector<std::unique_ptr<EventMap> >& versions = registeredEventVersions();
+            if ( !versions.empty() ){
+                auto it = versions.back()->find(ei);
+                if ( it != versions.back()->end() )
+                    return it->second;
+            }
+
+            EventMap* next = versions.empty() ? new EventMap : new EventMap(*versions.back());
+            Event::Id eId = next->size();
+            (*next)[ei] = eId;
+
+            versions.push_back(std::unique_ptr<EventMap>(next));
+            registeredEvents().store(next, std::memory_order_release);
 
             return eId;
         }
 
     };
 
+    static Event::Id registerType(const std::type_index& t);
+    static std::mutex& registryMutex();
 
     template<typename T>
     static Event::Id typeEventId(){
-        std::type_index t(typeid(T));
-        Event::Id tId = 0;
-
-        auto it = EventIdGenerator::registeredTypes.find(t);
-        if ( it == EventIdGenerator::registeredTypes.end() ){
-            tId = static_cast<Event::Id>(EventIdGenerator::registeredTypes.size());
-            EventIdGenerator::registeredTypes[t] = tId;
-        } else {
-            tId = it->second;
-        }
+        // resolved once per type, the registry keeps ids unique across libraries
+        static Event::Id tId = registerType(std::type_index(typeid(T)));
         return tId;
     }
 
@@ -112,8 +147,8 @@ public:
         return (instanceEventId << 48 ) | (localEventId << 32) | typeId;
     }
     static void separate(Event::Id eventId, Event::Id& typeId, Event::Id& localEventId, Event::Id& instanceEventId){
-        typeId          = eventId & 0xFFFF;
-        localEventId    = (eventId >> 32) & 0xFF;
+        typeId          = eventId & 0xFFFFFFFF;
+        localEventId    = (eventId >> 32) & 0xFFFF;
         instanceEventId = (eventId >> 48);
     }
 
@@ -435,6 +470,47 @@ private:
     std::list<std::list<EventConnectionFunction<const Function::Parameters&>* >::iterator*> m_callIterators;
 };
 
+/**
+ * @brief Listener containers of an element, indexed by event id.
+ *
+ * Elements usually have listeners on only a few of their events, so the containers are kept in a flat vector
+ * that is scanned linearly, which is faster to dispatch through than a tree.
+ */
+class EventListenerTable{
+
+public:
+    typedef std::pair<Event::Id, EventListenerContainerBase*> Entry;
+    typedef std::vector<Entry>::iterator                        Iterator;
+
+public:
+    Iterator begin(){ return m_entries.begin(); }
+    Iterator end(){ return m_entries.end(); }
+
+    Iterator find(Event::Id eventId){
+        for ( auto it = m_entries.begin(); it != m_entries.end(); ++it ){
+            if ( it->first == eventId )
+                return it;
+        }
+        return m_entries.end();
+    }
+
+    EventListenerContainerBase*& operator[](Event::Id eventId){
+        auto it = find(eventId);
+        if ( it != m_entries.end() )
+            return it->second;
+        m_entries.push_back(std::make_pair(eventId, nullptr));
+        return m_entries.back().second;
+    }
+
+    Iterator erase(Iterator it){ return m_entries.erase(it); }
+
+    bool empty() const{ return m_entries.empty(); }
+    size_t size() const{ return m_entries.size(); }
+
+private:
+    std::vector<Entry> m_entries;
+};
+
 }} // namespace lv, el
 
 #endif // LVEVENT_H
@@ -0,0 +1,298 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "incrementaltranspiler.h"
+#include "languagenodes_p.h"
+#include "elementssections_p.h"
+#include "engine.h"
+
+#include <algorithm>
+
+namespace lv{ namespace el{
+
+/**
+ * \class lv::el::IncrementalTranspiler
+ * \brief Converts successive versions of the same module to javascript, reusing the work done on previous versions
+ *
+ * The transpiler keeps the syntax tree and the converted top level components of the last version it was given.
+ * On each new version, the tree is edited and reparsed incrementally, and only the component declarations whose
+ * source changed are visited and converted again. Unchanged components are visited without their body, and their
+ * output is spliced in from the previous run.
+ *
+ * \code
+ * IncrementalTranspiler transpiler(LanguageParser::createForElements(), "main");
+ * std::string js = transpiler.toJs(source);
+ * // after the user edits a component
+ * js = transpiler.toJs(editedSource);
+ * \endcode
+ *
+ * The output is the same as the one of LanguageParser::toJs(). All components are converted again when the
+ * identifiers declared at program level change (e.g. a component is added, removed or renamed), since the
+ * converted components depend on them.
+ */
+
+/// \private
+class IncrementalTranspilerPrivate{
+
+public:
+    IncrementalTranspilerPrivate(const LanguageParser::Ptr& p, const std::string& fn)
+        : parser(p)
+        , filename(fn)
+        , ast(nullptr)
+        , lastConvertedComponents(0)
+        , lastVisitedComponents(0)
+        , lastTotalComponents(0)
+    {}
+
+    static const char* readSource(void* payload, uint32_t byteIndex, TSPoint, uint32_t* bytesRead);
+    static TSPoint pointAt(const std::string& source, size_t offset);
+
+    LanguageParser::Ptr         parser;
+    std::string                 filename;
+    std::string                 source;
+    std::string                 js;
+    LanguageParser::AST*        ast;
+    std::string                 declarationsKey;
+    ProgramNode::ComponentCache components;
+    size_t                      lastConvertedComponents;
+    size_t                      lastVisitedComponents;
+    size_t                      lastTotalComponents;
+};
+
+const char *IncrementalTranspilerPrivate::readSource(void *payload, uint32_t byteIndex, TSPoint, uint32_t *bytesRead){
+    const std::string* source = reinterpret_cast<const std::string*>(payload);
+    if ( byteIndex >= source->size() ){
+        *bytesRead = 0;
+        return "";
+    }
+    *bytesRead = static_cast<uint32_t>(source->size() - byteIndex);
+    return source->c_str() + byteIndex;
+}
+
+TSPoint IncrementalTranspilerPrivate::pointAt(const std::string &source, size_t offset){
+    TSPoint point;
+    point.row = 0;
+    size_t lineStart = 0;
+    for ( size_t i = 0; i < offset; ++i ){
+        if ( source[i] == '\n' ){
+            ++point.row;
+            lineStart = i + 1;
+        }
+    }
+    point.column = static_cast<uint32_t>(offset - lineStart);
+    return point;
+}
+
+/**
+ * \brief Constructor
+ *
+ * The \p filename is used as the export name for the default component, as in LanguageParser::toJs().
+ */
+IncrementalTranspiler::IncrementalTranspiler(const LanguageParser::Ptr &parser, const std::string &filename)
+    : m_d(new IncrementalTranspilerPrivate(parser, filename))
+{
+}
+
+/**
+ * \brief Destructor
+ */
+IncrementalTranspiler::~IncrementalTranspiler(){
+    m_d->parser->destroy(m_d->ast);
+    delete m_d;
+}
+
+/**
+ * \brief Converts \p source to javascript
+ *
+ * The edit from the previous source is computed from the common prefix and suffix of the two versions. Use the
+ * overload taking a TSInputEdit if the edit is already known.
+ */
+std::string IncrementalTranspiler::toJs(const std::string &source){
+    if ( m_d->ast && !m_d->js.empty() && source == m_d->source )
+        return m_d->js;
+
+    return toJs(source, createEdit(m_d->source, source));
+}
+
+/**
+ * \brief Converts \p source to javascript, given the \p edit that was applied to the previous source
+ */
+std::string IncrementalTranspiler::toJs(const std::string &source, const TSInputEdit &edit){
+    m_d->source = source;
+
+    TSInput input;
+    input.payload  = &m_d->source;
+    input.read     = &IncrementalTranspilerPrivate::readSource;
+    input.encoding = TSInputEncodingUTF8;
+
+    TSInputEdit treeEdit = edit;
+    LanguageParser::AST* previousAst = m_d->ast;
+    m_d->parser->editParseTree(m_d->ast, treeEdit, input);
+    m_d->parser->destroy(previousAst);
+
+    TSNode rootNode = ts_tree_root_node(reinterpret_cast<TSTree*>(m_d->ast));
+    ProgramNode* program = new ProgramNode(rootNode);
+    std::string declarationsKey;
+    bool canReuseComponents = false;
+
+    try {
+        // components found in the cache are visited without their body, which is only valid as long as
+        // the program declarations don't change, otherwise the tree is visited again in full
+        program->setReusableComponents(&m_d->source, &m_d->components);
+        BaseNode::visit(program);
+
+        declarationsKey = program->declarationsKey(m_d->source);
+        canReuseComponents = (declarationsKey == m_d->declarationsKey);
+
+        if ( !canReuseComponents && program->totalSkippedComponents() > 0 ){
+            delete program;
+            program = new ProgramNode(rootNode);
+            BaseNode::visit(program);
+        }
+    } catch (SyntaxException exc){
+        delete program;
+        m_d->js.clear();
+        m_d->components.clear();
+        m_d->declarationsKey.clear();
+        if (m_d->parser->engine())
+            m_d->parser->engine()->throwError(&exc, nullptr);
+        return "";
+    }
+
+    BaseNode* root = program;
+    if ( !m_d->filename.empty() )
+        program->setFilename(m_d->filename);
+
+    ProgramNode::ComponentCache components;
+    program->setComponentCache(canReuseComponents ? &m_d->components : nullptr, &components);
+
+    el::JSSection* section = new el::JSSection;
+    section->from = 0;
+    section->to   = static_cast<int>(m_d->source.size());
+
+    root->convertToJs(m_d->source, section->m_children);
+
+    std::vector<std::string> flatten;
+    section->flatten(m_d->source, flatten);
+
+    m_d->js.clear();
+    for ( const std::string& s : flatten ){
+        m_d->js += s;
+    }
+
+    m_d->lastConvertedComponents = program->totalConvertedComponents();
+    m_d->lastVisitedComponents   = program->totalComponents() - program->totalSkippedComponents();
+    m_d->lastTotalComponents     = program->totalComponents();
+    m_d->components.swap(components);
+    m_d->declarationsKey = declarationsKey;
+
+    delete section;
+    delete root;
+
+    return m_d->js;
+}
+
+/**
+ * \brief Discards the tree and the converted components, so the next conversion starts from scratch
+ */
+void IncrementalTranspiler::reset(){
+    m_d->parser->destroy(m_d->ast);
+    m_d->ast = nullptr;
+    m_d->source.clear();
+    m_d->js.clear();
+    m_d->components.clear();
+    m_d->declarationsKey.clear();
+    m_d->lastConvertedComponents = 0;
+    m_d->lastVisitedComponents = 0;
+    m_d->lastTotalComponents = 0;
+}
+
+/**
+ * \brief Returns the last converted source
+ */
+const std::string &IncrementalTranspiler::source() const{
+    return m_d->source;
+}
+
+/**
+ * \brief Returns the filename given in the constructor
+ */
+const std::string &IncrementalTranspiler::filename() const{
+    return m_d->filename;
+}
+
+/**
+ * \brief Returns the tree of the last converted source, owned by this transpiler
+ */
+LanguageParser::AST *IncrementalTranspiler::ast() const{
+    return m_d->ast;
+}
+
+/**
+ * \brief Returns the number of components that were converted during the last call to toJs()
+ */
+size_t IncrementalTranspiler::lastConvertedComponents() const{
+    return m_d->lastConvertedComponents;
+}
+
+/**
+ * \brief Returns the number of components whose body was visited during the last call to toJs()
+ *
+ * Components reused from the previous version are visited without their body.
+ */
+size_t IncrementalTranspiler::lastVisitedComponents() const{
+    return m_d->lastVisitedComponents;
+}
+
+/**
+ * \brief Returns the number of top level components found during the last call to toJs()
+ */
+size_t IncrementalTranspiler::lastTotalComponents() const{
+    return m_d->lastTotalComponents;
+}
+
+/**
+ * \brief Creates the edit that turns \p oldSource into \p newSource
+ *
+ * The edited range spans from the first to the last byte that differs between the two sources.
+ */
+TSInputEdit IncrementalTranspiler::createEdit(const std::string &oldSource, const std::string &newSource){
+    size_t maxCommon = std::min(oldSource.size(), newSource.size());
+
+    size_t prefix = 0;
+    while ( prefix < maxCommon && oldSource[prefix] == newSource[prefix] )
+        ++prefix;
+    // keep the edit on a utf8 character boundary
+    while ( prefix > 0 && prefix < newSource.size() && (static_cast<unsigned char>(newSource[prefix]) & 0xC0) == 0x80 )
+        --prefix;
+
+    size_t suffix = 0;
+    while ( suffix < maxCommon - prefix &&
+            oldSource[oldSource.size() - 1 - suffix] == newSource[newSource.size() - 1 - suffix] )
+        ++suffix;
+
+    TSInputEdit edit;
+    edit.start_byte    = static_cast<uint32_t>(prefix);
+    edit.old_end_byte  = static_cast<uint32_t>(oldSource.size() - suffix);
+    edit.new_end_byte  = static_cast<uint32_t>(newSource.size() - suffix);
+    edit.start_point   = IncrementalTranspilerPrivate::pointAt(newSource, prefix);
+    edit.old_end_point = IncrementalTranspilerPrivate::pointAt(oldSource, edit.old_end_byte);
+    edit.new_end_point = IncrementalTranspilerPrivate::pointAt(newSource, edit.new_end_byte);
+    return edit;
+}
+
+}} // namespace lv, el
@@ -0,0 +1,58 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVINCREMENTALTRANSPILER_H
+#define LVINCREMENTALTRANSPILER_H
+
+#include "live/elements/lvelementsglobal.h"
+#include "live/elements/languageparser.h"
+
+#include <string>
+
+namespace lv{ namespace el{
+
+class IncrementalTranspilerPrivate;
+
+class LV_ELEMENTS_EXPORT IncrementalTranspiler{
+
+    DISABLE_COPY(IncrementalTranspiler);
+
+public:
+    IncrementalTranspiler(const LanguageParser::Ptr& parser, const std::string& filename = "");
+    ~IncrementalTranspiler();
+
+    std::string toJs(const std::string& source);
+    std::string toJs(const std::string& source, const TSInputEdit& edit);
+    void reset();
+
+    const std::string& source() const;
+    const std::string& filename() const;
+    LanguageParser::AST* ast() const;
+
+    size_t lastConvertedComponents() const;
+    size_t lastVisitedComponents() const;
+    size_t lastTotalComponents() const;
+
+    static TSInputEdit createEdit(const std::string& oldSource, const std::string& newSource);
+
+private:
+    IncrementalTranspilerPrivate* m_d;
+};
+
+}} // namespace lv, el
+
+#endif // LVINCREMENTALTRANSPILER_H
@@ -63,8 +63,8 @@ void EnumInfo::fromMLNode(const MLNode &node)
 
 TypeReference::TypeReference(uint32_t language, const Utf8 &name, const Utf8 &path)
     : m_language(language)
-    , m_name(name)
-    , m_path(path)
+    , m_name(name.intern())
+    , m_path(path.intern())
 {
 }
 
@@ -283,8 +283,8 @@ void PropertyInfo::fromMLNode(const MLNode &node)
 // ------------------------------------------------------------
 
 TypeInfo::TypeInfo(Utf8 name, Utf8 inheritsName, bool isCreatable, bool isInstance)
-    : m_typeName(name)
-    , m_inherits(inheritsName)
+    : m_typeName(name.intern())
+    , m_inherits(inheritsName.intern())
     , m_constructor("")
     , m_isCreatable(isCreatable)
     , m_isInstance(isInstance)
@@ -757,9 +757,11 @@ void ModuleInfo::fromMLNode(const MLNode &node)
 
 ImportInfo::ImportInfo(const std::vector<Utf8> &segments, const Utf8 &importAs, bool isRelative)
     : m_isRelative(isRelative)
-    , m_segments(segments)
     , m_importAs(importAs)
 {
+    m_segments.reserve(segments.size());
+    for ( auto it = segments.begin(); it != segments.end(); ++it )
+        m_segments.push_back(it->intern());
 }
 
 bool ImportInfo::isRelative() const{
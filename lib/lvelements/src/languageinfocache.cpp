@@ -0,0 +1,202 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "languageinfocache.h"
+#include "live/mlnodetobinary.h"
+#include "live/exception.h"
+#include "live/visuallog.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QCryptographicHash>
+
+#include <stdexcept>
+
+namespace lv{ namespace el{
+
+/**
+ * \class lv::el::LanguageInfoCache
+ * \brief Persistent cache of the DocumentInfo extracted from each file of a package
+ *
+ * Entries are keyed by file path, and store a key created with createKey() from the file source and the
+ * ParsedDocument::InfoVersion. A lookup only succeeds if the key matches, so changed files or a different grammar or
+ * extraction simply miss the cache and get scanned again.
+ *
+ * The cache is stored in binary format (see ml::toBinary) in a single file, usually named fileName and placed next
+ * to the package file. Cache files that are missing, corrupt or written with a different FormatVersion are ignored.
+ *
+ * \ingroup lvelements
+ */
+
+const char* LanguageInfoCache::fileName = "live.types.cache";
+
+/**
+ * \brief Creates an empty cache that is loaded from and saved to \p cacheFilePath
+ */
+LanguageInfoCache::LanguageInfoCache(const std::string &cacheFilePath)
+    : m_cacheFilePath(cacheFilePath)
+    , m_isModified(false)
+{
+}
+
+/**
+ * \brief Destructor
+ */
+LanguageInfoCache::~LanguageInfoCache(){
+}
+
+/**
+ * \brief Returns the document info cached for \p filePath, or null if missing or stored under a different \p key
+ *
+ * Lookups don't modify the cache, so they can run on multiple threads at the same time.
+ */
+DocumentInfo::Ptr LanguageInfoCache::lookup(const std::string &filePath, const std::string &key) const{
+    auto it = m_entries.find(filePath);
+    if ( it == m_entries.end() || it->second.key != key )
+        return DocumentInfo::Ptr(nullptr);
+
+    try{
+        DocumentInfo::Ptr info = DocumentInfo::create();
+        info->fromMLNode(it->second.info);
+        return info;
+    } catch ( lv::Exception& ){
+    } catch ( std::out_of_range& ){
+    }
+    return DocumentInfo::Ptr(nullptr);
+}
+
+/**
+ * \brief Stores the \p info extracted from \p filePath under \p key, replacing any previous entry
+ */
+void LanguageInfoCache::store(const std::string &filePath, const std::string &key, const DocumentInfo::Ptr &info){
+    Entry& entry = m_entries[filePath];
+    entry.key  = key;
+    entry.info = info->toMLNode();
+    m_isModified = true;
+}
+
+/**
+ * \brief Removes the entry for \p filePath
+ */
+void LanguageInfoCache::remove(const std::string &filePath){
+    if ( m_entries.erase(filePath) )
+        m_isModified = true;
+}
+
+/**
+ * \brief Removes all entries
+ */
+void LanguageInfoCache::clear(){
+    if ( !m_entries.empty() )
+        m_isModified = true;
+    m_entries.clear();
+}
+
+/**
+ * \brief Loads entries from the cache file, replacing the current ones
+ *
+ * Returns false and leaves the cache empty if the file cannot be used.
+ */
+bool LanguageInfoCache::load(){
+    m_entries.clear();
+    m_isModified = false;
+
+    QFile file(QString::fromStdString(m_cacheFilePath));
+    if ( !file.open(QIODevice::ReadOnly) )
+        return false;
+
+    QByteArray content = file.readAll();
+    if ( !ml::isBinary(content.constData(), static_cast<size_t>(content.size())) ){
+        vlog("lvelements-languageinfocache").w() << "Ignoring corrupt language info cache: " << m_cacheFilePath;
+        return false;
+    }
+
+    try{
+        MLNode root;
+        ml::fromBinary(content.constData(), static_cast<size_t>(content.size()), root);
+
+        if ( root.type() != MLNode::Object || !root.hasKey("version") || root["version"].asInt() != FormatVersion )
+            return false;
+
+        const MLNode::ObjectType& entries = root["entries"].asObject();
+        for ( auto it = entries.begin(); it != entries.end(); ++it ){
+            Entry entry;
+            entry.key  = it->second["key"].asString();
+            entry.info = it->second["info"];
+            m_entries[it->first] = entry;
+        }
+    } catch ( lv::Exception& e ){
+        vlog("lvelements-languageinfocache").w() << "Ignoring language info cache \'" << m_cacheFilePath << "\': " << e.message();
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Writes all entries to the cache file
+ *
+ * The file is written atomically. Returns false if it could not be written, e.g. for packages in read-only
+ * locations.
+ */
+bool LanguageInfoCache::save(){
+    MLNode entries(MLNode::Object);
+    for ( auto it = m_entries.begin(); it != m_entries.end(); ++it ){
+        entries[it->first] = {
+            {"key", it->second.key},
+            {"info", it->second.info}
+        };
+    }
+
+    MLNode root = {
+        {"version", FormatVersion},
+        {"entries", entries}
+    };
+
+    std::string serialized;
+    ml::toBinary(root, serialized);
+
+    QSaveFile file(QString::fromStdString(m_cacheFilePath));
+    if ( !file.open(QIODevice::WriteOnly) )
+        return false;
+
+    file.write(serialized.data(), static_cast<qint64>(serialized.size()));
+    if ( !file.commit() )
+        return false;
+
+    m_isModified = false;
+    return true;
+}
+
+/**
+ * \brief Creates the key for a file with the given \p source
+ *
+ * The \p infoVersion is part of the key, since the extracted info depends on the grammar and on the extraction
+ * itself (see ParsedDocument::InfoVersion).
+ */
+std::string LanguageInfoCache::createKey(const std::string &source, const std::string &infoVersion){
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    std::string header = std::to_string(FormatVersion) + ":" + infoVersion + ":";
+    hash.addData(header.data(), static_cast<int>(header.size()));
+    hash.addData(source.data(), static_cast<int>(source.size()));
+
+    return hash.result().toHex().toStdString();
+}
+
+}} // namespace lv, el
@@ -0,0 +1,98 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVLANGUAGEINFOCACHE_H
+#define LVLANGUAGEINFOCACHE_H
+
+#include "live/elements/lvelementsglobal.h"
+#include "live/elements/languageinfo.h"
+#include "live/mlnode.h"
+
+#include <memory>
+#include <string>
+#include <map>
+
+namespace lv{ namespace el{
+
+class LV_ELEMENTS_EXPORT LanguageInfoCache{
+
+    DISABLE_COPY(LanguageInfoCache);
+
+public:
+    /** Shared pointer to this class */
+    typedef std::shared_ptr<LanguageInfoCache> Ptr;
+
+    /** Version of the cache file format, bumped whenever the extracted document info changes */
+    static const int FormatVersion = 1;
+    /** Name of the cache file stored within each package */
+    static const char* fileName;
+
+public:
+    explicit LanguageInfoCache(const std::string& cacheFilePath);
+    ~LanguageInfoCache();
+
+    DocumentInfo::Ptr lookup(const std::string& filePath, const std::string& key) const;
+    void store(const std::string& filePath, const std::string& key, const DocumentInfo::Ptr& info);
+    void remove(const std::string& filePath);
+    void clear();
+
+    bool load();
+    bool save();
+
+    const std::string& cacheFilePath() const;
+    size_t size() const;
+    bool isModified() const;
+
+    static std::string createKey(const std::string& source, const std::string& infoVersion);
+
+private:
+    /// \private
+    class Entry{
+    public:
+        std::string key;
+        MLNode      info;
+    };
+
+    std::string                  m_cacheFilePath;
+    std::map<std::string, Entry> m_entries;
+    bool                         m_isModified;
+};
+
+/**
+ * \brief Returns the path of the file this cache is loaded from and saved to
+ */
+inline const std::string &LanguageInfoCache::cacheFilePath() const{
+    return m_cacheFilePath;
+}
+
+/**
+ * \brief Returns the number of cached documents
+ */
+inline size_t LanguageInfoCache::size() const{
+    return m_entries.size();
+}
+
+/**
+ * \brief Checks wether the cache has changed since it was loaded or saved
+ */
+inline bool LanguageInfoCache::isModified() const{
+    return m_isModified;
+}
+
+}} // namespace lv, el
+
+#endif // LVLANGUAGEINFOCACHE_H
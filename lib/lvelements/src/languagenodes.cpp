@@ -32,15 +32,23 @@ BaseNode *BaseNode::visit(LanguageParser::AST *ast){
     TSNode root_node = ts_tree_root_node(tree);
 
     ProgramNode* node = new ProgramNode(root_node);
+    visit(node);
+    return node;
+}
 
-    uint32_t count = ts_node_child_count(root_node);
+/**
+ * \brief Visits the children of the \p program root node
+ *
+ * Top level components set as reusable through ProgramNode::setReusableComponents() are visited without their
+ * body.
+ */
+void BaseNode::visit(ProgramNode *program){
+    uint32_t count = ts_node_child_count(program->current());
 
     for ( uint32_t i = 0; i < count; ++i ){
-        TSNode child = ts_node_child(root_node, i);
-        visit(node, child);
+        TSNode child = ts_node_child(program->current(), i);
+        visit(program, child);
     }
-
-    return node;
 }
 
 void BaseNode::checkIdentifierDeclared(const std::string& source, BaseNode *node, std::string id)
@@ -264,6 +272,9 @@ void BaseNode::visitImportPath(BaseNode *parent, const TSNode &node){
 }
 
 void BaseNode::visitComponentDeclaration(BaseNode *parent, const TSNode &node){
+    // the body of a reused component is never converted, so only its declarations are needed
+    bool isReused = parent->typeString() == "Program" && parent->as<ProgramNode>()->isReusableComponent(node);
+
     ComponentDeclarationNode* enode = new ComponentDeclarationNode(node);
     parent->insert(enode);
     if (parent->typeString() == "PropertyDeclaration")
@@ -290,7 +301,8 @@ void BaseNode::visitComponentDeclaration(BaseNode *parent, const TSNode &node){
         } else if ( strcmp(ts_node_type(child), "component_body") == 0 ){
             enode->m_body = new ComponentBodyNode(child);
             enode->m_body->setParent(enode);
-            visitChildren(enode->m_body, child);
+            if ( !isReused )
+                visitChildren(enode->m_body, child);
         } else if ( strcmp(ts_node_type(child), "component_identifier") == 0 ){
             if ( ts_node_named_child_count(child) > 0 ){
                 TSNode idChild = ts_node_child(child, 1);
@@ -959,8 +971,47 @@ void ProgramNode::convertToJs(const std::string &source, std::vector<ElementsIns
 
     size_t offset = fragments.size();
 
-    for ( BaseNode* child: m_exports )
+    for ( ComponentDeclarationNode* child: m_exports ){
+        if ( !m_components ){
+            child->convertToJs(source, fragments, indentValue);
+            ++m_totalConverted;
+            continue;
+        }
+
+        std::string componentSource = slice(source, child);
+        auto previousIt = m_previousComponents ? m_previousComponents->find(componentSource) : ComponentCache::const_iterator();
+        if ( m_previousComponents && previousIt != m_previousComponents->end() ){
+            ElementsInsertion* reused = new ElementsInsertion;
+            reused->from = child->startByte();
+            reused->to   = child->endByte();
+            *reused << previousIt->second.js;
+            fragments.push_back(reused);
+
+            m_undeclared.insert(previousIt->second.undeclared.begin(), previousIt->second.undeclared.end());
+            (*m_components)[componentSource] = previousIt->second;
+            continue;
+        }
+
+        // convert with an empty set, so the identifiers this component leaves undeclared can be captured
+        std::set<std::string> undeclared;
+        undeclared.swap(m_undeclared);
+
+        size_t componentOffset = fragments.size();
         child->convertToJs(source, fragments, indentValue);
+        ++m_totalConverted;
+
+        std::vector<std::string> flat;
+        for ( size_t i = componentOffset; i < fragments.size(); ++i )
+            fragments[i]->flatten(source, flat);
+
+        ConvertedComponent& converted = (*m_components)[componentSource];
+        converted.js.clear();
+        for ( const std::string& s : flat )
+            converted.js += s;
+        converted.undeclared = m_undeclared;
+
+        m_undeclared.insert(undeclared.begin(), undeclared.end());
+    }
 
     BaseNode::convertToJs(source, fragments, indentValue);
 
@@ -1005,6 +1056,59 @@ void ProgramNode::convertToJs(const std::string &source, std::vector<ElementsIns
 
 }
 
+/**
+ * \brief Reuses the converted components from \p previous, and stores all converted components in \p current
+ *
+ * Components are matched by their source, so only components that changed since \p previous was populated are
+ * converted again. The converted output of a component also depends on the declarations in the program scope,
+ * so \p previous should only be given if declarationsKey() hasn't changed.
+ */
+void ProgramNode::setComponentCache(const ComponentCache *previous, ComponentCache *current){
+    m_previousComponents = previous;
+    m_components = current;
+}
+
+/**
+ * \brief Sets the components that can be visited without their body
+ *
+ * A top level component whose \p source slice is found in \p components is expected to be reused from the cache
+ * given to setComponentCache(), so its body is skipped when visiting the tree. Must be set before visiting.
+ */
+void ProgramNode::setReusableComponents(const std::string *source, const ComponentCache *components){
+    m_reusableSource = source;
+    m_reusableComponents = components;
+    m_totalSkipped = 0;
+}
+
+/**
+ * \brief Checks whether the top level component \p node can be visited without its body
+ *
+ * Each reusable component that's found is counted in totalSkippedComponents().
+ */
+bool ProgramNode::isReusableComponent(const TSNode &node){
+    if ( !m_reusableComponents || m_reusableComponents->empty() )
+        return false;
+
+    std::string componentSource = slice(*m_reusableSource, ts_node_start_byte(node), ts_node_end_byte(node));
+    if ( m_reusableComponents->find(componentSource) == m_reusableComponents->end() )
+        return false;
+
+    ++m_totalSkipped;
+    return true;
+}
+
+/**
+ * \brief Returns a key that changes whenever the identifiers declared in the program scope change
+ */
+std::string ProgramNode::declarationsKey(const std::string &source) const{
+    std::string result;
+    for ( IdentifierNode* declaration : identifiers() ){
+        result += slice(source, declaration);
+        result += ",";
+    }
+    return result;
+}
+
 ComponentDeclarationNode::ComponentDeclarationNode(const TSNode &node)
     : JsBlockNode(node, "ComponentDeclaration")
     , m_name(nullptr)
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <set>
+#include <map>
 
 #include "live/utf8.h"
 
@@ -33,6 +34,7 @@ class MemberExpressionNode;
 class SubscriptExpressionNode;
 class StatementBlockNode;
 class ArgumentsNode;
+class ProgramNode;
 
 class BaseNode{
     friend class JsBlockNode;
@@ -45,6 +47,7 @@ public:
     virtual std::string toString(int indent = 0) const;
 
     static BaseNode* visit(LanguageParser::AST* ast);
+    static void visit(ProgramNode* program);
     static void checkIdentifierDeclared(const std::string& source, BaseNode* node, std::string id);
     const std::string& typeString() const{ return m_typeString; }
 
@@ -150,10 +153,36 @@ private:
 class ProgramNode : public JsBlockNode {
     friend class BaseNode;
 public:
-    ProgramNode(const TSNode& node) : JsBlockNode(node, "Program") {}
+    /** Converted javascript of a top level component, with the identifiers it left undeclared */
+    class ConvertedComponent{
+    public:
+        std::string           js;
+        std::set<std::string> undeclared;
+    };
+    /** Converted components, keyed by their source */
+    typedef std::map<std::string, ConvertedComponent> ComponentCache;
+
+public:
+    ProgramNode(const TSNode& node)
+        : JsBlockNode(node, "Program")
+        , m_previousComponents(nullptr)
+        , m_components(nullptr)
+        , m_totalConverted(0)
+        , m_reusableSource(nullptr)
+        , m_reusableComponents(nullptr)
+        , m_totalSkipped(0)
+    {}
     std::set<std::string>& undeclared() { return m_undeclared; }
     void setFilename(std::string fn){ m_fileName = fn; }
     std::string filename() const { return m_fileName; }
+
+    void setComponentCache(const ComponentCache* previous, ComponentCache* current);
+    size_t totalConvertedComponents() const{ return m_totalConverted; }
+    size_t totalComponents() const{ return m_exports.size(); }
+    void setReusableComponents(const std::string* source, const ComponentCache* components);
+    bool isReusableComponent(const TSNode& node);
+    size_t totalSkippedComponents() const{ return m_totalSkipped; }
+    std::string declarationsKey(const std::string& source) const;
 protected:
     virtual void insert(BaseNode *child);
     virtual std::string toString(int indent = 0) const;
@@ -167,6 +196,14 @@ private:
 
     std::vector<NewComponentExpressionNode*> m_idComponents;
 
+    const ComponentCache* m_previousComponents;
+    ComponentCache*       m_components;
+    size_t                m_totalConverted;
+
+    const std::string*    m_reusableSource;
+    const ComponentCache* m_reusableComponents;
+    size_t                m_totalSkipped;
+
 };
 
 class IdentifierNode : public BaseNode{
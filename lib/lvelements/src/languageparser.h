@@ -40,6 +40,9 @@ public:
     typedef std::shared_ptr<LanguageParser>       Ptr;
     typedef std::shared_ptr<const LanguageParser> ConstPtr;
 
+    /** Version of the javascript generated by toJs(), bumped whenever the generated code changes */
+    static const int TranspilerVersion = 1;
+
 public:
     typedef void* AST;
     typedef const void Language;
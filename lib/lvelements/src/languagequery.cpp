@@ -2,6 +2,8 @@
 #include "live/visuallog.h"
 #include "tree_sitter/api.h"
 
+#include <algorithm>
+
 namespace lv{ namespace el{
 
 // LanguageQueryException
@@ -131,56 +133,125 @@ LanguageQuery::Cursor::Ptr LanguageQuery::exec(LanguageParser::AST *ast, uint32_
 }
 
 bool LanguageQuery::predicateMatch(const Cursor::Ptr &cursor, void *payload){
-    TSQuery* query = reinterpret_cast<TSQuery*>(m_query);
-    uint32_t length;
-    const TSQueryPredicateStep* step = ts_query_predicates_for_pattern(query, cursor->matchPatternIndex(), &length);
-    if ( length == 0 )
+    uint16_t patternIndex = cursor->matchPatternIndex();
+    if ( patternIndex >= m_patternPredicates.size() )
         return true;
 
-    std::string functionToCall;
-    uint32_t strLen = 0;
-
-    std::vector<LanguageQuery::PredicateData> args;
-
-    for( uint32_t i = 0; i < length; ++i ){
-        if ( functionToCall.empty() ){
-            functionToCall = ts_query_string_value_for_id(query, step[i].value_id, &strLen);
-        } else if ( step[i].type == TSQueryPredicateStepTypeString ){
-            LanguageQuery::PredicateData pd;
-            pd.m_value = ts_query_string_value_for_id(query, step[i].value_id, &strLen);
-            args.push_back(pd);
-        } else if ( step[i].type == TSQueryPredicateStepTypeCapture ){
-            uint16_t captures = cursor->totalMatchCaptures();
-            for ( uint16_t captureIndex = 0; captureIndex < captures; ++captureIndex ){
-                uint32_t captureId = cursor->captureId(captureIndex);
-                if ( captureId == step[i].value_id ){
-                    LanguageQuery::PredicateData pd;
-                    pd.m_range = cursor->captureRange(captureIndex);
-                    args.push_back(pd);
-                    break;
-                }
-            }
-        } else if ( step[i].type == TSQueryPredicateStepTypeDone ){
-            auto it = m_predicates.find(functionToCall);
-            if ( it == m_predicates.end() ){
-                THROW_EXCEPTION(Exception, "LanguageQuery: Failed to find function \'" + functionToCall + "\'", Exception::toCode("~Function"));
+    std::vector<CompiledPredicate>& predicates = m_patternPredicates[patternIndex];
+    if ( predicates.empty() )
+        return true;
+
+    // index the captures of this match by their id
+    if ( ++m_generation == 0 ){
+        std::fill(m_captureGeneration.begin(), m_captureGeneration.end(), 0);
+        m_generation = 1;
+    }
+
+    TSQueryMatch* match = reinterpret_cast<TSQueryMatch*>(cursor->m_currentMatch);
+    for ( uint16_t i = 0; i < match->capture_count; ++i ){
+        uint32_t captureId = match->captures[i].index;
+        m_captureGeneration[captureId] = m_generation;
+        m_captureIndex[captureId] = i;
+    }
+
+    for ( auto it = predicates.begin(); it != predicates.end(); ++it ){
+        CompiledPredicate& predicate = *it;
+        if ( predicate.callback >= m_predicateCallbacks.size() ){
+            THROW_EXCEPTION(
+                Exception, "LanguageQuery: Predicate without a function name", Exception::toCode("~Function")
+            );
+        }
+
+        const PredicateCallback& callback = m_predicateCallbacks[predicate.callback];
+        if ( !callback ){
+            THROW_EXCEPTION(
+                Exception,
+                "LanguageQuery: Failed to find function \'" + m_predicateNames[predicate.callback] + "\'",
+                Exception::toCode("~Function")
+            );
+        }
+
+        for ( auto argIt = predicate.captureArgs.begin(); argIt != predicate.captureArgs.end(); ++argIt ){
+            PredicateData& pd = predicate.args[argIt->first];
+            if ( m_captureGeneration[argIt->second] == m_generation ){
+                TSNode node = match->captures[m_captureIndex[argIt->second]].node;
+                TSPoint start = ts_node_start_point(node);
+                pd.m_range  = SourceRange(ts_node_start_byte(node), ts_node_end_byte(node) - ts_node_start_byte(node));
+                pd.m_row    = start.row;
+                pd.m_column = start.column;
+            } else {
+                pd.m_range = SourceRange();
             }
-            if ( !it->second(args, payload) )
-                return false;
-            functionToCall = "";
         }
+
+        if ( !callback(predicate.args, payload) )
+            return false;
     }
 
     return true;
 }
 
-void LanguageQuery::addPredicate(const std::string &name, std::function<bool (const std::vector<LanguageQuery::PredicateData> &, void *)> callback){
-    m_predicates[name] = callback;
+void LanguageQuery::addPredicate(const std::string &name, PredicateCallback callback){
+    m_predicateCallbacks[predicateSlot(name)] = callback;
 }
 
 LanguageQuery::LanguageQuery(void *query)
-    : m_query(query)
+    : m_generation(0)
+    , m_query(query)
 {
+    TSQuery* tsQuery = reinterpret_cast<TSQuery*>(m_query);
+    m_captureGeneration.resize(ts_query_capture_count(tsQuery), 0);
+    m_captureIndex.resize(ts_query_capture_count(tsQuery), 0);
+
+    compilePredicates();
+}
+
+void LanguageQuery::compilePredicates(){
+    TSQuery* query = reinterpret_cast<TSQuery*>(m_query);
+
+    uint32_t totalPatterns = ts_query_pattern_count(query);
+    m_patternPredicates.resize(totalPatterns);
+
+    for ( uint32_t patternIndex = 0; patternIndex < totalPatterns; ++patternIndex ){
+        uint32_t length = 0;
+        const TSQueryPredicateStep* step = ts_query_predicates_for_pattern(query, patternIndex, &length);
+
+        CompiledPredicate predicate;
+        bool hasFunction = false;
+        uint32_t strLen = 0;
+
+        for ( uint32_t i = 0; i < length; ++i ){
+            if ( step[i].type == TSQueryPredicateStepTypeDone ){
+                m_patternPredicates[patternIndex].push_back(predicate);
+                predicate = CompiledPredicate();
+                hasFunction = false;
+            } else if ( !hasFunction ){
+                const char* name = ts_query_string_value_for_id(query, step[i].value_id, &strLen);
+                predicate.callback = predicateSlot(std::string(name, strLen));
+                hasFunction = true;
+            } else if ( step[i].type == TSQueryPredicateStepTypeString ){
+                LanguageQuery::PredicateData pd;
+                const char* value = ts_query_string_value_for_id(query, step[i].value_id, &strLen);
+                pd.m_value = std::string(value, strLen);
+                predicate.args.push_back(pd);
+            } else if ( step[i].type == TSQueryPredicateStepTypeCapture ){
+                predicate.captureArgs.push_back(std::make_pair(predicate.args.size(), step[i].value_id));
+                predicate.args.push_back(LanguageQuery::PredicateData());
+            }
+        }
+    }
+}
+
+size_t LanguageQuery::predicateSlot(const std::string &name){
+    auto it = m_predicateSlots.find(name);
+    if ( it != m_predicateSlots.end() )
+        return it->second;
+
+    size_t slot = m_predicateCallbacks.size();
+    m_predicateSlots[name] = slot;
+    m_predicateNames.push_back(name);
+    m_predicateCallbacks.push_back(PredicateCallback());
+    return slot;
 }
 
 }}// namespace lv, el
@@ -6,8 +6,10 @@
 
 #include "live/exception.h"
 
+#include <cstdint>
 #include <memory>
 #include <map>
+#include <vector>
 #include <functional>
 
 namespace lv{ namespace el{
@@ -53,10 +55,16 @@ public:
 
     class LV_ELEMENTS_EXPORT PredicateData{
     public:
+        PredicateData() : m_row(0), m_column(0){}
+
         SourceRange m_range;
+        uint32_t    m_row;
+        uint32_t    m_column;
         Utf8        m_value;
     };
 
+    typedef std::function<bool(const std::vector<PredicateData>&, void* payload)> PredicateCallback;
+
     typedef std::shared_ptr<LanguageQuery>       Ptr;
     typedef std::shared_ptr<const LanguageQuery> ConstPtr;
 
@@ -72,13 +80,33 @@ public:
 
     bool predicateMatch(const Cursor::Ptr& cursor, void* payload = nullptr);
 
-    void addPredicate(const std::string& name, std::function<bool(const std::vector<PredicateData>&, void* payload)> callback);
+    void addPredicate(const std::string& name, PredicateCallback callback);
 
 private:
+    /// \private
+    class CompiledPredicate{
+    public:
+        CompiledPredicate() : callback(SIZE_MAX){}
+
+        size_t                                    callback;
+        std::vector<PredicateData>                args;
+        std::vector<std::pair<size_t, uint32_t> > captureArgs;
+    };
+
     DISABLE_COPY(LanguageQuery);
     LanguageQuery(void* query);
 
-    std::map<std::string, std::function<bool(const std::vector<PredicateData>&, void* payload)> > m_predicates;
+    void compilePredicates();
+    size_t predicateSlot(const std::string& name);
+
+    std::map<std::string, size_t>                m_predicateSlots;
+    std::vector<std::string>                     m_predicateNames;
+    std::vector<PredicateCallback>               m_predicateCallbacks;
+    std::vector<std::vector<CompiledPredicate> > m_patternPredicates;
+
+    std::vector<uint32_t> m_captureGeneration;
+    std::vector<uint16_t> m_captureIndex;
+    uint32_t              m_generation;
 
     void* m_query;
 };
@@ -1,34 +1,62 @@
 #include "languagescanner.h"
 #include "live/plugincontext.h"
 #include "live/elements/parseddocument.h"
+#include "live/exception.h"
+#include "live/visuallog.h"
+
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 namespace lv{ namespace el{
 
-LanguageScanner::LanguageScanner(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io)
+/**
+ * \class lv::el::LanguageScanner
+ * \brief Scans modules and their dependencies, publishing each ModuleInfo after its dependencies
+ *
+ * Queued modules are scanned in rounds when consuming the queue. Each round loads the plugins of the newly
+ * reached modules through the PackageGraph on the calling thread, then reads and parses all of their documents
+ * on a pool of threads, each with its own LanguageParser. The imports found in the parsed documents schedule the
+ * next round, so the number of rounds follows the longest import chain, not the number of modules.
+ *
+ * Scanned modules are then ordered topologically by their dependencies and published through the onModuleReady
+ * callback. Modules that are part of a dependency cycle are reported once, and published next to each other,
+ * before the modules that depend on them.
+ *
+ * The info extracted from each document is stored in a LanguageInfoCache next to its package, keyed by a hash of
+ * the document source and ParsedDocument::InfoVersion. Documents that didn't change since are loaded from the cache
+ * instead of being parsed again.
+ *
+ * \ingroup lvelements
+ */
+
+LanguageScanner::LanguageScanner(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io, size_t threadCount)
     : m_packageGraph(new PackageGraph)
+    , m_threadCount(threadCount)
+    , m_isCacheEnabled(true)
+    , m_infoVersion(std::to_string(ParsedDocument::InfoVersion))
     , m_parser(parser)
     , m_io(io)
 {
-}
-
-void LanguageScanner::resolveModule(ModuleInfo::Ptr module){
-    size_t totalDocs = module->totalUnresolvedDocuments();
-    for ( size_t i = 0; i < totalDocs; ++i ){
-        DocumentInfo::Ptr doc = module->unresolvedDocumentAt(i);
-        size_t totalTypes = doc->totalTypes();
-        for ( size_t t = 0; t < totalTypes; ++t ){
-            TypeInfo::Ptr type = doc->typeAt(t);
-            //TODO: For name, instance, and each property in this type, resolve
-            // it's type from the loaded modules
-        }
+    if ( m_threadCount == 0 ){
+        m_threadCount = std::thread::hardware_concurrency();
+        if ( m_threadCount == 0 )
+            m_threadCount = 2;
+        if ( m_threadCount > 4 )
+            m_threadCount = 4;
     }
 }
 
 LanguageScanner::~LanguageScanner(){
 }
 
-LanguageScanner::Ptr LanguageScanner::create(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io){
-    return LanguageScanner::Ptr(new LanguageScanner(parser, io));
+/**
+ * \brief Creates a scanner that parses documents with \p parser and reads them through \p io
+ *
+ * If \p threadCount is 0, the number of threads is chosen based on the available cores.
+ */
+LanguageScanner::Ptr LanguageScanner::create(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io, size_t threadCount){
+    return LanguageScanner::Ptr(new LanguageScanner(parser, io, threadCount));
 }
 
 /**
@@ -38,6 +66,71 @@ LanguageScanner::Ptr LanguageScanner::create(LanguageParser::Ptr parser, LockedF
  * is parsed.
  */
 ModuleInfo::Ptr LanguageScanner::parseModule(const std::string &importUri){
+    std::vector<ScanTask> tasks;
+    ModuleInfo::Ptr module = createModule(importUri, tasks);
+    if ( !module )
+        return module;
+
+    scanDocuments(tasks);
+    joinDocuments(tasks);
+    saveCaches();
+
+    module->updateScanStatus(ModuleInfo::Parsed);
+    return module;
+}
+
+/**
+ * \brief Schedules \p importUri to be scanned during the next consumeQueue() call
+ *
+ * Modules that were already scheduled or loaded are ignored.
+ */
+void LanguageScanner::queueModule(const std::string &importUri){
+    if ( !m_scheduledModules.insert(importUri).second )
+        return;
+    m_modulesToScan.push_back(importUri);
+}
+
+/**
+ * \brief Queues an already parsed \p module for publishing, scheduling any of its dependencies that are not known
+ * yet
+ */
+void LanguageScanner::queueModule(const ModuleInfo::Ptr &module){
+    auto it = locateModuleInQueue(module->importUri().data());
+    if ( it != m_modulesToLoad.end() )
+        return;
+
+    m_scheduledModules.insert(module->importUri().data());
+
+    size_t totalDependencies = module->totalDependencies();
+    for ( size_t i = 0; i < totalDependencies; ++i ){
+        queueModule(module->dependencyAt(i).data());
+    }
+
+    m_modulesToLoad.push_back(module);
+}
+
+/**
+ * \brief Scans all scheduled modules, then publishes up to \p max modules in dependency order
+ *
+ * Modules that are not published remain queued, already ordered, for the next call.
+ */
+void LanguageScanner::consumeQueue(size_t max){
+    scanQueue();
+    sortQueue();
+
+    while ( m_modulesToLoad.size() > 0 && max > 0 ){
+        ModuleInfo::Ptr module = m_modulesToLoad.front();
+        m_modulesToLoad.pop_front();
+
+        m_loadedModules[module->importUri().data()] = module;
+        if ( m_onModuleReady )
+            m_onModuleReady(module);
+
+        --max;
+    }
+}
+
+ModuleInfo::Ptr LanguageScanner::createModule(const std::string &importUri, std::vector<ScanTask> &tasks){
     Plugin::Ptr plugin = m_packageGraph->loadPlugin(importUri);
 
     if ( !plugin || !plugin->context() )
@@ -59,81 +152,222 @@ ModuleInfo::Ptr LanguageScanner::parseModule(const std::string &importUri){
         module->addDependency(dep);
     }
 
+    LanguageInfoCache* cache = cacheFor(plugin);
+
     const std::list<std::string>& files = plugin->modules();
     for ( auto it = files.begin(); it != files.end(); ++it ){
-        std::string filePath = plugin->filePath() + "/" + *it + ".lv";
-        std::string content = m_io->readFromFile(filePath);
-        LanguageParser::AST* ast = m_parser->parse(content);
-        DocumentInfo::Ptr info = ParsedDocument::extractInfo(content, ast);
-
-        for ( size_t i = 0; i < info->totalImports(); ++i ){
-            Plugin::Ptr depPlugin = m_packageGraph->loadPlugin(info->importAt(i).segments(), plugin);
-            if ( depPlugin && depPlugin->context() )
-                module->addDependency(depPlugin->context()->importId);
+        ScanTask task;
+        task.module   = module;
+        task.plugin   = plugin;
+        task.path     = plugin->path() + "/" + *it + ".lv";
+        task.cache    = cache;
+        task.isCached = false;
+        tasks.push_back(task);
+    }
+
+    return module;
+}
+
+void LanguageScanner::scanDocuments(std::vector<ScanTask> &tasks){
+    size_t threadCount = m_threadCount < tasks.size() ? m_threadCount : tasks.size();
+
+    std::atomic<size_t> next(0);
+    auto work = [this, &tasks, &next](LanguageParser* parser){
+        size_t index;
+        while ( (index = next++) < tasks.size() ){
+            scanDocument(parser, tasks[index]);
         }
+    };
 
-        module->addUnresolvedDocument(info);
-        m_parser->destroy(ast);
+    std::vector<std::thread> threads;
+    for ( size_t i = 1; i < threadCount; ++i ){
+        threads.push_back(std::thread([this, &work](){
+            LanguageParser::Ptr parser = LanguageParser::create(m_parser->language());
+            work(parser.get());
+        }));
     }
+    work(m_parser.get());
 
-    module->updateScanStatus(ModuleInfo::Parsed);
-    return module;
+    for ( auto it = threads.begin(); it != threads.end(); ++it )
+        it->join();
 }
 
-void LanguageScanner::queueModule(const std::string &importUri){
-    ModuleInfo::Ptr module = parseModule(importUri);
-    queueModule(module);
+void LanguageScanner::scanDocument(LanguageParser *parser, LanguageScanner::ScanTask &task) const{
+    LockedFileIOSession::ContentPtr content = m_io->readSharedFromFile(task.path);
+    const std::string emptyContent;
+    const std::string& source = content ? *content : emptyContent;
+
+    if ( task.cache ){
+        task.key = LanguageInfoCache::createKey(source, m_infoVersion);
+        task.info = task.cache->lookup(task.path, task.key);
+        if ( task.info ){
+            task.isCached = true;
+            return;
+        }
+    }
+
+    LanguageParser::AST* ast = nullptr;
+    try{
+        ast = parser->parse(source);
+        task.info = ParsedDocument::extractInfo(source, ast);
+    } catch ( lv::Exception& e ){
+        task.error = e.message();
+    }
+    if ( ast )
+        parser->destroy(ast);
 }
 
-void LanguageScanner::queueModule(const ModuleInfo::Ptr &module){
-    auto it = locateModuleInQueue(module->importUri().data());
-    if ( it != m_modulesToLoad.end() )
-        return;
+void LanguageScanner::joinDocuments(std::vector<ScanTask> &tasks){
+    for ( auto it = tasks.begin(); it != tasks.end(); ++it ){
+        ScanTask& task = *it;
+        if ( !task.info ){
+            vlog("lvelements-languagescanner").w() << "Failed to scan \'" << task.path << "\': " << task.error;
+            continue;
+        }
 
-    size_t totalDependencies = module->totalDependencies();
-    for ( size_t i = 0; i < totalDependencies; ++i ){
-        Utf8 dep = module->dependencyAt(i);
-        if ( !hasModule(dep.data()) ){
-            auto it = locateModuleInQueue(dep.data());
-            if ( it == m_modulesToLoad.end() ){
-                ModuleInfo::Ptr depModule = parseModule(dep.data());
-                queueModule(depModule);
+        for ( size_t i = 0; i < task.info->totalImports(); ++i ){
+            try{
+                Plugin::Ptr depPlugin = m_packageGraph->loadPlugin(task.info->importAt(i).segments(), task.plugin);
+                if ( depPlugin && depPlugin->context() )
+                    task.module->addDependency(depPlugin->context()->importId);
+            } catch ( lv::Exception& e ){
+                vlog("lvelements-languagescanner").w() << "Skipping import in \'" << task.path << "\': " << e.message();
             }
         }
-    }
 
-    m_modulesToLoad.push_back(module);
+        task.module->addUnresolvedDocument(task.info);
+
+        if ( task.cache && !task.isCached )
+            task.cache->store(task.path, task.key, task.info);
+    }
 }
 
-void LanguageScanner::consumeQueue(size_t max){
-    while ( m_modulesToLoad.size() > 0 && max > 0 ){
-        ModuleInfo::Ptr module = m_modulesToLoad.front();
-        m_modulesToLoad.pop_front();
+void LanguageScanner::scanQueue(){
+    while ( !m_modulesToScan.empty() ){
+        std::vector<std::string> importUris;
+        importUris.swap(m_modulesToScan);
+
+        std::vector<ModuleInfo::Ptr> modules;
+        std::vector<ScanTask> tasks;
 
-        bool resolvedAllDependencies = true;
-        size_t totalDependencies = module->totalDependencies();
-        for ( size_t i = 0; i < totalDependencies; ++i ){
-            Utf8 dep = module->dependencyAt(i);
-            if ( !hasModule(dep.data()) ){
-                resolvedAllDependencies = false;
+        for ( auto it = importUris.begin(); it != importUris.end(); ++it ){
+            try{
+                ModuleInfo::Ptr module = createModule(*it, tasks);
+                if ( module ){
+                    m_scheduledModules.insert(module->importUri().data());
+                    modules.push_back(module);
+                } else {
+                    vlog("lvelements-languagescanner").w() << "Failed to find module: " << *it;
+                }
+            } catch ( lv::Exception& e ){
+                vlog("lvelements-languagescanner").w() << "Failed to load module \'" << *it << "\': " << e.message();
             }
         }
 
-        if ( !resolvedAllDependencies ){
-            queueModule(module);
-        } else {
-            resolveModule(module);
-            m_loadedModules[module->importUri().data()] = module;
-            m_onModuleReady(module);
+        scanDocuments(tasks);
+        joinDocuments(tasks);
+
+        // dependencies that were not scheduled yet are scanned in the next round
+        for ( auto it = modules.begin(); it != modules.end(); ++it ){
+            (*it)->updateScanStatus(ModuleInfo::Parsed);
+            queueModule(*it);
         }
+    }
 
-        --max;
+    saveCaches();
+}
+
+LanguageInfoCache *LanguageScanner::cacheFor(const Plugin::Ptr &plugin){
+    if ( !m_isCacheEnabled )
+        return nullptr;
+
+    Package::Ptr package = plugin->context()->package;
+    if ( !package || package->filePath().empty() )
+        return nullptr;
+
+    auto it = m_caches.find(package->path());
+    if ( it != m_caches.end() )
+        return it->second.get();
+
+    LanguageInfoCache::Ptr cache(new LanguageInfoCache(package->path() + "/" + LanguageInfoCache::fileName));
+    cache->load();
+    m_caches[package->path()] = cache;
+    return cache.get();
+}
+
+void LanguageScanner::saveCaches(){
+    for ( auto it = m_caches.begin(); it != m_caches.end(); ++it ){
+        LanguageInfoCache::Ptr& cache = it->second;
+        if ( cache->isModified() && !cache->save() )
+            vlog("lvelements-languagescanner").v() << "Failed to write language info cache: " << cache->cacheFilePath();
     }
+}
+
+void LanguageScanner::sortQueue(){
+    std::vector<ModuleInfo::Ptr> modules(m_modulesToLoad.begin(), m_modulesToLoad.end());
+
+    DependencyGraph graph;
+    std::map<std::string, DependencyGraph::Node> nodes;
+    for ( auto it = modules.begin(); it != modules.end(); ++it )
+        nodes[(*it)->importUri().data()] = graph.addNode();
+
+    // dependencies outside the queue are either loaded or missing, so only queued ones are waited for
+    for ( DependencyGraph::Node node = 0; node < modules.size(); ++node ){
+        const ModuleInfo::Ptr& module = modules[node];
+        for ( size_t i = 0; i < module->totalDependencies(); ++i ){
+            auto depIt = nodes.find(module->dependencyAt(i).data());
+            if ( depIt != nodes.end() && depIt->second != node )
+                graph.addEdge(node, depIt->second);
+        }
+    }
+
+    // components come after the ones they depend on, and hold more than one module only for cycles
+    std::list<ModuleInfo::Ptr> sorted;
+    std::vector<std::vector<DependencyGraph::Node> > components = graph.stronglyConnectedComponents();
+    for ( auto it = components.begin(); it != components.end(); ++it ){
+        if ( it->size() > 1 )
+            reportCycle(graph, *it, modules);
+        for ( DependencyGraph::Node node : *it )
+            sorted.push_back(modules[node]);
+    }
+
+    m_modulesToLoad.swap(sorted);
+}
+
+void LanguageScanner::reportCycle(
+        const DependencyGraph &graph,
+        const std::vector<DependencyGraph::Node> &component,
+        const std::vector<ModuleInfo::Ptr> &modules)
+{
+    DependencyGraph::Node start = *std::min_element(component.begin(), component.end());
+    if ( m_reportedCycles.find(modules[start]->importUri().data()) != m_reportedCycles.end() )
+        return;
+
+    // shortest cycle through the first queued module of the component
+    std::vector<DependencyGraph::Node> cycle;
+    for ( DependencyGraph::Node dep : graph.edges(start) ){
+        if ( std::find(component.begin(), component.end(), dep) == component.end() )
+            continue;
+
+        std::vector<DependencyGraph::Node> back = graph.path(dep, start);
+        if ( cycle.empty() || back.size() + 1 < cycle.size() ){
+            cycle.assign(1, start);
+            cycle.insert(cycle.end(), back.begin(), back.end());
+        }
+    }
+
+    std::string message;
+    for ( size_t i = 0; i < cycle.size(); ++i )
+        message += (i == 0 ? "" : " -> ") + modules[cycle[i]]->importUri().data();
+
+    for ( DependencyGraph::Node node : component )
+        m_reportedCycles.insert(modules[node]->importUri().data());
 
+    vlog("lvelements-languagescanner").w() << "Cyclic module dependency: " << message;
 }
 
 bool LanguageScanner::hasModule(const std::string& importUri){
-    return (m_loadedModules.find(importUri) == m_loadedModules.end());
+    return (m_loadedModules.find(importUri) != m_loadedModules.end());
 }
 
 std::list<ModuleInfo::Ptr>::iterator LanguageScanner::locateModuleInQueue(const std::string& importUri){
@@ -3,12 +3,19 @@
 
 #include "live/elements/lvelementsglobal.h"
 #include "live/elements/languageinfo.h"
+#include "live/elements/languageinfocache.h"
 #include "live/packagegraph.h"
+#include "live/dependencygraph.h"
 #include "live/lockedfileiosession.h"
 #include "live/elements/languageparser.h"
 
 #include <memory>
 #include <functional>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
 
 namespace lv{ namespace el{
 
@@ -21,7 +28,7 @@ public:
 public:
     ~LanguageScanner();
 
-    static LanguageScanner::Ptr create(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io);
+    static LanguageScanner::Ptr create(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io, size_t threadCount = 0);
 
     ModuleInfo::Ptr parseModule(const std::string& importUri);
     void onModuleReady(const std::function<void(ModuleInfo::ConstPtr)> callback);
@@ -37,14 +44,52 @@ public:
     void setPackageImportPaths(const std::vector<std::string>& paths);
     const std::vector<std::string>& packageImportPaths() const;
 
+    size_t threadCount() const;
+
+    void setCacheEnabled(bool enable);
+    bool isCacheEnabled() const;
+
 private:
-    LanguageScanner(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io);
+    /// \private
+    class ScanTask{
+    public:
+        ModuleInfo::Ptr   module;
+        Plugin::Ptr       plugin;
+        std::string       path;
+        DocumentInfo::Ptr info;
+        std::string       error;
+        LanguageInfoCache* cache;
+        std::string       key;
+        bool              isCached;
+    };
+
+    LanguageScanner(LanguageParser::Ptr parser, LockedFileIOSession::Ptr io, size_t threadCount);
     DISABLE_COPY(LanguageScanner);
 
-    void resolveModule(ModuleInfo::Ptr module);
+    ModuleInfo::Ptr createModule(const std::string& importUri, std::vector<ScanTask>& tasks);
+    void scanDocuments(std::vector<ScanTask>& tasks);
+    void scanDocument(LanguageParser* parser, ScanTask& task) const;
+    void joinDocuments(std::vector<ScanTask>& tasks);
+    void scanQueue();
+    LanguageInfoCache* cacheFor(const Plugin::Ptr& plugin);
+    void saveCaches();
+    void sortQueue();
+    void reportCycle(
+        const DependencyGraph& graph,
+        const std::vector<DependencyGraph::Node>& component,
+        const std::vector<ModuleInfo::Ptr>& modules
+    );
 
     PackageGraph* m_packageGraph;
+    size_t        m_threadCount;
+    bool          m_isCacheEnabled;
+    std::string   m_infoVersion;
+
+    std::map<std::string, LanguageInfoCache::Ptr> m_caches;
 
+    std::vector<std::string>                    m_modulesToScan;
+    std::set<std::string>                       m_scheduledModules;
+    std::set<std::string>                       m_reportedCycles;
     std::list<ModuleInfo::Ptr>                  m_modulesToLoad;
     std::map<std::string, ModuleInfo::ConstPtr> m_loadedModules;
     std::function<void(ModuleInfo::ConstPtr)>   m_onModuleReady;
@@ -57,6 +102,27 @@ inline void LanguageScanner::onModuleReady(const std::function<void(ModuleInfo::
     m_onModuleReady = callback;
 }
 
+/**
+ * \brief Returns the maximum number of threads used to parse module documents
+ */
+inline size_t LanguageScanner::threadCount() const{
+    return m_threadCount;
+}
+
+/**
+ * \brief Enables or disables the LanguageInfoCache stored next to each scanned package
+ */
+inline void LanguageScanner::setCacheEnabled(bool enable){
+    m_isCacheEnabled = enable;
+}
+
+/**
+ * \brief Checks wether document info is loaded from and saved to package caches
+ */
+inline bool LanguageScanner::isCacheEnabled() const{
+    return m_isCacheEnabled;
+}
+
 }} // namespace lv, el
 
 #endif // LVLANGUAGESCANNER_H
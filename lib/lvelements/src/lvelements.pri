@@ -6,6 +6,7 @@ HEADERS += \
     $$PWD/function.h \
     $$PWD/engine.h \
     $$PWD/languageinfo.h \
+    $$PWD/languageinfocache.h \
     $$PWD/languagenodes_p.h \
     $$PWD/languageparser.h \
     $$PWD/languagequery.h \
@@ -15,6 +16,7 @@ HEADERS += \
     $$PWD/sourcerange.h \
     $$PWD/value.h \
     $$PWD/element.h \
+    $$PWD/elementpool.h \
     $$PWD/element_p.h \
     $$PWD/property.h \
     $$PWD/event.h \
@@ -31,6 +33,8 @@ HEADERS += \
     $$PWD/value_p.h \
     $$PWD/list.h \
     $$PWD/buffer.h \
+    $$PWD/buffer_p.h \
+    $$PWD/bufferpool.h \
     $$PWD/container.h \
     $$PWD/errorhandler.h \
     $$PWD/mlnodetojs.h \
@@ -41,6 +45,11 @@ HEADERS += \
     $$PWD/modulelibrary.h \
     $$PWD/moduleloader.h \
     $$PWD/tuple.h \
+    $$PWD/compilecache.h \
+    $$PWD/moduleprefetcher.h \
+    $$PWD/incrementaltranspiler.h \
+    $$PWD/enginepool.h \
+    $$PWD/bindingscheduler_p.h \
     $$PWD/elementssections_p.h
 
 SOURCES += \
@@ -49,6 +58,7 @@ SOURCES += \
     $$PWD/function.cpp \
     $$PWD/engine.cpp \
     $$PWD/languageinfo.cpp \
+    $$PWD/languageinfocache.cpp \
     $$PWD/languagenodes.cpp \
     $$PWD/languageparser.cpp \
     $$PWD/languagequery.cpp \
@@ -58,6 +68,7 @@ SOURCES += \
     $$PWD/sourcerange.cpp \
     $$PWD/value.cpp \
     $$PWD/element.cpp \
+    $$PWD/elementpool.cpp \
     $$PWD/property.cpp \
     $$PWD/event.cpp \
     $$PWD/eventfunction.cpp \
@@ -69,6 +80,7 @@ SOURCES += \
     $$PWD/object.cpp \
     $$PWD/list.cpp \
     $$PWD/buffer.cpp \
+    $$PWD/bufferpool.cpp \
     $$PWD/container.cpp \
     $$PWD/errorhandler.cpp \
     $$PWD/mlnodetojs.cpp \
@@ -78,4 +90,9 @@ SOURCES += \
     $$PWD/imports.cpp \
     $$PWD/modulelibrary.cpp \
     $$PWD/tuple.cpp \
+    $$PWD/compilecache.cpp \
+    $$PWD/moduleprefetcher.cpp \
+    $$PWD/incrementaltranspiler.cpp \
+    $$PWD/enginepool.cpp \
+    $$PWD/bindingscheduler.cpp \
     $$PWD/elementssections.cpp
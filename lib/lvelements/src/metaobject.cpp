@@ -1,12 +1,44 @@
 #include "metaobject.h"
 
+#include <algorithm>
+
 namespace lv{ namespace el{
 
 MetaObject::MetaObject()
     : m_base(nullptr)
     , m_constructor(nullptr)
+    , m_pool(nullptr)
 {
 
 }
 
+/**
+ * \brief Returns the property for \p key, or null if this type has no such property
+ *
+ * Properties are looked up by the id of the key, through a binary search.
+ */
+Property *MetaObject::getProperty(const PropertyKey &key) const{
+    PropertyKey::Id keyId = key.id();
+    if ( keyId == PropertyKey::NoId )
+        return nullptr;
+
+    auto it = std::lower_bound(
+        m_propertyTable.begin(),
+        m_propertyTable.end(),
+        keyId,
+        [](const std::pair<PropertyKey::Id, Property*>& entry, PropertyKey::Id id){ return entry.first < id; }
+    );
+    if ( it == m_propertyTable.end() || it->first != keyId )
+        return nullptr;
+    return it->second;
+}
+
+void MetaObject::indexProperties(){
+    m_propertyTable.clear();
+    m_propertyTable.reserve(m_properties.size());
+    for ( auto it = m_properties.begin(); it != m_properties.end(); ++it )
+        m_propertyTable.push_back(std::make_pair(PropertyKey::declare(it->first), it->second));
+    std::sort(m_propertyTable.begin(), m_propertyTable.end());
+}
+
 }}// namespace lv, el
@@ -11,11 +11,13 @@
 #include "live/elements/property.h"
 #include "live/elements/event.h"
 #include "live/elements/eventfunction.h"
+#include "live/elements/elementpool.h"
 #include "live/typename.h"
 
 #include <string>
 #include <functional>
 #include <map>
+#include <vector>
 
 namespace lv{ namespace el{
 
@@ -57,6 +59,11 @@ public:
             return *this;
         }
 
+        Builder& pooled(size_t capacity = ElementPool::DefaultCapacity){
+            m_pool = new ElementPool(sizeof(C), capacity);
+            return *this;
+        }
+
         Builder& scriptIndexAccess(Property::IndexGetFunction indexGet, Property::IndexSetFunction indexSet)
         {
             m_indexGet = indexGet;
@@ -279,6 +286,7 @@ public:
         std::map<std::string, Property*>      m_properties;
         std::string                           m_defaultProperty;
         Constructor*                          m_constructor;
+        ElementPool*                          m_pool;
         Property::IndexGetFunction            m_indexGet;
         Property::IndexSetFunction            m_indexSet;
 
@@ -302,6 +310,7 @@ public:
         mo.m_typeId        = builder.m_typeId;
         mo.m_functions     = builder.m_functions;
         mo.m_constructor   = builder.m_constructor;
+        mo.m_pool          = builder.m_pool;
         mo.m_ownMethods    = builder.m_methods;
         mo.m_ownEvents     = builder.m_events;
         mo.m_ownEventsById = builder.m_eventsById;
@@ -333,6 +342,8 @@ public:
         if ( !mo.m_defaultProperty.empty() && mo.m_properties.find(mo.m_defaultProperty) == mo.m_properties.end() )
             THROW_EXCEPTION(lv::Exception, "Default property \'" + mo.m_defaultProperty + "\' is not a class property.", 1);
 
+        mo.indexProperties();
+
         return mo;
     }
 
@@ -342,6 +353,7 @@ public:
     }
 
     Constructor* constructor() const { return m_constructor; }
+    ElementPool* pool() const{ return m_pool; }
     const MetaObject* base() const;
 
 
@@ -378,6 +390,7 @@ public:
 
     EventFunction* getEvent(const std::string& name) const;
     Property* getProperty(const std::string& name) const;
+    Property* getProperty(const PropertyKey& key) const;
     Function* getMethod(const std::string& name) const;
 
     bool hasIndexAccess() const;
@@ -395,12 +408,15 @@ public:
     void log(lv::VisualLog& vl, const Element* object) const;
 
 private:
+    void indexProperties();
+
     std::string                           m_name;
     std::string                           m_fullName;
     const MetaObject*                     m_base;
     MetaObject::Id                        m_typeId;
     std::map<std::string, Function*>      m_functions;
     Constructor*                          m_constructor;
+    ElementPool*                          m_pool;
 
     std::map<std::string, Function*>      m_methods;
     std::map<std::string, EventFunction*> m_events;
@@ -412,6 +428,9 @@ private:
     std::map<Event::Id,   EventFunction*> m_ownEventsById;
     std::map<std::string, Property*>      m_ownProperties;
 
+    // all properties sorted by their PropertyKey id
+    std::vector<std::pair<PropertyKey::Id, Property*> > m_propertyTable;
+
     Property::IndexGetFunction            m_indexGet;
     Property::IndexSetFunction            m_indexSet;
 
@@ -431,6 +450,7 @@ MetaObject::Builder<C>::Builder(const std::string &name)
     , m_fullName(TypeName<C>::capture())
     , m_base(nullptr)
     , m_constructor(nullptr)
+    , m_pool(nullptr)
     , m_indexGet(nullptr)
     , m_indexSet(nullptr)
 {
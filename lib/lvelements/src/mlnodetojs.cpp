@@ -1,5 +1,6 @@
 #include "mlnodetojs.h"
 #include "element_p.h"
+#include "buffer.h"
 
 namespace lv{
 namespace ml{
@@ -32,7 +33,8 @@ void toJs(const MLNode &n, v8::Local<v8::Value>& v, el::Engine *engine){
         break;
     }
     case MLNode::Type::Bytes:{
-        v = v8::ArrayBuffer::New(engine->isolate(), n.asBytes().data(), n.asBytes().size());
+        MLNode::BytesType bytes = n.asBytes();
+        v = el::Buffer::copy(bytes.data(), bytes.size()).toArrayBuffer(engine);
         break;
     }
     case MLNode::Type::String:{
@@ -68,6 +70,9 @@ void fromJs(const v8::Local<v8::Value> v, MLNode& n, el::Engine* engine){
         }
     } else if ( v->IsString() || v->IsStringObject() ){
         n = MLNode(*v8::String::Utf8Value(v->ToString(engine->isolate())));
+    } else if ( v->IsArrayBuffer() ){
+        v8::ArrayBuffer::Contents contents = v8::Local<v8::ArrayBuffer>::Cast(v)->GetContents();
+        n = MLNode(MLNode::BytesType(reinterpret_cast<MLNode::ByteType*>(contents.Data()), contents.ByteLength()));
     } else if ( v->IsObject() ){
         v8::Local<v8::Object> vo = v8::Local<v8::Object>::Cast(v);
         n = MLNode(MLNode::Type::Object);
@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#include "moduleprefetcher.h"
+#include "live/elements/engine.h"
+#include "live/elements/languageparser.h"
+#include "live/elements/parseddocument.h"
+#include "live/elements/compilecache.h"
+#include "live/packagegraph.h"
+#include "live/plugincontext.h"
+#include "live/exception.h"
+#include "live/visuallog.h"
+#include "live/trace.h"
+
+#include "v8nowarnings.h"
+
+#include <QFileInfo>
+
+#include <thread>
+#include <atomic>
+
+namespace lv{ namespace el{
+
+/**
+ * \class lv::el::ModulePrefetcher
+ * \brief Parses and transpiles the modules reachable from an entry module on background threads
+ *
+ * Starting from the entry module and the modules of its plugin, the prefetcher parses each file, extracts its
+ * imports and converts it to javascript. Imports are resolved through the engine's PackageGraph on the calling
+ * thread, and the modules of each newly reached plugin are processed in the next round. Parsing and transpiling
+ * run on a pool of threads, each with its own LanguageParser.
+ *
+ * The engine takes the generated javascript when compiling a module, so only the V8 compilation is left on the
+ * isolate thread:
+ *
+ * \code
+ * ModulePrefetcher prefetcher(engine);
+ * prefetcher.prefetch(plugin, "main.lv");
+ * // ...
+ * std::string js;
+ * if ( prefetcher.take(path, source, js) )
+ *     // compile js
+ * \endcode
+ *
+ * Modules that fail to parse are skipped, so the engine will report their errors when compiling them.
+ *
+ * \ingroup lvelements
+ */
+
+/**
+ * \brief Constructor
+ *
+ * If \p threadCount is 0, the number of threads is chosen based on the available cores.
+ */
+ModulePrefetcher::ModulePrefetcher(Engine *engine, size_t threadCount)
+    : m_engine(engine)
+    , m_threadCount(threadCount)
+{
+    if ( m_threadCount == 0 ){
+        m_threadCount = std::thread::hardware_concurrency();
+        if ( m_threadCount == 0 )
+            m_threadCount = 2;
+        if ( m_threadCount > 4 )
+            m_threadCount = 4;
+    }
+}
+
+/**
+ * \brief Destructor
+ */
+ModulePrefetcher::~ModulePrefetcher(){
+}
+
+/**
+ * \brief Parses and transpiles \p entryPath, the modules in \p plugin and all modules reachable through imports
+ *
+ * Blocks until all reachable modules are processed. Files that were already processed by this prefetcher are
+ * skipped.
+ */
+void ModulePrefetcher::prefetch(const Plugin::Ptr &plugin, const std::string &entryPath){
+    vtrace("lvelements", "ModulePrefetcher::prefetch", entryPath);
+
+    std::vector<Task> tasks;
+    addFile(plugin, entryPath, tasks);
+    if ( plugin )
+        addPlugin(plugin, tasks);
+
+    PackageGraph* packageGraph = m_engine->packageGraph();
+
+    while ( !tasks.empty() ){
+        process(tasks);
+
+        std::vector<Task> next;
+        for ( Task& task : tasks ){
+            if ( !task.isParsed )
+                continue;
+
+            if ( !task.js.empty() ){
+                Module& module = m_modules[task.path];
+                module.source.swap(task.source);
+                module.js.swap(task.js);
+            }
+
+            if ( !packageGraph )
+                continue;
+
+            for ( const std::vector<std::string>& segments : task.imports ){
+                try{
+                    Plugin::Ptr dependency = packageGraph->loadPlugin(segments, task.plugin);
+                    if ( dependency )
+                        addPlugin(dependency, next);
+                } catch ( lv::Exception& e ){
+                    vlog("lvelements-prefetcher").v() << "Skipping import in \'" << task.path << "\': " << e.message();
+                }
+            }
+        }
+
+        tasks.swap(next);
+    }
+}
+
+/**
+ * \brief Retrieves the prefetched javascript for \p path, if it was generated from \p source
+ *
+ * The module is removed from the prefetcher. Returns false if the module was not prefetched, or if its source
+ * changed since.
+ */
+bool ModulePrefetcher::take(const std::string &path, const std::string &source, std::string &js){
+    auto it = m_modules.find(path);
+    if ( it == m_modules.end() )
+        return false;
+
+    bool isValid = it->second.source == source;
+    if ( isValid )
+        js.swap(it->second.js);
+
+    m_modules.erase(it);
+    return isValid;
+}
+
+/**
+ * \brief Removes all prefetched modules
+ */
+void ModulePrefetcher::clear(){
+    m_modules.clear();
+    m_visitedFiles.clear();
+    m_visitedPlugins.clear();
+}
+
+void ModulePrefetcher::addPlugin(const Plugin::Ptr &plugin, std::vector<Task> &tasks){
+    if ( !m_visitedPlugins.insert(plugin->path()).second )
+        return;
+
+    for ( auto it = plugin->modules().begin(); it != plugin->modules().end(); ++it )
+        addFile(plugin, plugin->path() + "/" + *it + ".lv", tasks);
+}
+
+void ModulePrefetcher::addFile(const Plugin::Ptr &plugin, const std::string &path, std::vector<Task> &tasks){
+    if ( !m_visitedFiles.insert(path).second )
+        return;
+
+    Task task;
+    task.path     = path;
+    task.plugin   = plugin;
+    task.isParsed = false;
+    tasks.push_back(task);
+}
+
+void ModulePrefetcher::process(std::vector<Task> &tasks){
+    size_t threadCount = m_threadCount < tasks.size() ? m_threadCount : tasks.size();
+
+    std::atomic<size_t> next(0);
+    auto work = [this, &tasks, &next](){
+        LanguageParser::Ptr parser = LanguageParser::createForElements();
+        size_t index;
+        while ( (index = next++) < tasks.size() ){
+            processTask(parser.get(), tasks[index]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for ( size_t i = 1; i < threadCount; ++i )
+        threads.push_back(std::thread(work));
+    work();
+
+    for ( auto it = threads.begin(); it != threads.end(); ++it )
+        it->join();
+}
+
+void ModulePrefetcher::processTask(LanguageParser *parser, ModulePrefetcher::Task &task) const{
+    LockedFileIOSession::ContentPtr content = m_engine->fileInterceptor()->fileInput()->readSharedFromFile(task.path);
+    if ( !content )
+        return;
+
+    task.source = *content;
+
+    LanguageParser::AST* ast = parser->parse(task.source);
+    if ( !ast )
+        return;
+
+    std::vector<ImportInfo> imports = ParsedDocument::extractImports(task.source, ast);
+    for ( const ImportInfo& import : imports ){
+        std::vector<std::string> segments = import.segments();
+        if ( import.isRelative() ) // relative imports start with an empty package name, i.e. '.plugin'
+            segments.insert(segments.begin(), std::string());
+        task.imports.push_back(segments);
+    }
+
+    std::string name = QFileInfo(QString::fromStdString(task.path)).baseName().toStdString();
+
+    // modules found in the compile cache don't need to be transpiled
+    const CompileCache::Ptr& compileCache = m_engine->compileCache();
+    if ( !compileCache || !compileCache->contains(CompileCache::createKey(name, task.source, v8::V8::GetVersion())) ){
+        try{
+            task.js = parser->toJs(task.source, ast, name);
+        } catch ( ... ){
+            task.js.clear();
+        }
+    }
+
+    parser->destroy(ast);
+    task.isParsed = true;
+}
+
+}} // namespace lv, el
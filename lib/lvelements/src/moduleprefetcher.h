@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+
+#ifndef LVMODULEPREFETCHER_H
+#define LVMODULEPREFETCHER_H
+
+#include "live/elements/lvelementsglobal.h"
+#include "live/plugin.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+namespace lv{ namespace el{
+
+class Engine;
+class LanguageParser;
+
+class LV_ELEMENTS_EXPORT ModulePrefetcher{
+
+    DISABLE_COPY(ModulePrefetcher);
+
+public:
+    explicit ModulePrefetcher(Engine* engine, size_t threadCount = 0);
+    ~ModulePrefetcher();
+
+    void prefetch(const Plugin::Ptr& plugin, const std::string& entryPath);
+    bool take(const std::string& path, const std::string& source, std::string& js);
+    void clear();
+
+    size_t totalModules() const;
+    size_t threadCount() const;
+
+private:
+    /// \private
+    class Task{
+    public:
+        std::string path;
+        Plugin::Ptr plugin;
+        std::string source;
+        std::string js;
+        std::vector<std::vector<std::string> > imports;
+        bool        isParsed;
+    };
+
+    /// \private
+    class Module{
+    public:
+        std::string source;
+        std::string js;
+    };
+
+    void addPlugin(const Plugin::Ptr& plugin, std::vector<Task>& tasks);
+    void addFile(const Plugin::Ptr& plugin, const std::string& path, std::vector<Task>& tasks);
+    void process(std::vector<Task>& tasks);
+    void processTask(LanguageParser* parser, Task& task) const;
+
+    Engine*                       m_engine;
+    size_t                        m_threadCount;
+    std::map<std::string, Module> m_modules;
+    std::set<std::string>         m_visitedFiles;
+    std::set<std::string>         m_visitedPlugins;
+};
+
+/**
+ * \brief Returns the number of transpiled modules that were not taken yet
+ */
+inline size_t ModulePrefetcher::totalModules() const{
+    return m_modules.size();
+}
+
+/**
+ * \brief Returns the maximum number of threads used while prefetching
+ */
+inline size_t ModulePrefetcher::threadCount() const{
+    return m_threadCount;
+}
+
+}} // namespace lv, el
+
+#endif // LVMODULEPREFETCHER_H
@@ -13,51 +13,70 @@ std::string ParsedDocument::slice(const std::string &source, TSNode node)
     return source.substr(start, end-start);
 }
 
+ImportInfo ParsedDocument::extractImport(const std::string &source, TSNode node){
+    bool rel = false;
+    std::vector<Utf8> segs;
+    Utf8 alias;
+
+    TSTreeCursor cursor = ts_tree_cursor_new(node);
+    if (ts_tree_cursor_goto_first_child(&cursor))
+    {
+        do
+        {
+            TSNode import_child = ts_tree_cursor_current_node(&cursor);
+            if (strcmp(ts_node_type(import_child), ".") == 0)
+            {
+                rel = true;
+            } else if (strcmp(ts_node_type(import_child), "import_path") == 0) {
+                // segments are at even positions, separated by '.'
+                if (ts_tree_cursor_goto_first_child(&cursor))
+                {
+                    int k = 0;
+                    do
+                    {
+                        if (k % 2 == 0)
+                            segs.push_back(slice(source, ts_tree_cursor_current_node(&cursor)));
+                        ++k;
+                    } while (ts_tree_cursor_goto_next_sibling(&cursor));
+                    ts_tree_cursor_goto_parent(&cursor);
+                }
+            } else if (strcmp(ts_node_type(import_child), "import_as") == 0) {
+                alias = slice(source, ts_node_child(import_child, 1));
+            }
+        } while (ts_tree_cursor_goto_next_sibling(&cursor));
+    }
+    ts_tree_cursor_delete(&cursor);
+
+    return ImportInfo(segs, alias, rel);
+}
+
 std::vector<ImportInfo> ParsedDocument::extractImports(const std::string &source, LanguageParser::AST *ast){
     TSTree* tree = reinterpret_cast<TSTree*>(ast);
     TSNode root_node = ts_tree_root_node(tree);
 
     std::vector<ImportInfo> result;
 
-    auto count = ts_node_child_count(root_node);
-    for (int i = 0; i < count; ++i)
+    TSTreeCursor cursor = ts_tree_cursor_new(root_node);
+    if (ts_tree_cursor_goto_first_child(&cursor))
     {
-        TSNode child = ts_node_child(root_node, i);
-        if (strcmp(ts_node_type(child), "import_statement") == 0)
+        do
         {
-            bool rel = false;
-            std::vector<Utf8> segs;
-            Utf8 alias;
-
-            auto import_count = ts_node_child_count(child);
-            int j = 0;
-            while (j < import_count)
+            TSNode child = ts_tree_cursor_current_node(&cursor);
+            if (strcmp(ts_node_type(child), "import_statement") == 0)
             {
-                TSNode import_child = ts_node_child(child, j);
-                if (strcmp(ts_node_type(import_child), ".") == 0)
-                {
-                    rel = true;
-                } else if (strcmp(ts_node_type(import_child), "import_path") == 0) {
-                    auto import_child_count = ts_node_child_count(import_child);
-                    for (int k = 0; k < import_child_count; k+=2)
-                    {
-                        segs.push_back(slice(source, ts_node_child(import_child, k)));
-                    }
-                } else if (strcmp(ts_node_type(import_child), "import_as") == 0) {
-                    alias = slice(source, ts_node_child(import_child, 1));
-                }
-                ++j;
+                result.push_back(extractImport(source, child));
             }
-
-            result.push_back(ImportInfo(segs, alias, rel));
-        }
+        } while (ts_tree_cursor_goto_next_sibling(&cursor));
     }
+    ts_tree_cursor_delete(&cursor);
 
     return result;
 }
 
 CursorContext ParsedDocument::findCursorContext(LanguageParser::AST *ast, int position){
 
+    TSNode root_node = ts_tree_root_node(reinterpret_cast<TSTree*>(ast));
+
     std::vector<TSNode> path;
     treePath(ast, position, path);
 
@@ -230,10 +249,10 @@ CursorContext ParsedDocument::findCursorContext(LanguageParser::AST *ast, int po
 
         if (strcmp(type, "import_path") == 0)
         {
-            auto count = ts_node_child_count(curr);
             context = CursorContext::InImport | CursorContext::InElements;
 
-            auto parent = ts_node_parent(curr);
+            // the parent is already on the path, ts_node_parent would walk down from the root again
+            auto parent = idx > 0 ? path[idx - 1] : root_node;
 
             auto parent_count = ts_node_child_count(parent);
 
@@ -242,22 +261,32 @@ CursorContext ParsedDocument::findCursorContext(LanguageParser::AST *ast, int po
                 context |=  CursorContext::InRelativeImport;
             }
 
-            for (int ip = 0; ip < count; ip+=2)
+            TSTreeCursor cursor = ts_tree_cursor_new(curr);
+            if (ts_tree_cursor_goto_first_child(&cursor))
             {
-                auto start = ts_node_start_byte(ts_node_child(curr, ip));
-                auto end = ts_node_end_byte(ts_node_child(curr, ip));
-                if (start < position)
+                int ip = 0;
+                do
                 {
-                    if (end < position)
+                    if (ip++ % 2 != 0)
+                        continue;
+
+                    TSNode segment = ts_tree_cursor_current_node(&cursor);
+                    auto start = ts_node_start_byte(segment);
+                    auto end = ts_node_end_byte(segment);
+                    if (start < position)
                     {
-                        expressionPath.push_back(SourceRange(start, end - start));
-                    }
-                    else {
-                        expressionPath.push_back(SourceRange(start, position-start));
-                        break;
+                        if (end < position)
+                        {
+                            expressionPath.push_back(SourceRange(start, end - start));
+                        }
+                        else {
+                            expressionPath.push_back(SourceRange(start, position-start));
+                            break;
+                        }
                     }
-                }
+                } while (ts_tree_cursor_goto_next_sibling(&cursor));
             }
+            ts_tree_cursor_delete(&cursor);
 
             return CursorContext(context,expressionPath);
         }
@@ -278,27 +307,26 @@ void ParsedDocument::treePath(LanguageParser::AST *ast, int position, std::vecto
     TSTree* tree = reinterpret_cast<TSTree*>(ast);
     TSNode root_node = ts_tree_root_node(tree);
 
-    TSNode current = root_node;
-    bool found = true;
-    while (found)
+    uint32_t offset = static_cast<uint32_t>(position);
+
+    // Descend to the first child that contains the position (start <= position <= end). Children are
+    // sorted, so the first child ending at or after position is the only candidate.
+    TSTreeCursor cursor = ts_tree_cursor_new(root_node);
+    while (true)
     {
-        auto count = ts_node_child_count(current);
-        found = false;
-        for (int idx = 0; idx < count; ++idx)
-        {
-            TSNode child = ts_node_child(current, idx);
-            auto start = ts_node_start_byte(child);
-            auto end = ts_node_end_byte(child);
+        int64_t index = offset > 0
+            ? ts_tree_cursor_goto_first_child_for_byte(&cursor, offset - 1)
+            : (ts_tree_cursor_goto_first_child(&cursor) ? 0 : -1);
+        if (index < 0)
+            break;
 
-            if (start <= position && position <= end)
-            {
-                result.push_back(child);
-                current = child;
-                found = true;
-                break;
-            }
-        }
+        TSNode child = ts_tree_cursor_current_node(&cursor);
+        if (ts_node_start_byte(child) > offset || ts_node_end_byte(child) < offset)
+            break;
+
+        result.push_back(child);
     }
+    ts_tree_cursor_delete(&cursor);
 }
 
 TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node)
@@ -322,57 +350,70 @@ TypeInfo::Ptr ParsedDocument::extractType(const std::string& source, TSNode node
 
 
 
-    auto count = ts_node_child_count(node);
-    for (int i = 0; i < count; i++)
+    TSTreeCursor cursor = ts_tree_cursor_new(node);
+    if (ts_tree_cursor_goto_first_child(&cursor))
     {
-        TSNode cdChild = ts_node_child(node, i);
-
-        if (strcmp(ts_node_type(cdChild), "identifier") == 0)
-        {
-            typeName = slice(source, cdChild);
-        }
-        else if (strcmp(ts_node_type(cdChild), "component_heritage") == 0)
+        do
         {
+            TSNode cdChild = ts_tree_cursor_current_node(&cursor);
 
-            auto start = ts_node_start_byte(ts_node_child(cdChild, 1));
-            auto length = ts_node_end_byte(ts_node_child(cdChild, ts_node_child_count(cdChild)-1)) - start;
-            inherits = source.substr(start, length);
-
-        }
-        else if (strcmp(ts_node_type(cdChild), "component_body") == 0)
-        {
-            auto component_body_count = ts_node_child_count(cdChild);
-            for (int cb = 1; cb < component_body_count-1; ++cb)
+            if (strcmp(ts_node_type(cdChild), "identifier") == 0)
+            {
+                typeName = slice(source, cdChild);
+            }
+            else if (strcmp(ts_node_type(cdChild), "component_heritage") == 0)
             {
-                TSNode component_body_child = ts_node_child(cdChild, cb);
 
-                if (strcmp(ts_node_type(component_body_child), "property_declaration") == 0)
-                {
-                    Utf8 type = slice(source, ts_node_child(component_body_child, 0));
-                    Utf8 name = slice(source, ts_node_child(component_body_child, 1));
-                    properties.push_back(PropertyInfo(name, type));
-                }
-                else if (strcmp(ts_node_type(component_body_child), "typed_function_declaration") == 0 || strcmp(ts_node_type(component_body_child), "event_declaration") == 0)
+                auto start = ts_node_start_byte(ts_node_child(cdChild, 1));
+                auto length = ts_node_end_byte(ts_node_child(cdChild, ts_node_child_count(cdChild)-1)) - start;
+                inherits = source.substr(start, length);
+
+            }
+            else if (strcmp(ts_node_type(cdChild), "component_body") == 0 && ts_tree_cursor_goto_first_child(&cursor))
+            {
+                // braces and separators are skipped by type
+                do
                 {
-                    Utf8 funcName = slice(source, ts_node_child(component_body_child, 1));
-                    FunctionInfo fi(funcName);
+                    TSNode component_body_child = ts_tree_cursor_current_node(&cursor);
 
-                    TSNode formal_type_parameters = ts_node_child(component_body_child, 2);
-                    auto ftpc = ts_node_child_count(formal_type_parameters);
-                    for (int ftpcidx = 1; ftpcidx < ftpc; ftpcidx+=2)
+                    if (strcmp(ts_node_type(component_body_child), "property_declaration") == 0)
                     {
-                        TSNode formal_type_parameter = ts_node_child(formal_type_parameters, ftpcidx);
-                        fi.addParameter(slice(source, ts_node_child(formal_type_parameter, 1)), slice(source, ts_node_child(formal_type_parameter, 0)));
+                        Utf8 type = slice(source, ts_node_child(component_body_child, 0));
+                        Utf8 name = slice(source, ts_node_child(component_body_child, 1));
+                        properties.push_back(PropertyInfo(name, type));
+                    }
+                    else if (strcmp(ts_node_type(component_body_child), "typed_function_declaration") == 0 || strcmp(ts_node_type(component_body_child), "event_declaration") == 0)
+                    {
+                        Utf8 funcName = slice(source, ts_node_child(component_body_child, 1));
+                        FunctionInfo fi(funcName);
+
+                        TSTreeCursor parameterCursor = ts_tree_cursor_new(ts_node_child(component_body_child, 2));
+                        if (ts_tree_cursor_goto_first_child(&parameterCursor))
+                        {
+                            // parameters are at odd positions, between '(', ',' and ')'
+                            int ftpcidx = 0;
+                            do
+                            {
+                                if (ftpcidx++ % 2 == 0)
+                                    continue;
+                                TSNode formal_type_parameter = ts_tree_cursor_current_node(&parameterCursor);
+                                fi.addParameter(slice(source, ts_node_child(formal_type_parameter, 1)), slice(source, ts_node_child(formal_type_parameter, 0)));
+                            } while (ts_tree_cursor_goto_next_sibling(&parameterCursor));
+                        }
+                        ts_tree_cursor_delete(&parameterCursor);
+
+                        if (strcmp(ts_node_type(component_body_child), "typed_function_declaration") == 0)
+                            functions.push_back(fi);
+                        else
+                            events.push_back(fi);
                     }
-                    if (strcmp(ts_node_type(component_body_child), "typed_function_declaration") == 0)
-                        functions.push_back(fi);
-                    else
-                        events.push_back(fi);
-                }
 
+                } while (ts_tree_cursor_goto_next_sibling(&cursor));
+                ts_tree_cursor_goto_parent(&cursor);
             }
-        }
+        } while (ts_tree_cursor_goto_next_sibling(&cursor));
     }
+    ts_tree_cursor_delete(&cursor);
 
     auto result = TypeInfo::create(typeName, inherits, false, isInstance);
     for (auto property: properties)
@@ -395,54 +436,34 @@ DocumentInfo::Ptr ParsedDocument::extractInfo(const std::string &source, Languag
     TSNode root_node = ts_tree_root_node(tree);
 
     DocumentInfo::Ptr result = DocumentInfo::create();
-    auto count = ts_node_child_count(root_node);
-    for (int i = 0; i < count; ++i)
+
+    TSTreeCursor cursor = ts_tree_cursor_new(root_node);
+    if (ts_tree_cursor_goto_first_child(&cursor))
     {
-        TSNode child = ts_node_child(root_node, i);
-        if (strcmp(ts_node_type(child), "import_statement") == 0)
+        do
         {
-            bool rel = false;
-            std::vector<Utf8> segs;
-            Utf8 alias;
-
-            auto import_count = ts_node_child_count(child);
-            int j = 0;
-            while (j < import_count)
+            TSNode child = ts_tree_cursor_current_node(&cursor);
+            if (strcmp(ts_node_type(child), "import_statement") == 0)
             {
-                TSNode import_child = ts_node_child(child, j);
-                if (strcmp(ts_node_type(import_child), ".") == 0)
-                {
-                    rel = true;
-                } else if (strcmp(ts_node_type(import_child), "import_path") == 0) {
-                    auto import_child_count = ts_node_child_count(import_child);
-                    for (int k = 0; k < import_child_count; k+=2)
-                    {
-                        segs.push_back(slice(source, ts_node_child(import_child, k)));
-                    }
-                } else if (strcmp(ts_node_type(import_child), "import_as") == 0) {
-                    alias = slice(source, ts_node_child(import_child, 1));
-                }
-                ++j;
+                result->addImport(extractImport(source, child));
             }
-
-            result->addImport(ImportInfo(segs, alias, rel));
-        }
-        else if (strcmp(ts_node_type(child), "component_declaration") == 0)
-        {
-            TypeInfo::Ptr res = extractType(source, child);
-            result->addType(res);
-        }
-        else if (strcmp(ts_node_type(child), "expression_statement") == 0)
-        {
-
-            if (ts_node_child_count(child) == 1 && strcmp(ts_node_type(ts_node_child(child, 0)), "new_component_expression") == 0)
+            else if (strcmp(ts_node_type(child), "component_declaration") == 0)
             {
-                TypeInfo::Ptr res = extractType(source, ts_node_child(child, 0));
-                if (res != nullptr) result->addType(res);
+                TypeInfo::Ptr res = extractType(source, child);
+                result->addType(res);
             }
-        }
+            else if (strcmp(ts_node_type(child), "expression_statement") == 0)
+            {
 
+                if (ts_node_child_count(child) == 1 && strcmp(ts_node_type(ts_node_child(child, 0)), "new_component_expression") == 0)
+                {
+                    TypeInfo::Ptr res = extractType(source, ts_node_child(child, 0));
+                    if (res != nullptr) result->addType(res);
+                }
+            }
+        } while (ts_tree_cursor_goto_next_sibling(&cursor));
     }
+    ts_tree_cursor_delete(&cursor);
 
     return result;
 }
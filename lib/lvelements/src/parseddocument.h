@@ -10,11 +10,16 @@ namespace lv{ namespace el{
 
 class LV_ELEMENTS_EXPORT ParsedDocument{
 
+public:
+    /** Version of the info returned by extractInfo(), bumped whenever the grammar or the extraction changes */
+    static const int InfoVersion = 1;
+
 public:
     static std::vector<ImportInfo> extractImports(const std::string& source, LanguageParser::AST* ast);
     static DocumentInfo::Ptr extractInfo(const std::string& source, LanguageParser::AST* ast);
     static CursorContext findCursorContext(LanguageParser::AST* ast, int position);
 private:
+    static ImportInfo extractImport(const std::string& source, TSNode node);
     static void treePath(LanguageParser::AST* ast, int position, std::vector<TSNode>& result);
     static TypeInfo::Ptr extractType(const std::string& source, TSNode node);
 
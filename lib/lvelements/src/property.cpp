@@ -3,8 +3,178 @@
 #include "live/elements/element.h"
 #include "v8nowarnings.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace lv{ namespace el{
 
+namespace{
+
+/// \private
+class PropertyKeyRegistry{
+public:
+    PropertyKeyRegistry() : size(0){}
+
+    std::mutex                                            mutex;
+    std::unordered_map<std::string, PropertyKey::Id>      ids;
+    std::atomic<size_t>                                   size;
+
+    static PropertyKeyRegistry& instance(){
+        static PropertyKeyRegistry registry;
+        return registry;
+    }
+};
+
+} // namespace
+
+/**
+ * \class lv::el::PropertyKey
+ * \brief Property name with an id, used for fast property lookups
+ *
+ * MetaObjects declare an id for each of their property names once, so keys compare by id, and MetaObjects can look
+ * up their properties by id instead of comparing strings. Only names of type properties get an id, so the number of
+ * ids is bounded by the declared types. Keys for any other name, like instance properties, have the id NoId, and
+ * are compared and looked up by name.
+ *
+ * A key also caches the properties it was resolved to, together with the type of the element each was resolved on,
+ * so lookups with the same key on elements of the same type are resolved without a search:
+ *
+ * \code
+ * static PropertyKey valueKey("value");
+ * element->set(valueKey, ScopedValue(engine, 20));
+ * \endcode
+ *
+ * Cache entries are immutable once published, and new ones are prepended atomically, so a key can be shared
+ * between engines running on different threads.
+ */
+
+const PropertyKey::Id PropertyKey::NoId;
+
+/**
+ * \brief Creates the key for \p name
+ */
+PropertyKey::PropertyKey(const std::string &name)
+    : m_name(name)
+    , m_id(NoId)
+    , m_lookupSize(static_cast<size_t>(-1))
+    , m_cache(nullptr)
+{
+}
+
+/**
+ * \brief Creates the key for \p name
+ */
+PropertyKey::PropertyKey(const char *name)
+    : m_name(name)
+    , m_id(NoId)
+    , m_lookupSize(static_cast<size_t>(-1))
+    , m_cache(nullptr)
+{
+}
+
+/**
+ * \brief Copies the name of \p other, the cache is not copied
+ */
+PropertyKey::PropertyKey(const PropertyKey &other)
+    : m_name(other.m_name)
+    , m_id(other.m_id.load())
+    , m_lookupSize(other.m_lookupSize.load())
+    , m_cache(nullptr)
+{
+}
+
+/**
+ * \brief Destructor
+ */
+PropertyKey::~PropertyKey(){
+    clearCache();
+}
+
+/**
+ * \brief Assigns the name of \p other, clearing the cache
+ */
+PropertyKey &PropertyKey::operator =(const PropertyKey &other){
+    if ( this != &other ){
+        clearCache();
+        m_name = other.m_name;
+        m_id = other.m_id.load();
+        m_lookupSize = other.m_lookupSize.load();
+    }
+    return *this;
+}
+
+/**
+ * \brief Returns the id of this key, or NoId if no type has a property with this name
+ *
+ * Types declare their names when their MetaObject is created, which can happen after the key was created, so the
+ * id is looked up again whenever new names were declared since the last lookup.
+ */
+PropertyKey::Id PropertyKey::id() const{
+    Id id = m_id.load(std::memory_order_acquire);
+    if ( id != NoId )
+        return id;
+
+    PropertyKeyRegistry& registry = PropertyKeyRegistry::instance();
+    if ( m_lookupSize.load(std::memory_order_relaxed) == registry.size.load(std::memory_order_acquire) )
+        return NoId;
+
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    auto it = registry.ids.find(m_name);
+    if ( it != registry.ids.end() )
+        m_id.store(it->second, std::memory_order_release);
+    m_lookupSize.store(registry.ids.size(), std::memory_order_relaxed);
+    return it != registry.ids.end() ? it->second : NoId;
+}
+
+/**
+ * \brief Checks wether this key and \p other have the same name
+ */
+bool PropertyKey::operator ==(const PropertyKey &other) const{
+    Id thisId = id();
+    if ( thisId != NoId )
+        return thisId == other.id();
+    return m_name == other.m_name;
+}
+
+PropertyKey::Id PropertyKey::declare(const std::string &name){
+    PropertyKeyRegistry& registry = PropertyKeyRegistry::instance();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+
+    auto it = registry.ids.find(name);
+    if ( it != registry.ids.end() )
+        return it->second;
+
+    Id id = registry.ids.size();
+    registry.ids[name] = id;
+    registry.size.store(registry.ids.size(), std::memory_order_release);
+    return id;
+}
+
+void PropertyKey::clearCache(){
+    CacheEntry* entry = m_cache.exchange(nullptr);
+    while ( entry ){
+        CacheEntry* next = entry->next;
+        delete entry;
+        entry = next;
+    }
+}
+
+Property *PropertyKey::cachedProperty(const MetaObject *mo) const{
+    for ( CacheEntry* entry = m_cache.load(std::memory_order_acquire); entry; entry = entry->next ){
+        if ( entry->metaObject == mo )
+            return entry->property;
+    }
+    return nullptr;
+}
+
+void PropertyKey::cacheProperty(const MetaObject *mo, Property *property) const{
+    CacheEntry* entry = new CacheEntry;
+    entry->metaObject = mo;
+    entry->property   = property;
+    entry->next       = m_cache.load(std::memory_order_relaxed);
+    while ( !m_cache.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed) ){}
+}
+
 Property::Property(
         const std::string &name,
         const std::string &type,
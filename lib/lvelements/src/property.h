@@ -4,8 +4,63 @@
 #include "live/elements/lvelementsglobal.h"
 #include "live/elements/function.h"
 
+#include <atomic>
+
 namespace lv{ namespace el{
 
+class MetaObject;
+class Property;
+
+class LV_ELEMENTS_EXPORT PropertyKey{
+
+public:
+    friend class Element;
+    friend class MetaObject;
+
+    typedef size_t Id;
+
+    /** Id of keys whose name is not a property of any type */
+    static const Id NoId = static_cast<Id>(-1);
+
+public:
+    explicit PropertyKey(const std::string& name);
+    explicit PropertyKey(const char* name);
+    PropertyKey(const PropertyKey& other);
+    ~PropertyKey();
+
+    PropertyKey& operator = (const PropertyKey& other);
+
+    const std::string& name() const{ return m_name; }
+    Id id() const;
+
+    bool operator == (const PropertyKey& other) const;
+    bool operator != (const PropertyKey& other) const{ return !(*this == other); }
+
+private:
+    /// \private
+    class CacheEntry{
+    public:
+        const MetaObject* metaObject;
+        Property*         property;
+        CacheEntry*       next;
+    };
+
+    static Id declare(const std::string& name);
+
+    void clearCache();
+    Property* cachedProperty(const MetaObject* mo) const;
+    void cacheProperty(const MetaObject* mo, Property* property) const;
+
+    std::string m_name;
+
+    // id of the name once declared, and the number of declared names when it was last looked up
+    mutable std::atomic<Id>     m_id;
+    mutable std::atomic<size_t> m_lookupSize;
+
+    // inline cache, one entry for each type this key was resolved on
+    mutable std::atomic<CacheEntry*> m_cache;
+};
+
 class LV_ELEMENTS_EXPORT Property{
 
 public:
@@ -83,7 +83,7 @@ ScopedValue::ScopedValue(Engine *, Object val)
 }
 
 ScopedValue::ScopedValue(Engine *engine, const Buffer &val)
-    : m_d(new LocalValuePrivate(v8::ArrayBuffer::New(engine->isolate(), val.data(), val.size())))
+    : m_d(new LocalValuePrivate(val.toArrayBuffer(engine)))
     , m_ref(new int)
 {
     ++(*m_ref);
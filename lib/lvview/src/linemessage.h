@@ -3,6 +3,8 @@
 
 #include <QByteArray>
 #include "lvviewglobal.h"
+#include "live/mlnodetojson.h"
+#include "live/mlnodetobinary.h"
 
 namespace lv{
 
@@ -12,6 +14,7 @@ public:
     enum Type{
         Raw  = 1,
         Json = 2,
+        Binary = 4,
         Error = 8,
         Build = 16,
         Input = 32
@@ -23,6 +26,9 @@ public:
     static QByteArray create(int type, const QByteArray& ba, int id = 0);
     static QByteArray create(int type, const char* ba, int len, int id = 0);
 
+    static QByteArray serialize(const MLNode& n, int format);
+    static void deserialize(const QByteArray& data, int type, MLNode& n);
+
     QByteArray data;
     int        type;
     int        id;
@@ -42,6 +48,28 @@ inline QByteArray LineMessage::create(int type, const char *ba, int len, int id)
     return create(type, QByteArray::fromRawData(ba, len), id);
 }
 
+/**
+ * \brief Serializes \p n in the given \p format, which is either LineMessage::Json or LineMessage::Binary
+ */
+inline QByteArray LineMessage::serialize(const MLNode &n, int format){
+    std::string result;
+    if ( format & LineMessage::Binary )
+        ml::toBinary(n, result);
+    else
+        ml::toJson(n, result);
+    return QByteArray(result.c_str(), static_cast<int>(result.size()));
+}
+
+/**
+ * \brief Deserializes \p data into \p n, depending on the format flag found in the message \p type
+ */
+inline void LineMessage::deserialize(const QByteArray &data, int type, MLNode &n){
+    if ( type & LineMessage::Binary )
+        ml::fromBinary(data.constData(), static_cast<size_t>(data.size()), n);
+    else
+        ml::fromJson(data.constData(), n);
+}
+
 }// namespace
 
 #endif // LINEMESSAGE_H
@@ -20,6 +20,7 @@
 #include "live/incubationcontroller.h"
 #include "live/packagegraph.h"
 #include "live/applicationcontext.h"
+#include "live/trace.h"
 
 #include "qmlcontainer.h"
 #include "qmlact.h"
@@ -444,6 +445,8 @@ QObject* ViewEngine::createObject(const QString &qmlCode, QObject *parent, const
  * \brief Creates an object from the given qmlcode synchronously
  */
 QObject *ViewEngine::createObject(const QByteArray &qmlCode, QObject *parent, const QUrl &file, bool clearCache){
+    vtrace("lvview", "ViewEngine::createObject", file.toString().toStdString());
+
     QMutexLocker engineMutexLock(m_engineMutex);
 
     if ( clearCache )
@@ -550,6 +553,8 @@ ViewEngine::ComponentResult::Ptr ViewEngine::createPluginObject(const QString &f
 }
 
 ViewEngine::ComponentResult::Ptr ViewEngine::createObject(const QString &filePath, QObject *parent){
+    vtrace("lvview", "ViewEngine::createObject", filePath.toStdString());
+
     QFile f(filePath);
     if ( !f.open(QFile::ReadOnly) ){
         ViewEngine::ComponentResult::Ptr result = ViewEngine::ComponentResult::create();
@@ -1,6 +1,8 @@
 #include "documenttree.h"
 #include <QDebug>
 
+#include <stdlib.h>
+
 namespace lv { namespace el {
 
 el::LanguageParser::AST *DocumentTree::ast() const
@@ -20,14 +22,50 @@ ProjectDocument *DocumentTree::document() const
 
 void DocumentTree::parse()
 {
+    el::LanguageParser::AST* previous = m_ast;
 
     auto content = m_document->contentString().toStdString();
     m_ast = m_parser->parse(content);
+
+    m_parser->destroy(previous);
+    setChangedRange(nullptr);
 }
 
 void DocumentTree::editParseTree(TSInputEdit edit, TSInput input)
 {
+    el::LanguageParser::AST* previous = m_ast;
     m_parser->editParseTree(m_ast, edit, input);
+
+    setChangedRange(previous);
+    m_parser->destroy(previous);
+}
+
+const std::vector<TSRange> &DocumentTree::changedRanges() const
+{
+    return m_changedRanges;
+}
+
+void DocumentTree::setChangedRange(LanguageParser::AST *previous)
+{
+    m_changedRanges.clear();
+    if ( !m_ast )
+        return;
+
+    TSTree* tree = reinterpret_cast<TSTree*>(m_ast);
+
+    // without a previous tree, the whole document is considered changed
+    if ( !previous ){
+        TSNode root = ts_tree_root_node(tree);
+        m_changedRanges.push_back(TSRange{
+            ts_node_start_point(root), ts_node_end_point(root), ts_node_start_byte(root), ts_node_end_byte(root)
+        });
+        return;
+    }
+
+    uint32_t totalRanges = 0;
+    TSRange* ranges = ts_tree_get_changed_ranges(reinterpret_cast<TSTree*>(previous), tree, &totalRanges);
+    m_changedRanges.assign(ranges, ranges + totalRanges);
+    free(ranges);
 }
 
 QString DocumentTree::slice(SourceRange r)
@@ -43,5 +81,10 @@ lv::el::DocumentTree::DocumentTree(lv::ProjectDocument *doc)
 
 }
 
+DocumentTree::~DocumentTree()
+{
+    m_parser->destroy(m_ast);
+}
+
 } // namespace el
 } // namespace lv
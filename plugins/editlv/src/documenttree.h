@@ -10,7 +10,7 @@ class DocumentTree
 {
 public:
     DocumentTree(ProjectDocument* doc);
-
+    ~DocumentTree();
 
     el::LanguageParser::AST *ast() const;
 
@@ -21,10 +21,15 @@ public:
     void parse();
     void editParseTree(TSInputEdit, TSInput);
     QString slice(SourceRange r);
+
+    const std::vector<TSRange>& changedRanges() const;
 private:
+    void setChangedRange(el::LanguageParser::AST* previous);
+
     el::LanguageParser::Ptr         m_parser;
     el::LanguageParser::AST*        m_ast;
     ProjectDocument*                m_document;
+    std::vector<TSRange>            m_changedRanges;
 };
 
 } // namespace el
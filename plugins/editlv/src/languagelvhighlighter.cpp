@@ -4,7 +4,9 @@
 #include "live/visuallog.h"
 #include "live/elements/parseddocument.h"
 
-#include <math.h>
+#include <QTimer>
+
+#include <algorithm>
 
 namespace lv{
 
@@ -14,6 +16,7 @@ LanguageLvHighlighter::LanguageLvHighlighter(EditLvSettings *settings, DocumentH
     , m_settings(settings)
     , m_documentTree(tree)
     , m_textDocumentData(new TextDocumentData)
+    , m_isRehighlightScheduled(false)
 {
     // capture index to formats
 
@@ -157,48 +160,22 @@ LanguageLvHighlighter::~LanguageLvHighlighter(){
 }
 
 bool LanguageLvHighlighter::predicateEq(const std::vector<el::LanguageQuery::PredicateData> &args, void *payload){
-    QTextDocument* doc = reinterpret_cast<QTextDocument*>(payload);
+    TextDocumentData* data = reinterpret_cast<TextDocumentData*>(payload);
     if ( args.size() != 2 )
         THROW_EXCEPTION(lv::Exception, "Predicate eq? requires 2 arguments.", Exception::toCode("~Arguments"));
 
-    QString compare1;
-    QString compare2;
-    if ( args[0].m_range.isValid() ){
-        compare1 = slice(doc, args[0].m_range.from() / sizeof(ushort), (args[0].m_range.from() + args[0].m_range.length()) / sizeof(ushort));
-    } else {
-        compare1 = QString::fromStdString(args[0].m_value.data());
-    }
-    if ( args[1].m_range.isValid() ){
-        compare2 = slice(doc, args[1].m_range.from() / sizeof(ushort), (args[1].m_range.from() + args[1].m_range.length())  / sizeof(ushort));
-    } else {
-        compare2 = QString::fromStdString(args[1].m_value.data());
-    }
-
-    return compare1 == compare2;
+    return argumentsEqual(data, args[0], args[1]);
 }
 
 bool LanguageLvHighlighter::predicateEqOr(const std::vector<el::LanguageQuery::PredicateData> &args, void *payload){
-    QTextDocument* doc = reinterpret_cast<QTextDocument*>(payload);
+    TextDocumentData* data = reinterpret_cast<TextDocumentData*>(payload);
     if ( args.size() < 2)
         THROW_EXCEPTION(lv::Exception, "Predicate eq-or? must have at least 2 arguments", Exception::toCode("~Arguments"));
 
-    QString compare1;
-    QString compare2;
-    if ( args[0].m_range.isValid() ){
-        compare1 = slice(doc, args[0].m_range.from() / sizeof(ushort), (args[0].m_range.from() + args[0].m_range.length()) / sizeof(ushort));
-    } else {
-        compare1 = QString::fromStdString(args[0].m_value.data());
-    }
-
-    for (int i = 1; i < args.size(); ++i)
+    for (size_t i = 1; i < args.size(); ++i)
     {
-        if ( args[i].m_range.isValid() ){
-            compare2 = slice(doc, args[i].m_range.from() / sizeof(ushort), (args[i].m_range.from() + args[i].m_range.length())  / sizeof(ushort));
-        } else {
-            compare2 = QString::fromStdString(args[i].m_value.data());
-        }
-
-        if (compare1 == compare2) return true;
+        if ( argumentsEqual(data, args[0], args[i]) )
+            return true;
     }
 
     return false;
@@ -243,6 +220,57 @@ void LanguageLvHighlighter::documentChanged(int pos, int removed, int added){
     TSInput input = {m_textDocumentData, LanguageLvHighlighter::parsingCallback, TSInputEncodingUTF16};
 
     m_documentTree->editParseTree(edit, input);
+
+    // cached blocks after the edit shift along with it, while edited blocks are highlighted again
+    int startRow  = static_cast<int>(editPoints[0].first);
+    int oldEndRow = static_cast<int>(editPoints[1].first);
+    int newEndRow = static_cast<int>(editPoints[2].first);
+
+    if ( static_cast<int>(m_blockHighlights.size()) > oldEndRow ){
+        m_blockHighlights.erase(m_blockHighlights.begin() + startRow, m_blockHighlights.begin() + oldEndRow + 1);
+        m_blockHighlights.insert(m_blockHighlights.begin() + startRow, newEndRow - startRow + 1, BlockHighlight());
+    } else {
+        m_blockHighlights.clear();
+    }
+
+    if ( !m_documentTree->ast() )
+        return;
+
+    // blocks whose syntax changed outside the edit, including the full extent of the nodes highlighted within them,
+    // are highlighted again after the edit
+    const std::vector<TSRange>& changedRanges = m_documentTree->changedRanges();
+    for ( auto it = changedRanges.begin(); it != changedRanges.end(); ++it ){
+        int fromRow = static_cast<int>(it->start_point.row);
+        int toRow   = static_cast<int>(it->end_point.row);
+
+        el::LanguageQuery::Cursor::Ptr cursor = m_languageQuery->exec(m_documentTree->ast(), it->start_byte, it->end_byte);
+        while ( cursor->nextMatch() ){
+            uint16_t captures = cursor->totalMatchCaptures();
+            for ( uint16_t captureIndex = 0; captureIndex < captures; ++captureIndex ){
+                el::SourceRange range = cursor->captureRange(captureIndex);
+                int from = static_cast<int>(range.from() / sizeof(ushort));
+                int to   = static_cast<int>((range.from() + range.length()) / sizeof(ushort));
+                QTextBlock fromBlock = doc->findBlock(from);
+                QTextBlock toBlock   = doc->findBlock(to);
+                if ( fromBlock.isValid() )
+                    fromRow = std::min(fromRow, fromBlock.blockNumber());
+                if ( toBlock.isValid() )
+                    toRow = std::max(toRow, toBlock.blockNumber());
+            }
+        }
+
+        invalidateBlocks(fromRow, toRow);
+
+        if ( fromRow < startRow )
+            m_invalidBlocks.push_back(std::make_pair(fromRow, std::min(toRow, startRow - 1)));
+        if ( toRow > newEndRow )
+            m_invalidBlocks.push_back(std::make_pair(std::max(fromRow, newEndRow + 1), toRow));
+    }
+
+    if ( !m_invalidBlocks.empty() && !m_isRehighlightScheduled ){
+        m_isRehighlightScheduled = true;
+        QTimer::singleShot(0, this, [this](){ rehighlightInvalidBlocks(); });
+    }
 }
 
 QList<SyntaxHighlighter::TextFormatRange> LanguageLvHighlighter::highlight(
@@ -254,87 +282,236 @@ QList<SyntaxHighlighter::TextFormatRange> LanguageLvHighlighter::highlight(
     if ( !m_documentTree->ast() )
         return ranges;
 
-    el::LanguageQuery::Cursor::Ptr cursor = m_languageQuery->exec(m_documentTree->ast(), position * sizeof(ushort), (position + text.length())* sizeof(ushort));
-    while ( cursor->nextMatch() ){
-        uint16_t captures = cursor->totalMatchCaptures();
+    if ( static_cast<int>(m_blockHighlights.size()) != doc->blockCount() ){
+        m_blockHighlights.clear();
+        m_blockHighlights.resize(static_cast<size_t>(doc->blockCount()));
+    }
 
-        if ( m_languageQuery->predicateMatch(cursor, doc) ){
-            for ( uint16_t captureIndex = 0; captureIndex < captures; ++captureIndex ){
-                uint32_t captureId = cursor->captureId(captureIndex);
+    QTextBlock first = doc->findBlock(position);
+    QTextBlock last  = doc->findBlock(position + text.length());
+    if ( !first.isValid() )
+        return ranges;
+    if ( !last.isValid() )
+        last = doc->lastBlock();
+
+    // each run of blocks that are not cached is queried once
+    for ( QTextBlock block = first; block.isValid() && block.blockNumber() <= last.blockNumber(); block = block.next() ){
+        if ( m_blockHighlights[block.blockNumber()].isValid )
+            continue;
+
+        QTextBlock runLast = block;
+        while ( runLast.next().isValid() &&
+                runLast.next().blockNumber() <= last.blockNumber() &&
+                !m_blockHighlights[runLast.next().blockNumber()].isValid )
+        {
+            runLast = runLast.next();
+        }
+
+        highlightBlocks(block, runLast);
+        block = runLast;
+    }
+
+    for ( QTextBlock block = first; block.isValid() && block.blockNumber() <= last.blockNumber(); block = block.next() ){
+        const QList<TextFormatRange>& blockRanges = m_blockHighlights[block.blockNumber()].ranges;
+        for ( TextFormatRange r : blockRanges ){
+            r.start += block.position();
+            ranges.append(r);
+        }
+    }
+
+    return ranges;
+}
+
+void LanguageLvHighlighter::highlightBlocks(const QTextBlock &first, const QTextBlock &last){
+    QTextDocument* doc = static_cast<QTextDocument*>(parent());
+
+    for ( int i = first.blockNumber(); i <= last.blockNumber(); ++i ){
+        m_blockHighlights[i].isValid = true;
+        m_blockHighlights[i].ranges.clear();
+    }
+
+    int runStart = first.position();
+    int runEnd   = last.position() + last.length() - 1;
 
-                el::SourceRange range = cursor->captureRange(0);
-                int from = static_cast<int>(range.from()) / sizeof(ushort);
-                int length = static_cast<int>(range.length()) / sizeof(ushort);
+    el::LanguageQuery::Cursor::Ptr cursor = m_languageQuery->exec(
+        m_documentTree->ast(), static_cast<uint32_t>(runStart * sizeof(ushort)), static_cast<uint32_t>(runEnd * sizeof(ushort))
+    );
+    while ( cursor->nextMatch() ){
+        if ( !m_languageQuery->predicateMatch(cursor, m_textDocumentData) )
+            continue;
+
+        uint16_t captures = cursor->totalMatchCaptures();
+        for ( uint16_t captureIndex = 0; captureIndex < captures; ++captureIndex ){
+            uint32_t captureId = cursor->captureId(captureIndex);
+
+            el::SourceRange range = cursor->captureRange(captureIndex);
+            int from = static_cast<int>(range.from() / sizeof(ushort));
+            int to   = static_cast<int>((range.from() + range.length()) / sizeof(ushort));
+
+            auto name = m_languageQuery->captureName(captureId);
+            int userstate = 0;
+            if ( name == "string" )
+                userstate = 2;
+            else if ( name == "comment" )
+                userstate = 1;
+
+            // captures spanning multiple blocks are split, each block following the state of the capture until
+            // its last block
+            QTextBlock block = from < runStart ? first : doc->findBlock(from);
+            while ( block.isValid() && block.blockNumber() <= last.blockNumber() && block.position() <= to ){
+                int blockEnd = block.position() + block.length() - 1;
 
                 TextFormatRange r;
-                r.start = fmax(from, position);
-                r.length = fmin(from + length, position + text.length()) - r.start;
-                r.userstate = 0;
-                auto name = m_languageQuery->captureName(captureId);
-
-                if (name == "string")
-                {
-                    r.userstate = 2;
-                    if (r.start + r.length == from + length) r.userstateFollows = 0;
-                    else r.userstateFollows = 2;
+                r.start = std::max(from, block.position());
+                r.length = std::min(to, blockEnd) - r.start;
+                if ( r.length >= 0 ){
+                    r.userstate = userstate;
+                    r.userstateFollows = to > blockEnd ? userstate : 0;
+                    r.format = m_captureToFormatMap[captureId];
+                    r.start -= block.position();
+                    m_blockHighlights[block.blockNumber()].ranges.append(r);
                 }
-                else if (name == "comment")
-                {
-                    r.userstate = 1;
-                    if (r.start + r.length == from + length) r.userstateFollows = 0;
-                    else r.userstateFollows = 1;
-                } else {
-                    r.userstate = 0;
-                    r.userstateFollows = 0;
-                }
-                r.format = m_captureToFormatMap[captureId];
 
-                ranges.append(r);
+                if ( to <= blockEnd )
+                    break;
+                block = block.next();
             }
         }
     }
 
-    if (ranges.empty())
-    {
-        TextFormatRange r;
-        r.start = position;
-        r.length = text.length();
-        r.userstate = 0;
-        r.userstateFollows = 0;
-        r.format = m_captureToFormatMap[UINT_MAX]; // regular text
-
-        ranges.append(r);
+    for ( QTextBlock block = first; block.isValid() && block.blockNumber() <= last.blockNumber(); block = block.next() ){
+        BlockHighlight& bh = m_blockHighlights[block.blockNumber()];
+        if ( bh.ranges.empty() ){
+            TextFormatRange r;
+            r.start = 0;
+            r.length = block.length() - 1;
+            r.userstate = 0;
+            r.userstateFollows = 0;
+            r.format = m_captureToFormatMap[UINT_MAX]; // regular text
+
+            bh.ranges.append(r);
+        }
     }
+}
 
+void LanguageLvHighlighter::invalidateBlocks(int from, int to){
+    int total = static_cast<int>(m_blockHighlights.size());
+    for ( int i = std::max(from, 0); i <= to && i < total; ++i ){
+        m_blockHighlights[i].isValid = false;
+    }
+}
 
-    return ranges;
+void LanguageLvHighlighter::rehighlightInvalidBlocks(){
+    m_isRehighlightScheduled = false;
+
+    QTextDocument* doc = static_cast<QTextDocument*>(parent());
+    if ( !doc )
+        return;
+
+    std::vector<std::pair<int, int> > invalidBlocks;
+    invalidBlocks.swap(m_invalidBlocks);
+
+    for ( auto it = invalidBlocks.begin(); it != invalidBlocks.end(); ++it ){
+        QTextBlock first = doc->findBlockByNumber(it->first);
+        QTextBlock last  = doc->findBlockByNumber(it->second);
+        if ( !first.isValid() )
+            continue;
+        if ( !last.isValid() )
+            last = doc->lastBlock();
+
+        rehighlightBlocks(first, last);
+    }
 }
 
 QList<SyntaxHighlighter::TextFormatRange> LanguageLvHighlighter::highlightSections(const QList<ProjectDocumentSection::Ptr> &){
     return QList<SyntaxHighlighter::TextFormatRange>();
 }
 
-QString LanguageLvHighlighter::slice(QTextDocument *doc, int from, int to)
+bool LanguageLvHighlighter::argumentsEqual(
+        TextDocumentData *data,
+        const el::LanguageQuery::PredicateData &arg1,
+        const el::LanguageQuery::PredicateData &arg2)
+{
+    if ( !arg1.m_range.isValid() && !arg2.m_range.isValid() )
+        return arg1.m_value == arg2.m_value;
+    if ( !arg1.m_range.isValid() )
+        return argumentEquals(data, arg2, arg1.m_value.data());
+    if ( !arg2.m_range.isValid() )
+        return argumentEquals(data, arg1, arg2.m_value.data());
+
+    std::u16string buffer1, buffer2;
+    const char16_t* text1 = nullptr;
+    const char16_t* text2 = nullptr;
+    size_t length1 = 0, length2 = 0;
+
+    argumentText(data, arg1, text1, length1, buffer1);
+    argumentText(data, arg2, text2, length2, buffer2);
+
+    return length1 == length2 && std::equal(text1, text1 + length1, text2);
+}
+
+bool LanguageLvHighlighter::argumentEquals(
+        TextDocumentData *data, const el::LanguageQuery::PredicateData &arg, const std::string &value)
+{
+    std::u16string buffer;
+    const char16_t* text = nullptr;
+    size_t length = 0;
+    argumentText(data, arg, text, length, buffer);
+    return textEquals(text, length, value);
+}
+
+void LanguageLvHighlighter::argumentText(
+        TextDocumentData *data,
+        const el::LanguageQuery::PredicateData &arg,
+        const char16_t *&text,
+        size_t &length,
+        std::u16string &buffer)
 {
-    QTextBlock block = doc->findBlock(from);
-    QTextBlock last = doc->findBlock(to);
+    length = arg.m_range.length() / sizeof(ushort);
+
+    size_t row = arg.m_row;
+    size_t column = arg.m_column / sizeof(ushort);
+    if ( row >= data->size() ){
+        text = buffer.data();
+        length = 0;
+        return;
+    }
 
-    if (block == last) return block.text().mid(from - block.position(), to - from);
+    // captures within a single row point directly into the document rows
+    const std::u16string& rowText = data->rowAt(static_cast<unsigned>(row));
+    if ( column + length <= rowText.size() ){
+        text = rowText.data() + column;
+        return;
+    }
 
-    QString text = block.text();
-    QString result = text.right(block.position() + text.length() - from) + "\n";
-    block = block.next();
+    buffer = rowText.substr(std::min(column, rowText.size()));
+    while ( buffer.size() < length && ++row < data->size() ){
+        buffer += u'\n';
+        buffer += data->rowAt(static_cast<unsigned>(row));
+    }
+    if ( buffer.size() > length )
+        buffer.resize(length);
 
-    while (block != last)
-    {
-        result += block.text() + "\n";
-        block = block.next();
+    text = buffer.data();
+    length = buffer.size();
+}
+
+bool LanguageLvHighlighter::textEquals(const char16_t *text, size_t length, const std::string &value){
+    for ( size_t i = 0; i < value.size(); ++i ){
+        if ( static_cast<unsigned char>(value[i]) >= 0x80 ){
+            return QString::fromRawData(reinterpret_cast<const QChar*>(text), static_cast<int>(length)) ==
+                   QString::fromUtf8(value.c_str(), static_cast<int>(value.size()));
+        }
     }
 
-    text = last.text();
-    result += text.left(to - last.position());
+    if ( value.size() != length )
+        return false;
 
-    return result;
+    for ( size_t i = 0; i < length; ++i ){
+        if ( text[i] != static_cast<char16_t>(value[i]) )
+            return false;
+    }
+    return true;
 }
 
 }// namespace
@@ -2,6 +2,7 @@
 #define LANGUAGELVHIGHLIGHTER_H
 
 #include <QTextDocument>
+#include <QTextBlock>
 
 #include "editlvsettings.h"
 #include "live/documenthandler.h"
@@ -22,6 +23,8 @@ public:
 
     void setTarget(QTextDocument* target);
 
+    bool isBlockCached(int blockNumber) const;
+
     static bool predicateEq(const std::vector<el::LanguageQuery::PredicateData>& args, void* payload);
     static bool predicateEqOr(const std::vector<el::LanguageQuery::PredicateData>& args, void* payload);
     static const char *parsingCallback(void *payload, uint32_t, TSPoint position, uint32_t *bytes_read);
@@ -31,7 +34,33 @@ protected:
     QList<TextFormatRange> highlightSections(const QList<ProjectDocumentSection::Ptr>&) override;
 
 private:
-    static QString slice(QTextDocument* doc, int from, int to);
+    /// \private
+    class BlockHighlight{
+    public:
+        BlockHighlight() : isValid(false){}
+
+        bool                   isValid;
+        QList<TextFormatRange> ranges; // relative to the block position
+    };
+
+    static bool argumentsEqual(
+        TextDocumentData* data,
+        const el::LanguageQuery::PredicateData& arg1,
+        const el::LanguageQuery::PredicateData& arg2
+    );
+    static bool argumentEquals(TextDocumentData* data, const el::LanguageQuery::PredicateData& arg, const std::string& value);
+    static void argumentText(
+        TextDocumentData* data,
+        const el::LanguageQuery::PredicateData& arg,
+        const char16_t*& text,
+        size_t& length,
+        std::u16string& buffer
+    );
+    static bool textEquals(const char16_t* text, size_t length, const std::string& value);
+
+    void highlightBlocks(const QTextBlock& first, const QTextBlock& last);
+    void invalidateBlocks(int from, int to);
+    void rehighlightInvalidBlocks();
 
     el::LanguageQuery::Ptr   m_languageQuery;
     EditLvSettings*          m_settings;
@@ -39,6 +68,10 @@ private:
     TextDocumentData*        m_textDocumentData;
 
     QMap<uint32_t, QTextCharFormat> m_captureToFormatMap;
+
+    std::vector<BlockHighlight>       m_blockHighlights;
+    std::vector<std::pair<int, int> > m_invalidBlocks;
+    bool                              m_isRehighlightScheduled;
 };
 
 
@@ -46,6 +79,12 @@ inline void LanguageLvHighlighter::setTarget(QTextDocument *target){
     setDocument(target);
 }
 
+inline bool LanguageLvHighlighter::isBlockCached(int blockNumber) const{
+    return blockNumber >= 0 &&
+           blockNumber < static_cast<int>(m_blockHighlights.size()) &&
+           m_blockHighlights[static_cast<size_t>(blockNumber)].isValid;
+}
+
 }// namespace
 
 #endif // LANGUAGELVHIGHLIGHTER_H
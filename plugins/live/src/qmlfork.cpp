@@ -46,10 +46,7 @@ void QmlFork::sendError(const QByteArray &type, int code, const QString &message
         {"type", type.toStdString()}
     };
 
-    std::string errorSerialized;
-    ml::toJson(errorObject, errorSerialized);
-
-    m_writeSocket->write(errorSerialized.c_str(), LineMessage::Error | LineMessage::Json);
+    m_writeSocket->write(LineMessage::serialize(errorObject, messageFormat()), LineMessage::Error | messageFormat());
 }
 
 void QmlFork::sendBuild(const QByteArray &buildData){
@@ -58,10 +55,7 @@ void QmlFork::sendBuild(const QByteArray &buildData){
 }
 
 void QmlFork::sendInput(const MLNode &input){
-    std::string inputSerialized;
-    ml::toJson(input, inputSerialized);
-
-    m_writeSocket->write(inputSerialized.c_str(), LineMessage::Input | LineMessage::Json);
+    m_writeSocket->write(LineMessage::serialize(input, messageFormat()), LineMessage::Input | messageFormat());
 }
 
 void QmlFork::onMessage(std::function<void (const LineMessage &, void *)> handler, void *handlerData){
@@ -27,6 +27,7 @@ QmlForkNode::QmlForkNode(QObject *parent)
     , m_component()
     , m_componentContext(nullptr)
     , m_sourceItem(nullptr)
+    , m_messageFormat(LineMessage::Json)
 {
     m_response->onResponse([this](const QString& propertyName, const QVariant& value){
         responseValueChanged(propertyName, value);
@@ -57,10 +58,7 @@ void QmlForkNode::responseValueChanged(const QString &key, const QVariant &value
 
     n[key.toStdString()] = result;
 
-    std::string responseSerialized;
-    ml::toJson(n, responseSerialized);
-
-    m_writeSocket->write(QByteArray(responseSerialized.c_str(), (int)responseSerialized.size()), LineMessage::Input | LineMessage::Json);
+    m_writeSocket->write(LineMessage::serialize(n, m_messageFormat), LineMessage::Input | m_messageFormat);
 }
 
 void QmlForkNode::sendError(const QByteArray &type, Exception::Code code, const QString &message){
@@ -70,10 +68,7 @@ void QmlForkNode::sendError(const QByteArray &type, Exception::Code code, const
         {"type", type.toStdString()}
     };
 
-    std::string errorSerialized;
-    ml::toJson(errorObject, errorSerialized);
-
-    m_writeSocket->write(QByteArray(errorSerialized.c_str(), (int)errorSerialized.size()), LineMessage::Error | LineMessage::Json);
+    m_writeSocket->write(LineMessage::serialize(errorObject, m_messageFormat), LineMessage::Error | m_messageFormat);
 }
 
 void QmlForkNode::componentComplete(){
@@ -124,9 +119,9 @@ void QmlForkNode::onSharedMemoryMessage(const QByteArray &message, int type, int
 
         m_sourceItem = m_component->create(m_componentContext);
     } else if ( type & LineMessage::Error ){
-        if ( type & LineMessage::Json ){
+        if ( type & (LineMessage::Json | LineMessage::Binary) ){
             MLNode errorOb;
-            ml::fromJson(message.data(), errorOb);
+            LineMessage::deserialize(message, type, errorOb);
             emit error(
                 QByteArray::fromStdString(errorOb["message"].asString()),
                 errorOb["code"].asInt(),
@@ -141,9 +136,12 @@ void QmlForkNode::onSharedMemoryMessage(const QByteArray &message, int type, int
             sendError("Error", Exception::toCode("~Build"), "Input sent without any build component.");
         }
 
+        // responses are sent back in the same format as the input
+        m_messageFormat = (type & LineMessage::Binary) ? LineMessage::Binary : LineMessage::Json;
+
         try{
             MLNode inputOb;
-            ml::fromJson(message.data(), inputOb);
+            LineMessage::deserialize(message, type, inputOb);
 
             ViewEngine* engine = ViewContext::instance().engine();
 
@@ -51,6 +51,7 @@ private:
     QQmlComponent*      m_component;
     QQmlContext*        m_componentContext;
     QObject*            m_sourceItem;
+    int                 m_messageFormat;
 };
 
 } // namespace
@@ -5,6 +5,7 @@ namespace lv{
 RemoteContainer::RemoteContainer(QObject *parent)
     : QObject(parent)
     , m_componentComplete(false)
+    , m_binaryMessages(false)
 {
 
 }
@@ -16,6 +17,14 @@ void RemoteContainer::componentComplete(){
     m_componentComplete = true;
 }
 
+void RemoteContainer::setBinaryMessages(bool binaryMessages){
+    if ( m_binaryMessages == binaryMessages )
+        return;
+
+    m_binaryMessages = binaryMessages;
+    emit binaryMessagesChanged();
+}
+
 void RemoteContainer::sendError(const QByteArray &, int, const QString &){}
 void RemoteContainer::sendBuild(const QByteArray &){}
 void RemoteContainer::sendInput(const MLNode&){}
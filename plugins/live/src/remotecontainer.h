@@ -13,6 +13,7 @@ class RemoteContainer : public QObject, public QQmlParserStatus{
 
     Q_OBJECT
     Q_INTERFACES(QQmlParserStatus)
+    Q_PROPERTY(bool binaryMessages READ binaryMessages WRITE setBinaryMessages NOTIFY binaryMessagesChanged)
 
 public:
     explicit RemoteContainer(QObject* parent = nullptr);
@@ -28,8 +29,13 @@ public:
 
     bool isComponentComplete() const;
 
+    bool binaryMessages() const;
+    void setBinaryMessages(bool binaryMessages);
+    int messageFormat() const;
+
 signals:
     void ready();
+    void binaryMessagesChanged();
 
 protected:
     void classBegin() Q_DECL_OVERRIDE{}
@@ -37,12 +43,24 @@ protected:
 
 private:
     bool m_componentComplete;
+    bool m_binaryMessages;
 };
 
 inline bool RemoteContainer::isComponentComplete() const{
     return m_componentComplete;
 }
 
+inline bool RemoteContainer::binaryMessages() const{
+    return m_binaryMessages;
+}
+
+/**
+ * \brief Returns the format used to serialize messages (LineMessage::Binary or LineMessage::Json)
+ */
+inline int RemoteContainer::messageFormat() const{
+    return m_binaryMessages ? LineMessage::Binary : LineMessage::Json;
+}
+
 }// namespace
 
 #endif // LVREMOTECONTAINER_H
@@ -102,15 +102,29 @@ void RemoteLine::receiveMessage(const LineMessage &message, void *data){
 
 void RemoteLine::onMessage(const LineMessage &message){
     if ( message.type & LineMessage::Error ){
-        lv::Exception e = CREATE_EXCEPTION(
-            lv::Exception, "TcpLine error: " + std::string(message.data), 0
-        );
-        lv::ViewContext::instance().engine()->throwError(&e, this);
+        if ( message.type & (LineMessage::Json | LineMessage::Binary) ){
+            try{
+                MLNode errorOb;
+                LineMessage::deserialize(message.data, message.type, errorOb);
+
+                lv::Exception e = CREATE_EXCEPTION(
+                    lv::Exception, "TcpLine error: " + errorOb["message"].asString(), errorOb["code"].asInt()
+                );
+                lv::ViewContext::instance().engine()->throwError(&e, this);
+            } catch ( Exception& e ){
+                lv::ViewContext::instance().engine()->throwError(&e, this);
+            }
+        } else {
+            lv::Exception e = CREATE_EXCEPTION(
+                lv::Exception, "TcpLine error: " + message.data.toStdString(), 0
+            );
+            lv::ViewContext::instance().engine()->throwError(&e, this);
+        }
     } else if ( message.type & LineMessage::Input ){
 
         try{
             MLNode inputOb;
-            ml::fromJson(message.data.data(), inputOb);
+            LineMessage::deserialize(message.data, message.type, inputOb);
 
             ViewEngine* engine = ViewContext::instance().engine();
 
@@ -48,13 +48,9 @@ void TcpLineConnection::sendError(const QByteArray &type, int code, const QStrin
         {"type", type.toStdString()}
     };
 
-    std::string errorSerialized;
-    ml::toJson(errorObject, errorSerialized);
-
     QByteArray toSend = LineMessage::create(
-        LineMessage::Error | LineMessage::Json,
-        errorSerialized.c_str(),
-        (int)errorSerialized.size()
+        LineMessage::Error | messageFormat(),
+        LineMessage::serialize(errorObject, messageFormat())
     );
     m_socket->write(toSend);
 }
@@ -69,13 +65,9 @@ void TcpLineConnection::sendBuild(const QByteArray &buildData){
 }
 
 void TcpLineConnection::sendInput(const MLNode &input){
-    std::string inputSerialized;
-    ml::toJson(input, inputSerialized);
-
     QByteArray toSend = LineMessage::create(
-        LineMessage::Input | LineMessage::Json,
-        inputSerialized.c_str(),
-        (int)inputSerialized.size()
+        LineMessage::Input | messageFormat(),
+        LineMessage::serialize(input, messageFormat())
     );
 
     m_socket->write(toSend);
@@ -25,6 +25,7 @@ TcpLineSocket::TcpLineSocket(QTcpSocket *socket, QObject* parent)
     , m_component(new QQmlComponent())
     , m_componentContext(nullptr)
     , m_sourceItem(nullptr)
+    , m_messageFormat(LineMessage::Json)
 {
     m_response->onResponse([this](const QString& propertyName, const QVariant& value){
         responseValueChanged(propertyName, value);
@@ -74,9 +75,9 @@ void TcpLineSocket::onMessage(const LineMessage &message){
         m_sourceItem = m_component->create(m_componentContext);
 
     } else if ( message.type & LineMessage::Error ){
-        if ( message.type & LineMessage::Json ){
+        if ( message.type & (LineMessage::Json | LineMessage::Binary) ){
             MLNode errorOb;
-            ml::fromJson(message.data.data(), errorOb);
+            LineMessage::deserialize(message.data, message.type, errorOb);
             server()->lineSocketError(
                 this,
                 QByteArray::fromStdString(errorOb["message"].asString()),
@@ -92,9 +93,12 @@ void TcpLineSocket::onMessage(const LineMessage &message){
             sendError("Error", Exception::toCode("~Build"), "Input sent without any build component.");
         }
 
+        // responses are sent back in the same format as the input
+        m_messageFormat = (message.type & LineMessage::Binary) ? LineMessage::Binary : LineMessage::Json;
+
         try{
             MLNode inputOb;
-            ml::fromJson(message.data.data(), inputOb);
+            LineMessage::deserialize(message.data, message.type, inputOb);
 
             ViewEngine* engine = ViewContext::instance().engine();
 
@@ -121,13 +125,9 @@ void TcpLineSocket::sendError(const QByteArray &type, Exception::Code code, cons
         {"type", type.toStdString()}
     };
 
-    std::string errorSerialized;
-    ml::toJson(errorObject, errorSerialized);
-
     QByteArray toSend = LineMessage::create(
-        LineMessage::Error | LineMessage::Json,
-        errorSerialized.c_str(),
-        (int)errorSerialized.size()
+        LineMessage::Error | m_messageFormat,
+        LineMessage::serialize(errorObject, m_messageFormat)
     );
     m_socket->write(toSend);
 }
@@ -140,13 +140,9 @@ void TcpLineSocket::responseValueChanged(const QString &key, const QVariant &val
 
     n[key.toStdString()] = result;
 
-    std::string responseSerialized;
-    ml::toJson(n, responseSerialized);
-
     QByteArray toSend = LineMessage::create(
-        LineMessage::Input | LineMessage::Json,
-        responseSerialized.c_str(),
-        (int)responseSerialized.size()
+        LineMessage::Input | m_messageFormat,
+        LineMessage::serialize(n, m_messageFormat)
     );
     m_socket->write(toSend);
 }
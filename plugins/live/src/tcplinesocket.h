@@ -55,6 +55,7 @@ private:
     QQmlComponent*      m_component;
     QQmlContext*        m_componentContext;
     QObject*            m_sourceItem;
+    int                 m_messageFormat;
 };
 
 inline const QString &TcpLineSocket::address(){
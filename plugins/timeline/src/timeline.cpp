@@ -11,6 +11,7 @@
 
 #include "live/mlnode.h"
 #include "live/mlnodetojson.h"
+#include "live/mlnodetobinary.h"
 #include "live/mlnodetoqml.h"
 
 #include <QQmlPropertyMap>
@@ -36,6 +37,7 @@ Timeline::Timeline(QObject *parent)
     , m_trackList(new TrackListModel())
     , m_headerModel(new TimelineHeaderModel(this))
     , m_properties(new QQmlPropertyMap(this))
+    , m_fileFormat(Timeline::Json)
 {
     m_timer.setSingleShot(false);
 
@@ -340,7 +342,13 @@ void Timeline::load(){
 
     try {
         MLNode contentNode;
-        ml::fromJson(content.data(), contentNode);
+        if ( ml::isBinary(content.constData(), static_cast<size_t>(content.size())) ){
+            ml::fromBinary(content.constData(), static_cast<size_t>(content.size()), contentNode);
+            setFileFormat(Timeline::Binary);
+        } else {
+            ml::fromJson(content.data(), contentNode);
+            setFileFormat(Timeline::Json);
+        }
         deserialize(this, ViewEngine::grab(this), contentNode);
     } catch (Exception& e) {
         ViewContext::instance().engine()->throwError(&e, this);
@@ -362,8 +370,11 @@ void Timeline::save(){
             serialize(ViewContext::instance().engine(), this, result);
 
             std::string resultData;
-            ml::toJson(result, resultData);
-            file.write(resultData.c_str());
+            if ( m_fileFormat == Timeline::Binary )
+                ml::toBinary(result, resultData);
+            else
+                ml::toJson(result, resultData);
+            file.write(resultData.c_str(), static_cast<qint64>(resultData.size()));
             file.close();
         }
     } catch (lv::Exception& e) {
@@ -28,11 +28,19 @@ class Timeline : public QObject, public QQmlParserStatus{
     Q_PROPERTY(bool loop                        READ loop           WRITE setLoop          NOTIFY loopChanged)
     Q_PROPERTY(QObject* properties              READ properties     WRITE setProperties    NOTIFY propertiesChanged)
     Q_PROPERTY(QString file                     READ file           WRITE setFile          NOTIFY fileChanged)
+    Q_PROPERTY(FileFormat fileFormat            READ fileFormat     WRITE setFileFormat    NOTIFY fileFormatChanged)
     Q_PROPERTY(lv::TimelineConfig* config       READ config         CONSTANT)
     Q_PROPERTY(lv::TrackListModel* trackList    READ trackList      NOTIFY trackListChanged)
     Q_PROPERTY(TimelineHeaderModel* headerModel READ headerModel    CONSTANT)
     Q_PROPERTY(QQmlListProperty<QObject> tracks READ tracks         CONSTANT)
     Q_CLASSINFO("DefaultProperty", "tracks")
+    Q_ENUMS(FileFormat)
+
+public:
+    enum FileFormat{
+        Json = 0,
+        Binary
+    };
 
 public:
     Timeline(QObject* parent = nullptr);
@@ -67,6 +75,9 @@ public:
     const QString& file() const;
     void setFile(const QString& file);
 
+    FileFormat fileFormat() const;
+    void setFileFormat(FileFormat fileFormat);
+
     static void serialize(ViewEngine* engine, const QObject* o, MLNode &node);
     static QObject *deserialize(ViewEngine* engine, const MLNode &node);
 
@@ -102,6 +113,7 @@ signals:
     void loopChanged();
     void propertiesChanged();
     void fileChanged();
+    void fileFormatChanged();
     void trackListChanged();
     void trackNameChanged(Track* track);
 
@@ -122,6 +134,7 @@ private:
     QTimer               m_timer;
     QObject*             m_properties;
     QString              m_file;
+    FileFormat           m_fileFormat;
 };
 
 inline qint64 Timeline::contentLength() const{
@@ -199,6 +212,18 @@ inline void Timeline::setProperties(QObject *properties){
     emit propertiesChanged();
 }
 
+inline Timeline::FileFormat Timeline::fileFormat() const{
+    return m_fileFormat;
+}
+
+inline void Timeline::setFileFormat(Timeline::FileFormat fileFormat){
+    if (m_fileFormat == fileFormat)
+        return;
+
+    m_fileFormat = fileFormat;
+    emit fileFormatChanged();
+}
+
 inline void Timeline::setFile(const QString &file){
     if (m_file == file)
         return;
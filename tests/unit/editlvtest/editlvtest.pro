@@ -0,0 +1,42 @@
+TARGET   = editlvtest
+TEMPLATE = app
+QT      += qml quick testlib
+CONFIG  += console testcase
+
+linkLocalLibrary(lvbase,     lvbase)
+linkLocalLibrary(lvview,     lvview)
+linkLocalLibrary(lveditor,   lveditor)
+linkLocalLibrary(lvelements, lvelements)
+
+# Plugin sources under test
+
+EDITLV_SOURCE_PATH = $$PWD/../../../plugins/editlv/src
+INCLUDEPATH += $$EDITLV_SOURCE_PATH
+
+HEADERS += \
+    $$EDITLV_SOURCE_PATH/documenttree.h \
+    $$EDITLV_SOURCE_PATH/editlvsettings.h \
+    $$EDITLV_SOURCE_PATH/languagelvhighlighter.h
+
+SOURCES += \
+    $$EDITLV_SOURCE_PATH/documenttree.cpp \
+    $$EDITLV_SOURCE_PATH/editlvsettings.cpp \
+    $$EDITLV_SOURCE_PATH/languagelvhighlighter.cpp
+
+# Fixtures shared with the lvelements tests
+
+LVELEMENTS_TEST_PATH = $$PWD/../lvelementstest
+INCLUDEPATH += $$LVELEMENTS_TEST_PATH
+
+HEADERS += \
+    $$LVELEMENTS_TEST_PATH/predicatebenchmarkfixture.h
+
+# Tests
+
+HEADERS += \
+    $$PWD/testrunner.h \
+    $$PWD/languagelvhighlightertest.h
+
+SOURCES += \
+    $$PWD/main.cpp \
+    $$PWD/languagelvhighlightertest.cpp
@@ -0,0 +1,216 @@
+#include "languagelvhighlightertest.h"
+
+#include "live/project.h"
+#include "live/projectfile.h"
+#include "live/projectdocument.h"
+#include "live/textdocumentdata.h"
+#include "live/elements/languageparser.h"
+#include "live/elements/languagequery.h"
+
+#include "languagelvhighlighter.h"
+#include "editlvsettings.h"
+#include "documenttree.h"
+#include "predicatebenchmarkfixture.h"
+
+#include <QTextCursor>
+#include <QTextLayout>
+
+#include <algorithm>
+
+Q_TEST_RUNNER_REGISTER(LanguageLvHighlighterTest);
+
+using namespace lv;
+
+namespace{
+
+/// Records the blocks that are no longer cached right after each edit, before they are highlighted again
+class TrackedHighlighter : public LanguageLvHighlighter{
+
+public:
+    using LanguageLvHighlighter::LanguageLvHighlighter;
+
+    std::vector<int> invalidBlocks;
+
+protected:
+    void documentChanged(int pos, int removed, int added) override{
+        LanguageLvHighlighter::documentChanged(pos, removed, added);
+
+        invalidBlocks.clear();
+        for ( int i = 0; i < document()->blockCount(); ++i ){
+            if ( !isBlockCached(i) )
+                invalidBlocks.push_back(i);
+        }
+    }
+};
+
+/// Document with one property per line, highlighted from scratch
+class HighlightedDocument{
+
+public:
+    HighlightedDocument(int totalProperties)
+        : project(nullptr)
+        , file(new ProjectFile("languagelvhighlightertest.lv"))
+        , document(new ProjectDocument(file, false, &project))
+        , tree(document)
+    {
+        QString source = "component A < Element{\n";
+        for ( int i = 0; i < totalProperties; ++i )
+            source += "    int p" + QString::number(i) + ": " + QString::number(i) + "\n";
+        source += "}\n";
+        document->textDocument()->setPlainText(source);
+
+        highlighter = new TrackedHighlighter(&settings, nullptr, &tree, document->textDocument());
+        QCoreApplication::processEvents();
+    }
+
+    ~HighlightedDocument(){
+        delete highlighter;
+        delete document;
+        delete file;
+    }
+
+    QTextBlock block(int number) const{ return document->textDocument()->findBlockByNumber(number); }
+
+    int totalCachedBlocks() const{
+        int total = 0;
+        for ( int i = 0; i < document->textDocument()->blockCount(); ++i )
+            if ( highlighter->isBlockCached(i) )
+                ++total;
+        return total;
+    }
+
+    bool hasFormat(const QTextBlock& b, const QTextCharFormat& format) const{
+        for ( const QTextLayout::FormatRange& r : b.layout()->formats() ){
+            if ( r.format.foreground() == format.foreground() )
+                return true;
+        }
+        return false;
+    }
+
+    Project             project;
+    ProjectFile*        file;
+    ProjectDocument*    document;
+    EditLvSettings      settings;
+    el::DocumentTree    tree;
+    TrackedHighlighter* highlighter;
+};
+
+}// namespace
+
+LanguageLvHighlighterTest::LanguageLvHighlighterTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void LanguageLvHighlighterTest::initTestCase(){
+}
+
+void LanguageLvHighlighterTest::editRehighlightsChangedBlockTest(){
+    HighlightedDocument hd(40);
+    QTextDocument* doc = hd.document->textDocument();
+    QCOMPARE(hd.totalCachedBlocks(), doc->blockCount());
+
+    // "    int p20: 20" -> "    int p20: 200"
+    QTextCursor cursor(hd.block(21));
+    cursor.movePosition(QTextCursor::EndOfBlock);
+    cursor.insertText("0");
+
+    QCOMPARE(hd.highlighter->invalidBlocks.size(), static_cast<size_t>(1));
+    QCOMPARE(hd.highlighter->invalidBlocks[0], 21);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(hd.totalCachedBlocks(), doc->blockCount());
+    QVERIFY(hd.hasFormat(hd.block(21), hd.settings["number"]));
+}
+
+void LanguageLvHighlighterTest::insertedLineShiftsCachedBlocksTest(){
+    HighlightedDocument hd(40);
+    QTextDocument* doc = hd.document->textDocument();
+    int totalBlocks = doc->blockCount();
+
+    QTextCursor cursor(hd.block(10));
+    cursor.movePosition(QTextCursor::EndOfBlock);
+    cursor.insertText("\n    string extra: \"a\"");
+
+    QCOMPARE(doc->blockCount(), totalBlocks + 1);
+
+    // only the edited line and the inserted one are highlighted again, the ones after keep their cache
+    for ( int blockNumber : hd.highlighter->invalidBlocks ){
+        QVERIFY(blockNumber == 10 || blockNumber == 11);
+    }
+    for ( int i = 12; i < doc->blockCount(); ++i ){
+        QVERIFY(hd.highlighter->isBlockCached(i));
+    }
+
+    QCoreApplication::processEvents();
+    QCOMPARE(hd.totalCachedBlocks(), doc->blockCount());
+    QVERIFY(hd.hasFormat(hd.block(11), hd.settings["string"]));
+    QVERIFY(hd.hasFormat(hd.block(30), hd.settings["number"]));
+}
+
+void LanguageLvHighlighterTest::changedRangeRehighlightsOtherBlocksTest(){
+    HighlightedDocument hd(40);
+    QTextDocument* doc = hd.document->textDocument();
+
+    QTextCursor cursor(hd.block(12));
+    cursor.movePosition(QTextCursor::EndOfBlock);
+    cursor.insertText(" // */");
+    QCoreApplication::processEvents();
+
+    // opening a comment on line 5 closes it on line 12, turning lines 5 to 12 into a comment while only line 5
+    // is edited
+    cursor = QTextCursor(hd.block(5));
+    cursor.insertText("/*");
+
+    auto invalidBlocks = hd.highlighter->invalidBlocks;
+    QVERIFY(std::find(invalidBlocks.begin(), invalidBlocks.end(), 12) != invalidBlocks.end());
+    QVERIFY(std::find(invalidBlocks.begin(), invalidBlocks.end(), 30) == invalidBlocks.end());
+
+    QCoreApplication::processEvents();
+    QCOMPARE(hd.totalCachedBlocks(), doc->blockCount());
+    for ( int i = 5; i <= 12; ++i ){
+        QVERIFY(hd.hasFormat(hd.block(i), hd.settings["comment"]));
+    }
+    QVERIFY(!hd.hasFormat(hd.block(13), hd.settings["comment"]));
+}
+
+void LanguageLvHighlighterTest::predicateBenchmark(){
+    // the engine level benchmark runs the same query over UTF-8 source, this one over the UTF-16 rows of the
+    // document, the same way the highlighter reads them
+    QString source = QString::fromStdString(predicatebenchmark::source());
+
+    QTextDocument doc;
+    doc.setPlainText(source);
+
+    TextDocumentData data;
+    data.contentsChange(&doc, 0, 0, doc.characterCount());
+
+    el::LanguageParser::Ptr parser = el::LanguageParser::createForElements();
+    el::LanguageParser::AST* ast = nullptr;
+    TSInputEdit edit = {};
+    TSInput input = {&data, &LanguageLvHighlighter::parsingCallback, TSInputEncodingUTF16};
+    parser->editParseTree(ast, edit, input);
+    QVERIFY(ast);
+
+    el::LanguageQuery::Ptr query = predicatebenchmark::createQuery(parser);
+    query->addPredicate("eq-or?", &LanguageLvHighlighter::predicateEqOr);
+
+    size_t expectedMatches = predicatebenchmark::expectedMatches(query, ast, [&source](const el::SourceRange& range){
+        return source.mid(static_cast<int>(range.from() / 2), static_cast<int>(range.length() / 2)).toStdString();
+    });
+    QVERIFY(expectedMatches > 0);
+
+    size_t totalMatches = 0;
+    QBENCHMARK{
+        totalMatches = 0;
+        el::LanguageQuery::Cursor::Ptr cursor = query->exec(ast);
+        while ( cursor->nextMatch() ){
+            if ( query->predicateMatch(cursor, &data) )
+                ++totalMatches;
+        }
+    }
+
+    QCOMPARE(totalMatches, expectedMatches);
+
+    parser->destroy(ast);
+}
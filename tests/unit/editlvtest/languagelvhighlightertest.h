@@ -0,0 +1,26 @@
+#ifndef LANGUAGELVHIGHLIGHTERTEST_H
+#define LANGUAGELVHIGHLIGHTERTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class LanguageLvHighlighterTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    LanguageLvHighlighterTest(QObject* parent = nullptr);
+    ~LanguageLvHighlighterTest(){}
+
+private slots:
+    void initTestCase();
+
+    void editRehighlightsChangedBlockTest();
+    void insertedLineShiftsCachedBlocksTest();
+    void changedRangeRehighlightsOtherBlocksTest();
+    void predicateBenchmark();
+
+};
+
+#endif // LANGUAGELVHIGHLIGHTERTEST_H
@@ -0,0 +1,32 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include <QGuiApplication>
+#include <QTest>
+
+#include "live/applicationcontext.h"
+
+#include "testrunner.h"
+#include "languagelvhighlightertest.h"
+
+int main(int argc, char *argv[]){
+    lv::ApplicationContext::initialize({});
+
+    QGuiApplication app(argc, argv);
+    app.setAttribute(Qt::AA_Use96Dpi, true);
+
+    return lv::TestRunner::runTests(argc, argv);
+}
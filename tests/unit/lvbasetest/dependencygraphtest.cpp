@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "dependencygraphtest.h"
+#include "live/dependencygraph.h"
+
+#include <algorithm>
+
+Q_TEST_RUNNER_REGISTER(DependencyGraphTest);
+
+using namespace lv;
+
+namespace{
+
+size_t positionOf(const std::vector<DependencyGraph::Node>& order, DependencyGraph::Node node){
+    return static_cast<size_t>(std::find(order.begin(), order.end(), node) - order.begin());
+}
+
+}// namespace
+
+DependencyGraphTest::DependencyGraphTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+DependencyGraphTest::~DependencyGraphTest(){
+}
+
+void DependencyGraphTest::edgesTest(){
+    DependencyGraph g;
+    DependencyGraph::Node a = g.addNode();
+    DependencyGraph::Node b = g.addNode();
+    QCOMPARE(g.nodeCount(), static_cast<size_t>(2));
+
+    QVERIFY(g.addEdge(a, b));
+    QVERIFY(!g.addEdge(a, b));
+    QVERIFY(g.hasEdge(a, b));
+    QVERIFY(!g.hasEdge(b, a));
+    QCOMPARE(g.edges(a).size(), static_cast<size_t>(1));
+
+    QVERIFY(g.removeEdge(a, b));
+    QVERIFY(!g.removeEdge(a, b));
+    QVERIFY(!g.hasEdge(a, b));
+    QVERIFY(g.edges(a).empty());
+}
+
+void DependencyGraphTest::reachesTest(){
+    DependencyGraph g;
+    DependencyGraph::Node a = g.addNode();
+    DependencyGraph::Node b = g.addNode();
+    DependencyGraph::Node c = g.addNode();
+    DependencyGraph::Node d = g.addNode();
+
+    g.addEdge(a, b);
+    g.addEdge(b, c);
+
+    QVERIFY(g.reaches(a, b));
+    QVERIFY(g.reaches(a, c));
+    QVERIFY(!g.reaches(a, a));
+    QVERIFY(!g.reaches(c, a));
+    QVERIFY(!g.reaches(a, d));
+    QCOMPARE(g.reachable(a).size(), static_cast<size_t>(2));
+}
+
+void DependencyGraphTest::closureInvalidationTest(){
+    DependencyGraph g;
+    DependencyGraph::Node a = g.addNode();
+    DependencyGraph::Node b = g.addNode();
+    DependencyGraph::Node c = g.addNode();
+    DependencyGraph::Node d = g.addNode();
+
+    g.addEdge(a, b);
+    QVERIFY(!g.reaches(a, d));
+    QVERIFY(!g.reaches(c, d));
+
+    // a reaches b, so its cached closure needs to include the new edge
+    g.addEdge(b, d);
+    QVERIFY(g.reaches(a, d));
+    QVERIFY(!g.reaches(c, d));
+
+    g.removeEdge(b, d);
+    QVERIFY(!g.reaches(a, d));
+    QVERIFY(g.reaches(a, b));
+}
+
+void DependencyGraphTest::pathTest(){
+    DependencyGraph g;
+    DependencyGraph::Node a = g.addNode();
+    DependencyGraph::Node b = g.addNode();
+    DependencyGraph::Node c = g.addNode();
+    DependencyGraph::Node d = g.addNode();
+
+    g.addEdge(a, b);
+    g.addEdge(b, c);
+    g.addEdge(c, d);
+    g.addEdge(a, c);
+
+    std::vector<DependencyGraph::Node> path = g.path(a, d);
+    QCOMPARE(path.size(), static_cast<size_t>(3));
+    QCOMPARE(path[0], a);
+    QCOMPARE(path[1], c);
+    QCOMPARE(path[2], d);
+
+    QVERIFY(g.path(d, a).empty());
+}
+
+void DependencyGraphTest::cyclesTest(){
+    DependencyGraph g;
+    DependencyGraph::Node a = g.addNode();
+    DependencyGraph::Node b = g.addNode();
+    DependencyGraph::Node c = g.addNode();
+    DependencyGraph::Node d = g.addNode();
+
+    g.addEdge(a, b);
+    g.addEdge(b, c);
+    g.addEdge(c, a);
+    g.addEdge(c, d);
+
+    QVERIFY(g.reaches(a, a));
+    QVERIFY(!g.reaches(d, d));
+
+    std::vector<DependencyGraph::Node> path = g.path(b, b);
+    QCOMPARE(path.size(), static_cast<size_t>(4));
+    QCOMPARE(path.front(), b);
+    QCOMPARE(path.back(), b);
+
+    std::vector<std::vector<DependencyGraph::Node> > components = g.stronglyConnectedComponents();
+    QCOMPARE(components.size(), static_cast<size_t>(2));
+    QCOMPARE(components[0].size(), static_cast<size_t>(1));
+    QCOMPARE(components[0][0], d);
+    QCOMPARE(components[1].size(), static_cast<size_t>(3));
+}
+
+void DependencyGraphTest::topologicalOrderTest(){
+    DependencyGraph g;
+    DependencyGraph::Node a = g.addNode();
+    DependencyGraph::Node b = g.addNode();
+    DependencyGraph::Node c = g.addNode();
+    DependencyGraph::Node d = g.addNode();
+    DependencyGraph::Node e = g.addNode();
+
+    g.addEdge(a, b);
+    g.addEdge(a, c);
+    g.addEdge(b, d);
+    g.addEdge(c, d);
+    g.addEdge(e, a);
+
+    std::vector<DependencyGraph::Node> order = g.topologicalOrder();
+    QCOMPARE(order.size(), static_cast<size_t>(5));
+
+    for ( DependencyGraph::Node n = 0; n < g.nodeCount(); ++n ){
+        for ( DependencyGraph::Node dependency : g.edges(n) ){
+            QVERIFY(positionOf(order, dependency) < positionOf(order, n));
+        }
+    }
+}
+
+void DependencyGraphTest::levelsTest(){
+    DependencyGraph g;
+    DependencyGraph::Node a = g.addNode();
+    DependencyGraph::Node b = g.addNode();
+    DependencyGraph::Node c = g.addNode();
+    DependencyGraph::Node d = g.addNode();
+    DependencyGraph::Node e = g.addNode();
+
+    g.addEdge(a, b);
+    g.addEdge(a, c);
+    g.addEdge(b, d);
+    g.addEdge(c, d);
+
+    std::vector<std::vector<DependencyGraph::Node> > levels = g.levels();
+    QCOMPARE(levels.size(), static_cast<size_t>(3));
+
+    std::sort(levels[0].begin(), levels[0].end());
+    std::sort(levels[1].begin(), levels[1].end());
+
+    QCOMPARE(levels[0], std::vector<DependencyGraph::Node>({d, e}));
+    QCOMPARE(levels[1], std::vector<DependencyGraph::Node>({b, c}));
+    QCOMPARE(levels[2], std::vector<DependencyGraph::Node>({a}));
+}
+
+void DependencyGraphTest::diamondChainTest(){
+    // chain of diamonds, which has an exponential number of paths between its ends
+    const size_t diamonds = 64;
+
+    DependencyGraph g;
+    DependencyGraph::Node top = g.addNode();
+    DependencyGraph::Node current = top;
+    for ( size_t i = 0; i < diamonds; ++i ){
+        DependencyGraph::Node left   = g.addNode();
+        DependencyGraph::Node right  = g.addNode();
+        DependencyGraph::Node bottom = g.addNode();
+        g.addEdge(current, left);
+        g.addEdge(current, right);
+        g.addEdge(left, bottom);
+        g.addEdge(right, bottom);
+        current = bottom;
+    }
+
+    QVERIFY(g.reaches(top, current));
+    QVERIFY(!g.reaches(current, top));
+    QCOMPARE(g.reachable(top).size(), diamonds * 3);
+    QCOMPARE(g.path(top, current).size(), diamonds * 2 + 1);
+    QCOMPARE(g.stronglyConnectedComponents().size(), g.nodeCount());
+}
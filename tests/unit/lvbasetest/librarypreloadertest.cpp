@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "librarypreloadertest.h"
+#include "live/librarypreloader.h"
+
+#include <cstdio>
+#include <fstream>
+
+Q_TEST_RUNNER_REGISTER(LibraryPreloaderTest);
+
+using namespace lv;
+
+LibraryPreloaderTest::LibraryPreloaderTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+LibraryPreloaderTest::~LibraryPreloaderTest(){
+}
+
+void LibraryPreloaderTest::qmldirTest(){
+    {
+        std::ofstream out("qmldir", std::ofstream::out);
+        out << "module test\n";
+        out << "plugin testplugin\n";
+        out << "plugin otherplugin lib\n";
+        out << "Item 1.0 Item.qml\n";
+    }
+
+    std::vector<std::string> libraries = LibraryPreloader::librariesFromQmldir(".");
+    QCOMPARE(libraries.size(), static_cast<size_t>(2));
+    QCOMPARE(libraries[0], std::string("./testplugin"));
+    QCOMPARE(libraries[1], std::string("./lib/otherplugin"));
+
+    std::remove("qmldir");
+
+    QVERIFY(LibraryPreloader::librariesFromQmldir(".").empty());
+}
+
+void LibraryPreloaderTest::duplicateLibraryTest(){
+    LibraryPreloader preloader;
+    preloader.addLibrary("a");
+    preloader.addLibrary("b");
+    preloader.addLibrary("a");
+    QCOMPARE(preloader.libraries().size(), static_cast<size_t>(2));
+}
+
+void LibraryPreloaderTest::failedLibraryTest(){
+    LibraryPreloader preloader(2);
+    for ( int i = 0; i < 5; ++i )
+        preloader.addLibrary("librarypreloadertest_missing" + std::to_string(i));
+
+    preloader.start();
+    QVERIFY(preloader.isRunning());
+    preloader.wait();
+    QVERIFY(!preloader.isRunning());
+
+    QCOMPARE(preloader.results().size(), static_cast<size_t>(5));
+    for ( size_t i = 0; i < preloader.results().size(); ++i ){
+        const LibraryPreloader::Result& r = preloader.results()[i];
+        QCOMPARE(r.path, "librarypreloadertest_missing" + std::to_string(i));
+        QVERIFY(r.library == nullptr);
+        QVERIFY(!r.error.empty());
+    }
+}
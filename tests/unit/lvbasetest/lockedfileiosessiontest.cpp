@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "lockedfileiosessiontest.h"
+#include "live/lockedfileiosession.h"
+
+#include <cstdio>
+#include <fstream>
+
+Q_TEST_RUNNER_REGISTER(LockedFileIOSessionTest);
+
+using namespace lv;
+
+namespace{
+
+void writeFile(const std::string& path, const std::string& content){
+    std::ofstream out(path, std::ofstream::out | std::ofstream::binary);
+    out << content;
+}
+
+std::string testFilePath(int index){
+    return "lockedfileiosessiontest_" + std::to_string(index) + ".txt";
+}
+
+}// namespace
+
+LockedFileIOSessionTest::LockedFileIOSessionTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+LockedFileIOSessionTest::~LockedFileIOSessionTest(){
+}
+
+void LockedFileIOSessionTest::cleanup(){
+    for ( int i = 0; i < 8; ++i )
+        std::remove(testFilePath(i).c_str());
+}
+
+void LockedFileIOSessionTest::readTest(){
+    writeFile(testFilePath(0), "content");
+
+    LockedFileIOSession::Ptr io = LockedFileIOSession::createInstance();
+    QCOMPARE(io->readFromFile(testFilePath(0)), std::string("content"));
+
+    LockedFileIOSession::ContentPtr first  = io->readSharedFromFile(testFilePath(0));
+    LockedFileIOSession::ContentPtr second = io->readSharedFromFile(testFilePath(0));
+    QVERIFY(first != nullptr);
+    QVERIFY(first == second);
+    QCOMPARE(io->cacheSize(), static_cast<size_t>(7));
+
+    writeFile(testFilePath(1), "");
+    QCOMPARE(io->readFromFile(testFilePath(1)), std::string(""));
+
+    QVERIFY(io->readSharedFromFile(testFilePath(2)) == nullptr);
+    QCOMPARE(io->readFromFile(testFilePath(2)), std::string(""));
+}
+
+void LockedFileIOSessionTest::modifiedFileTest(){
+    writeFile(testFilePath(0), "content");
+
+    LockedFileIOSession::Ptr io = LockedFileIOSession::createInstance();
+    LockedFileIOSession::ContentPtr first = io->readSharedFromFile(testFilePath(0));
+
+    writeFile(testFilePath(0), "changed content");
+
+    LockedFileIOSession::ContentPtr second = io->readSharedFromFile(testFilePath(0));
+    QVERIFY(first != second);
+    QCOMPARE(*first, std::string("content"));
+    QCOMPARE(*second, std::string("changed content"));
+}
+
+void LockedFileIOSessionTest::writeTest(){
+    LockedFileIOSession::Ptr io = LockedFileIOSession::createInstance();
+
+    QVERIFY(io->writeToFile(testFilePath(0), "first"));
+    QCOMPARE(io->readFromFile(testFilePath(0)), std::string("first"));
+
+    QVERIFY(io->writeToFile(testFilePath(0), "other"));
+    QCOMPARE(io->cacheSize(), static_cast<size_t>(0));
+    QCOMPARE(io->readFromFile(testFilePath(0)), std::string("other"));
+}
+
+void LockedFileIOSessionTest::cacheLimitTest(){
+    LockedFileIOSession::Ptr io = LockedFileIOSession::createInstance();
+    io->setCacheLimit(10);
+    QCOMPARE(io->cacheLimit(), static_cast<size_t>(10));
+
+    writeFile(testFilePath(0), "aaaa");
+    writeFile(testFilePath(1), "bbbb");
+    writeFile(testFilePath(2), "cccc");
+    writeFile(testFilePath(3), "too large to cache");
+
+    LockedFileIOSession::ContentPtr a = io->readSharedFromFile(testFilePath(0));
+    io->readSharedFromFile(testFilePath(1));
+    QCOMPARE(io->cacheSize(), static_cast<size_t>(8));
+
+    // reading 'a' again makes 'b' the least recently used entry
+    QVERIFY(io->readSharedFromFile(testFilePath(0)) == a);
+    io->readSharedFromFile(testFilePath(2));
+    QCOMPARE(io->cacheSize(), static_cast<size_t>(8));
+    QVERIFY(io->readSharedFromFile(testFilePath(0)) == a);
+
+    io->readSharedFromFile(testFilePath(3));
+    QCOMPARE(io->cacheSize(), static_cast<size_t>(8));
+
+    io->clearCache();
+    QCOMPARE(io->cacheSize(), static_cast<size_t>(0));
+    QVERIFY(io->readSharedFromFile(testFilePath(0)) != a);
+}
+
+void LockedFileIOSessionTest::readFromFilesTest(){
+    std::vector<std::string> paths;
+    for ( int i = 0; i < 8; ++i ){
+        if ( i != 5 )
+            writeFile(testFilePath(i), "file " + std::to_string(i));
+        paths.push_back(testFilePath(i));
+    }
+
+    LockedFileIOSession::Ptr io = LockedFileIOSession::createInstance();
+    std::vector<LockedFileIOSession::ContentPtr> contents = io->readFromFiles(paths);
+
+    QCOMPARE(contents.size(), paths.size());
+    for ( int i = 0; i < 8; ++i ){
+        if ( i == 5 ){
+            QVERIFY(contents[i] == nullptr);
+        } else {
+            QCOMPARE(*contents[i], "file " + std::to_string(i));
+            QVERIFY(io->readSharedFromFile(paths[i]) == contents[i]);
+        }
+    }
+}
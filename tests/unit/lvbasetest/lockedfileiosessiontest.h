@@ -0,0 +1,42 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef LOCKEDFILEIOSESSIONTEST_H
+#define LOCKEDFILEIOSESSIONTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class LockedFileIOSessionTest : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit LockedFileIOSessionTest(QObject *parent = 0);
+    ~LockedFileIOSessionTest();
+
+private slots:
+    void cleanup();
+
+    void readTest();
+    void modifiedFileTest();
+    void writeTest();
+    void cacheLimitTest();
+    void readFromFilesTest();
+};
+
+#endif // LOCKEDFILEIOSESSIONTEST_H
@@ -9,12 +9,30 @@ HEADERS += \
     $$PWD/testrunner.h \
     $$PWD/commandlineparsertest.h \
     $$PWD/mlnodetest.h \
-    $$PWD/mlnodetojsontest.h
+    $$PWD/mlnodetojsontest.h \
+    $$PWD/mldocumenttest.h \
+    $$PWD/mlnodetobinarytest.h \
+    $$PWD/mljsonviewtest.h \
+    $$PWD/manifestcachetest.h \
+    $$PWD/librarypreloadertest.h \
+    $$PWD/tracetest.h \
+    $$PWD/dependencygraphtest.h \
+    $$PWD/utf8test.h \
+    $$PWD/lockedfileiosessiontest.h
 
 SOURCES += \
     $$PWD/main.cpp \
     $$PWD/commandlineparsertest.cpp \
     $$PWD/mlnodetest.cpp \
-    $$PWD/mlnodetojsontest.cpp
+    $$PWD/mlnodetojsontest.cpp \
+    $$PWD/mldocumenttest.cpp \
+    $$PWD/mlnodetobinarytest.cpp \
+    $$PWD/mljsonviewtest.cpp \
+    $$PWD/manifestcachetest.cpp \
+    $$PWD/librarypreloadertest.cpp \
+    $$PWD/tracetest.cpp \
+    $$PWD/dependencygraphtest.cpp \
+    $$PWD/utf8test.cpp \
+    $$PWD/lockedfileiosessiontest.cpp
 
 
@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "manifestcachetest.h"
+#include "live/manifestcache.h"
+#include "live/package.h"
+
+#include <cstdio>
+#include <fstream>
+
+Q_TEST_RUNNER_REGISTER(ManifestCacheTest);
+
+using namespace lv;
+
+namespace{
+
+void writeFile(const std::string& path, const std::string& content){
+    std::ofstream out(path, std::ofstream::out | std::ofstream::binary);
+    out << content;
+}
+
+}// namespace
+
+ManifestCacheTest::ManifestCacheTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+ManifestCacheTest::~ManifestCacheTest(){
+}
+
+void ManifestCacheTest::lookupTest(){
+    std::string path = "manifestcachetest.package.json";
+    writeFile(path, "{\"name\":\"test\",\"version\":\"1.0.0\"}");
+
+    ManifestCache cache;
+    MLNode m;
+    QVERIFY(!cache.lookup(path, m));
+
+    cache.store(path, {{"name", "test"}, {"version", "1.0.0"}});
+    QVERIFY(cache.isModified());
+    QCOMPARE(cache.size(), static_cast<size_t>(1));
+
+    QVERIFY(cache.lookup(path, m));
+    QCOMPARE(m["name"].asString(), std::string("test"));
+
+    std::remove(path.c_str());
+    QVERIFY(!cache.lookup(path, m));
+    QCOMPARE(cache.size(), static_cast<size_t>(0));
+}
+
+void ManifestCacheTest::modifiedFileTest(){
+    std::string path = "manifestcachetest.package.json";
+    writeFile(path, "{\"name\":\"test\",\"version\":\"1.0.0\"}");
+
+    ManifestCache cache;
+    cache.store(path, {{"name", "test"}, {"version", "1.0.0"}});
+
+    writeFile(path, "{\"name\":\"test\",\"version\":\"1.10.0\"}");
+
+    MLNode m;
+    QVERIFY(!cache.lookup(path, m));
+
+    std::remove(path.c_str());
+}
+
+void ManifestCacheTest::saveLoadTest(){
+    std::string path      = "manifestcachetest.package.json";
+    std::string cachePath = "manifestcachetest.cache";
+    writeFile(path, "{\"name\":\"test\",\"version\":\"1.0.0\"}");
+
+    {
+        ManifestCache cache;
+        cache.store(path, {{"name", "test"}, {"version", "1.0.0"}, {"dependencies", {{"lvbase", "1.0.0"}}}});
+        cache.save(cachePath);
+        QVERIFY(!cache.isModified());
+    }
+
+    ManifestCache cache;
+    QVERIFY(cache.load(cachePath));
+    QCOMPARE(cache.size(), static_cast<size_t>(1));
+
+    MLNode m;
+    QVERIFY(cache.lookup(path, m));
+    QCOMPARE(m["dependencies"]["lvbase"].asString(), std::string("1.0.0"));
+
+    std::remove(path.c_str());
+    std::remove(cachePath.c_str());
+}
+
+void ManifestCacheTest::invalidCacheFileTest(){
+    std::string cachePath = "manifestcachetest.cache";
+
+    ManifestCache cache;
+    QVERIFY(!cache.load(cachePath));
+
+    writeFile(cachePath, "{\"version\":1}");
+    QVERIFY(!cache.load(cachePath));
+
+    writeFile(cachePath, std::string("\xd9\xd9\xf7\xa2", 4));
+    QVERIFY(!cache.load(cachePath));
+    QCOMPARE(cache.size(), static_cast<size_t>(0));
+
+    std::remove(cachePath.c_str());
+}
+
+void ManifestCacheTest::packageFromCacheTest(){
+    std::string path = "live.package.json";
+    writeFile(path, "{\"name\":\"test\",\"version\":\"1.0.0\",\"unused\":[1,2,3]}");
+
+    ManifestCache cache;
+    Package::Ptr p = Package::createFromPath(path, &cache);
+    QVERIFY(p != nullptr);
+    QCOMPARE(p->name(), std::string("test"));
+    QCOMPARE(cache.size(), static_cast<size_t>(1));
+
+    MLNode m;
+    QVERIFY(cache.lookup(path, m));
+    QVERIFY(!m.hasKey("unused"));
+
+    Package::Ptr cached = Package::createFromPath(path, &cache);
+    QCOMPARE(cached->name(), std::string("test"));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,40 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef MANIFESTCACHETEST_H
+#define MANIFESTCACHETEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class ManifestCacheTest : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit ManifestCacheTest(QObject *parent = 0);
+    ~ManifestCacheTest();
+
+private slots:
+    void lookupTest();
+    void modifiedFileTest();
+    void saveLoadTest();
+    void invalidCacheFileTest();
+    void packageFromCacheTest();
+};
+
+#endif // MANIFESTCACHETEST_H
@@ -0,0 +1,251 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "mldocumenttest.h"
+#include "live/mlnodetojson.h"
+
+Q_TEST_RUNNER_REGISTER(MLDocumentTest);
+
+using namespace lv;
+
+namespace{
+
+// Generates a timeline-like document with many small objects
+std::string generateLargeJson(int tracks, int segments){
+    MLNode root(MLNode::Object);
+    MLNode trackList(MLNode::Array);
+    for ( int i = 0; i < tracks; ++i ){
+        MLNode segmentList(MLNode::Array);
+        for ( int j = 0; j < segments; ++j ){
+            segmentList.append({
+                {"position", j * 10},
+                {"length", 10},
+                {"label", "segment"},
+                {"factory", "qrc:/timeline/VideoSegmentFactory.qml"},
+                {"enabled", true},
+                {"speed", 1.5}
+            });
+        }
+        trackList.append({
+            {"name", "Track " + std::to_string(i)},
+            {"factory", "qrc:/timeline/VideoTrackFactory.qml"},
+            {"segments", segmentList}
+        });
+    }
+    root["tracks"] = trackList;
+    root["fps"] = 30.0;
+    root["contentLength"] = tracks * segments * 10;
+
+    std::string result;
+    ml::toJson(root, result);
+    return result;
+}
+
+MLNode::IntType traverse(const MLNode& n){
+    MLNode::IntType total = 0;
+    const MLNode& tracks = n["tracks"];
+    for ( int i = 0; i < tracks.size(); ++i ){
+        const MLNode& segments = tracks[i]["segments"];
+        for ( int j = 0; j < segments.size(); ++j ){
+            total += segments[j]["position"].asInt() + segments[j]["length"].asInt();
+        }
+    }
+    return total;
+}
+
+MLNode::IntType traverse(const MLDocument::Node& n){
+    MLNode::IntType total = 0;
+    const MLDocument::Node& tracks = n["tracks"];
+    for ( int i = 0; i < tracks.size(); ++i ){
+        const MLDocument::Node& segments = tracks[i]["segments"];
+        for ( int j = 0; j < segments.size(); ++j ){
+            total += segments[j]["position"].asInt() + segments[j]["length"].asInt();
+        }
+    }
+    return total;
+}
+
+} // namespace
+
+MLDocumentTest::MLDocumentTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+MLDocumentTest::~MLDocumentTest(){
+}
+
+void MLDocumentTest::initTestCase(){
+    m_largeJson = generateLargeJson(100, 200);
+}
+
+void MLDocumentTest::assignTest(){
+    MLNode n = {
+        {"object", {
+             {"string", "value1"},
+             {"key2", 100}
+        }},
+        {"array", { 100, "200", false}},
+        {"bool", true},
+        {"int", 100},
+        {"float", 100.1},
+        {"null", nullptr}
+    };
+
+    MLDocument doc;
+    doc.assign(n);
+
+    QCOMPARE(doc.root().type(), MLNode::Object);
+    QCOMPARE(doc.root().size(), 6);
+    QCOMPARE(doc.root().toString(), n.toString());
+    QCOMPARE(doc.toMLNode().toString(), n.toString());
+}
+
+void MLDocumentTest::accessorTest(){
+    MLNode::ByteType bytes[] = {1, 2, 3, 4};
+
+    MLNode n = {
+        {"short", "abc"},
+        {"long", "a string that does not fit inside the node"},
+        {"bytes", MLNode(bytes, 4)},
+        {"bigint", static_cast<MLNode::IntType>(1) << 40},
+        {"array", {1, 2, 3}}
+    };
+
+    MLDocument doc;
+    doc.assign(n);
+
+    const MLDocument::Node& root = doc.root();
+    QCOMPARE(root["short"].asString(), std::string("abc"));
+    QCOMPARE(root["long"].asString(), std::string("a string that does not fit inside the node"));
+    QCOMPARE(root["bytes"].bytesSize(), static_cast<size_t>(4));
+    QCOMPARE(root["bytes"].bytesData()[3], static_cast<MLNode::ByteType>(4));
+    QCOMPARE(root["bigint"].asLongInt(), static_cast<MLNode::IntType>(1) << 40);
+    QCOMPARE(root["array"][2].asInt(), 3);
+    QVERIFY(root.hasKey("short"));
+    QVERIFY(!root.hasKey("missing"));
+    QVERIFY(root["missing"].isNull());
+    QCOMPARE(root.memberAt(0).key(), std::string("array"));
+
+    bool isException = false;
+    try{
+        root["array"][3];
+    } catch ( MLOutOfRanceException& ){
+        isException = true;
+    }
+    QVERIFY(isException);
+
+    isException = false;
+    try{
+        root["short"].asInt();
+    } catch ( InvalidMLTypeException& ){
+        isException = true;
+    }
+    QVERIFY(isException);
+}
+
+void MLDocumentTest::jsonRoundTripTest(){
+    MLDocument doc;
+    ml::fromJson(m_largeJson, doc);
+
+    MLNode n;
+    ml::fromJson(m_largeJson, n);
+
+    QCOMPARE(traverse(doc.root()), traverse(n));
+
+    std::string docJson, nodeJson;
+    ml::toJson(doc, docJson);
+    ml::toJson(n, nodeJson);
+    QCOMPARE(docJson, nodeJson);
+}
+
+void MLDocumentTest::duplicateKeyTest(){
+    MLDocument doc;
+    ml::fromJson("{\"b\": 1, \"a\": 2, \"b\": 3}", doc);
+
+    QCOMPARE(doc.root().size(), 2);
+    QCOMPARE(doc.root()["a"].asInt(), 2);
+    QCOMPARE(doc.root()["b"].asInt(), 3);
+}
+
+void MLDocumentTest::sharedKeyTableTest(){
+    MLStringTable::Ptr keys(new MLStringTable);
+
+    MLDocument doc1(keys);
+    ml::fromJson("{\"position\": 1, \"length\": 2}", doc1);
+    MLDocument doc2(keys);
+    ml::fromJson("[{\"position\": 3}, {\"length\": 4}]", doc2);
+
+    QCOMPARE(keys->size(), static_cast<size_t>(2));
+    QCOMPARE(doc1.root().memberAt(1).keyEntry(), doc2.root()[0].memberAt(0).keyEntry());
+}
+
+void MLDocumentTest::benchmarkParseMLNode(){
+    QBENCHMARK{
+        MLNode n;
+        ml::fromJson(m_largeJson, n);
+    }
+}
+
+void MLDocumentTest::benchmarkParseMLDocument(){
+    MLStringTable::Ptr keys(new MLStringTable);
+    QBENCHMARK{
+        MLDocument doc(keys);
+        ml::fromJson(m_largeJson, doc);
+    }
+}
+
+void MLDocumentTest::benchmarkSerializeMLNode(){
+    MLNode n;
+    ml::fromJson(m_largeJson, n);
+
+    QBENCHMARK{
+        std::string result;
+        ml::toJson(n, result);
+    }
+}
+
+void MLDocumentTest::benchmarkSerializeMLDocument(){
+    MLDocument doc;
+    ml::fromJson(m_largeJson, doc);
+
+    QBENCHMARK{
+        std::string result;
+        ml::toJson(doc, result);
+    }
+}
+
+void MLDocumentTest::benchmarkTraverseMLNode(){
+    MLNode n;
+    ml::fromJson(m_largeJson, n);
+
+    MLNode::IntType total = 0;
+    QBENCHMARK{
+        total += traverse(n);
+    }
+    QVERIFY(total > 0);
+}
+
+void MLDocumentTest::benchmarkTraverseMLDocument(){
+    MLDocument doc;
+    ml::fromJson(m_largeJson, doc);
+
+    MLNode::IntType total = 0;
+    QBENCHMARK{
+        total += traverse(doc.root());
+    }
+    QVERIFY(total > 0);
+}
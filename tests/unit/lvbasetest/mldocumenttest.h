@@ -0,0 +1,53 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef MLDOCUMENTTEST_H
+#define MLDOCUMENTTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+#include "live/mlnode.h"
+#include "live/mldocument.h"
+
+class MLDocumentTest : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit MLDocumentTest(QObject *parent = 0);
+    ~MLDocumentTest();
+
+private slots:
+    void initTestCase();
+    void assignTest();
+    void accessorTest();
+    void jsonRoundTripTest();
+    void duplicateKeyTest();
+    void sharedKeyTableTest();
+
+    void benchmarkParseMLNode();
+    void benchmarkParseMLDocument();
+    void benchmarkSerializeMLNode();
+    void benchmarkSerializeMLDocument();
+    void benchmarkTraverseMLNode();
+    void benchmarkTraverseMLDocument();
+
+private:
+    std::string m_largeJson;
+};
+
+#endif // MLDOCUMENTTEST_H
@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "mljsonviewtest.h"
+#include "live/mlnodetojson.h"
+#include "live/exception.h"
+
+#include <cstdio>
+#include <fstream>
+
+Q_TEST_RUNNER_REGISTER(MLJsonViewTest);
+
+using namespace lv;
+
+MLJsonViewTest::MLJsonViewTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+MLJsonViewTest::~MLJsonViewTest(){
+}
+
+void MLJsonViewTest::initTestCase(){
+    MLNode items(MLNode::Array);
+    for ( int i = 0; i < 20000; ++i ){
+        items.append({
+            {"id", i},
+            {"name", "item" + std::to_string(i)},
+            {"tags", {"a", "b", "c"}},
+            {"weight", 0.5 * i}
+        });
+    }
+
+    MLNode root = {
+        {"items", items},
+        {"name", "large"},
+        {"version", "1.0.0"}
+    };
+    ml::toJson(root, m_largeJson);
+}
+
+void MLJsonViewTest::valueAccessTest(){
+    MLJsonView::Ptr view = MLJsonView::create(
+        "{\"object\":{\"string\":\"value1\",\"key2\":100}, \"array\":[100, \"200\", false, [1, 2], {}],"
+        " \"bool\":true, \"int\":-20, \"float\":1.5e2, \"null\":null}"
+    );
+
+    MLJsonView::Value root = view->root();
+    QCOMPARE(root.type(), MLNode::Object);
+    QCOMPARE(root.size(), 6);
+    QVERIFY(root.hasKey("null"));
+    QVERIFY(!root.hasKey("missing"));
+    QVERIFY(!root["missing"].isValid());
+    QVERIFY(root["null"].isNull());
+
+    QCOMPARE(root["object"]["string"].asString(), std::string("value1"));
+    QCOMPARE(root["object"]["key2"].asInt(), 100);
+    QCOMPARE(root["int"].type(), MLNode::Integer);
+    QCOMPARE(root["int"].asInt(), -20);
+    QCOMPARE(root["float"].type(), MLNode::Float);
+    QCOMPARE(root["float"].asFloat(), 150.0);
+    QCOMPARE(root["bool"].asBool(), true);
+
+    MLJsonView::Value arr = root["array"];
+    QCOMPARE(arr.type(), MLNode::Array);
+    QCOMPARE(arr.size(), 5);
+    QCOMPARE(arr[1].asString(), std::string("200"));
+    QCOMPARE(arr[2].asBool(), false);
+    QCOMPARE(arr[3].size(), 2);
+    QCOMPARE(arr[3][1].asInt(), 2);
+    QCOMPARE(arr[4].size(), 0);
+    QVERIFY(!arr[5].isValid());
+
+    std::vector<std::string> keys = root.keys();
+    QCOMPARE(keys.size(), static_cast<size_t>(6));
+    QCOMPARE(keys[0], std::string("object"));
+    QCOMPARE(keys[5], std::string("null"));
+
+    QCOMPARE(arr[3].rawJson(), std::string("[1, 2]"));
+
+    MLNode expected;
+    ml::fromJson(view->root().rawJson(), expected);
+    QCOMPARE(root.toMLNode().toString(), expected.toString());
+}
+
+void MLJsonViewTest::escapedStringTest(){
+    MLJsonView::Ptr view = MLJsonView::create("{\"quo\\\"te\":\"a\\\\\", \"b\":\"line\\nnext\\\"\"}");
+
+    MLJsonView::Value root = view->root();
+    QCOMPARE(root.size(), 2);
+    QCOMPARE(root["quo\"te"].asString(), std::string("a\\"));
+    QCOMPARE(root["b"].asString(), std::string("line\nnext\""));
+}
+
+void MLJsonViewTest::duplicateKeyTest(){
+    MLJsonView::Ptr view = MLJsonView::create("{\"a\":1,\"b\":2,\"a\":3}");
+
+    QCOMPARE(view->root().size(), 3);
+    QCOMPARE(view->root()["a"].asInt(), 3);
+}
+
+void MLJsonViewTest::partialDecodeTest(){
+    MLJsonView::Ptr view = MLJsonView::create(m_largeJson);
+
+    MLNode partial = view->root().toMLNode({"name", "version", "missing"});
+    QCOMPARE(partial.type(), MLNode::Object);
+    QCOMPARE(partial.size(), 2);
+    QCOMPARE(partial["name"].asString(), std::string("large"));
+    QCOMPARE(partial["version"].asString(), std::string("1.0.0"));
+
+    MLJsonView::Value item = view->root()["items"][19999];
+    QCOMPARE(item["name"].asString(), std::string("item19999"));
+    QCOMPARE(item["tags"][2].asString(), std::string("c"));
+}
+
+void MLJsonViewTest::fileMappingTest(){
+    std::string path = "mljsonviewtest.json";
+    {
+        std::ofstream out(path, std::ofstream::out | std::ofstream::binary);
+        out << "{\"name\": \"test\", \"dependencies\": {\"lvbase\": \"1.0.0\"}}";
+    }
+
+    {
+        MLJsonView::Ptr view = MLJsonView::createFromFile(path);
+        QCOMPARE(view->root()["name"].asString(), std::string("test"));
+        QCOMPARE(view->root()["dependencies"]["lvbase"].asString(), std::string("1.0.0"));
+    }
+
+    std::remove(path.c_str());
+
+    bool isException = false;
+    try{
+        MLJsonView::createFromFile(path);
+    } catch ( lv::Exception& ){
+        isException = true;
+    }
+    QVERIFY(isException);
+}
+
+void MLJsonViewTest::invalidStructureTest(){
+    const char* invalid[] = {"{\"a\":[1,2}", "{\"a\":\"b}", "[1,2]]", "{\"a\":1} 2"};
+    for ( size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i ){
+        bool isException = false;
+        try{
+            MLJsonView::create(invalid[i]);
+        } catch ( lv::Exception& ){
+            isException = true;
+        }
+        QVERIFY(isException);
+    }
+}
+
+void MLJsonViewTest::benchmarkFullParseLookup(){
+    QBENCHMARK{
+        MLNode n;
+        ml::fromJson(m_largeJson, n);
+        QCOMPARE(n["version"].asString(), std::string("1.0.0"));
+    }
+}
+
+void MLJsonViewTest::benchmarkViewLookup(){
+    QBENCHMARK{
+        MLJsonView::Ptr view = MLJsonView::create(m_largeJson.c_str(), m_largeJson.size());
+        QCOMPARE(view->root()["version"].asString(), std::string("1.0.0"));
+    }
+}
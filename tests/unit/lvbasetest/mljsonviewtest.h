@@ -0,0 +1,50 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef MLJSONVIEWTEST_H
+#define MLJSONVIEWTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+#include "live/mlnode.h"
+#include "live/mljsonview.h"
+
+class MLJsonViewTest : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit MLJsonViewTest(QObject *parent = 0);
+    ~MLJsonViewTest();
+
+private slots:
+    void initTestCase();
+    void valueAccessTest();
+    void escapedStringTest();
+    void duplicateKeyTest();
+    void partialDecodeTest();
+    void fileMappingTest();
+    void invalidStructureTest();
+
+    void benchmarkFullParseLookup();
+    void benchmarkViewLookup();
+
+private:
+    std::string m_largeJson;
+};
+
+#endif // MLJSONVIEWTEST_H
@@ -0,0 +1,186 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "mlnodetobinarytest.h"
+#include "live/mlnodetojson.h"
+
+Q_TEST_RUNNER_REGISTER(MLNodeToBinaryTest);
+
+using namespace lv;
+
+MLNodeToBinaryTest::MLNodeToBinaryTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+MLNodeToBinaryTest::~MLNodeToBinaryTest(){
+}
+
+void MLNodeToBinaryTest::initTestCase(){
+    std::vector<MLNode::ByteType> frame(64 * 1024);
+    for ( size_t i = 0; i < frame.size(); ++i )
+        frame[i] = static_cast<MLNode::ByteType>(i % 251);
+
+    m_large = MLNode(MLNode::Array);
+    for ( int i = 0; i < 200; ++i ){
+        m_large.append({
+            {"position", i * 10},
+            {"label", "segment " + std::to_string(i)},
+            {"speed", 1.5},
+            {"frame", MLNode(frame.data(), frame.size())}
+        });
+    }
+}
+
+void MLNodeToBinaryTest::binaryRoundTripTest(){
+    MLNode::ByteType bytes[] = {0, 1, 2, 255};
+
+    MLNode n = {
+        {"object", {
+             {"string", "value1"},
+             {"key2", 100}
+        }},
+        {"array", { 100, "200", false}},
+        {"bool", true},
+        {"int", 100},
+        {"negative", -100000},
+        {"large", static_cast<MLNode::IntType>(1) << 50},
+        {"float", 100.1},
+        {"bytes", MLNode(bytes, 4)},
+        {"null", nullptr}
+    };
+
+    std::string serialized;
+    ml::toBinary(n, serialized);
+    QVERIFY(ml::isBinary(serialized.c_str(), serialized.size()));
+
+    MLNode rt;
+    ml::fromBinary(serialized, rt);
+
+    QCOMPARE(rt.toString(), n.toString());
+    QCOMPARE(rt["large"].asLongInt(), static_cast<MLNode::IntType>(1) << 50);
+    QCOMPARE(rt["negative"].asInt(), -100000);
+    QCOMPARE(rt["float"].asFloat(), 100.1);
+    QCOMPARE(rt["bytes"].type(), MLNode::Bytes);
+    QCOMPARE(rt["bytes"].asBytes().size(), static_cast<size_t>(4));
+    QCOMPARE(rt["bytes"].asBytes().data()[3], static_cast<MLNode::ByteType>(255));
+}
+
+void MLNodeToBinaryTest::binaryEncodingTest(){
+    // Values from the CBOR specification (RFC 7049, Appendix A)
+    MLNode n = {1, -10, 1000000, true, nullptr, {"a"}};
+
+    std::string serialized;
+    ml::toBinary(n, serialized);
+
+    const char expected[] = "\xd9\xd9\xf7\x86\x01\x29\x1a\x00\x0f\x42\x40\xf5\xf6\x81\x61\x61";
+    QCOMPARE(serialized, std::string(expected, sizeof(expected) - 1));
+
+    // Decoding half and single precision floats
+    MLNode floats;
+    ml::fromBinary("\x82\xf9\x3e\x00\xfa\x47\xc3\x50\x00", 9, floats);
+    QCOMPARE(floats[0].asFloat(), 1.5);
+    QCOMPARE(floats[1].asFloat(), 100000.0);
+}
+
+void MLNodeToBinaryTest::binaryDocumentReferenceTest(){
+    std::string serialized;
+    ml::toBinary(m_large, serialized);
+
+    MLDocument doc;
+    ml::fromBinaryReference(serialized.c_str(), serialized.size(), doc);
+
+    QCOMPARE(doc.root().size(), 200);
+    const MLDocument::Node& frame = doc.root()[10]["frame"];
+    QCOMPARE(frame.bytesSize(), static_cast<size_t>(64 * 1024));
+    QVERIFY(frame.bytesData() > reinterpret_cast<const MLNode::ByteType*>(serialized.c_str()));
+    QVERIFY(frame.bytesData() < reinterpret_cast<const MLNode::ByteType*>(serialized.c_str() + serialized.size()));
+    QCOMPARE(frame.bytesData()[300], static_cast<MLNode::ByteType>(300 % 251));
+    QCOMPARE(doc.root()[10]["label"].asString(), std::string("segment 10"));
+
+    std::string reserialized;
+    ml::toBinary(doc, reserialized);
+    QCOMPARE(reserialized, serialized);
+}
+
+void MLNodeToBinaryTest::binaryInvalidDataTest(){
+    std::string serialized;
+    ml::toBinary(MLNode({{"key", "value"}}), serialized);
+
+    bool isException = false;
+    try{
+        MLNode n;
+        ml::fromBinary(serialized.c_str(), serialized.size() - 2, n);
+    } catch ( lv::Exception& ){
+        isException = true;
+    }
+    QVERIFY(isException);
+
+    isException = false;
+    try{
+        MLNode n;
+        ml::fromBinary("\xa1\x01\x02", 3, n); // non-string key
+    } catch ( lv::Exception& ){
+        isException = true;
+    }
+    QVERIFY(isException);
+
+    QVERIFY(!ml::isBinary("{}", 2));
+}
+
+void MLNodeToBinaryTest::benchmarkToJson(){
+    QBENCHMARK{
+        std::string result;
+        ml::toJson(m_large, result);
+    }
+}
+
+void MLNodeToBinaryTest::benchmarkToBinary(){
+    QBENCHMARK{
+        std::string result;
+        ml::toBinary(m_large, result);
+    }
+}
+
+void MLNodeToBinaryTest::benchmarkFromJson(){
+    std::string serialized;
+    ml::toJson(m_large, serialized);
+
+    QBENCHMARK{
+        MLNode n;
+        ml::fromJson(serialized, n);
+    }
+}
+
+void MLNodeToBinaryTest::benchmarkFromBinary(){
+    std::string serialized;
+    ml::toBinary(m_large, serialized);
+
+    QBENCHMARK{
+        MLNode n;
+        ml::fromBinary(serialized, n);
+    }
+}
+
+void MLNodeToBinaryTest::benchmarkFromBinaryReference(){
+    std::string serialized;
+    ml::toBinary(m_large, serialized);
+
+    QBENCHMARK{
+        MLDocument doc;
+        ml::fromBinaryReference(serialized.c_str(), serialized.size(), doc);
+    }
+}
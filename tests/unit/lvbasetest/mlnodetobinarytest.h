@@ -0,0 +1,51 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef MLNODETOBINARYTEST_H
+#define MLNODETOBINARYTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+#include "live/mlnode.h"
+#include "live/mlnodetobinary.h"
+
+class MLNodeToBinaryTest : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit MLNodeToBinaryTest(QObject *parent = 0);
+    ~MLNodeToBinaryTest();
+
+private slots:
+    void initTestCase();
+    void binaryRoundTripTest();
+    void binaryEncodingTest();
+    void binaryDocumentReferenceTest();
+    void binaryInvalidDataTest();
+
+    void benchmarkToJson();
+    void benchmarkToBinary();
+    void benchmarkFromJson();
+    void benchmarkFromBinary();
+    void benchmarkFromBinaryReference();
+
+private:
+    lv::MLNode m_large;
+};
+
+#endif // MLNODETOBINARYTEST_H
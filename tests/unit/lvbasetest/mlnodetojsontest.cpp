@@ -24,6 +24,30 @@ Q_TEST_RUNNER_REGISTER(MLNodeToJsonTest);
 
 using namespace lv;
 
+namespace{
+
+std::string generateLargeJson(int items){
+    MLNode list(MLNode::Array);
+    for ( int i = 0; i < items; ++i ){
+        list.append({
+            {"id", i},
+            {"name", "Item with a name long enough to be allocated " + std::to_string(i)},
+            {"path", "C:\\path\\to\\item"},
+            {"tags", {"a", "b", "c"}},
+            {"visible", i % 2 == 0},
+            {"weight", i * 0.5}
+        });
+    }
+    MLNode root(MLNode::Object);
+    root["items"] = list;
+
+    std::string result;
+    ml::toJson(root, result);
+    return result;
+}
+
+} // namespace
+
 MLNodeToJsonTest::MLNodeToJsonTest(QObject *parent)
     : QObject(parent)
 {
@@ -33,6 +57,7 @@ MLNodeToJsonTest::~MLNodeToJsonTest(){
 }
 
 void MLNodeToJsonTest::initTestCase(){
+    m_largeJson = generateLargeJson(20000);
 }
 
 void MLNodeToJsonTest::jsonSerializeTest(){
@@ -119,3 +144,113 @@ void MLNodeToJsonTest::jsonDeserializeTest(){
     QCOMPARE(rt["float"].asFloat(), 100.1);
     QVERIFY(rt["null"].isNull());
 }
+
+void MLNodeToJsonTest::jsonDuplicateKeyTest(){
+    MLNode rt;
+    ml::fromJson("{\"b\": 1, \"a\": [1, {\"c\": 2}], \"b\": 3}", rt);
+
+    QCOMPARE(rt.size(), 2);
+    QCOMPARE(rt["a"][1]["c"].asInt(), 2);
+    QCOMPARE(rt["b"].asInt(), 3);
+}
+
+void MLNodeToJsonTest::jsonInsituDeserializeTest(){
+    MLNode n = {
+        {"object", {
+             {"string", "value1"},
+             {"escaped", "line\nbreak \"quoted\""}
+        }},
+        {"array", { 100, "200", false}},
+        {"float", 100.1},
+        {"null", nullptr}
+    };
+
+    std::string serialized;
+    ml::toJson(n, serialized);
+
+    std::vector<char> buffer(serialized.begin(), serialized.end());
+    buffer.push_back('\0');
+
+    MLNode rt;
+    ml::fromJsonInsitu(buffer.data(), rt);
+
+    QCOMPARE(rt.toString(), n.toString());
+    QCOMPARE(rt["object"]["escaped"].asString(), MLNode::StringType("line\nbreak \"quoted\""));
+
+    MLDocument doc;
+    ml::fromJsonInsitu(serialized, doc);
+
+    QCOMPARE(doc.root().toString(), n.toString());
+    QCOMPARE(doc.root()["object"]["escaped"].asString(), MLNode::StringType("line\nbreak \"quoted\""));
+
+    bool isException = false;
+    try{
+        ml::fromJsonInsitu(std::string("{\"a\": "), doc);
+    } catch ( lv::Exception& ){
+        isException = true;
+    }
+    QVERIFY(isException);
+}
+
+void MLNodeToJsonTest::jsonSerializeToBufferTest(){
+    MLNode n = {
+        {"array", { 100, "200", false}},
+        {"string", "value"}
+    };
+
+    std::string expected;
+    ml::toJson(n, expected);
+
+    char small[8];
+    size_t required = ml::toJson(n, small, sizeof(small));
+    QCOMPARE(required, expected.size());
+    QCOMPARE(std::string(small, sizeof(small)), expected.substr(0, sizeof(small)));
+
+    std::vector<char> buffer(required + 1);
+    QCOMPARE(ml::toJson(n, buffer.data(), buffer.size()), required);
+    QCOMPARE(std::string(buffer.data()), expected);
+}
+
+void MLNodeToJsonTest::benchmarkFromJson(){
+    QBENCHMARK{
+        MLNode n;
+        ml::fromJson(m_largeJson.c_str(), n);
+    }
+}
+
+void MLNodeToJsonTest::benchmarkFromJsonInsitu(){
+    std::vector<char> buffer(m_largeJson.size() + 1);
+    QBENCHMARK{
+        memcpy(buffer.data(), m_largeJson.c_str(), m_largeJson.size() + 1);
+        MLNode n;
+        ml::fromJsonInsitu(buffer.data(), n);
+    }
+}
+
+void MLNodeToJsonTest::benchmarkFromJsonInsituDocument(){
+    MLStringTable::Ptr keys(new MLStringTable);
+    QBENCHMARK{
+        MLDocument doc(keys);
+        ml::fromJsonInsitu(m_largeJson, doc);
+    }
+}
+
+void MLNodeToJsonTest::benchmarkToJson(){
+    MLNode n;
+    ml::fromJson(m_largeJson.c_str(), n);
+
+    QBENCHMARK{
+        std::string result;
+        ml::toJson(n, result);
+    }
+}
+
+void MLNodeToJsonTest::benchmarkToJsonBuffer(){
+    MLNode n;
+    ml::fromJson(m_largeJson.c_str(), n);
+
+    std::vector<char> buffer(m_largeJson.size() + 1);
+    QBENCHMARK{
+        ml::toJson(n, buffer.data(), buffer.size());
+    }
+}
@@ -35,6 +35,18 @@ private slots:
     void initTestCase();
     void jsonSerializeTest();
     void jsonDeserializeTest();
+    void jsonDuplicateKeyTest();
+    void jsonInsituDeserializeTest();
+    void jsonSerializeToBufferTest();
+
+    void benchmarkFromJson();
+    void benchmarkFromJsonInsitu();
+    void benchmarkFromJsonInsituDocument();
+    void benchmarkToJson();
+    void benchmarkToJsonBuffer();
+
+private:
+    std::string m_largeJson;
 };
 
 #endif // MLNODETOJSONTEST_H
@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "tracetest.h"
+#include "live/trace.h"
+#include "live/mlnode.h"
+#include "live/mlnodetojson.h"
+
+#include <thread>
+
+Q_TEST_RUNNER_REGISTER(TraceTest);
+
+using namespace lv;
+
+TraceTest::TraceTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+TraceTest::~TraceTest(){
+}
+
+void TraceTest::cleanup(){
+    Trace::disable();
+    Trace::clear();
+}
+
+void TraceTest::disabledTest(){
+    {
+        vtrace("test", "disabled");
+    }
+    Trace::instant("test", "disabledInstant");
+
+    QVERIFY(Trace::events().empty());
+}
+
+void TraceTest::disabledDetailTest(){
+    int evaluations = 0;
+    auto detail = [&evaluations](){
+        ++evaluations;
+        return std::string("detail");
+    };
+
+    {
+        vtrace("test", "disabled", detail());
+    }
+    QCOMPARE(evaluations, 0);
+
+    Trace::enable();
+    {
+        vtrace("test", "enabled", detail());
+    }
+    QCOMPARE(evaluations, 1);
+
+    std::vector<Trace::Event> events = Trace::events();
+    QCOMPARE(events.size(), static_cast<size_t>(1));
+    QCOMPARE(events[0].detail, std::string("detail"));
+}
+
+void TraceTest::scopeTest(){
+    Trace::enable();
+    {
+        vtrace("test", "outer");
+        {
+            vtrace("test", "inner", "detail");
+        }
+        Trace::instant("test", "mark");
+    }
+
+    std::vector<Trace::Event> events = Trace::events();
+    QCOMPARE(events.size(), static_cast<size_t>(3));
+
+    QCOMPARE(std::string(events[0].name), std::string("inner"));
+    QCOMPARE(events[0].phase, 'X');
+    QCOMPARE(events[0].detail, std::string("detail"));
+
+    QCOMPARE(std::string(events[1].name), std::string("mark"));
+    QCOMPARE(events[1].phase, 'i');
+
+    QCOMPARE(std::string(events[2].name), std::string("outer"));
+    QVERIFY(events[2].timestamp <= events[0].timestamp);
+    QVERIFY(events[2].timestamp + events[2].duration >= events[0].timestamp + events[0].duration);
+}
+
+void TraceTest::threadTest(){
+    Trace::enable();
+    {
+        vtrace("test", "main");
+    }
+
+    std::thread th([](){
+        vtrace("test", "worker");
+    });
+    th.join();
+
+    std::vector<Trace::Event> events = Trace::events();
+    QCOMPARE(events.size(), static_cast<size_t>(2));
+    QVERIFY(events[0].thread != events[1].thread);
+}
+
+void TraceTest::chromeJsonTest(){
+    Trace::enable();
+    {
+        vtrace("test", "scope", "file.qml");
+    }
+    Trace::instant("test", "mark");
+
+    std::string result;
+    Trace::toChromeJson(result);
+
+    MLNode root;
+    ml::fromJson(result, root);
+
+    QVERIFY(root.hasKey("traceEvents"));
+    QCOMPARE(root["traceEvents"].size(), 2);
+
+    const MLNode& scope = root["traceEvents"][0];
+    QCOMPARE(scope["name"].asString(), std::string("scope"));
+    QCOMPARE(scope["cat"].asString(), std::string("test"));
+    QCOMPARE(scope["ph"].asString(), std::string("X"));
+    QVERIFY(scope.hasKey("dur"));
+    QCOMPARE(scope["args"]["detail"].asString(), std::string("file.qml"));
+
+    const MLNode& mark = root["traceEvents"][1];
+    QCOMPARE(mark["ph"].asString(), std::string("i"));
+    QVERIFY(!mark.hasKey("args"));
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#include "utf8test.h"
+#include "live/utf8.h"
+
+Q_TEST_RUNNER_REGISTER(Utf8Test);
+
+using namespace lv;
+
+Utf8Test::Utf8Test(QObject *parent)
+    : QObject(parent)
+{
+}
+
+Utf8Test::~Utf8Test(){
+}
+
+void Utf8Test::validationTest(){
+    std::string longAscii(100, 'a');
+
+    QVERIFY(Utf8("").isValid());
+    QVERIFY(Utf8(longAscii).isValid());
+    QVERIFY(Utf8(longAscii).isAscii());
+    QVERIFY(Utf8(longAscii + "\xc3\xa4" + longAscii).isValid());
+    QVERIFY(!Utf8(longAscii + "\xc3\xa4").isAscii());
+    QVERIFY(Utf8("\xe2\x82\xac \xf0\x9f\x98\x80").isValid());
+
+    // truncated sequence, after an ascii run longer than a vector
+    QVERIFY(!Utf8(longAscii + "\xc3").isValid());
+    // stray continuation byte
+    QVERIFY(!Utf8(longAscii + "\x80" + longAscii).isValid());
+    // overlong encoding of '/'
+    QVERIFY(!Utf8("\xc0\xaf").isValid());
+    QVERIFY(!Utf8("\xe0\x80\xaf").isValid());
+    // surrogate
+    QVERIFY(!Utf8("\xed\xa0\x80").isValid());
+    // above U+10FFFF
+    QVERIFY(!Utf8("\xf4\x90\x80\x80").isValid());
+}
+
+void Utf8Test::utfLengthTest(){
+    QCOMPARE(Utf8("").utfLength(), static_cast<size_t>(0));
+    QCOMPARE(Utf8("abc").utfLength(), static_cast<size_t>(3));
+
+    std::string mixed;
+    for ( int i = 0; i < 20; ++i )
+        mixed += "a\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80";
+    QCOMPARE(Utf8(mixed).utfLength(), static_cast<size_t>(80));
+}
+
+void Utf8Test::findLastTest(){
+    std::string str = "lang/" + std::string(40, 'p') + "#" + std::string(40, 'n') + "#Name";
+    Utf8 u(str);
+
+    for ( size_t offset = 0; offset < str.size() + 2; ++offset )
+        QCOMPARE(u.findLast('#', offset), str.rfind('#', offset));
+
+    QCOMPARE(u.findLast('#'), str.rfind('#'));
+    QCOMPARE(u.findLast('x'), std::string::npos);
+    QCOMPARE(Utf8("").findLast('x'), std::string::npos);
+}
+
+void Utf8Test::splitTest(){
+    std::vector<Utf8> segments = Utf8("a.bc..d.").split('.');
+    QCOMPARE(segments.size(), static_cast<size_t>(5));
+    QCOMPARE(segments[0].data(), std::string("a"));
+    QCOMPARE(segments[1].data(), std::string("bc"));
+    QCOMPARE(segments[2].data(), std::string(""));
+    QCOMPARE(segments[3].data(), std::string("d"));
+    QCOMPARE(segments[4].data(), std::string(""));
+
+    segments = Utf8("a::b::c").split("::");
+    QCOMPARE(segments.size(), static_cast<size_t>(3));
+    QCOMPARE(segments[2].data(), std::string("c"));
+
+    segments = Utf8("abc").split(",");
+    QCOMPARE(segments.size(), static_cast<size_t>(1));
+    QCOMPARE(segments[0].data(), std::string("abc"));
+}
+
+void Utf8Test::trimTest(){
+    QCOMPARE(Utf8(" \t a b \n").trim().data(), std::string("a b"));
+    QCOMPARE(Utf8(" \t a b \n").trimLeft().data(), std::string("a b \n"));
+    QCOMPARE(Utf8(" \t a b \n").trimRight().data(), std::string(" \t a b"));
+    QCOMPARE(Utf8("   ").trim().data(), std::string(""));
+    QCOMPARE(Utf8("\xc3\xa4 ").trim().data(), std::string("\xc3\xa4"));
+}
+
+void Utf8Test::caseTest(){
+    QCOMPARE(Utf8("Type_Name1").toLower().data(), std::string("type_name1"));
+    QCOMPARE(Utf8("Type_Name1").toUpper().data(), std::string("TYPE_NAME1"));
+    QCOMPARE(Utf8("\xc3\x84pfel").toLower().data(), std::string("\xc3\xa4pfel"));
+    QCOMPARE(Utf8("\xc3\xa4pfel").toUpper().data(), std::string("\xc3\x84PFEL"));
+}
+
+void Utf8Test::normalizeTest(){
+    Utf8 ascii("module.name");
+    QVERIFY(ascii.normalize() == ascii);
+
+    // 'e' followed by a combining acute accent, and the precomposed character
+    Utf8 decomposed("e\xcc\x81");
+    Utf8 composed("\xc3\xa9");
+
+    QCOMPARE(decomposed.normalize(Utf8::NFC).data(), composed.data());
+    QCOMPARE(composed.normalize(Utf8::NFD).data(), decomposed.data());
+    QCOMPARE(Utf8("\xef\xac\x81").normalize(Utf8::NFKC).data(), std::string("fi"));
+}
+
+void Utf8Test::internTest(){
+    Utf8 a = Utf8(std::string("Utf8Test.internTest")).intern();
+    Utf8 b = Utf8(std::string("Utf8Test.") + "internTest").intern();
+    Utf8 c = Utf8(std::string("Utf8Test.other")).intern();
+
+    QVERIFY(&a.data() == &b.data());
+    QVERIFY(&a.data() != &c.data());
+    QVERIFY(a == b);
+    QVERIFY(a != c);
+}
+
+void Utf8Test::benchmarkValidation(){
+    std::string content;
+    for ( int i = 0; i < 10000; ++i )
+        content += "import base 1.0\nComponent{ property string name: 'n\xc3\xa4me' }\n";
+    Utf8 u(content);
+
+    QBENCHMARK{
+        QVERIFY(u.isValid());
+    }
+}
@@ -0,0 +1,44 @@
+/****************************************************************************
+**
+** Copyright (C) 2014-2019 Dinu SV.
+** (contact: mail@dinusv.com)
+** This file is part of Livekeys Application.
+**
+** GNU Lesser General Public License Usage
+** This file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPLv3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl.html.
+**
+****************************************************************************/
+
+#ifndef UTF8TEST_H
+#define UTF8TEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class Utf8Test : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit Utf8Test(QObject *parent = 0);
+    ~Utf8Test();
+
+private slots:
+    void validationTest();
+    void utfLengthTest();
+    void findLastTest();
+    void splitTest();
+    void trimTest();
+    void caseTest();
+    void normalizeTest();
+    void internTest();
+    void benchmarkValidation();
+};
+
+#endif // UTF8TEST_H
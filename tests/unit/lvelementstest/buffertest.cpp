@@ -0,0 +1,185 @@
+#include "buffertest.h"
+#include "live/elements/engine.h"
+#include "live/elements/element.h"
+#include "live/elements/metaobject.h"
+#include "live/elements/buffer.h"
+#include "live/elements/bufferpool.h"
+
+Q_TEST_RUNNER_REGISTER(BufferTest);
+
+using namespace lv;
+using namespace lv::el;
+
+class BufferHolderStub : public Element{
+
+    META_OBJECT{
+        META_OBJECT_DESCRIBE(BufferHolderStub)
+            .base<Element>()
+            .constructor<>()
+            .scriptProperty<Buffer>("data", &BufferHolderStub::data, &BufferHolderStub::setData, "dataChanged")
+            .scriptEvent("dataChanged", &BufferHolderStub::dataChanged)
+        META_OBJECT_CLOSE
+    }
+
+public:
+    BufferHolderStub(Engine* engine) : Element(engine), m_data(nullptr, 0){}
+
+    Buffer data() const{ return m_data; }
+    void setData(Buffer data){
+        m_data = data;
+        dataChanged();
+    }
+
+    Event dataChanged(){ static Event::Id eid = eventId(&BufferHolderStub::dataChanged); return notify(eid); }
+
+private:
+    Buffer m_data;
+};
+
+BufferTest::BufferTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void BufferTest::initTestCase(){
+}
+
+void BufferTest::poolTest(){
+    BufferPool pool(1024);
+
+    void* first = pool.allocate(100);
+    pool.release(first, 100);
+    QCOMPARE(pool.cachedBytes(), static_cast<size_t>(128));
+
+    // Same size class reuses the block
+    void* second = pool.allocate(120);
+    QVERIFY(second == first);
+    QCOMPARE(pool.cachedBytes(), static_cast<size_t>(0));
+    pool.release(second, 120);
+
+    // Blocks over the cache limit are freed
+    void* large = pool.allocate(2000);
+    pool.release(large, 2000);
+    QCOMPARE(pool.cachedBytes(), static_cast<size_t>(128));
+
+    pool.clear();
+    QCOMPARE(pool.cachedBytes(), static_cast<size_t>(0));
+}
+
+void BufferTest::ownedBufferTest(){
+    Buffer b = Buffer::create(16);
+    QVERIFY(b.isOwned());
+    QCOMPARE(b.size(), static_cast<size_t>(16));
+    QCOMPARE(b.useCount(), 1l);
+    for ( size_t i = 0; i < b.size(); ++i )
+        QCOMPARE(b.dataAs<unsigned char*>()[i], static_cast<unsigned char>(0));
+
+    {
+        Buffer shared = b;
+        QVERIFY(shared.data() == b.data());
+        QCOMPARE(b.useCount(), 2l);
+    }
+    QCOMPARE(b.useCount(), 1l);
+
+    const char text[] = "buffer";
+    Buffer c = Buffer::copy(text, sizeof(text));
+    QVERIFY(c.isOwned());
+    QVERIFY(c.data() != text);
+    QCOMPARE(std::string(c.dataAs<const char*>()), std::string(text));
+
+    Buffer raw(const_cast<char*>(text), sizeof(text));
+    QVERIFY(!raw.isOwned());
+    QCOMPARE(raw.useCount(), 0l);
+}
+
+void BufferTest::cppToJsTest(){
+    Engine* engine = new Engine();
+    engine->scope([engine](){
+        BufferHolderStub* e = new BufferHolderStub(engine);
+        e->ref();
+
+        Buffer b = Buffer::create(4);
+        b.dataAs<unsigned char*>()[0] = 7;
+        e->setData(b);
+
+        Object::Accessor globalObject(engine->currentContext());
+        globalObject.set(engine, "e", ScopedValue(engine, e));
+
+        // Exposed without a copy, and as the same object while it's alive
+        Value v = engine->compileJsEnclosed("return new Uint8Array(e.data)[0];")->run();
+        QCOMPARE(v.asInt32(), 7);
+        v = engine->compileJsEnclosed("return e.data === e.data;")->run();
+        QCOMPARE(v.asBool(), true);
+
+        engine->compileJsEnclosed("new Uint8Array(e.data)[1] = 9;")->run();
+        QCOMPARE(static_cast<int>(b.dataAs<unsigned char*>()[1]), 9);
+
+        // Js keeps the data alive after c++ releases it
+        engine->compileJsEnclosed("kept = e.data;")->run();
+        b = Buffer(nullptr, 0);
+        e->setData(Buffer(nullptr, 0));
+        v = engine->compileJsEnclosed("return new Uint8Array(kept)[1];")->run();
+        QCOMPARE(v.asInt32(), 9);
+
+        delete e;
+    });
+    delete engine;
+}
+
+void BufferTest::jsToCppTest(){
+    Engine* engine = new Engine();
+    engine->scope([engine](){
+        BufferHolderStub* e = new BufferHolderStub(engine);
+        e->ref();
+
+        Object::Accessor globalObject(engine->currentContext());
+        globalObject.set(engine, "e", ScopedValue(engine, e));
+
+        engine->compileJsEnclosed(
+            "ab = new ArrayBuffer(8); new Uint8Array(ab)[0] = 3; e.data = ab;"
+        )->run();
+
+        // Ownership moved to an owned buffer shared with js
+        Buffer b = e->data();
+        QVERIFY(b.isOwned());
+        QCOMPARE(b.size(), static_cast<size_t>(8));
+        QCOMPARE(static_cast<int>(b.dataAs<unsigned char*>()[0]), 3);
+
+        engine->compileJsEnclosed("new Uint8Array(ab)[0] = 5;")->run();
+        QCOMPARE(static_cast<int>(b.dataAs<unsigned char*>()[0]), 5);
+
+        // Passing the same object back shares the existing storage
+        Value v = engine->compileJsEnclosed("e.data = ab; return e.data === ab;")->run();
+        QCOMPARE(v.asBool(), true);
+        QVERIFY(e->data().data() == b.data());
+
+        delete e;
+    });
+    delete engine;
+}
+
+void BufferTest::engineDisposalTest(){
+    Buffer b = Buffer::create(4);
+
+    Engine* engine = new Engine();
+    engine->scope([engine, &b](){
+        BufferHolderStub* e = new BufferHolderStub(engine);
+        e->ref();
+        e->setData(b);
+
+        Object::Accessor globalObject(engine->currentContext());
+        globalObject.set(engine, "e", ScopedValue(engine, e));
+
+        engine->compileJsEnclosed("kept = e.data;")->run();
+        e->setData(Buffer(nullptr, 0));
+
+        delete e;
+    });
+
+    // The object is still reachable from js, so its handle keeps the storage
+    QCOMPARE(b.useCount(), 2l);
+
+    // Handles still alive when the engine is disposed release the storage
+    delete engine;
+    QCOMPARE(b.useCount(), 1l);
+}
@@ -0,0 +1,25 @@
+#ifndef BUFFERTEST_H
+#define BUFFERTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class BufferTest : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit BufferTest(QObject *parent = nullptr);
+    ~BufferTest(){}
+
+private slots:
+    void initTestCase();
+    void poolTest();
+    void ownedBufferTest();
+    void cppToJsTest();
+    void jsToCppTest();
+    void engineDisposalTest();
+};
+
+#endif // BUFFERTEST_H
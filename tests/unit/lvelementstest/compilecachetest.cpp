@@ -0,0 +1,156 @@
+#include "compilecachetest.h"
+#include "live/elements/engine.h"
+#include "live/elements/element.h"
+#include "live/elements/component.h"
+#include "live/elements/compilecache.h"
+#include "live/applicationcontext.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+
+Q_TEST_RUNNER_REGISTER(CompileCacheTest);
+
+using namespace lv;
+using namespace lv::el;
+
+CompileCacheTest::CompileCacheTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void CompileCacheTest::initTestCase(){
+}
+
+void CompileCacheTest::keyTest(){
+    std::string key = CompileCache::createKey("A", "component A{}", "1.0");
+    QCOMPARE(key, CompileCache::createKey("A", "component A{}", "1.0"));
+    QVERIFY(key != CompileCache::createKey("B", "component A{}", "1.0"));
+    QVERIFY(key != CompileCache::createKey("A", "component B{}", "1.0"));
+    QVERIFY(key != CompileCache::createKey("A", "component A{}", "1.1"));
+}
+
+void CompileCacheTest::storeLookupTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    CompileCache cache(dir.path().toStdString() + "/compiled");
+
+    CompileCache::Entry entry;
+    QVERIFY(!cache.lookup("key", entry));
+
+    entry.js = "module.exports = 20";
+    entry.codeCache = std::string("\0\1\2\3", 4);
+    QVERIFY(cache.store("key", entry));
+
+    CompileCache::Entry result;
+    QVERIFY(cache.lookup("key", result));
+    QCOMPARE(result.js, entry.js);
+    QCOMPARE(result.codeCache, entry.codeCache);
+
+    entry.codeCache.clear();
+    QVERIFY(cache.store("key", entry));
+    QVERIFY(cache.lookup("key", result));
+    QVERIFY(result.codeCache.empty());
+
+    cache.remove("key");
+    QVERIFY(!cache.lookup("key", result));
+
+    QVERIFY(cache.store("key1", entry));
+    QVERIFY(cache.store("key2", entry));
+    cache.clear();
+    QVERIFY(!cache.lookup("key1", result));
+    QVERIFY(!cache.lookup("key2", result));
+}
+
+void CompileCacheTest::corruptEntryTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    CompileCache cache(dir.path().toStdString());
+
+    CompileCache::Entry entry;
+    entry.js = "module.exports = 20";
+    QVERIFY(cache.store("key", entry));
+
+    QFile file(dir.path() + "/key.lvc");
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 4));
+    file.close();
+
+    CompileCache::Entry result;
+    QVERIFY(!cache.lookup("key", result));
+
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("LVXX");
+    file.close();
+
+    QVERIFY(!cache.lookup("key", result));
+}
+
+void CompileCacheTest::pruneTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString cachePath = dir.path() + "/compiled";
+    CompileCache cache(cachePath.toStdString());
+
+    CompileCache::Entry entry;
+    entry.js = std::string(1000, 'a');
+    QVERIFY(cache.store("key1", entry));
+    QVERIFY(cache.store("key2", entry));
+    QVERIFY(cache.store("key3", entry));
+
+    QFileInfoList entries = QDir(cachePath).entryInfoList(QStringList() << "*.lvc", QDir::Files);
+    QCOMPARE(entries.size(), 3);
+    size_t entrySize = static_cast<size_t>(entries.first().size());
+
+    // the cache is pruned right away when it no longer fits
+    cache.setMaxSize(entrySize * 2);
+    QCOMPARE(QDir(cachePath).entryList(QStringList() << "*.lvc", QDir::Files).size(), 2);
+
+    // storing above the limit prunes down to three quarters of it
+    cache.setMaxSize(entrySize * 4);
+    QVERIFY(cache.store("key4", entry));
+    QVERIFY(cache.store("key5", entry));
+    QVERIFY(cache.store("key6", entry));
+    QCOMPARE(QDir(cachePath).entryList(QStringList() << "*.lvc", QDir::Files).size(), 3);
+}
+
+void CompileCacheTest::engineCompileTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    CompileCache::Ptr cache(new CompileCache(dir.path().toStdString()));
+
+    for ( int i = 0; i < 2; ++i ){
+        lv::el::Engine* engine = new lv::el::Engine();
+        engine->setCompileCache(cache);
+
+        engine->scope([engine](){
+            std::string scriptsPath = lv::ApplicationContext::instance().releasePath() + "/data/Test1.lv";
+            Script::Ptr sc = engine->compileModuleFile(scriptsPath);
+
+            ElementsPlugin::Ptr epl = ElementsPlugin::create(Plugin::createEmpty("test"), engine);
+            ModuleFile* mf = ElementsPlugin::addModuleFile(epl, "Test1");
+
+            Object m = sc->loadAsModule(mf);
+            Object::Accessor lm(m);
+            ScopedValue exports = lm.get(engine, "exports");
+
+            Object e = exports.toObject(engine);
+            Object::Accessor le(e);
+
+            Callable c = le.get(engine, "Test1").toCallable(engine);
+            QVERIFY(c.isComponent());
+
+            Element* elem = c.toComponent().create(Function::Parameters(0));
+            QVERIFY(elem->hasProperty("x"));
+            QVERIFY(elem->get("x").toInt32(engine) == 50);
+        });
+
+        delete engine;
+
+        QCOMPARE(QDir(dir.path()).entryList(QStringList() << "*.lvc", QDir::Files).size(), 1);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef COMPILECACHETEST_H
+#define COMPILECACHETEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class CompileCacheTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    CompileCacheTest(QObject* parent = nullptr);
+    ~CompileCacheTest(){}
+
+private slots:
+    void initTestCase();
+
+    void keyTest();
+    void storeLookupTest();
+    void corruptEntryTest();
+    void pruneTest();
+    void engineCompileTest();
+
+};
+
+#endif // COMPILECACHETEST_H
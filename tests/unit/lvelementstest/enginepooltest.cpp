@@ -0,0 +1,115 @@
+#include "enginepooltest.h"
+#include "live/elements/enginepool.h"
+#include "live/applicationcontext.h"
+
+#include "testpack.h"
+
+#include <QCoreApplication>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+
+Q_TEST_RUNNER_REGISTER(EnginePoolTest);
+
+using namespace lv;
+using namespace lv::el;
+
+EnginePoolTest::EnginePoolTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void EnginePoolTest::initTestCase(){
+    m_testPath = (QCoreApplication::applicationDirPath() + "/enginepooltest").toStdString();
+
+    TestPack tp(m_testPath);
+    tp.unpack(lv::ApplicationContext::instance().releasePath() + "/data/EnginePoolTest01.lv");
+}
+
+void EnginePoolTest::runTest(){
+    EnginePool pool(3);
+    QCOMPARE(pool.engineCount(), static_cast<size_t>(3));
+
+    std::atomic<int> runs(0);
+    std::mutex engineMutex;
+    std::set<Engine*> engines;
+
+    pool.run([&runs, &engineMutex, &engines](Engine* engine){
+        ++runs;
+        std::lock_guard<std::mutex> guard(engineMutex);
+        engines.insert(engine);
+    });
+
+    QCOMPARE(runs.load(), 3);
+    QCOMPARE(engines.size(), static_cast<size_t>(3));
+
+    // Engines are kept between jobs
+    pool.run([&runs, &engines](Engine* engine){
+        if ( engines.find(engine) != engines.end() )
+            ++runs;
+    });
+    QCOMPARE(runs.load(), 6);
+}
+
+void EnginePoolTest::mapTest(){
+    std::vector<MLNode> inputs;
+    for ( int i = 0; i < 100; ++i ){
+        MLNode input(MLNode::Object);
+        input["index"] = i;
+        input["value"] = i;
+        inputs.push_back(input);
+    }
+
+    EnginePool pool(4);
+    std::vector<EnginePool::Result> results = pool.map(m_testPath + "/main.lv.js", "square", inputs);
+
+    QCOMPARE(results.size(), inputs.size());
+    for ( int i = 0; i < 100; ++i ){
+        QVERIFY(!results[i].hasError());
+        QCOMPARE(results[i].value["index"].asInt(), i);
+        QCOMPARE(results[i].value["value"].asInt(), i * i);
+    }
+}
+
+void EnginePoolTest::mapBufferTest(){
+    std::vector<MLNode> inputs;
+    for ( int i = 1; i <= 10; ++i ){
+        MLNode input(MLNode::Object);
+        input["size"] = i * 8;
+        inputs.push_back(input);
+    }
+
+    EnginePool pool(2);
+    std::vector<EnginePool::Result> results = pool.map(m_testPath + "/main.lv.js", "bytes", inputs);
+
+    QCOMPARE(results.size(), inputs.size());
+    for ( size_t i = 0; i < results.size(); ++i ){
+        QVERIFY(!results[i].hasError());
+        QVERIFY(results[i].buffer.isOwned());
+        QCOMPARE(results[i].buffer.size(), (i + 1) * 8);
+        QCOMPARE(static_cast<int>(results[i].buffer.dataAs<unsigned char*>()[5]), 5);
+    }
+}
+
+void EnginePoolTest::mapErrorTest(){
+    std::vector<MLNode> inputs;
+    for ( int i = 0; i < 4; ++i ){
+        MLNode input(MLNode::Object);
+        input["index"] = i;
+        inputs.push_back(input);
+    }
+
+    EnginePool pool(2);
+    std::vector<EnginePool::Result> results = pool.map(m_testPath + "/main.lv.js", "fail", inputs);
+    for ( size_t i = 0; i < results.size(); ++i ){
+        QVERIFY(results[i].hasError());
+        QVERIFY(results[i].error.find("Failed input: " + std::to_string(i)) != std::string::npos);
+    }
+
+    results = pool.map(m_testPath + "/main.lv.js", "missing", inputs);
+    for ( size_t i = 0; i < results.size(); ++i ){
+        QVERIFY(results[i].hasError());
+        QVERIFY(results[i].error.find("missing") != std::string::npos);
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef ENGINEPOOLTEST_H
+#define ENGINEPOOLTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class EnginePoolTest : public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    explicit EnginePoolTest(QObject *parent = nullptr);
+    ~EnginePoolTest(){}
+
+private slots:
+    void initTestCase();
+    void runTest();
+    void mapTest();
+    void mapBufferTest();
+    void mapErrorTest();
+
+private:
+    std::string m_testPath;
+};
+
+#endif // ENGINEPOOLTEST_H
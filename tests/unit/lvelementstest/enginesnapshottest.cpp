@@ -0,0 +1,127 @@
+#include "enginesnapshottest.h"
+#include "live/elements/engine.h"
+#include "live/elements/element.h"
+#include "live/elements/component.h"
+#include "live/applicationcontext.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+
+Q_TEST_RUNNER_REGISTER(EngineSnapshotTest);
+
+using namespace lv;
+using namespace lv::el;
+
+EngineSnapshotTest::EngineSnapshotTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void EngineSnapshotTest::initTestCase(){
+}
+
+void EngineSnapshotTest::globalsTest(){
+    Engine::Snapshot::Ptr snapshot = Engine::createSnapshot();
+    QVERIFY(snapshot != nullptr);
+    QVERIFY(!snapshot->data().empty());
+
+    lv::el::Engine* engine = new lv::el::Engine(nullptr, snapshot);
+    engine->scope([engine](){
+        Script::Ptr s = engine->compileJsEnclosed(
+            "return [Element, List, Container, ErrorHandler, Tuple, Point, Size, Rectangle].every("
+            "function(t){ return typeof t === 'function'; }) && typeof vlog.i === 'function';"
+        );
+        QVERIFY(s->run().asBool());
+
+        Script::Ptr p = engine->compileJsEnclosed("var p = new Point(10, 20); return p.x + p.y;");
+        QCOMPARE(p->run().asInt32(), 30);
+    });
+    delete engine;
+}
+
+void EngineSnapshotTest::compileTest(){
+    Engine::Snapshot::Ptr snapshot = Engine::createSnapshot();
+
+    lv::el::Engine* engine = new lv::el::Engine(nullptr, snapshot);
+    engine->scope([engine](){
+        std::string scriptsPath = lv::ApplicationContext::instance().releasePath() + "/data/Test1.lv";
+        Script::Ptr sc = engine->compileModuleFile(scriptsPath);
+
+        ElementsPlugin::Ptr epl = ElementsPlugin::create(Plugin::createEmpty("test"), engine);
+        ModuleFile* mf = ElementsPlugin::addModuleFile(epl, "Test1");
+
+        Object m = sc->loadAsModule(mf);
+        Object::Accessor lm(m);
+        ScopedValue exports = lm.get(engine, "exports");
+
+        Object e = exports.toObject(engine);
+        Object::Accessor le(e);
+
+        Callable c = le.get(engine, "Test1").toCallable(engine);
+        QVERIFY(c.isComponent());
+        QVERIFY(engine->isElementConstructor(c));
+
+        Element* elem = c.toComponent().create(Function::Parameters(0));
+        QVERIFY(elem->get("x").toInt32(engine) == 50);
+
+        elem->set("y", ScopedValue(engine, 100));
+        QVERIFY(elem->get("x").toInt32(engine) == 130);
+    });
+    delete engine;
+}
+
+void EngineSnapshotTest::saveLoadTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    std::string path = dir.path().toStdString() + "/elements.snapshot";
+
+    Engine::Snapshot::Ptr snapshot = Engine::createSnapshot();
+    snapshot->save(path);
+
+    Engine::Snapshot::Ptr loaded = Engine::Snapshot::createFromFile(path);
+    QVERIFY(loaded != nullptr);
+    QCOMPARE(loaded->data(), snapshot->data());
+
+    QFile file(QString::fromStdString(path));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("lvsnapshot:0:0:0\n");
+    file.write(snapshot->data().data(), static_cast<qint64>(snapshot->data().size()));
+    file.close();
+
+    QVERIFY(Engine::Snapshot::createFromFile(path) == nullptr);
+    QVERIFY(Engine::Snapshot::createFromFile(path + ".missing") == nullptr);
+
+    // same format and engine, but written by a different lvelements build
+    snapshot->save(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray content = file.readAll();
+    file.close();
+
+    QByteArray buildId = QByteArray::fromStdString(Engine::Snapshot::buildId());
+    int headerEnd = content.indexOf('\n');
+    QVERIFY(headerEnd > 0);
+    QVERIFY(content.left(headerEnd).endsWith(":" + buildId));
+    content.replace(headerEnd - buildId.size(), buildId.size(), "other build");
+
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(content);
+    file.close();
+
+    QVERIFY(Engine::Snapshot::createFromFile(path) == nullptr);
+}
+
+void EngineSnapshotTest::createEngineBenchmark(){
+    QBENCHMARK{
+        lv::el::Engine* engine = new lv::el::Engine();
+        delete engine;
+    }
+}
+
+void EngineSnapshotTest::createEngineFromSnapshotBenchmark(){
+    Engine::Snapshot::Ptr snapshot = Engine::createSnapshot();
+    QBENCHMARK{
+        lv::el::Engine* engine = new lv::el::Engine(nullptr, snapshot);
+        delete engine;
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef ENGINESNAPSHOTTEST_H
+#define ENGINESNAPSHOTTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class EngineSnapshotTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    EngineSnapshotTest(QObject* parent = nullptr);
+    ~EngineSnapshotTest(){}
+
+private slots:
+    void initTestCase();
+
+    void globalsTest();
+    void compileTest();
+    void saveLoadTest();
+
+    void createEngineBenchmark();
+    void createEngineFromSnapshotBenchmark();
+
+};
+
+#endif // ENGINESNAPSHOTTEST_H
@@ -118,3 +118,30 @@ void EventTest::removeAllEventsFromWithinTest(){
     e.setValue(20.0);
     QCOMPARE(value, 20.0);
 }
+
+void EventTest::notifyBenchmark_data(){
+    QTest::addColumn<int>("listeners");
+
+    QTest::newRow("1 listener")    << 1;
+    QTest::newRow("10 listeners")  << 10;
+    QTest::newRow("100 listeners") << 100;
+}
+
+void EventTest::notifyBenchmark(){
+    QFETCH(int, listeners);
+
+    EventEmitter e(nullptr);
+
+    double total = 0;
+    for ( int i = 0; i < listeners; ++i ){
+        e.on(&EventEmitter::valueChanged, [&total](double v){
+            total += v;
+        });
+    }
+
+    QBENCHMARK{
+        e.setValue(1.0);
+    }
+
+    QVERIFY(total >= listeners);
+}
@@ -21,6 +21,9 @@ private slots:
 
     void removeEventFromWithinTest();
     void removeAllEventsFromWithinTest();
+
+    void notifyBenchmark_data();
+    void notifyBenchmark();
 };
 
 #endif // LVEVENTTEST_H
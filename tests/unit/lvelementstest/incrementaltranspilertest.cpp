@@ -0,0 +1,140 @@
+#include "incrementaltranspilertest.h"
+#include "live/elements/incrementaltranspiler.h"
+#include "live/elements/languageparser.h"
+#include "live/lockedfileiosession.h"
+#include "live/applicationcontext.h"
+
+Q_TEST_RUNNER_REGISTER(IncrementalTranspilerTest);
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+const char* componentsSource =
+    "component A < Element{\n"
+    "    int x : 20\n"
+    "}\n"
+    "\n"
+    "component B < A{\n"
+    "    int y : 30\n"
+    "}\n"
+    "\n"
+    "component default < B{\n"
+    "    int z : this.x + this.y\n"
+    "}\n";
+
+std::string replaceFirst(std::string source, const std::string& from, const std::string& to){
+    size_t pos = source.find(from);
+    if ( pos != std::string::npos )
+        source.replace(pos, from.size(), to);
+    return source;
+}
+
+}// namespace
+
+IncrementalTranspilerTest::IncrementalTranspilerTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void IncrementalTranspilerTest::initTestCase(){
+}
+
+void IncrementalTranspilerTest::editComponentTest(){
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+    IncrementalTranspiler transpiler(parser, "Test");
+
+    std::string source = componentsSource;
+    QCOMPARE(transpiler.toJs(source), parser->toJs(source, "Test"));
+    QCOMPARE(transpiler.lastTotalComponents(), size_t(3));
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(3));
+    QCOMPARE(transpiler.lastVisitedComponents(), size_t(3));
+
+    // unchanged components are neither converted, nor visited
+    source = replaceFirst(source, "int y : 30", "int y : 300 + this.x");
+    QCOMPARE(transpiler.toJs(source), parser->toJs(source, "Test"));
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(1));
+    QCOMPARE(transpiler.lastVisitedComponents(), size_t(1));
+
+    source = replaceFirst(source, "this.x + this.y", "this.y");
+    QCOMPARE(transpiler.toJs(source), parser->toJs(source, "Test"));
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(1));
+
+    QCOMPARE(transpiler.toJs(source), parser->toJs(source, "Test"));
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(1));
+}
+
+void IncrementalTranspilerTest::addComponentTest(){
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+    IncrementalTranspiler transpiler(parser, "Test");
+
+    std::string source = componentsSource;
+    transpiler.toJs(source);
+
+    // new declarations at program level require all components to be converted again
+    source += "\ncomponent C < Element{\n    int w : 10\n}\n";
+    QCOMPARE(transpiler.toJs(source), parser->toJs(source, "Test"));
+    QCOMPARE(transpiler.lastTotalComponents(), size_t(4));
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(4));
+    QCOMPARE(transpiler.lastVisitedComponents(), size_t(4));
+
+    // components referencing undeclared identifiers still add their imports when reused
+    source = replaceFirst(source, "component C < Element{", "component C < Rectangle{");
+    QCOMPARE(transpiler.toJs(source), parser->toJs(source, "Test"));
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(1));
+    QCOMPARE(transpiler.lastVisitedComponents(), size_t(1));
+
+    source = replaceFirst(source, "int w : 10", "int w : 11");
+    std::string js = transpiler.toJs(source);
+    QCOMPARE(js, parser->toJs(source, "Test"));
+    QVERIFY(js.find("imports.get('Rectangle')") != std::string::npos);
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(1));
+
+    transpiler.reset();
+    QCOMPARE(transpiler.toJs(source), parser->toJs(source, "Test"));
+    QCOMPARE(transpiler.lastConvertedComponents(), size_t(4));
+}
+
+void IncrementalTranspilerTest::createEditTest(){
+    TSInputEdit edit = IncrementalTranspiler::createEdit("ab\ncd\nef", "ab\ncXd\nef");
+    QCOMPARE(edit.start_byte, uint32_t(4));
+    QCOMPARE(edit.old_end_byte, uint32_t(4));
+    QCOMPARE(edit.new_end_byte, uint32_t(5));
+    QCOMPARE(edit.start_point.row, uint32_t(1));
+    QCOMPARE(edit.start_point.column, uint32_t(1));
+    QCOMPARE(edit.new_end_point.row, uint32_t(1));
+    QCOMPARE(edit.new_end_point.column, uint32_t(2));
+
+    edit = IncrementalTranspiler::createEdit("ab\ncd\nef", "ab\nef");
+    QCOMPARE(edit.start_byte, uint32_t(3));
+    QCOMPARE(edit.old_end_byte, uint32_t(6));
+    QCOMPARE(edit.new_end_byte, uint32_t(3));
+    QCOMPARE(edit.old_end_point.row, uint32_t(2));
+    QCOMPARE(edit.old_end_point.column, uint32_t(0));
+
+    edit = IncrementalTranspiler::createEdit("", "abc");
+    QCOMPARE(edit.start_byte, uint32_t(0));
+    QCOMPARE(edit.old_end_byte, uint32_t(0));
+    QCOMPARE(edit.new_end_byte, uint32_t(3));
+}
+
+void IncrementalTranspilerTest::parserFilesTest(){
+    LockedFileIOSession::Ptr fileSession = LockedFileIOSession::createInstance();
+    std::string scriptPath = lv::ApplicationContext::instance().releasePath() + "/data";
+
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+    for ( int i = 1; i <= 5; ++i ){
+        std::string contents = fileSession->readFromFile(scriptPath + "/ParserTest" + std::to_string(i) + ".lv");
+        IncrementalTranspiler transpiler(parser);
+
+        QCOMPARE(transpiler.toJs(contents), parser->toJs(contents));
+
+        // whitespace at the end of the file does not change any component
+        contents += "\n";
+        QCOMPARE(transpiler.toJs(contents), parser->toJs(contents));
+        QCOMPARE(transpiler.lastConvertedComponents(), size_t(0));
+        QCOMPARE(transpiler.lastVisitedComponents(), size_t(0));
+    }
+}
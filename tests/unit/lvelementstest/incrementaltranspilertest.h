@@ -0,0 +1,26 @@
+#ifndef INCREMENTALTRANSPILERTEST_H
+#define INCREMENTALTRANSPILERTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class IncrementalTranspilerTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    IncrementalTranspilerTest(QObject* parent = nullptr);
+    ~IncrementalTranspilerTest(){}
+
+private slots:
+    void initTestCase();
+
+    void editComponentTest();
+    void addComponentTest();
+    void createEditTest();
+    void parserFilesTest();
+
+};
+
+#endif // INCREMENTALTRANSPILERTEST_H
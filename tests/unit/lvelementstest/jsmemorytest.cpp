@@ -28,6 +28,33 @@ public:
 
 };
 
+class PooledMemoryStub : public Element{
+
+    META_OBJECT{
+        META_OBJECT_DESCRIBE(PooledMemoryStub)
+            .base<Element>()
+            .constructor<>()
+            .pooled()
+        META_OBJECT_CLOSE
+    }
+
+public:
+    PooledMemoryStub(Engine* engine) : Element(engine){}
+};
+
+class UnpooledMemoryStub : public Element{
+
+    META_OBJECT{
+        META_OBJECT_DESCRIBE(UnpooledMemoryStub)
+            .base<Element>()
+            .constructor<>()
+        META_OBJECT_CLOSE
+    }
+
+public:
+    UnpooledMemoryStub(Engine* engine) : Element(engine){}
+};
+
 JsMemoryTest::JsMemoryTest(QObject *parent)
     : QObject(parent)
 {
@@ -121,3 +148,68 @@ void JsMemoryTest::jsAllocationTest(){
 
     delete engine;
 }
+
+void JsMemoryTest::pooledAllocationTest(){
+    Engine* engine = new Engine();
+    {
+        ElementPool* pool = PooledMemoryStub::metaObject().pool();
+        QVERIFY(pool != nullptr);
+        QVERIFY(UnpooledMemoryStub::metaObject().pool() == nullptr);
+
+        size_t reused = pool->totalReused();
+
+        PooledMemoryStub* e = Element::create<PooledMemoryStub>(engine);
+        e->addProperty("p", "int", ScopedValue(engine, 200), false, false, "");
+        void* address = e;
+        delete e;
+
+        QVERIFY(pool->available() > 0);
+
+        // The block is reused, without the previous instance properties
+        PooledMemoryStub* e2 = Element::create<PooledMemoryStub>(engine);
+        QVERIFY(static_cast<void*>(e2) == address);
+        QCOMPARE(pool->totalReused(), reused + 1);
+        QVERIFY(!e2->hasProperty("p"));
+        delete e2;
+
+        // Unused blocks are freed after a full generation
+        pool->nextGeneration();
+        pool->nextGeneration();
+        QCOMPARE(pool->available(), static_cast<size_t>(0));
+
+        // Blocks released above the total capacity of all pools are freed
+        size_t totalCapacity = ElementPool::totalCapacity();
+        ElementPool::setTotalCapacity(ElementPool::totalAvailable());
+        delete Element::create<PooledMemoryStub>(engine);
+        QCOMPARE(pool->available(), static_cast<size_t>(0));
+        ElementPool::setTotalCapacity(totalCapacity);
+    }
+    delete engine;
+}
+
+void JsMemoryTest::allocationBenchmark_data(){
+    QTest::addColumn<bool>("pooled");
+
+    QTest::newRow("unpooled") << false;
+    QTest::newRow("pooled") << true;
+}
+
+void JsMemoryTest::allocationBenchmark(){
+    QFETCH(bool, pooled);
+
+    Engine* engine = new Engine();
+    std::vector<Element*> elements(1000, nullptr);
+
+    QBENCHMARK{
+        for ( size_t i = 0; i < elements.size(); ++i ){
+            if ( pooled )
+                elements[i] = Element::create<PooledMemoryStub>(engine);
+            else
+                elements[i] = Element::create<UnpooledMemoryStub>(engine);
+        }
+        for ( size_t i = 0; i < elements.size(); ++i )
+            delete elements[i];
+    }
+
+    delete engine;
+}
@@ -19,6 +19,9 @@ private slots:
     void multiParentTest();
     void multiLevelTest();
     void jsAllocationTest();
+    void pooledAllocationTest();
+    void allocationBenchmark_data();
+    void allocationBenchmark();
 
 };
 
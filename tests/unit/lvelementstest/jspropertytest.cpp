@@ -541,6 +541,51 @@ void JsPropertyTest::propertyInheritance(){
     delete engine;
 }
 
+void JsPropertyTest::propertyKeyTest(){
+    PropertyKey k1("intProperty");
+    PropertyKey k2(std::string("intProperty"));
+    PropertyKey k3("boolProperty");
+    QVERIFY(k1 == k2);
+    QVERIFY(k1 != k3);
+    QCOMPARE(k1.name(), std::string("intProperty"));
+
+    Engine* engine = new Engine();
+    {
+        engine->scope([engine, &k1](){
+            PropertyTypesStub* e = new PropertyTypesStub(engine);
+            e->ref();
+
+            QVERIFY(e->hasProperty(k1));
+            QVERIFY(e->property(k1) == e->property("intProperty"));
+
+            e->set(k1, ScopedValue(engine, 20));
+            QCOMPARE(e->intProperty(), 20);
+            QCOMPARE(e->get(k1).toInt32(engine), 20);
+
+            // Lookups through a different meta object use the same key
+            PropertyTypesInheritLevel2Stub* e2 = new PropertyTypesInheritLevel2Stub(engine);
+            e2->ref();
+            e2->set(k1, ScopedValue(engine, 30));
+            QCOMPARE(e2->intOverrideProperty(), 30);
+            QCOMPARE(e->get(k1).toInt32(engine), 20);
+
+            // Instance properties are found by name, without being assigned an id
+            PropertyKey dynamicKey("dynamicProperty");
+            QCOMPARE(dynamicKey.id(), PropertyKey::NoId);
+            QVERIFY(k1.id() != PropertyKey::NoId);
+            QVERIFY(!e->hasProperty(dynamicKey));
+            e->addProperty("dynamicProperty", "int", ScopedValue(engine, 10), false, false, "");
+            QVERIFY(e->hasProperty(dynamicKey));
+            QCOMPARE(e->get(dynamicKey).toInt32(engine), 10);
+
+            delete e2;
+            delete e;
+        });
+    }
+
+    delete engine;
+}
+
 void JsPropertyTest::dynamicReadOnlyProperty(){
     Engine* engine = new Engine();
     {
@@ -751,3 +796,216 @@ void JsPropertyTest::jsDynamicPropertyWithAddedExpression(){
 
     delete engine;
 }
+
+void JsPropertyTest::jsBatchedPropertyExpression(){
+    Engine* engine = new Engine();
+    {
+        engine->scope([engine](){
+            Element* e = new Element(engine);
+            e->ref();
+            e->addProperty("p", "int", ScopedValue(engine, 0), false, true, "pChanged");
+
+            Element* x = new Element(engine);
+            x->addProperty("value", "int", ScopedValue(engine, 200), false, true, "valueChanged");
+
+            Element* y = new Element(engine);
+            y->addProperty("value", "int", ScopedValue(engine, 200), false, true, "valueChanged");
+
+            Object::Accessor globalObject(engine->currentContext());
+            globalObject.set(engine, "e", ScopedValue(engine, e));
+            globalObject.set(engine, "x", ScopedValue(engine, x));
+            globalObject.set(engine, "y", ScopedValue(engine, y));
+
+            Script::Ptr s = engine->compileJs(
+                "var evaluations = 0;"
+                "Element.assignPropertyExpression("
+                    "e, 'p', function(){ ++evaluations; return x.value + y.value; }, [[x, 'valueChanged'], [y,'valueChanged']]"
+                ");"
+            );
+            s->run();
+
+            QCOMPARE(e->get("p").toInt32(engine), 400);
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 1);
+
+            engine->batch([engine, x, y](){
+                x->set("value", ScopedValue(engine, 500));
+                y->set("value", ScopedValue(engine, 300));
+            });
+            QCOMPARE(e->get("p").toInt32(engine), 800);
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 2);
+
+            Script::Ptr sb = engine->compileJs(
+                "Element.batch(function(){ x.value = 10; y.value = 20; x.value = 30; });"
+            );
+            sb->run();
+            QCOMPARE(e->get("p").toInt32(engine), 50);
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 3);
+
+            // unbatched changes still propagate immediately
+            x->set("value", ScopedValue(engine, 100));
+            QCOMPARE(e->get("p").toInt32(engine), 120);
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 4);
+
+            delete e;
+        });
+    }
+
+    delete engine;
+}
+
+void JsPropertyTest::jsGlitchFreePropertyExpression(){
+    Engine* engine = new Engine();
+    {
+        engine->scope([engine](){
+            Element* x = new Element(engine);
+            x->addProperty("value", "int", ScopedValue(engine, 1), false, true, "valueChanged");
+
+            Element* b = new Element(engine);
+            b->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Element* c = new Element(engine);
+            c->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Element* d = new Element(engine);
+            d->ref();
+            d->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Object::Accessor globalObject(engine->currentContext());
+            globalObject.set(engine, "x", ScopedValue(engine, x));
+            globalObject.set(engine, "b", ScopedValue(engine, b));
+            globalObject.set(engine, "c", ScopedValue(engine, c));
+            globalObject.set(engine, "d", ScopedValue(engine, d));
+
+            // d depends on x through both b and c, and should only see consistent values
+            Script::Ptr s = engine->compileJs(
+                "var evaluations = 0;"
+                "var glitches = 0;"
+                "Element.assignPropertyExpression(d, 'value', function(){"
+                    "++evaluations;"
+                    "if ( b.value * 3 !== c.value * 2 ) ++glitches;"
+                    "return b.value + c.value;"
+                "}, [[b, 'valueChanged'], [c,'valueChanged']]);"
+                "Element.assignPropertyExpression(b, 'value', function(){ return x.value * 2; }, [[x, 'valueChanged']]);"
+                "Element.assignPropertyExpression(c, 'value', function(){ return x.value * 3; }, [[x, 'valueChanged']]);"
+                "evaluations = 0;"
+                "glitches = 0;"
+            );
+            s->run();
+
+            x->set("value", ScopedValue(engine, 2));
+            QCOMPARE(d->get("value").toInt32(engine), 10);
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 1);
+            QCOMPARE(globalObject.get(engine, "glitches").toInt32(engine), 0);
+
+            x->set("value", ScopedValue(engine, 5));
+            QCOMPARE(d->get("value").toInt32(engine), 25);
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 2);
+            QCOMPARE(globalObject.get(engine, "glitches").toInt32(engine), 0);
+
+            delete d;
+        });
+    }
+
+    delete engine;
+}
+
+void JsPropertyTest::jsRescheduledPropertyExpression(){
+    Engine* engine = new Engine();
+    {
+        engine->scope([engine](){
+            Element* x = new Element(engine);
+            x->addProperty("value", "int", ScopedValue(engine, 1), false, true, "valueChanged");
+
+            Element* y = new Element(engine);
+            y->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Element* e = new Element(engine);
+            e->ref();
+            e->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Element* f = new Element(engine);
+            f->ref();
+            f->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            // writes y after f is evaluated, which is after e was already evaluated in the same transaction
+            f->on("valueChanged", [engine, f, y](const Function::Parameters&){
+                y->set("value", ScopedValue(engine, f->get("value").toInt32(engine) * 10));
+            });
+
+            Object::Accessor globalObject(engine->currentContext());
+            globalObject.set(engine, "x", ScopedValue(engine, x));
+            globalObject.set(engine, "y", ScopedValue(engine, y));
+            globalObject.set(engine, "e", ScopedValue(engine, e));
+            globalObject.set(engine, "f", ScopedValue(engine, f));
+
+            Script::Ptr s = engine->compileJs(
+                "var evaluations = 0;"
+                "Element.assignPropertyExpression(e, 'value', function(){"
+                    "++evaluations;"
+                    "return x.value + y.value;"
+                "}, [[x, 'valueChanged'], [y,'valueChanged']]);"
+                "Element.assignPropertyExpression(f, 'value', function(){ return x.value * 2; }, [[x, 'valueChanged']]);"
+                "evaluations = 0;"
+            );
+            s->run();
+
+            x->set("value", ScopedValue(engine, 2));
+            QCOMPARE(f->get("value").toInt32(engine), 4);
+            QCOMPARE(y->get("value").toInt32(engine), 40);
+            QCOMPARE(e->get("value").toInt32(engine), 42);
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 2);
+
+            delete e;
+            delete f;
+        });
+    }
+
+    delete engine;
+}
+
+void JsPropertyTest::jsCyclicPropertyExpression(){
+    Engine* engine = new Engine();
+    {
+        engine->scope([engine](){
+            Element* a = new Element(engine);
+            a->ref();
+            a->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Element* b = new Element(engine);
+            b->ref();
+            b->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Element* x = new Element(engine);
+            x->addProperty("value", "int", ScopedValue(engine, 0), false, true, "valueChanged");
+
+            Object::Accessor globalObject(engine->currentContext());
+            globalObject.set(engine, "a", ScopedValue(engine, a));
+            globalObject.set(engine, "b", ScopedValue(engine, b));
+            globalObject.set(engine, "x", ScopedValue(engine, x));
+
+            // a and b depend on each other, and are evaluated once per transaction
+            Script::Ptr s = engine->compileJs(
+                "var evaluations = 0;"
+                "Element.assignPropertyExpression(a, 'value', function(){"
+                    "++evaluations;"
+                    "return b.value + x.value;"
+                "}, [[b, 'valueChanged'], [x, 'valueChanged']]);"
+                "Element.assignPropertyExpression(b, 'value', function(){"
+                    "++evaluations;"
+                    "return a.value + 1;"
+                "}, [[a, 'valueChanged']]);"
+                "evaluations = 0;"
+            );
+            s->run();
+
+            x->set("value", ScopedValue(engine, 10));
+            QCOMPARE(globalObject.get(engine, "evaluations").toInt32(engine), 2);
+            QCOMPARE(b->get("value").toInt32(engine), a->get("value").toInt32(engine) + 1);
+
+            delete a;
+            delete b;
+        });
+    }
+
+    delete engine;
+}
@@ -21,6 +21,7 @@ private slots:
     void defaultProperty();
     void propertyWithExpression();
     void propertyInheritance();
+    void propertyKeyTest();
 
     void dynamicReadOnlyProperty();
     void dynamicProperty();
@@ -31,6 +32,10 @@ private slots:
     void dynamicDefaultProperty();
     void jsDynamicPropertyWithAssignedExpression();
     void jsDynamicPropertyWithAddedExpression();
+    void jsBatchedPropertyExpression();
+    void jsGlitchFreePropertyExpression();
+    void jsRescheduledPropertyExpression();
+    void jsCyclicPropertyExpression();
 
 };
 
@@ -0,0 +1,211 @@
+#include "languageinfocachetest.h"
+#include "scannertestutils.h"
+#include "live/elements/languageinfocache.h"
+#include "live/elements/parseddocument.h"
+#include "live/mlnodetobinary.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+
+Q_TEST_RUNNER_REGISTER(LanguageInfoCacheTest);
+
+using namespace lv;
+using namespace lv::el;
+
+using namespace scannertest;
+
+LanguageInfoCacheTest::LanguageInfoCacheTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void LanguageInfoCacheTest::initTestCase(){
+}
+
+void LanguageInfoCacheTest::keyTest(){
+    std::string key = LanguageInfoCache::createKey("component A{}", "13");
+    QCOMPARE(key, LanguageInfoCache::createKey("component A{}", "13"));
+    QVERIFY(key != LanguageInfoCache::createKey("component B{}", "13"));
+    QVERIFY(key != LanguageInfoCache::createKey("component A{}", "14"));
+}
+
+void LanguageInfoCacheTest::storeLookupTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    std::string cachePath = dir.path().toStdString() + "/" + LanguageInfoCache::fileName;
+
+    DocumentInfo::Ptr info = DocumentInfo::create();
+    info->addType(TypeInfo::create("A", "Element", true, false));
+    info->addImport(ImportInfo({"plugin", "a"}, "a"));
+
+    LanguageInfoCache cache(cachePath);
+    QVERIFY(!cache.load());
+    QVERIFY(!cache.lookup("A.lv", "key1"));
+
+    cache.store("A.lv", "key1", info);
+    QVERIFY(cache.isModified());
+    QVERIFY(cache.save());
+    QVERIFY(!cache.isModified());
+
+    LanguageInfoCache loaded(cachePath);
+    QVERIFY(loaded.load());
+    QCOMPARE(loaded.size(), static_cast<size_t>(1));
+    QVERIFY(!loaded.lookup("A.lv", "key2"));
+
+    DocumentInfo::Ptr result = loaded.lookup("A.lv", "key1");
+    QVERIFY(result != nullptr);
+    QCOMPARE(result->totalTypes(), static_cast<size_t>(1));
+    QCOMPARE(result->typeAt(0)->typeName().data(), std::string("A"));
+    QCOMPARE(result->totalImports(), static_cast<size_t>(1));
+    QCOMPARE(result->importAt(0).importAs().data(), std::string("a"));
+
+    loaded.remove("A.lv");
+    QVERIFY(!loaded.lookup("A.lv", "key1"));
+}
+
+void LanguageInfoCacheTest::scannerCacheTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString packagePath = createPackage(dir.path(), "scancache", {}, 3);
+
+    ModuleInfo::ConstPtr module = scanModule(dir.path(), "scancache");
+    QVERIFY(module != nullptr);
+    QCOMPARE(module->totalUnresolvedDocuments(), static_cast<size_t>(3));
+
+    std::string infoVersion = std::to_string(ParsedDocument::InfoVersion);
+    std::string cachePath = packagePath.toStdString() + "/" + LanguageInfoCache::fileName;
+
+    LanguageInfoCache cache(cachePath);
+    QVERIFY(cache.load());
+    QCOMPARE(cache.size(), static_cast<size_t>(3));
+
+    std::string d1Path = packagePath.toStdString() + "/D1.lv";
+    QVERIFY(cache.lookup(d1Path, LanguageInfoCache::createKey(documentSource(1), infoVersion)) != nullptr);
+
+    // a changed document is scanned again, and replaces its entry
+    writeFile(packagePath + "/D1.lv", documentSource(1, 2));
+
+    module = scanModule(dir.path(), "scancache");
+    QVERIFY(module != nullptr);
+    QCOMPARE(module->unresolvedDocumentAt(0)->totalTypes(), static_cast<size_t>(1));
+    QCOMPARE(module->unresolvedDocumentAt(1)->totalTypes(), static_cast<size_t>(2));
+
+    QVERIFY(cache.load());
+    QVERIFY(cache.lookup(d1Path, LanguageInfoCache::createKey(documentSource(1), infoVersion)) == nullptr);
+    QVERIFY(cache.lookup(d1Path, LanguageInfoCache::createKey(documentSource(1, 2), infoVersion)) != nullptr);
+}
+
+void LanguageInfoCacheTest::corruptCacheTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString packagePath = createPackage(dir.path(), "scancorrupt", {}, 2);
+
+    QString cachePath = packagePath + "/" + LanguageInfoCache::fileName;
+    writeFile(cachePath, "not a cache");
+
+    LanguageInfoCache cache(cachePath.toStdString());
+    QVERIFY(!cache.load());
+
+    ModuleInfo::ConstPtr module = scanModule(dir.path(), "scancorrupt");
+    QVERIFY(module != nullptr);
+    QCOMPARE(module->totalUnresolvedDocuments(), static_cast<size_t>(2));
+
+    QVERIFY(cache.load());
+    QCOMPARE(cache.size(), static_cast<size_t>(2));
+
+    QFile file(cachePath);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() / 2));
+    file.close();
+
+    QVERIFY(!cache.load());
+    QCOMPARE(cache.size(), static_cast<size_t>(0));
+
+    module = scanModule(dir.path(), "scancorrupt");
+    QVERIFY(module != nullptr);
+    QCOMPARE(module->totalUnresolvedDocuments(), static_cast<size_t>(2));
+}
+
+void LanguageInfoCacheTest::versionMismatchTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QString packagePath = createPackage(dir.path(), "scanversion", {}, 2);
+    std::string cachePath = packagePath.toStdString() + "/" + LanguageInfoCache::fileName;
+    std::string d0Path = packagePath.toStdString() + "/D0.lv";
+    std::string key = LanguageInfoCache::createKey(documentSource(0), std::to_string(ParsedDocument::InfoVersion));
+
+    // a cache written by a different format version, with a stale entry under the current key
+    DocumentInfo::Ptr stale = DocumentInfo::create();
+    stale->addType(TypeInfo::create("Stale", "Element", true, false));
+
+    MLNode entries(MLNode::Object);
+    entries[d0Path] = {
+        {"key", key},
+        {"info", stale->toMLNode()}
+    };
+    MLNode root = {
+        {"version", LanguageInfoCache::FormatVersion + 1},
+        {"entries", entries}
+    };
+
+    std::string serialized;
+    ml::toBinary(root, serialized);
+    writeFile(QString::fromStdString(cachePath), serialized);
+
+    LanguageInfoCache cache(cachePath);
+    QVERIFY(!cache.load());
+    QCOMPARE(cache.size(), static_cast<size_t>(0));
+
+    ModuleInfo::ConstPtr module = scanModule(dir.path(), "scanversion");
+    QVERIFY(module != nullptr);
+    QCOMPARE(module->totalUnresolvedDocuments(), static_cast<size_t>(2));
+    QCOMPARE(module->unresolvedDocumentAt(0)->totalTypes(), static_cast<size_t>(1));
+    QCOMPARE(module->unresolvedDocumentAt(0)->typeAt(0)->typeName().data(), std::string("C0_0"));
+
+    // the documents were scanned again, and the cache was rewritten with the current version
+    QVERIFY(cache.load());
+    QCOMPARE(cache.size(), static_cast<size_t>(2));
+    DocumentInfo::Ptr result = cache.lookup(d0Path, key);
+    QVERIFY(result != nullptr);
+    QCOMPARE(result->typeAt(0)->typeName().data(), std::string("C0_0"));
+}
+
+void LanguageInfoCacheTest::scanBenchmark_data(){
+    QTest::addColumn<bool>("warm");
+
+    QTest::newRow("cold") << false;
+    QTest::newRow("warm") << true;
+}
+
+void LanguageInfoCacheTest::scanBenchmark(){
+    QFETCH(bool, warm);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // 500 packages, each with its own module and cache, where every package imports the previous one
+    const int totalPackages = 500;
+
+    std::vector<std::string> importUris;
+    for ( int i = 0; i < totalPackages; ++i ){
+        std::string name = "scanbenchmark" + std::to_string(i);
+        std::vector<std::string> imports;
+        if ( i > 0 )
+            imports.push_back(importUris.back());
+
+        createPackage(dir.path(), name, imports, 4);
+        importUris.push_back(name);
+    }
+
+    if ( warm )
+        QCOMPARE(scanModules(dir.path(), importUris).size(), static_cast<size_t>(totalPackages));
+
+    QBENCHMARK{
+        std::vector<ModuleInfo::ConstPtr> modules = scanModules(dir.path(), importUris, warm);
+        QCOMPARE(modules.size(), static_cast<size_t>(totalPackages));
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef LANGUAGEINFOCACHETEST_H
+#define LANGUAGEINFOCACHETEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class LanguageInfoCacheTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    LanguageInfoCacheTest(QObject* parent = nullptr);
+    ~LanguageInfoCacheTest(){}
+
+private slots:
+    void initTestCase();
+
+    void keyTest();
+    void storeLookupTest();
+    void scannerCacheTest();
+    void corruptCacheTest();
+    void versionMismatchTest();
+    void scanBenchmark_data();
+    void scanBenchmark();
+
+};
+
+#endif // LANGUAGEINFOCACHETEST_H
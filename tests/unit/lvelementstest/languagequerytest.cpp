@@ -0,0 +1,160 @@
+#include "languagequerytest.h"
+#include "predicatebenchmarkfixture.h"
+#include "live/elements/languageparser.h"
+#include "live/elements/languagequery.h"
+
+Q_TEST_RUNNER_REGISTER(LanguageQueryTest);
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+bool argumentEquals(const std::string& source, const LanguageQuery::PredicateData& arg, const std::string& value){
+    if ( !arg.m_range.isValid() )
+        return arg.m_value.data() == value;
+    return arg.m_range.length() == value.size() && source.compare(arg.m_range.from(), arg.m_range.length(), value) == 0;
+}
+
+bool predicateEqOr(const std::vector<LanguageQuery::PredicateData>& args, void* payload){
+    const std::string& source = *reinterpret_cast<const std::string*>(payload);
+    for ( size_t i = 1; i < args.size(); ++i ){
+        if ( argumentEquals(source, args[0], args[i].m_value.data()) )
+            return true;
+    }
+    return false;
+}
+
+std::string capturedText(const std::string& source, const SourceRange& range){
+    return source.substr(range.from(), range.length());
+}
+
+}// namespace
+
+LanguageQueryTest::LanguageQueryTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void LanguageQueryTest::initTestCase(){
+}
+
+void LanguageQueryTest::predicateTest(){
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+    std::string source =
+        "component A < Element{\n"
+        "    int x: 20\n"
+        "    string y: \"a\"\n"
+        "}\n";
+    LanguageParser::AST* ast = parser->parse(source);
+
+    LanguageQuery::Ptr query = LanguageQuery::create(
+        parser->language(), "((identifier) @keyword (eq-or? @keyword \"int\" \"string\"))"
+    );
+    query->addPredicate("eq-or?", &predicateEqOr);
+
+    std::vector<std::string> matches;
+    LanguageQuery::Cursor::Ptr cursor = query->exec(ast);
+    while ( cursor->nextMatch() ){
+        if ( query->predicateMatch(cursor, &source) )
+            matches.push_back(capturedText(source, cursor->captureRange(0)));
+    }
+
+    QCOMPARE(matches.size(), static_cast<size_t>(2));
+    QCOMPARE(matches[0], std::string("int"));
+    QCOMPARE(matches[1], std::string("string"));
+
+    parser->destroy(ast);
+}
+
+void LanguageQueryTest::predicateCaptureTest(){
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+    std::string source =
+        "component A < Element{\n"
+        "    int x: 20\n"
+        "}\n";
+    LanguageParser::AST* ast = parser->parse(source);
+
+    LanguageQuery::Ptr query = LanguageQuery::create(
+        parser->language(), "((identifier) @keyword (eq? @keyword \"int\"))"
+    );
+
+    std::vector<LanguageQuery::PredicateData> received;
+    query->addPredicate("eq?", [&source, &received](const std::vector<LanguageQuery::PredicateData>& args, void*){
+        received = args;
+        return argumentEquals(source, args[0], args[1].m_value.data());
+    });
+
+    size_t totalMatches = 0;
+    LanguageQuery::Cursor::Ptr cursor = query->exec(ast);
+    while ( cursor->nextMatch() ){
+        if ( query->predicateMatch(cursor) ){
+            ++totalMatches;
+
+            QCOMPARE(received.size(), static_cast<size_t>(2));
+            QVERIFY(received[0].m_range.isValid());
+            QCOMPARE(received[0].m_row, static_cast<uint32_t>(1));
+            QCOMPARE(received[0].m_column, static_cast<uint32_t>(4));
+            QVERIFY(!received[1].m_range.isValid());
+            QCOMPARE(received[1].m_value.data(), std::string("int"));
+        }
+    }
+    QCOMPARE(totalMatches, static_cast<size_t>(1));
+
+    parser->destroy(ast);
+}
+
+void LanguageQueryTest::missingPredicateTest(){
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+    std::string source = "component A < Element{ int x: 20 }";
+    LanguageParser::AST* ast = parser->parse(source);
+
+    LanguageQuery::Ptr query = LanguageQuery::create(
+        parser->language(), "((identifier) @keyword (eq? @keyword \"int\"))"
+    );
+
+    LanguageQuery::Cursor::Ptr cursor = query->exec(ast);
+    QVERIFY(cursor->nextMatch());
+
+    bool hasException = false;
+    try{
+        query->predicateMatch(cursor);
+    } catch ( lv::Exception& ){
+        hasException = true;
+    }
+    QVERIFY(hasException);
+
+    parser->destroy(ast);
+}
+
+void LanguageQueryTest::predicateBenchmark(){
+    LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+    std::string source = predicatebenchmark::source();
+    LanguageParser::AST* ast = parser->parse(source);
+
+    LanguageQuery::Ptr query = predicatebenchmark::createQuery(parser);
+    query->addPredicate("eq-or?", &predicateEqOr);
+
+    size_t expectedMatches = predicatebenchmark::expectedMatches(query, ast, [&source](const SourceRange& range){
+        return capturedText(source, range);
+    });
+    QVERIFY(expectedMatches > 0);
+
+    size_t totalMatches = 0;
+    QBENCHMARK{
+        totalMatches = 0;
+        LanguageQuery::Cursor::Ptr cursor = query->exec(ast);
+        while ( cursor->nextMatch() ){
+            if ( query->predicateMatch(cursor, &source) )
+                ++totalMatches;
+        }
+    }
+
+    QCOMPARE(totalMatches, expectedMatches);
+
+    parser->destroy(ast);
+}
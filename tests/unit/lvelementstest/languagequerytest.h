@@ -0,0 +1,26 @@
+#ifndef LANGUAGEQUERYTEST_H
+#define LANGUAGEQUERYTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class LanguageQueryTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    LanguageQueryTest(QObject* parent = nullptr);
+    ~LanguageQueryTest(){}
+
+private slots:
+    void initTestCase();
+
+    void predicateTest();
+    void predicateCaptureTest();
+    void missingPredicateTest();
+    void predicateBenchmark();
+
+};
+
+#endif // LANGUAGEQUERYTEST_H
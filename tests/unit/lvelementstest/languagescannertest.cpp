@@ -0,0 +1,107 @@
+#include "languagescannertest.h"
+#include "scannertestutils.h"
+#include "live/visuallog.h"
+
+#include <QTemporaryDir>
+
+#include <algorithm>
+
+Q_TEST_RUNNER_REGISTER(LanguageScannerTest);
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+class ScannerLogTransport : public VisualLog::Transport{
+
+public:
+    void onMessage(const VisualLog::Configuration*, const VisualLog::MessageInfo&, const std::string& message) override{
+        messages.push_back(message);
+    }
+    void onObject(const VisualLog::Configuration*, const VisualLog::MessageInfo&, const std::string&, const MLNode&) override{}
+
+public:
+    std::vector<std::string> messages;
+};
+
+std::vector<std::string> scanModules(const QString& importPath, const std::string& importUri){
+    std::vector<ModuleInfo::ConstPtr> modules = scannertest::scanModules(importPath, {importUri}, false);
+
+    std::vector<std::string> published;
+    for ( auto it = modules.begin(); it != modules.end(); ++it )
+        published.push_back((*it)->importUri().data());
+    return published;
+}
+
+size_t indexOf(const std::vector<std::string>& published, const std::string& importUri){
+    return static_cast<size_t>(std::find(published.begin(), published.end(), importUri) - published.begin());
+}
+
+}// namespace
+
+LanguageScannerTest::LanguageScannerTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void LanguageScannerTest::initTestCase(){
+}
+
+void LanguageScannerTest::dependencyOrderTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    scannertest::createPackage(dir.path(), "scanordera", {"scanorderb", "scanorderc"});
+    scannertest::createPackage(dir.path(), "scanorderb", {"scanorderc"});
+    scannertest::createPackage(dir.path(), "scanorderc", {});
+
+    std::vector<std::string> published = scanModules(dir.path(), "scanordera");
+    QCOMPARE(published.size(), static_cast<size_t>(3));
+    QCOMPARE(published[0], std::string("scanorderc"));
+    QCOMPARE(published[1], std::string("scanorderb"));
+    QCOMPARE(published[2], std::string("scanordera"));
+}
+
+void LanguageScannerTest::cyclicDependencyTest(){
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // scancyclec -> scancyclea <-> scancycleb, scancycleb -> scancycled
+    scannertest::createPackage(dir.path(), "scancyclea", {"scancycleb"});
+    scannertest::createPackage(dir.path(), "scancycleb", {"scancyclea", "scancycled"});
+    scannertest::createPackage(dir.path(), "scancyclec", {"scancyclea"});
+    scannertest::createPackage(dir.path(), "scancycled", {});
+
+    ScannerLogTransport* transport = new ScannerLogTransport;
+    vlog().addTransport("lvelements-languagescanner", transport);
+
+    std::vector<std::string> published = scanModules(dir.path(), "scancyclec");
+
+    std::vector<std::string> messages = transport->messages;
+    vlog().removeTransports("lvelements-languagescanner");
+
+    QCOMPARE(published.size(), static_cast<size_t>(4));
+
+    size_t a = indexOf(published, "scancyclea");
+    size_t b = indexOf(published, "scancycleb");
+    size_t c = indexOf(published, "scancyclec");
+    size_t d = indexOf(published, "scancycled");
+
+    // the cycle is published in one piece, after its dependencies and before its dependents
+    QVERIFY(a < published.size() && b < published.size());
+    QCOMPARE(a > b ? a - b : b - a, static_cast<size_t>(1));
+    QVERIFY(d < a && d < b);
+    QVERIFY(c > a && c > b);
+
+    size_t totalCycleMessages = 0;
+    for ( auto it = messages.begin(); it != messages.end(); ++it ){
+        if ( it->find("Cyclic module dependency") != std::string::npos ){
+            ++totalCycleMessages;
+            QVERIFY(it->find("scancyclea") != std::string::npos);
+            QVERIFY(it->find("scancycleb") != std::string::npos);
+            QVERIFY(it->find("scancyclec") == std::string::npos);
+        }
+    }
+    QCOMPARE(totalCycleMessages, static_cast<size_t>(1));
+}
@@ -0,0 +1,24 @@
+#ifndef LANGUAGESCANNERTEST_H
+#define LANGUAGESCANNERTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class LanguageScannerTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    LanguageScannerTest(QObject* parent = nullptr);
+    ~LanguageScannerTest(){}
+
+private slots:
+    void initTestCase();
+
+    void dependencyOrderTest();
+    void cyclicDependencyTest();
+
+};
+
+#endif // LANGUAGESCANNERTEST_H
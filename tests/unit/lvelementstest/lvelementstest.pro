@@ -31,7 +31,18 @@ HEADERS += \
     $$PWD/metaobjecttypeinfotest.h \
     $$PWD/lvimportstest.h \
     $$PWD/lvelparseddocumenttest.h \
-    $$PWD/lvellanguageinfoserializationtest.h
+    $$PWD/lvellanguageinfoserializationtest.h \
+    $$PWD/compilecachetest.h \
+    $$PWD/enginesnapshottest.h \
+    $$PWD/moduleprefetchertest.h \
+    $$PWD/incrementaltranspilertest.h \
+    $$PWD/buffertest.h \
+    $$PWD/enginepooltest.h \
+    $$PWD/languageinfocachetest.h \
+    $$PWD/languagequerytest.h \
+    $$PWD/languagescannertest.h \
+    $$PWD/scannertestutils.h \
+    $$PWD/predicatebenchmarkfixture.h
 
 SOURCES += \
     $$PWD/main.cpp \
@@ -56,7 +67,16 @@ SOURCES += \
     $$PWD/metaobjecttypeinfotest.cpp \
     $$PWD/lvimportstest.cpp \
     $$PWD/lvelparseddocumenttest.cpp \
-    $$PWD/lvellanguageinfoserializationtest.cpp
+    $$PWD/lvellanguageinfoserializationtest.cpp \
+    $$PWD/compilecachetest.cpp \
+    $$PWD/enginesnapshottest.cpp \
+    $$PWD/moduleprefetchertest.cpp \
+    $$PWD/incrementaltranspilertest.cpp \
+    $$PWD/buffertest.cpp \
+    $$PWD/enginepooltest.cpp \
+    $$PWD/languageinfocachetest.cpp \
+    $$PWD/languagequerytest.cpp \
+    $$PWD/languagescannertest.cpp
 
 OTHER_FILES += $$PWD/data/*.*
 
@@ -543,3 +543,68 @@ void LvElParsedDocumentTest::cursorContext13Test()
     QVERIFY(result.propertyPath().size() == 0);
     QVERIFY(!result.propertyDeclaredType().isValid());
 }
+
+std::string LvElParsedDocumentTest::wideComponentSource(int totalProperties){
+    std::string result = "import a.b\n\ncomponent T < Element{\n";
+    for ( int i = 0; i < totalProperties; ++i )
+        result += "    int prop" + std::to_string(i) + ": " + std::to_string(i) + "\n";
+    result += "    fn test(int a, string b){}\n}\n";
+    return result;
+}
+
+void LvElParsedDocumentTest::wideComponentTest()
+{
+    std::string testString = wideComponentSource(10000);
+
+    auto ast = m_parser->parse(testString);
+    lv::el::DocumentInfo::Ptr result = lv::el::ParsedDocument::extractInfo(testString, ast);
+
+    QVERIFY(result->totalImports() == 1);
+    QVERIFY(result->totalTypes() == 1);
+
+    auto type = result->typeAt(0);
+    QVERIFY(type->totalProperties() == 10000);
+    QVERIFY(type->propertyAt(9999).name() == "prop9999");
+    QVERIFY(type->propertyAt(9999).typeName() == "int");
+    QVERIFY(type->totalFunctions() == 1);
+    QVERIFY(type->functionAt(0).parameterCount() == 2);
+
+    // cursor right after "prop9999"
+    size_t position = testString.find("prop9999") + 8;
+    lv::el::CursorContext context = lv::el::ParsedDocument::findCursorContext(ast, static_cast<int>(position));
+
+    QVERIFY(context.context() == (lv::el::CursorContext::InLeftOfDeclaration | lv::el::CursorContext::InElements));
+    QVERIFY(context.expressionPath().size() == 1);
+    QVERIFY(context.expressionPath()[0].from() == position - 8);
+    QVERIFY(context.expressionPath()[0].length() == 8);
+    QVERIFY(context.objectType().from() == testString.find("Element"));
+    QVERIFY(context.objectType().length() == 7);
+
+    m_parser->destroy(ast);
+}
+
+void LvElParsedDocumentTest::extractInfoBenchmark()
+{
+    std::string testString = wideComponentSource(10000);
+    auto ast = m_parser->parse(testString);
+
+    QBENCHMARK{
+        lv::el::ParsedDocument::extractInfo(testString, ast);
+    }
+
+    m_parser->destroy(ast);
+}
+
+void LvElParsedDocumentTest::cursorContextBenchmark()
+{
+    std::string testString = wideComponentSource(10000);
+    auto ast = m_parser->parse(testString);
+
+    int position = static_cast<int>(testString.find("prop9999") + 4);
+
+    QBENCHMARK{
+        lv::el::ParsedDocument::findCursorContext(ast, position);
+    }
+
+    m_parser->destroy(ast);
+}
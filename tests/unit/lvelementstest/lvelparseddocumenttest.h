@@ -40,7 +40,13 @@ private slots:
     void cursorContext12Test();
     void cursorContext13Test();
 
+    void wideComponentTest();
+    void extractInfoBenchmark();
+    void cursorContextBenchmark();
+
 private:
+    static std::string wideComponentSource(int totalProperties);
+
     lv::el::LanguageParser::Ptr m_parser;
 };
 
@@ -42,6 +42,14 @@
 #include "metaobjecttypeinfotest.h"
 #include "lvelparseddocumenttest.h"
 #include "lvellanguageinfoserializationtest.h"
+#include "compilecachetest.h"
+#include "enginesnapshottest.h"
+#include "moduleprefetchertest.h"
+#include "incrementaltranspilertest.h"
+#include "buffertest.h"
+#include "enginepooltest.h"
+#include "languageinfocachetest.h"
+#include "languagequerytest.h"
 
 int main(int argc, char *argv[]){
     lv::ApplicationContext::initialize({});
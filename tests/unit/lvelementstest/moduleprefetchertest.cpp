@@ -0,0 +1,126 @@
+#include "moduleprefetchertest.h"
+#include "live/elements/engine.h"
+#include "live/elements/element.h"
+#include "live/elements/component.h"
+#include "live/elements/moduleprefetcher.h"
+#include "live/applicationcontext.h"
+
+#include "testpack.h"
+
+#include <QFile>
+#include <QCoreApplication>
+
+Q_TEST_RUNNER_REGISTER(ModulePrefetcherTest);
+
+using namespace lv;
+using namespace lv::el;
+
+namespace{
+
+std::string readFile(const std::string& path){
+    QFile file(QString::fromStdString(path));
+    file.open(QFile::ReadOnly);
+    return file.readAll().toStdString();
+}
+
+}// namespace
+
+ModulePrefetcherTest::ModulePrefetcherTest(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void ModulePrefetcherTest::initTestCase(){
+}
+
+void ModulePrefetcherTest::prefetchTest(){
+    Engine* engine = new Engine;
+    std::string scriptsPath = lv::ApplicationContext::instance().releasePath() + "/data/ImportTest03.lv";
+    std::string testPath = (QCoreApplication::applicationDirPath() + "/test").toStdString();
+
+    TestPack tp(testPath);
+    tp.unpack(scriptsPath);
+
+    engine->scope([engine, testPath](){
+        Plugin::Ptr plugin = engine->packageGraph()->createRunningPlugin(testPath);
+
+        ModulePrefetcher prefetcher(engine, 2);
+        prefetcher.prefetch(plugin, testPath + "/main.lv");
+
+        // main.lv, plugin1/A.lv and plugin1/B.lv
+        QCOMPARE(prefetcher.totalModules(), static_cast<size_t>(3));
+
+        LanguageParser::Ptr parser = LanguageParser::createForElements();
+
+        std::string mainSource = readFile(testPath + "/main.lv");
+        std::string mainJs;
+        QVERIFY(prefetcher.take(testPath + "/main.lv", mainSource, mainJs));
+        QCOMPARE(mainJs, parser->toJs(mainSource, "main"));
+
+        std::string aSource = readFile(testPath + "/plugin1/A.lv");
+        std::string aJs;
+        QVERIFY(prefetcher.take(testPath + "/plugin1/A.lv", aSource, aJs));
+        QCOMPARE(aJs, parser->toJs(aSource, "A"));
+
+        QCOMPARE(prefetcher.totalModules(), static_cast<size_t>(1));
+
+        // taken modules are not prefetched again
+        QVERIFY(!prefetcher.take(testPath + "/main.lv", mainSource, mainJs));
+        prefetcher.prefetch(plugin, testPath + "/main.lv");
+        QCOMPARE(prefetcher.totalModules(), static_cast<size_t>(1));
+    });
+
+    delete engine;
+}
+
+void ModulePrefetcherTest::changedSourceTest(){
+    Engine* engine = new Engine;
+    std::string scriptsPath = lv::ApplicationContext::instance().releasePath() + "/data/ImportTest03.lv";
+    std::string testPath = (QCoreApplication::applicationDirPath() + "/test").toStdString();
+
+    TestPack tp(testPath);
+    tp.unpack(scriptsPath);
+
+    engine->scope([engine, testPath](){
+        Plugin::Ptr plugin = engine->packageGraph()->createRunningPlugin(testPath);
+
+        ModulePrefetcher prefetcher(engine);
+        prefetcher.prefetch(plugin, testPath + "/main.lv");
+
+        std::string js;
+        QVERIFY(!prefetcher.take(testPath + "/plugin1/B.lv", "component default < Element{}", js));
+        QVERIFY(js.empty());
+        QCOMPARE(prefetcher.totalModules(), static_cast<size_t>(2));
+    });
+
+    delete engine;
+}
+
+void ModulePrefetcherTest::loadFileTest(){
+    Engine* engine = new Engine;
+    engine->setModuleFileType(Engine::Lv);
+    std::string scriptsPath = lv::ApplicationContext::instance().releasePath() + "/data/ImportTest03.lv";
+    std::string testPath = (QCoreApplication::applicationDirPath() + "/test").toStdString();
+
+    TestPack tp(testPath);
+    tp.unpack(scriptsPath);
+
+    engine->scope([engine, testPath](){
+        Object exports = engine->loadFile(testPath + "/main.lv");
+        Object::Accessor localExports(exports);
+
+        ScopedValue lv = localExports.get(engine, "main");
+        QVERIFY(lv.isCallable());
+
+        Component comp = lv.toCallable(engine).toComponent();
+        Element* el = comp.create(Function::Parameters(0));
+
+        QVERIFY(el != nullptr);
+        QVERIFY(el->get("b").toStdString(engine) == "class[A]");
+
+        // all modules were compiled from their prefetched javascript
+        QCOMPARE(engine->modulePrefetcher()->totalModules(), static_cast<size_t>(0));
+    });
+
+    delete engine;
+}
@@ -0,0 +1,25 @@
+#ifndef MODULEPREFETCHERTEST_H
+#define MODULEPREFETCHERTEST_H
+
+#include <QObject>
+#include "testrunner.h"
+
+class ModulePrefetcherTest: public QObject{
+
+    Q_OBJECT
+    Q_TEST_RUNNER_SUITE
+
+public:
+    ModulePrefetcherTest(QObject* parent = nullptr);
+    ~ModulePrefetcherTest(){}
+
+private slots:
+    void initTestCase();
+
+    void prefetchTest();
+    void changedSourceTest();
+    void loadFileTest();
+
+};
+
+#endif // MODULEPREFETCHERTEST_H
@@ -0,0 +1,64 @@
+#ifndef PREDICATEBENCHMARKFIXTURE_H
+#define PREDICATEBENCHMARKFIXTURE_H
+
+#include "live/elements/languageparser.h"
+#include "live/elements/languagequery.h"
+
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+/// Source and query shared by the predicate benchmarks, which run the same query over different payloads
+namespace predicatebenchmark{
+
+inline std::string source(){
+    std::string result;
+    for ( int i = 0; i < 2000; ++i ){
+        result +=
+            "component C" + std::to_string(i) + " < Element{\n"
+            "    int x: " + std::to_string(i) + "\n"
+            "    string label: \"C" + std::to_string(i) + "\"\n"
+            "    variant data: Object.create(null)\n"
+            "    fn value(int a){\n"
+            "        return Math.max(this.x, a)\n"
+            "    }\n"
+            "}\n\n";
+    }
+    return result;
+}
+
+/// Query with one eq-or? predicate per pattern. The predicate needs to be added by each benchmark.
+inline lv::el::LanguageQuery::Ptr createQuery(lv::el::LanguageParser::Ptr parser){
+    return lv::el::LanguageQuery::create(
+        parser->language(),
+        "((identifier) @keyword (eq-or? @keyword \"Object\" \"Math\" \"string\" \"int\" \"variant\")) \n"
+        "((identifier) @variable.builtin (eq-or? @variable.builtin \"console\" \"parent\")) \n"
+    );
+}
+
+/// Counts the matches the predicates should accept, by comparing a copy of each captured text, returned by
+/// \p capturedText, against the values of its pattern. Every identifier is matched once per pattern.
+inline size_t expectedMatches(
+        lv::el::LanguageQuery::Ptr query,
+        lv::el::LanguageParser::AST* ast,
+        const std::function<std::string(const lv::el::SourceRange&)>& capturedText)
+{
+    std::vector<std::set<std::string> > patternValues = {
+        {"Object", "Math", "string", "int", "variant"},
+        {"console", "parent"}
+    };
+
+    size_t result = 0;
+    lv::el::LanguageQuery::Cursor::Ptr cursor = query->exec(ast);
+    while ( cursor->nextMatch() ){
+        const std::set<std::string>& values = patternValues[cursor->matchPatternIndex()];
+        if ( values.find(capturedText(cursor->captureRange(0))) != values.end() )
+            ++result;
+    }
+    return result;
+}
+
+} // namespace predicatebenchmark
+
+#endif // PREDICATEBENCHMARKFIXTURE_H
@@ -0,0 +1,99 @@
+#ifndef SCANNERTESTUTILS_H
+#define SCANNERTESTUTILS_H
+
+#include "live/elements/languagescanner.h"
+#include "live/elements/languageparser.h"
+#include "live/lockedfileiosession.h"
+
+#include <QFile>
+#include <QDir>
+
+#include <string>
+#include <vector>
+
+/// Helpers that write packages to disk and scan them, shared by the scanner and scanner cache tests
+namespace scannertest{
+
+inline void writeFile(const QString& path, const std::string& content){
+    QFile file(path);
+    file.open(QFile::WriteOnly);
+    file.write(content.data(), static_cast<qint64>(content.size()));
+}
+
+/// Source of document \p index, declaring \p totalTypes components after the given imports
+inline std::string documentSource(int index, int totalTypes = 1, const std::vector<std::string>& imports = {}){
+    std::string result;
+    for ( auto it = imports.begin(); it != imports.end(); ++it )
+        result += "import " + *it + "\n";
+    if ( !imports.empty() )
+        result += "\n";
+
+    for ( int i = 0; i < totalTypes; ++i ){
+        result +=
+            "component C" + std::to_string(index) + "_" + std::to_string(i) + " < Element{\n"
+            "    int x: " + std::to_string(index) + "\n"
+            "    string label: \"C" + std::to_string(index) + "\"\n"
+            "    fn value(int a){\n"
+            "        return this.x + a\n"
+            "    }\n"
+            "}\n\n";
+    }
+    return result;
+}
+
+/// Creates package \p name under \p importPath, with a single module of \p totalDocuments documents (D0.lv, D1.lv,
+/// ...), each one importing the given packages. Returns the package path.
+inline QString createPackage(
+        const QString& importPath,
+        const std::string& name,
+        const std::vector<std::string>& imports = {},
+        int totalDocuments = 1)
+{
+    QString path = importPath + "/" + QString::fromStdString(name);
+    QDir().mkpath(path);
+
+    std::string modules;
+    for ( int i = 0; i < totalDocuments; ++i ){
+        modules += (i == 0 ? "\"D" : ", \"D") + std::to_string(i) + "\"";
+        writeFile(path + "/D" + QString::number(i) + ".lv", documentSource(i, 1, imports));
+    }
+
+    writeFile(path + "/live.package.json", "{\"name\": \"" + name + "\", \"version\": \"1.0.0\"}");
+    writeFile(path + "/live.plugin.json", "{\"name\": \"" + name + "\", \"package\": \".\", \"modules\": [" + modules + "]}");
+    return path;
+}
+
+/// Scans the modules in \p importUris and their dependencies, returning them in the order they were published
+inline std::vector<lv::el::ModuleInfo::ConstPtr> scanModules(
+        const QString& importPath, const std::vector<std::string>& importUris, bool useCache = true)
+{
+    lv::el::LanguageScanner::Ptr scanner = lv::el::LanguageScanner::create(
+        lv::el::LanguageParser::createForElements(), lv::LockedFileIOSession::createInstance()
+    );
+    scanner->setCacheEnabled(useCache);
+    scanner->setPackageImportPaths({importPath.toStdString()});
+
+    std::vector<lv::el::ModuleInfo::ConstPtr> published;
+    scanner->onModuleReady([&published](lv::el::ModuleInfo::ConstPtr module){
+        published.push_back(module);
+    });
+
+    for ( auto it = importUris.begin(); it != importUris.end(); ++it )
+        scanner->queueModule(*it);
+    scanner->consumeQueue(1000);
+    return published;
+}
+
+/// Scans \p importUri, returning its module, or null if it wasn't published
+inline lv::el::ModuleInfo::ConstPtr scanModule(const QString& importPath, const std::string& importUri, bool useCache = true){
+    std::vector<lv::el::ModuleInfo::ConstPtr> published = scanModules(importPath, {importUri}, useCache);
+    for ( auto it = published.begin(); it != published.end(); ++it ){
+        if ( (*it)->importUri().data() == importUri )
+            return *it;
+    }
+    return nullptr;
+}
+
+} // namespace scannertest
+
+#endif // SCANNERTESTUTILS_H
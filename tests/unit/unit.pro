@@ -5,5 +5,6 @@ SUBDIRS += $$PWD/lveditortest
 
 !isEmpty(BUILD_ELEMENTS){
     SUBDIRS += $$PWD/lvelementstest
+    SUBDIRS += $$PWD/editlvtest
 }
 